@@ -0,0 +1,78 @@
+// Arrow IPC export and import on the demo types, against a plain memcpy of
+// the same number of bytes as the memory-bandwidth ceiling
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "meta.h"
+#include "meta_arrow.h"
+#include "meta_soa.h"
+#include "bench_common.meta"
+
+template <typename T> void runType(const char* type, const std::vector<T>& rows)
+{
+    const size_t count = rows.size();
+    meta::soa_vector<T> columns;
+    columns.reserve(count);
+    for (const T& row : rows)
+        columns.push_back(row);
+
+    const std::string ipc = meta::arrow::serialize(rows);
+    std::string copy(ipc.size(), '\0');
+    run(type, "memcpy", count,
+        [&]
+        {
+            std::memcpy(copy.data(), ipc.data(), ipc.size());
+            return copy.size();
+        });
+    // export into a reused buffer, as the memcpy does
+    std::string out;
+    run(type, "vector export", count,
+        [&]
+        {
+            out.clear();
+            meta::arrow::serialize_to(out, rows);
+            return out.size();
+        });
+    run(type, "soa export", count,
+        [&]
+        {
+            out.clear();
+            meta::arrow::serialize_to(out, columns);
+            return out.size();
+        });
+    run(type, "file export", count,
+        [&]
+        {
+            out.clear();
+            meta::arrow::serialize_to(out, columns, meta::arrow::Format::File);
+            return out.size();
+        });
+    run(type, "import", count,
+        [&]
+        {
+            meta::arrow::parse<T>(ipc);
+            return ipc.size();
+        });
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    std::vector<Car> cars;
+    std::vector<Row> rows;
+    std::vector<ComplexRow> complex;
+    makeBenchRows(count, cars, rows, complex);
+
+    std::cout << std::left << std::setw(12) << "type" << std::setw(20) << "method" << std::right
+              << std::setw(10) << "records" << std::setw(12) << "bytes" << std::setw(15)
+              << "throughput\n";
+
+    runType("Car", cars);
+    runType("Row", rows);
+    runType("ComplexRow", complex);
+}
@@ -0,0 +1,64 @@
+// meta::binary throughput on the demo types, next to compact JSON:
+// serialize / serialize_to (reused buffer) / parse<T>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "meta.h"
+#include "meta_binary.h"
+#include "meta_json.h"
+#include "bench_common.meta"
+
+template <typename T> void benchType(const char* type, const std::vector<T>& rows)
+{
+    run(type,
+        "json compact",
+        rows.size(),
+        [&] { return meta::json::serialize_compact(rows).size(); });
+    run(type, "serialize", rows.size(), [&] { return meta::binary::serialize(rows).size(); });
+
+    std::vector<char> buf(meta::binary::byte_size(rows));
+    run(type,
+        "serialize_to",
+        rows.size(),
+        [&] { return meta::binary::serialize_to(rows, std::span<char>(buf)); });
+
+    const std::string json = meta::json::serialize_compact(rows);
+    run(type,
+        "json parse<T>",
+        rows.size(),
+        [&]
+        {
+            auto parsed = meta::json::parse<std::vector<T>>(json);
+            return parsed.size() == rows.size() ? json.size() : 0;
+        });
+
+    const std::string bytes = meta::binary::serialize(rows);
+    run(type,
+        "parse<T>",
+        rows.size(),
+        [&]
+        {
+            auto parsed = meta::binary::parse<std::vector<T>>(bytes);
+            return parsed.size() == rows.size() ? bytes.size() : 0;
+        });
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+    std::vector<Car> cars;
+    std::vector<Row> rows;
+    std::vector<ComplexRow> complex;
+    makeBenchRows(count, cars, rows, complex);
+
+    std::cout << std::left << std::setw(12) << "type" << std::setw(20) << "codec" << std::right
+              << std::setw(10) << "records" << std::setw(12) << "bytes" << std::setw(15)
+              << "throughput\n";
+    benchType("Car", cars);
+    benchType("Row", rows);
+    benchType("ComplexRow", complex);
+}
@@ -0,0 +1,76 @@
+// Demo types and timing shared by the bench_* programs
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// demo01
+struct Car
+{
+    std::string maker;
+    std::string model;
+    unsigned short year;
+    bool electric;
+    unsigned int howmanymiles;
+};
+
+// demo06
+struct Row
+{
+    int64_t field1;
+    int64_t field2;
+    int64_t field3;
+    std::string field4;
+    std::string field5;
+    std::string field6;
+};
+
+// demoall
+struct ComplexRow
+{
+    int idd;
+    std::string name;
+    std::vector<int> scores;
+    std::vector<std::string> tags;
+    std::vector<std::vector<int64_t>> matrix;
+    std::vector<std::vector<std::string>> categories;
+};
+
+inline void makeBenchRows(size_t count,
+                          std::vector<Car>& cars,
+                          std::vector<Row>& rows,
+                          std::vector<ComplexRow>& complex)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto n = static_cast<int64_t>(i);
+        cars.push_back({"dodge", "caravan \"se\"", static_cast<unsigned short>(1990 + i % 35),
+                        i % 2 == 0, static_cast<unsigned int>(i * 7)});
+        rows.push_back({n, n * 2, n * 3, "a", "xxxx", "line\nbreak"});
+        complex.push_back({static_cast<int>(i),
+                           "row" + std::to_string(i),
+                           {1, 2, 3, 4},
+                           {"red", "green"},
+                           {{n, n + 1}, {n + 2, n + 3}},
+                           {{"x", "y"}, {"z"}}});
+    }
+}
+
+// Times fn (which returns the bytes it processed) and prints one result row
+template <typename Fn> void run(const char* type, const char* name, size_t count, Fn&& fn)
+{
+    constexpr int rounds = 20;
+    size_t bytes = fn(); // warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r)
+        bytes = fn();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double mb = static_cast<double>(bytes) * rounds / (1024.0 * 1024.0);
+    std::cout << std::left << std::setw(12) << type << std::setw(20) << name << std::right
+              << std::setw(10) << count << std::setw(12) << bytes << std::setw(10) << std::fixed
+              << std::setprecision(1) << mb / elapsed.count() << " MB/s\n";
+}
@@ -0,0 +1,86 @@
+// CSV reader throughput on the demo types (ComplexRow has no CSV form):
+// parse<T> serial and threaded, parse_each<T>, records<T>, and parse_file<T> over mmap
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "meta.h"
+#include "meta_csv.h"
+#include "bench_common.meta"
+
+template <typename T> void benchType(const char* type, const std::vector<T>& rows)
+{
+    const std::string csv = meta::csv::serialize(rows);
+    const std::string path = std::string("bench_csv_") + type + ".csv";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << csv;
+    }
+
+    run(type,
+        "parse<T>",
+        rows.size(),
+        [&]
+        {
+            auto parsed = meta::csv::parse<T>(csv);
+            return parsed.size() == rows.size() ? csv.size() : 0;
+        });
+    run(type,
+        "parse<T> threads",
+        rows.size(),
+        [&]
+        {
+            auto parsed = meta::csv::parse<T>(csv, {.threads = 0});
+            return parsed.size() == rows.size() ? csv.size() : 0;
+        });
+    run(type,
+        "parse_each<T>",
+        rows.size(),
+        [&]
+        {
+            size_t n = meta::csv::parse_each<T>(csv, [](T&& row) { (void)row; });
+            return n == rows.size() ? csv.size() : 0;
+        });
+    run(type,
+        "records<T>",
+        rows.size(),
+        [&]
+        {
+            size_t n = 0;
+            for (T& row : meta::csv::records<T>(csv))
+            {
+                (void)row;
+                ++n;
+            }
+            return n == rows.size() ? csv.size() : 0;
+        });
+    run(type,
+        "parse_file<T>",
+        rows.size(),
+        [&]
+        {
+            auto parsed = meta::csv::parse_file<T>(path, {.threads = 0});
+            return parsed.size() == rows.size() ? csv.size() : 0;
+        });
+    std::remove(path.c_str());
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+    std::vector<Car> cars;
+    std::vector<Row> rows;
+    std::vector<ComplexRow> complex;
+    makeBenchRows(count, cars, rows, complex);
+
+    std::cout << std::left << std::setw(12) << "type" << std::setw(20) << "reader" << std::right
+              << std::setw(10) << "records" << std::setw(12) << "bytes" << std::setw(15)
+              << "throughput\n";
+    benchType("Car", cars);
+    benchType("Row", rows);
+}
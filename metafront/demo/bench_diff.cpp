@@ -0,0 +1,94 @@
+// An update stream on the demo types: every record changes one field, sent
+// as the whole record (meta::binary::serialize) or as a patch (meta::diff,
+// then meta::binary::serialize_patch). Prints the bytes each stream carries
+// and the rate records go out at, and the JSON equivalents.
+// Usage: bench_diff [rows]
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "meta.h"
+#include "meta_binary.h"
+#include "meta_diff.h"
+#include "meta_json.h"
+#include "bench_common.meta"
+
+template <typename T, typename Touch>
+void runType(const char* type, const std::vector<T>& before, Touch&& touch)
+{
+    const size_t count = before.size();
+    std::vector<T> after = before;
+    for (T& row : after)
+        touch(row);
+
+    run(type, "binary full", count,
+        [&]
+        {
+            size_t bytes = 0;
+            for (const T& row : after)
+                bytes += meta::binary::serialize(row).size();
+            return bytes;
+        });
+    run(type, "binary patch", count,
+        [&]
+        {
+            size_t bytes = 0;
+            for (size_t i = 0; i < count; ++i)
+                bytes += meta::binary::serialize_patch(meta::diff(before[i], after[i])).size();
+            return bytes;
+        });
+    run(type, "json full", count,
+        [&]
+        {
+            size_t bytes = 0;
+            for (const T& row : after)
+                bytes += meta::json::format_json_value(row).size();
+            return bytes;
+        });
+    run(type, "json patch", count,
+        [&]
+        {
+            size_t bytes = 0;
+            for (size_t i = 0; i < count; ++i)
+                bytes += meta::json::serialize_patch(meta::diff(before[i], after[i])).size();
+            return bytes;
+        });
+
+    // receiving side: decode the patches and apply them to the old records
+    std::vector<std::string> patches;
+    patches.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        patches.push_back(meta::binary::serialize_patch(meta::diff(before[i], after[i])));
+    std::vector<T> replica = before;
+    run(type, "binary apply", count,
+        [&]
+        {
+            size_t bytes = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                meta::apply_patch(replica[i], meta::binary::parse_patch<T>(patches[i]));
+                bytes += patches[i].size();
+            }
+            return bytes;
+        });
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 200000;
+
+    std::vector<Car> cars;
+    std::vector<Row> rows;
+    std::vector<ComplexRow> complex;
+    makeBenchRows(count, cars, rows, complex);
+
+    std::cout << std::left << std::setw(12) << "type" << std::setw(20) << "method" << std::right
+              << std::setw(10) << "records" << std::setw(12) << "bytes" << std::setw(15)
+              << "throughput\n";
+
+    runType("Car", cars, [](Car& car) { car.howmanymiles += 12; });
+    runType("Row", rows, [](Row& row) { row.field2 += 1; });
+    runType("ComplexRow", complex, [](ComplexRow& row) { row.scores[2] = 7; });
+}
@@ -0,0 +1,113 @@
+// Escape kernel throughput (meta_escape.h) on mostly clean ASCII text,
+// per writer and per kernel (scalar, ssse3, avx2)
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "meta.h"
+#include "meta_csv.h"
+#include "meta_json.h"
+#include "meta_xml.h"
+#include "meta_yaml.h"
+
+namespace
+{
+// Sentence-like strings, roughly one byte in 200 needing an escape
+std::vector<std::string> makeText(size_t count)
+{
+    const char specials[] = "\"\\<>&,:\n\t";
+    std::mt19937 rng(7);
+    std::vector<std::string> text;
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string s;
+        size_t len = 32 + rng() % 224;
+        for (size_t k = 0; k < len; ++k)
+        {
+            if (rng() % 200 == 0)
+                s += specials[rng() % (sizeof(specials) - 1)];
+            else
+                s += rng() % 6 == 0 ? ' ' : static_cast<char>('a' + rng() % 26);
+        }
+        text.push_back(std::move(s));
+    }
+    return text;
+}
+
+size_t totalBytes(const std::vector<std::string>& text)
+{
+    size_t bytes = 0;
+    for (const auto& s : text)
+        bytes += s.size();
+    return bytes;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+    auto text = makeText(count);
+    size_t bytes = totalBytes(text);
+
+    const auto best = meta::escape::active_kernel();
+    std::cout << "best kernel: " << meta::escape::kernel_name(best) << "\n";
+    std::cout << std::left << std::setw(12) << "kernel" << std::setw(20) << "escape" << std::right
+              << std::setw(10) << "strings" << std::setw(12) << "bytes" << std::setw(15)
+              << "throughput\n";
+
+    for (auto kernel : {meta::escape::Kernel::Scalar,
+                        meta::escape::Kernel::SSSE3,
+                        meta::escape::Kernel::AVX2})
+    {
+        if (kernel > best)
+            continue;
+        meta::escape::use_kernel(kernel);
+        const char* name = meta::escape::kernel_name(kernel);
+
+        std::string out;
+        run(name,
+            "json",
+            count,
+            [&]
+            {
+                out.clear();
+                for (const auto& s : text)
+                    meta::json::append_escaped(out, s);
+                return bytes;
+            });
+        run(name,
+            "xml",
+            count,
+            [&]
+            {
+                size_t n = 0;
+                for (const auto& s : text)
+                    n += meta::xml::escape_xml_string(s).size();
+                return n != 0 ? bytes : 0;
+            });
+        run(name,
+            "yaml",
+            count,
+            [&]
+            {
+                size_t n = 0;
+                for (const auto& s : text)
+                    n += meta::yaml::escape_yaml_string(s).size();
+                return n != 0 ? bytes : 0;
+            });
+        run(name,
+            "csv",
+            count,
+            [&]
+            {
+                std::ostringstream os;
+                for (const auto& s : text)
+                    meta::csv::writeCSVValue(os, s);
+                return bytes;
+            });
+    }
+}
@@ -0,0 +1,142 @@
+// meta::hash against the hand-written hashers it replaces: a
+// boost::hash_combine fold over std::hash of each field, on the demo types.
+// Prints hashes per second, and how many distinct values a 2D grid of
+// points maps to (the hand-written "x ^ (y << 1)" collides).
+// Usage: bench_hash [rows]
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "bench_common.h"
+#include "meta.h"
+#include "meta_hash.h"
+#include "bench_common.meta"
+
+struct Point
+{
+    int32_t x;
+    int32_t y;
+};
+
+namespace meta
+{
+template <> struct MetaTuple<::Point>
+{
+    static constexpr auto fields = std::make_tuple(meta::StaticField<&::Point::x, "x", "int32_t">{},
+                                                   meta::StaticField<&::Point::y, "y", "int32_t">{});
+};
+} // namespace meta
+
+volatile size_t g_sink;
+
+template <typename V> void combine(size_t& seed, const V& value)
+{
+    seed ^= std::hash<V>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+size_t handHash(const Car& car)
+{
+    size_t seed = 0;
+    combine(seed, car.maker);
+    combine(seed, car.model);
+    combine(seed, car.year);
+    combine(seed, car.electric);
+    combine(seed, car.howmanymiles);
+    return seed;
+}
+
+size_t handHash(const Row& row)
+{
+    size_t seed = 0;
+    combine(seed, row.field1);
+    combine(seed, row.field2);
+    combine(seed, row.field3);
+    combine(seed, row.field4);
+    combine(seed, row.field5);
+    combine(seed, row.field6);
+    return seed;
+}
+
+size_t handHash(const ComplexRow& row)
+{
+    size_t seed = 0;
+    combine(seed, row.idd);
+    combine(seed, row.name);
+    for (int score : row.scores)
+        combine(seed, score);
+    for (const std::string& tag : row.tags)
+        combine(seed, tag);
+    for (const auto& line : row.matrix)
+        for (int64_t cell : line)
+            combine(seed, cell);
+    for (const auto& group : row.categories)
+        for (const std::string& category : group)
+            combine(seed, category);
+    return seed;
+}
+
+template <typename Fn> void runHash(const char* type, const char* name, size_t count, Fn&& fn)
+{
+    constexpr int rounds = 10;
+    auto start = std::chrono::steady_clock::now();
+    size_t sum = 0;
+    for (int r = 0; r < rounds; ++r)
+        sum += fn();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    g_sink = sum;
+
+    std::cout << std::left << std::setw(12) << type << std::setw(20) << name << std::right << std::setw(10)
+              << count << std::setw(14) << std::fixed << std::setprecision(0) << count * rounds / elapsed.count()
+              << " hashes/s\n";
+}
+
+template <typename T> void runType(const char* type, const std::vector<T>& rows)
+{
+    runHash(type, "hash_combine", rows.size(),
+            [&]
+            {
+                size_t sum = 0;
+                for (const T& row : rows)
+                    sum += handHash(row);
+                return sum;
+            });
+    runHash(type, "meta::hash", rows.size(),
+            [&]
+            {
+                size_t sum = 0;
+                for (const T& row : rows)
+                    sum += meta::hash<T>{}(row);
+                return sum;
+            });
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    std::vector<Car> cars;
+    std::vector<Row> rows;
+    std::vector<ComplexRow> complex;
+    makeBenchRows(count, cars, rows, complex);
+
+    std::cout << std::left << std::setw(12) << "type" << std::setw(20) << "hasher" << std::right << std::setw(10)
+              << "records" << std::setw(24) << "throughput\n";
+    runType("Car", cars);
+    runType("Row", rows);
+    runType("ComplexRow", complex);
+
+    std::unordered_set<size_t> hand, reflected;
+    for (int32_t x = 0; x < 1000; ++x)
+        for (int32_t y = 0; y < 1000; ++y)
+        {
+            hand.insert(std::hash<int32_t>{}(x) ^ (std::hash<int32_t>{}(y) << 1));
+            reflected.insert(meta::hash<Point>{}(Point{x, y}));
+        }
+    std::cout << "\n1000x1000 points: x ^ (y << 1) gives " << hand.size() << " distinct hashes, meta::hash "
+              << reflected.size() << "\n";
+}
@@ -0,0 +1,114 @@
+// Bulk INSERT throughput through unixODBC into the SQLite ODBC driver
+// (libsqlite3odbc, registered as "SQLite3" in odbcinst.ini):
+//   row at a time  - insertSQL(obj) + SQLExecDirect per row, autocommit on
+//   VALUES lists   - BulkWriterT with arrayBinding = false
+//   array binding  - BulkWriterT, prepared once, SQL_ATTR_PARAMSET_SIZE rows per execute
+// Usage: bench_insert [rows] [database file]
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "meta.h"
+#include "meta_sql.h"
+#include "bench_common.meta"
+
+struct Connection
+{
+    SQLHANDLE env = SQL_NULL_HANDLE;
+    SQLHANDLE dbc = SQL_NULL_HANDLE;
+
+    explicit Connection(const std::string& path)
+    {
+        SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &env);
+        SQLSetEnvAttr(env, SQL_ATTR_ODBC_VERSION, reinterpret_cast<SQLPOINTER>(SQL_OV_ODBC3), 0);
+        SQLAllocHandle(SQL_HANDLE_DBC, env, &dbc);
+        std::string connect = "Driver=SQLite3;Database=" + path + ";";
+        CheckOdbc(SQLDriverConnect(dbc, nullptr, reinterpret_cast<SQLCHAR*>(connect.data()), SQL_NTS,
+                                   nullptr, 0, nullptr, SQL_DRIVER_NOPROMPT),
+                  SQL_HANDLE_DBC, dbc, "SQLDriverConnect");
+    }
+    ~Connection()
+    {
+        SQLDisconnect(dbc);
+        SQLFreeHandle(SQL_HANDLE_DBC, dbc);
+        SQLFreeHandle(SQL_HANDLE_ENV, env);
+    }
+
+    void exec(const std::string& sql)
+    {
+        StatementPtr stmt = AllocStatement(dbc);
+        CheckOdbc(ExecDirect(stmt.get(), sql.c_str()), SQL_HANDLE_STMT, stmt.get(), "SQLExecDirect");
+    }
+};
+
+// Times fn on a fresh table and prints one result row
+template <typename Fn> void runInsert(Connection& db, const char* name, size_t count, Fn&& fn)
+{
+    db.exec("DROP TABLE IF EXISTS Car");
+    db.exec(db::createTable<Car>());
+
+    auto start = std::chrono::steady_clock::now();
+    size_t inserted = fn();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (inserted != count)
+        throw std::runtime_error(std::string(name) + ": inserted " + std::to_string(inserted) + " rows");
+
+    std::cout << std::left << std::setw(20) << name << std::right << std::setw(10) << count
+              << std::setw(12) << std::fixed << std::setprecision(0) << count / elapsed.count()
+              << " rows/s\n";
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+    std::string path = argc > 2 ? argv[2] : "bench_insert.db";
+    std::remove(path.c_str());
+
+    std::vector<Car> cars;
+    std::vector<Row> rows;
+    std::vector<ComplexRow> complex;
+    makeBenchRows(count, cars, rows, complex);
+
+    Connection db(path);
+    std::cout << std::left << std::setw(20) << "method" << std::right << std::setw(10) << "records"
+              << std::setw(19) << "throughput\n";
+
+    // one transaction per row: a slice is enough to see the rate
+    size_t slow = count < 2000 ? count : 2000;
+    runInsert(db, "row at a time", slow,
+              [&]
+              {
+                  for (size_t i = 0; i < slow; ++i)
+                      db.exec(db::insertSQL(cars[i]));
+                  return slow;
+              });
+
+    for (size_t batch : {100, 1000})
+    {
+        std::string name = "VALUES lists " + std::to_string(batch);
+        runInsert(db, name.c_str(), count,
+                  [&] { return InsertRowsT<Car>(db.dbc, cars, {.batchRows = batch, .arrayBinding = false}); });
+    }
+    for (size_t batch : {100, 1000})
+    {
+        std::string name = "array binding " + std::to_string(batch);
+        bool arrays = true;
+        runInsert(db, name.c_str(), count,
+                  [&]
+                  {
+                      BulkWriterT<Car> out(db.dbc, {.batchRows = batch});
+                      for (const Car& car : cars)
+                          out.write(car);
+                      out.close();
+                      arrays = out.arrayBinding();
+                      return out.rows();
+                  });
+        if (!arrays)
+            std::cout << "  (the driver refused parameter arrays: VALUES lists were used)\n";
+    }
+}
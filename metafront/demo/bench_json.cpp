@@ -0,0 +1,53 @@
+// JSON writer throughput on the demo types:
+// serialize / serialize_compact (fresh string per call) vs serialize_to (reused buffer)
+// vs serialize_parallel (one thread per core)
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "meta.h"
+#include "meta_json.h"
+#include "bench_common.meta"
+
+template <typename T> void benchType(const char* type, const std::vector<T>& rows)
+{
+    run(type, "serialize", rows.size(), [&] { return meta::json::serialize(rows).size(); });
+    run(type,
+        "serialize_compact",
+        rows.size(),
+        [&] { return meta::json::serialize_compact(rows).size(); });
+
+    std::string buf;
+    run(type,
+        "serialize_to",
+        rows.size(),
+        [&]
+        {
+            buf.clear();
+            meta::json::serialize_to(buf, rows);
+            return buf.size();
+        });
+    run(type,
+        "serialize_parallel",
+        rows.size(),
+        [&] { return meta::json::serialize_parallel(rows, meta::Layout::Compact).size(); });
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+    std::vector<Car> cars;
+    std::vector<Row> rows;
+    std::vector<ComplexRow> complex;
+    makeBenchRows(count, cars, rows, complex);
+
+    std::cout << std::left << std::setw(12) << "type" << std::setw(20) << "writer" << std::right
+              << std::setw(10) << "records" << std::setw(12) << "bytes" << std::setw(15)
+              << "throughput\n";
+    benchType("Car", cars);
+    benchType("Row", rows);
+    benchType("ComplexRow", complex);
+}
@@ -0,0 +1,64 @@
+// JSON reader throughput on the demo types:
+// nlohmann parse + get<T>() vs meta::json::parse<T> vs meta::json::parse_each<T>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "bench_common.h"
+#include "meta.h"
+#include "meta_json.h"
+#include "bench_common.meta"
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Car, maker, model, year, electric, howmanymiles)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Row, field1, field2, field3, field4, field5, field6)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ComplexRow, idd, name, scores, tags, matrix, categories)
+
+template <typename T> void benchType(const char* type, const std::vector<T>& rows)
+{
+    const std::string json = meta::json::serialize_compact(rows);
+
+    run(type,
+        "nlohmann get<T>",
+        rows.size(),
+        [&]
+        {
+            auto parsed = nlohmann::json::parse(json).get<std::vector<T>>();
+            return parsed.size() == rows.size() ? json.size() : 0;
+        });
+    run(type,
+        "parse<T>",
+        rows.size(),
+        [&]
+        {
+            auto parsed = meta::json::parse<std::vector<T>>(json);
+            return parsed.size() == rows.size() ? json.size() : 0;
+        });
+    run(type,
+        "parse_each<T>",
+        rows.size(),
+        [&]
+        {
+            size_t n = meta::json::parse_each<T>(json, [](T&& row) { (void)row; });
+            return n == rows.size() ? json.size() : 0;
+        });
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+    std::vector<Car> cars;
+    std::vector<Row> rows;
+    std::vector<ComplexRow> complex;
+    makeBenchRows(count, cars, rows, complex);
+
+    std::cout << std::left << std::setw(12) << "type" << std::setw(20) << "reader" << std::right
+              << std::setw(10) << "records" << std::setw(12) << "bytes" << std::setw(15)
+              << "throughput\n";
+    benchType("Car", cars);
+    benchType("Row", rows);
+    benchType("ComplexRow", complex);
+}
@@ -0,0 +1,65 @@
+// meta::soa_vector against std::vector<T> on the demo types: a scan over one
+// field, and JSON / CSV serialization straight from the columns
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "meta.h"
+#include "meta_csv.h"
+#include "meta_json.h"
+#include "meta_soa.h"
+#include "bench_common.meta"
+
+volatile uint64_t g_sink;
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    std::vector<Car> cars;
+    std::vector<Row> rows;
+    std::vector<ComplexRow> complex;
+    makeBenchRows(count, cars, rows, complex);
+
+    meta::soa_vector<Car> soaCars;
+    soaCars.reserve(cars.size());
+    for (const Car& car : cars)
+        soaCars.push_back(car);
+
+    std::cout << std::left << std::setw(12) << "type" << std::setw(20) << "layout" << std::right
+              << std::setw(10) << "records" << std::setw(12) << "bytes" << std::setw(15)
+              << "throughput\n";
+
+    // bytes = the field values actually summed
+    const size_t fieldBytes = count * sizeof(unsigned int);
+    run("Car",
+        "vector scan",
+        count,
+        [&]
+        {
+            uint64_t sum = 0;
+            for (const Car& car : cars)
+                sum += car.howmanymiles;
+            g_sink = sum;
+            return fieldBytes;
+        });
+    run("Car",
+        "soa scan",
+        count,
+        [&]
+        {
+            uint64_t sum = 0;
+            for (unsigned int miles : soaCars.column<&Car::howmanymiles>())
+                sum += miles;
+            g_sink = sum;
+            return fieldBytes;
+        });
+
+    run("Car", "vector json", count, [&] { return meta::json::serialize_compact(cars).size(); });
+    run("Car", "soa json", count, [&] { return meta::json::serialize_compact(soaCars).size(); });
+    run("Car", "vector csv", count, [&] { return meta::csv::serialize(cars).size(); });
+    run("Car", "soa csv", count, [&] { return meta::csv::serialize(soaCars).size(); });
+}
@@ -0,0 +1,100 @@
+// Point lookups by primary key: meta::table against the hand-built
+// std::unordered_map index it replaces, on rows spread over more memory
+// than the caches. "independent" lookups overlap their cache misses;
+// "chained" ones pick the next key from the row found, so each waits for
+// the last and the time per lookup is its miss latency. Prints lookups per
+// second.
+// Usage: bench_table [rows]
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "meta.h"
+#include "meta_table.h"
+
+struct Account
+{
+    int64_t id;
+    std::string name;
+    std::string city;
+    double balance;
+};
+
+namespace meta
+{
+template <> struct MetaTuple<::Account>
+{
+    static constexpr auto fields =
+        std::make_tuple(meta::StaticField<&::Account::id, "id", "int64_t", meta::Prop::PrimaryKey>{},
+                        meta::StaticField<&::Account::name, "name", "std::string">{},
+                        meta::StaticField<&::Account::city, "city", "std::string", meta::Prop::Hashable>{},
+                        meta::StaticField<&::Account::balance, "balance", "double">{});
+};
+} // namespace meta
+
+volatile double g_sink;
+
+template <bool Chained, typename Fn> void runLookups(const char* name, const std::vector<int64_t>& keys, Fn&& find)
+{
+    auto start = std::chrono::steady_clock::now();
+    double sum = 0;
+    size_t next = 0;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        const Account* row = find(keys[Chained ? next : i]);
+        sum += row->balance;
+        if constexpr (Chained)
+            next = (next + 1 + static_cast<size_t>(row->balance) % 2) % keys.size();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    g_sink = sum;
+
+    std::cout << std::left << std::setw(24) << name << std::setw(14) << (Chained ? "chained" : "independent")
+              << std::right << std::setw(10) << keys.size() << std::setw(14) << std::fixed << std::setprecision(0)
+              << keys.size() / elapsed.count() << " lookups/s\n";
+}
+
+template <typename Fn> void runLookups(const char* name, const std::vector<int64_t>& keys, Fn&& find)
+{
+    runLookups<false>(name, keys, find);
+    runLookups<true>(name, keys, find);
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 4000000;
+    const char* cities[] = {"Oslo", "Bergen", "Rome", "Lima"};
+
+    // sparse keys, as database ids tend to be
+    std::vector<Account> rows;
+    rows.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        rows.push_back({static_cast<int64_t>(i * 7919 + 13), "account" + std::to_string(i), cities[i % 4],
+                        static_cast<double>(i)});
+
+    std::vector<int64_t> keys(count);
+    std::mt19937_64 rng(42);
+    for (int64_t& key : keys)
+        key = rows[rng() % count].id;
+
+    std::cout << std::left << std::setw(24) << "index" << std::setw(14) << "lookups" << std::right
+              << std::setw(10) << "count" << std::setw(24) << "throughput\n";
+
+    std::unordered_map<int64_t, Account> byValue;
+    std::unordered_map<int64_t, size_t> byRow;
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        byValue.emplace(rows[i].id, rows[i]);
+        byRow.emplace(rows[i].id, i);
+    }
+    runLookups("unordered_map<id, T>", keys, [&](int64_t key) { return &byValue.find(key)->second; });
+    runLookups("vector + map<id, row>", keys, [&](int64_t key) { return &rows[byRow.find(key)->second]; });
+
+    meta::table<Account> table(rows);
+    runLookups("meta::table", keys, [&](int64_t key) { return table.find(key); });
+}
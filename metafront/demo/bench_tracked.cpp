@@ -0,0 +1,103 @@
+// Write-back of records where one field was set through meta::tracked:
+// the whole-row UPDATE (db::updateSQL(obj)) against the dirty-field UPDATE
+// (db::updateSQL(obj, dirty())), and the whole record as JSON against the
+// dirty-field JSON patch. Prints the bytes each write-back sends. The
+// records carry a Prop::PrimaryKey field, which the dirty UPDATE requires.
+// Usage: bench_tracked [rows]
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "meta.h"
+#include "meta_db.h"
+#include "meta_diff.h"
+#include "meta_json.h"
+#include "meta_tracked.h"
+
+struct Account
+{
+    int64_t id;
+    std::string name;
+    std::string city;
+    double balance;
+    unsigned int logins;
+};
+
+namespace meta
+{
+template <> struct MetaTuple<::Account>
+{
+    static constexpr auto fields =
+        std::make_tuple(meta::StaticField<&::Account::id, "id", "int64_t", meta::Prop::PrimaryKey>{},
+                        meta::StaticField<&::Account::name, "name", "std::string">{},
+                        meta::StaticField<&::Account::city, "city", "std::string">{},
+                        meta::StaticField<&::Account::balance, "balance", "double">{},
+                        meta::StaticField<&::Account::logins, "logins", "unsigned int">{});
+    static constexpr auto tableName = "Account";
+    static constexpr auto query = "SELECT id, name, city, balance, logins FROM Account";
+};
+} // namespace meta
+
+template <typename T, typename Touch> void runType(const char* type, const std::vector<T>& rows, Touch&& touch)
+{
+    const size_t count = rows.size();
+    std::vector<meta::tracked<T>> records;
+    records.reserve(count);
+    for (const T& row : rows)
+    {
+        records.emplace_back(row);
+        touch(records.back());
+    }
+
+    run(type, "sql full", count,
+        [&]
+        {
+            size_t bytes = 0;
+            for (const auto& record : records)
+                bytes += db::updateSQL(record.value()).size();
+            return bytes;
+        });
+    run(type, "sql dirty", count,
+        [&]
+        {
+            size_t bytes = 0;
+            for (const auto& record : records)
+                bytes += db::updateSQL(record.value(), record.dirty()).size();
+            return bytes;
+        });
+    run(type, "json full", count,
+        [&]
+        {
+            size_t bytes = 0;
+            for (const auto& record : records)
+                bytes += meta::json::format_json_value(record.value()).size();
+            return bytes;
+        });
+    run(type, "json dirty", count,
+        [&]
+        {
+            size_t bytes = 0;
+            for (const auto& record : records)
+                bytes += meta::json::serialize_patch(record.changes()).size();
+            return bytes;
+        });
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 200000;
+
+    std::vector<Account> accounts;
+    accounts.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        accounts.push_back({static_cast<int64_t>(i), "account" + std::to_string(i), "springfield",
+                            100.0 + static_cast<double>(i % 1000), static_cast<unsigned int>(i % 50)});
+
+    std::cout << std::left << std::setw(12) << "type" << std::setw(20) << "method" << std::right
+              << std::setw(10) << "records" << std::setw(12) << "bytes" << std::setw(15)
+              << "throughput\n";
+
+    runType("Account", accounts, [](meta::tracked<Account>& a) { a.set<&Account::logins>(a->logins + 1); });
+}
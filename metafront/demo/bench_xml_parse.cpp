@@ -0,0 +1,77 @@
+// XML round trip on the demo types: meta::xml::serialize (and
+// serialize_compact) against reading the output back with
+// meta::xml::parse<T> and a meta::xml::reader<T> that refills one record,
+// and both in a row. Throughput is over the bytes of the document.
+// Usage: bench_xml_parse [rows]
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "meta.h"
+#include "meta_xml.h"
+#include "bench_common.meta"
+
+template <typename T> void benchType(const char* type, const std::vector<T>& rows)
+{
+    const std::string pretty = meta::xml::serialize(rows);
+    const std::string compact = meta::xml::serialize_compact(rows);
+
+    run(type, "serialize", rows.size(), [&] { return meta::xml::serialize(rows).size(); });
+    run(type,
+        "parse<T>",
+        rows.size(),
+        [&]
+        {
+            auto parsed = meta::xml::parse<T>(pretty);
+            return parsed.size() == rows.size() ? pretty.size() : 0;
+        });
+    run(type,
+        "reader<T>::next",
+        rows.size(),
+        [&]
+        {
+            meta::xml::reader<T> in(pretty);
+            T row{};
+            size_t n = 0;
+            while (in.next(row))
+                ++n;
+            return n == rows.size() ? pretty.size() : 0;
+        });
+    run(type,
+        "round trip",
+        rows.size(),
+        [&]
+        {
+            std::string xml = meta::xml::serialize(rows);
+            auto parsed = meta::xml::parse<T>(xml);
+            return parsed.size() == rows.size() ? xml.size() : 0;
+        });
+    run(type, "serialize compact", rows.size(), [&] { return meta::xml::serialize_compact(rows).size(); });
+    run(type,
+        "parse<T> compact",
+        rows.size(),
+        [&]
+        {
+            auto parsed = meta::xml::parse<T>(compact);
+            return parsed.size() == rows.size() ? compact.size() : 0;
+        });
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 10000;
+
+    std::vector<Car> cars;
+    std::vector<Row> rows;
+    std::vector<ComplexRow> complex;
+    makeBenchRows(count, cars, rows, complex);
+
+    std::cout << std::left << std::setw(12) << "type" << std::setw(20) << "method" << std::right
+              << std::setw(10) << "records" << std::setw(12) << "bytes" << std::setw(15)
+              << "throughput\n";
+    benchType("Car", cars);
+    benchType("Row", rows);
+    benchType("ComplexRow", complex);
+}
@@ -0,0 +1,61 @@
+// YAML reader throughput on the demo types: meta::yaml::parse<T> and
+// meta::yaml::parse_each<T> over serialize() (block) and
+// serialize_compact() (flow) output
+// Usage: bench_yaml_parse [rows]
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "meta.h"
+#include "meta_yaml.h"
+#include "bench_common.meta"
+
+template <typename T> void benchType(const char* type, const std::vector<T>& rows)
+{
+    const std::string block = meta::yaml::serialize(rows);
+    const std::string flow = meta::yaml::serialize_compact(rows);
+
+    run(type,
+        "parse<T> block",
+        rows.size(),
+        [&]
+        {
+            auto parsed = meta::yaml::parse<std::vector<T>>(block);
+            return parsed.size() == rows.size() ? block.size() : 0;
+        });
+    run(type,
+        "parse_each<T> block",
+        rows.size(),
+        [&]
+        {
+            size_t n = meta::yaml::parse_each<T>(block, [](T&& row) { (void)row; });
+            return n == rows.size() ? block.size() : 0;
+        });
+    run(type,
+        "parse<T> flow",
+        rows.size(),
+        [&]
+        {
+            auto parsed = meta::yaml::parse<std::vector<T>>(flow);
+            return parsed.size() == rows.size() ? flow.size() : 0;
+        });
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+    std::vector<Car> cars;
+    std::vector<Row> rows;
+    std::vector<ComplexRow> complex;
+    makeBenchRows(count, cars, rows, complex);
+
+    std::cout << std::left << std::setw(12) << "type" << std::setw(20) << "reader" << std::right
+              << std::setw(10) << "records" << std::setw(12) << "bytes" << std::setw(15)
+              << "throughput\n";
+    benchType("Car", cars);
+    benchType("Row", rows);
+    benchType("ComplexRow", complex);
+}
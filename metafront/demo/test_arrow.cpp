@@ -0,0 +1,237 @@
+// Arrow IPC round trips in the stream and file formats (several record
+// batches, nulls, lists, timestamps, no rows at all), and a read of
+// test_arrow.arrow, a file written by pyarrow 26 with:
+//
+//   table = pa.table({
+//       "id": pa.array([1, -2, 3], pa.int64()),
+//       "symbol": pa.array(["ACME", "", "Zürich"], pa.string()),
+//       "price": pa.array([1.5, -0.25, 1e300], pa.float64()),
+//       "buy": pa.array([True, False, True]),
+//       "qty": pa.array([100, None, -7], pa.int32()),
+//       "note": pa.array([None, "late fill", ""], pa.large_string()),
+//       "fills": pa.array([[1, 2, 3], [], [-4]], pa.list_(pa.int32())),
+//       "at": pa.array([datetime(2024, 1, 2, 3, 4, 5, 123456, tzinfo=utc),
+//                       datetime(1970, 1, 1, tzinfo=utc),
+//                       datetime(1969, 12, 31, 23, 59, 59, tzinfo=utc)],
+//                      pa.timestamp("us", "UTC")),
+//       "unused": pa.array([0.5, 1.5, 2.5], pa.float32()),
+//   })
+//   with pa.ipc.new_file("test_arrow.arrow", table.schema) as out:
+//       out.write_table(table, max_chunksize=2)
+//
+// Exits non-zero on failure.
+// Usage: test_arrow [test_arrow.arrow]
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "meta.h"
+#include "meta_arrow.h"
+#include "meta_soa.h"
+
+using Clock = std::chrono::system_clock;
+
+struct Trade
+{
+    int64_t id;
+    std::string symbol;
+    double price;
+    bool buy;
+    std::optional<int32_t> qty;
+    std::optional<std::string> note;
+    std::vector<int32_t> fills;
+    Clock::time_point at;
+};
+
+// Narrow reads some of the file's columns; Missing names a column the file
+// lacks and WrongType reads the int64 id column as int32
+struct Narrow
+{
+    int64_t id;
+    std::optional<std::string> note;
+};
+
+struct Missing
+{
+    int64_t id;
+    std::string venue;
+};
+
+struct WrongType
+{
+    int32_t id;
+};
+
+#include "test_arrow.meta"
+
+static int failures = 0;
+
+static void check(const std::string& what, bool ok)
+{
+    if (!ok)
+    {
+        ++failures;
+        std::cout << "FAIL " << what << "\n";
+    }
+}
+
+static bool same(const Trade& a, const Trade& b)
+{
+    return a.id == b.id && a.symbol == b.symbol && a.price == b.price && a.buy == b.buy &&
+           a.qty == b.qty && a.note == b.note && a.fills == b.fills && a.at == b.at;
+}
+
+static bool same(const std::vector<Trade>& a, const std::vector<Trade>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (!same(a[i], b[i]))
+            return false;
+    return true;
+}
+
+static Clock::time_point at(int64_t micros)
+{
+    auto since = std::chrono::duration_cast<Clock::duration>(std::chrono::microseconds(micros));
+    return Clock::time_point(since);
+}
+
+// parse<T>(bytes) must throw meta::arrow::parse_error
+template <typename T> static void expectError(const std::string& what, std::string_view bytes)
+{
+    try
+    {
+        (void)meta::arrow::parse<T>(bytes);
+        ++failures;
+        std::cout << "FAIL " << what << ": no error\n";
+    }
+    catch (const meta::arrow::parse_error&)
+    {
+    }
+    catch (const std::exception& e)
+    {
+        ++failures;
+        std::cout << "FAIL " << what << ": wrong exception " << e.what() << "\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<Trade> trades;
+    for (int i = 0; i < 7; ++i)
+    {
+        Trade t{i - 3,
+                std::string(static_cast<size_t>(i), static_cast<char>('a' + i)),
+                i * 0.5 - 1,
+                i % 2 == 0,
+                std::nullopt,
+                std::nullopt,
+                {},
+                at(int64_t{-1000000} + i * 1234567)};
+        if (i % 3 != 1)
+            t.qty = i * 100;
+        if (i % 2)
+            t.note = i == 3 ? "" : "note " + std::to_string(i);
+        for (int j = 0; j < i % 4; ++j)
+            t.fills.push_back(j - i);
+        trades.push_back(std::move(t));
+    }
+
+    // stream and file, one batch and several, from rows and from columns
+    meta::soa_vector<Trade> columns;
+    for (const Trade& t : trades)
+        columns.push_back(t);
+    for (auto format : {meta::arrow::Format::Stream, meta::arrow::Format::File})
+    {
+        const std::string name = format == meta::arrow::Format::File ? "file" : "stream";
+        for (size_t batchRows : {size_t{0}, size_t{1}, size_t{3}})
+        {
+            const std::string what = name + " batch_rows " + std::to_string(batchRows);
+            const std::string bytes = meta::arrow::serialize(trades, format, batchRows);
+            check(what + ": soa bytes match",
+                  meta::arrow::serialize(columns, format, batchRows) == bytes);
+            try
+            {
+                check(what + " round trip", same(trades, meta::arrow::parse<Trade>(bytes)));
+            }
+            catch (const std::exception& e)
+            {
+                check(what + " round trip: " + e.what(), false);
+            }
+        }
+
+        // no rows: schema only, still readable
+        const std::string empty = meta::arrow::serialize(std::vector<Trade>{}, format);
+        try
+        {
+            check(name + " with no rows", meta::arrow::parse<Trade>(empty).empty());
+        }
+        catch (const std::exception& e)
+        {
+            check(name + " with no rows: " + e.what(), false);
+        }
+
+        // optionals that are all set (no validity bitmap) and all null
+        std::vector<Trade> dense(3, trades[0]), sparse(3, trades[1]);
+        for (auto& t : dense)
+            t.note = "x";
+        for (auto& t : sparse)
+            t.qty.reset(), t.note.reset();
+        check(name + " without nulls",
+              same(dense, meta::arrow::parse<Trade>(meta::arrow::serialize(dense, format))));
+        check(name + " all null",
+              same(sparse, meta::arrow::parse<Trade>(meta::arrow::serialize(sparse, format))));
+    }
+
+    // parse appends, as documented
+    {
+        const std::string bytes = meta::arrow::serialize(trades);
+        std::vector<Trade> twice;
+        meta::arrow::parse(bytes, twice);
+        meta::arrow::parse(bytes, twice);
+        check("parse appends",
+              twice.size() == 2 * trades.size() && same(twice[trades.size()], trades[0]));
+    }
+
+    // written by pyarrow: two record batches, LargeUtf8, microsecond timestamps
+    const std::string path = argc > 1 ? argv[1] : "test_arrow.arrow";
+    std::ifstream in(path, std::ios::binary);
+    const std::string file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (file.empty())
+    {
+        std::cout << "FAIL cannot read " << path << "\n";
+        return 1;
+    }
+    try
+    {
+        const std::vector<Trade> expected = {
+            {1, "ACME", 1.5, true, 100, std::nullopt, {1, 2, 3}, at(1704164645123456)},
+            {-2, "", -0.25, false, std::nullopt, "late fill", {}, at(0)},
+            {3, "Z\xc3\xbcrich", 1e300, true, -7, "", {-4}, at(-1000000)},
+        };
+        check("pyarrow file", same(expected, meta::arrow::parse<Trade>(file)));
+
+        auto narrow = meta::arrow::parse<Narrow>(file);
+        check("columns the struct lacks are skipped",
+              narrow.size() == 3 && narrow[0].id == 1 && !narrow[0].note &&
+                  narrow[1].note == "late fill");
+    }
+    catch (const std::exception& e)
+    {
+        check(std::string("pyarrow file: ") + e.what(), false);
+    }
+    expectError<Missing>("member with no column", file);
+    expectError<WrongType>("int32 member for an int64 column", file);
+    expectError<Trade>("truncated file", std::string_view(file).substr(0, file.size() - 1));
+    const std::string stream = meta::arrow::serialize(trades);
+    expectError<Trade>("truncated stream", std::string_view(stream).substr(0, 100));
+
+    std::cout << (failures ? "test_arrow: FAILED\n" : "test_arrow: ok\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,334 @@
+// meta::binary round trips of owning structs and of view structs that
+// decode std::string_view and array_view<T> members in place, plus the
+// errors parse() must raise: wrong magic, a schema hash from a different
+// layout, truncation at every offset, trailing bytes, and corrupt counts,
+// bools and optional flags. Exits non-zero on failure.
+// Usage: test_binary
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "meta.h"
+#include "meta_binary.h"
+
+enum class Color : uint8_t
+{
+    Red,
+    Green,
+    Blue
+};
+
+struct Point
+{
+    int32_t x;
+    int32_t y;
+};
+
+struct Row
+{
+    int32_t id;
+    std::string name;
+    double score;
+    bool active;
+    Color color;
+    std::optional<int64_t> extra;
+    std::vector<double> values;
+    std::vector<Point> points;
+    std::vector<std::string> tags;
+};
+
+// Same field names and shapes as Row, decoding strings and numbers in place
+struct RowView
+{
+    int32_t id;
+    std::string_view name;
+    double score;
+    bool active;
+    Color color;
+    std::optional<int64_t> extra;
+    meta::binary::array_view<double> values;
+    std::vector<Point> points;
+    std::vector<std::string_view> tags;
+};
+
+// Row with one field renamed, and with one field widened
+struct Renamed
+{
+    int32_t ident;
+    std::string name;
+    double score;
+    bool active;
+    Color color;
+    std::optional<int64_t> extra;
+    std::vector<double> values;
+    std::vector<Point> points;
+    std::vector<std::string> tags;
+};
+
+struct Widened
+{
+    int64_t id;
+    std::string name;
+    double score;
+    bool active;
+    Color color;
+    std::optional<int64_t> extra;
+    std::vector<double> values;
+    std::vector<Point> points;
+    std::vector<std::string> tags;
+};
+
+#define ROW_FIELDS(T, IdType)                                                                      \
+    std::make_tuple(meta::StaticField<&::T::id, "id", IdType>{},                                   \
+                    meta::StaticField<&::T::name, "name", "std::string">{},                        \
+                    meta::StaticField<&::T::score, "score", "double">{},                           \
+                    meta::StaticField<&::T::active, "active", "bool">{},                           \
+                    meta::StaticField<&::T::color, "color", "Color">{},                            \
+                    meta::StaticField<&::T::extra, "extra", "std::optional<int64_t>">{},           \
+                    meta::StaticField<&::T::values, "values", "std::vector<double>">{},            \
+                    meta::StaticField<&::T::points, "points", "std::vector<Point>">{},             \
+                    meta::StaticField<&::T::tags, "tags", "std::vector<std::string>">{})
+
+namespace meta
+{
+template <> struct MetaTuple<::Point>
+{
+    static constexpr auto fields = std::make_tuple(
+        meta::StaticField<&::Point::x, "x", "int32_t">{},
+        meta::StaticField<&::Point::y, "y", "int32_t">{});
+    static constexpr auto tableName = "Point";
+    static constexpr auto query = "SELECT x, y FROM Point";
+};
+
+template <> struct MetaTuple<::Row>
+{
+    static constexpr auto fields = ROW_FIELDS(Row, "int32_t");
+    static constexpr auto tableName = "Row";
+    static constexpr auto query =
+        "SELECT id, name, score, active, color, extra, values, points, tags FROM Row";
+};
+
+template <> struct MetaTuple<::RowView>
+{
+    static constexpr auto fields = ROW_FIELDS(RowView, "int32_t");
+    static constexpr auto tableName = "RowView";
+    static constexpr auto query =
+        "SELECT id, name, score, active, color, extra, values, points, tags FROM RowView";
+};
+
+template <> struct MetaTuple<::Renamed>
+{
+    static constexpr auto fields = std::make_tuple(
+        meta::StaticField<&::Renamed::ident, "ident", "int32_t">{},
+        meta::StaticField<&::Renamed::name, "name", "std::string">{},
+        meta::StaticField<&::Renamed::score, "score", "double">{},
+        meta::StaticField<&::Renamed::active, "active", "bool">{},
+        meta::StaticField<&::Renamed::color, "color", "Color">{},
+        meta::StaticField<&::Renamed::extra, "extra", "std::optional<int64_t>">{},
+        meta::StaticField<&::Renamed::values, "values", "std::vector<double>">{},
+        meta::StaticField<&::Renamed::points, "points", "std::vector<Point>">{},
+        meta::StaticField<&::Renamed::tags, "tags", "std::vector<std::string>">{});
+    static constexpr auto tableName = "Renamed";
+    static constexpr auto query =
+        "SELECT ident, name, score, active, color, extra, values, points, tags FROM Renamed";
+};
+
+template <> struct MetaTuple<::Widened>
+{
+    static constexpr auto fields = ROW_FIELDS(Widened, "int64_t");
+    static constexpr auto tableName = "Widened";
+    static constexpr auto query =
+        "SELECT id, name, score, active, color, extra, values, points, tags FROM Widened";
+};
+} // namespace meta
+
+static int failures = 0;
+
+static void check(const std::string& what, bool ok)
+{
+    if (!ok)
+    {
+        ++failures;
+        std::cout << "FAIL " << what << "\n";
+    }
+}
+
+// parse<T>(bytes) must throw meta::binary::parse_error
+template <typename T> static void expectError(const std::string& what, std::string_view bytes)
+{
+    try
+    {
+        (void)meta::binary::parse<T>(bytes);
+        ++failures;
+        std::cout << "FAIL " << what << ": no error\n";
+    }
+    catch (const meta::binary::parse_error&)
+    {
+    }
+    catch (const std::exception& e)
+    {
+        ++failures;
+        std::cout << "FAIL " << what << ": wrong exception " << e.what() << "\n";
+    }
+}
+
+static bool inside(const void* p, std::string_view buffer)
+{
+    auto* c = static_cast<const char*>(p);
+    return c >= buffer.data() && c < buffer.data() + buffer.size();
+}
+
+static bool same(const Row& a, const Row& b)
+{
+    bool points = a.points.size() == b.points.size();
+    for (size_t i = 0; points && i < a.points.size(); ++i)
+        points = a.points[i].x == b.points[i].x && a.points[i].y == b.points[i].y;
+    return points && a.id == b.id && a.name == b.name && a.score == b.score &&
+           a.active == b.active && a.color == b.color && a.extra == b.extra &&
+           a.values == b.values && a.tags == b.tags;
+}
+
+int main()
+{
+    std::vector<Row> rows = {
+        {1, "ann", 1.5, true, Color::Green, 1ll << 40, {0.25, -1e300}, {{1, 2}, {-3, 4}},
+         {"a", "bc"}},
+        {-2, "", 0.0, false, Color::Blue, std::nullopt, {}, {}, {}},
+        {3, std::string("nul\0in", 6), -0.0, true, Color::Red, -1, {42.0},
+         {{INT32_MIN, INT32_MAX}}, {""}},
+    };
+
+    // header and fixed-width little-endian layout
+    const std::string point = meta::binary::serialize(Point{1, -2});
+    check("Point size", point.size() == meta::binary::header_size + 8);
+    check("magic", point.compare(0, 4, "MTB1") == 0);
+    check("Point body", point.substr(meta::binary::header_size) ==
+                            std::string("\x01\x00\x00\x00\xfe\xff\xff\xff", 8));
+    check("schema hash is a constant expression", [] {
+        constexpr uint64_t hash = meta::binary::schema_hash<Row>();
+        return hash != 0;
+    }());
+
+    // owning round trip
+    const std::string bytes = meta::binary::serialize(rows);
+    check("byte_size matches", bytes.size() == meta::binary::byte_size(rows));
+    try
+    {
+        auto back = meta::binary::parse<std::vector<Row>>(bytes);
+        bool ok = back.size() == rows.size();
+        for (size_t i = 0; ok && i < rows.size(); ++i)
+            ok = same(rows[i], back[i]);
+        check("Row round trip", ok);
+    }
+    catch (const std::exception& e)
+    {
+        check(std::string("Row round trip: ") + e.what(), false);
+    }
+
+    // zero-copy: the view struct reads Row data, pointing into the buffer
+    check("view hashes like the owning struct",
+          meta::binary::schema_hash<std::vector<RowView>>() ==
+              meta::binary::schema_hash<std::vector<Row>>());
+    try
+    {
+        auto views = meta::binary::parse<std::vector<RowView>>(bytes);
+        bool ok = views.size() == rows.size();
+        for (size_t i = 0; ok && i < rows.size(); ++i)
+        {
+            const RowView& v = views[i];
+            ok = v.id == rows[i].id && v.name == rows[i].name && v.extra == rows[i].extra &&
+                 v.values.to_vector() == rows[i].values && v.tags.size() == rows[i].tags.size();
+            for (size_t t = 0; ok && t < v.tags.size(); ++t)
+                ok = v.tags[t] == rows[i].tags[t];
+        }
+        check("view values", ok);
+        check("string_view points into the input", inside(views[0].name.data(), bytes));
+        check("array_view points into the input", inside(views[0].values.bytes().data(), bytes));
+        check("string_view elements point into the input", inside(views[0].tags[1].data(), bytes));
+        check("array_view iterates",
+              views[0].values.size() == 2 && views[0].values[1] == -1e300 &&
+                  *(views[0].values.begin() + 1) == -1e300);
+        check("embedded NUL kept", views[2].name.size() == 6);
+    }
+    catch (const std::exception& e)
+    {
+        check(std::string("view parse: ") + e.what(), false);
+    }
+
+    // a different layout is rejected by the schema hash, not misread
+    expectError<std::vector<Renamed>>("renamed field", bytes);
+    expectError<std::vector<Widened>>("widened field", bytes);
+    expectError<Row>("vector read as a single row", bytes);
+    try
+    {
+        (void)meta::binary::parse<std::vector<Renamed>>(bytes);
+    }
+    catch (const meta::binary::parse_error& e)
+    {
+        check("hash mismatch reported after the magic",
+              e.offset() == 4 && std::string(e.what()).find("schema hash") != std::string::npos);
+    }
+
+    std::string badMagic = bytes;
+    badMagic[3] = '2';
+    expectError<std::vector<Row>>("wrong magic", badMagic);
+
+    // every truncation throws, none reads past the end
+    for (size_t n = 0; n < bytes.size(); ++n)
+    {
+        const std::string what = "truncated to " + std::to_string(n) + " bytes";
+        expectError<std::vector<Row>>(what, bytes.substr(0, n));
+        expectError<std::vector<RowView>>("view " + what, bytes.substr(0, n));
+    }
+    expectError<std::vector<Row>>("trailing bytes", bytes + '\0');
+
+    // corrupt counts and flags inside the body
+    {
+        std::string one = meta::binary::serialize(rows[0]);
+        const size_t body = meta::binary::header_size;
+        // id(4) name(4+3) score(8) active(1) color(1) extra(1+8) values count
+        const size_t active = body + 4 + 4 + 3 + 8;
+        const size_t extraFlag = active + 2;
+        const size_t valuesCount = extraFlag + 1 + 8;
+
+        std::string corrupt = one;
+        corrupt[active] = 2;
+        expectError<Row>("bool byte 2", corrupt);
+
+        corrupt = one;
+        corrupt[extraFlag] = 7;
+        expectError<Row>("optional flag 7", corrupt);
+
+        corrupt = one;
+        std::memcpy(corrupt.data() + valuesCount, "\xff\xff\xff\x7f", 4);
+        expectError<Row>("vector count past the end", corrupt);
+        expectError<RowView>("array_view count past the end", corrupt);
+
+        corrupt = one;
+        std::memcpy(corrupt.data() + body + 4, "\xff\xff\xff\xff", 4);
+        expectError<Row>("string length past the end", corrupt);
+        expectError<RowView>("string_view length past the end", corrupt);
+    }
+
+    // serialize_to into a short buffer throws instead of overrunning
+    {
+        std::string small(meta::binary::byte_size(rows) - 1, '\0');
+        bool threw = false;
+        try
+        {
+            meta::binary::serialize_to(rows, std::span<char>(small.data(), small.size()));
+        }
+        catch (const std::length_error&)
+        {
+            threw = true;
+        }
+        check("serialize_to into a short buffer throws", threw);
+    }
+
+    std::cout << (failures ? "test_binary: FAILED\n" : "test_binary: ok\n");
+    return failures ? 1 : 0;
+}
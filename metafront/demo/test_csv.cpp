@@ -0,0 +1,98 @@
+// CSV round trip of serialize() output through parse<T>: chars that are CSV
+// syntax (',', '"', line ends), doubles and floats that need every
+// significant digit, and a ';' delimiter; plus rejecting a record with more
+// fields than the header. Exits non-zero on failure.
+// Usage: test_csv
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "meta.h"
+#include "meta_csv.h"
+
+struct Sample
+{
+    char mark;
+    double value;
+    float ratio;
+    std::string label;
+};
+
+#include "test_csv.meta"
+
+int main()
+{
+    std::vector<Sample> samples;
+    const double doubles[] = {0.1, 1.0 / 3.0, 123456789.123, 6.02214076e23, -2.5e-300,
+                              std::numeric_limits<double>::max(), 0.0};
+    const char marks[] = {',', '"', '\n', '\r', 'x', ' ', '\0'};
+    for (size_t i = 0; i < std::size(doubles); ++i)
+        samples.push_back({marks[i], doubles[i], static_cast<float>(doubles[i] / 7), "row" + std::to_string(i)});
+
+    const std::string csv = meta::csv::serialize(samples);
+    int failures = 0;
+    std::vector<Sample> parsed;
+    try
+    {
+        parsed = meta::csv::parse<Sample>(csv);
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << "FAIL parse: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (parsed.size() != samples.size())
+    {
+        std::cout << "FAIL " << parsed.size() << " rows read, " << samples.size() << " written\n";
+        return 1;
+    }
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        const Sample& a = samples[i];
+        const Sample& b = parsed[i];
+        if (a.mark != b.mark || a.value != b.value || a.ratio != b.ratio || a.label != b.label)
+        {
+            ++failures;
+            std::cout << "FAIL row " << i << "\n";
+        }
+    }
+
+    // another delimiter: values holding it are quoted, and read back whole
+    std::vector<Sample> semi = {{';', 1.5, 2.5f, "a;b"}, {'x', 0.25, 0.5f, "plain"}};
+    try
+    {
+        auto back = meta::csv::parse<Sample>(meta::csv::serialize(semi, ";"), {.delimiter = ';'});
+        if (back.size() != 2 || back[0].mark != ';' || back[0].label != "a;b" || back[1].label != "plain")
+        {
+            ++failures;
+            std::cout << "FAIL ';' delimiter round trip\n";
+        }
+    }
+    catch (const std::exception& e)
+    {
+        ++failures;
+        std::cout << "FAIL ';' delimiter round trip: " << e.what() << "\n";
+    }
+
+    // a record with more fields than the header is rejected, not truncated
+    bool threw = false;
+    try
+    {
+        meta::csv::parse<Sample>("mark,value,ratio,label\nx,1,2,a,extra\n");
+    }
+    catch (const meta::csv::parse_error&)
+    {
+        threw = true;
+    }
+    if (!threw)
+    {
+        ++failures;
+        std::cout << "FAIL extra field accepted\n";
+    }
+
+    std::cout << (failures ? "test_csv: FAILED\n" : "test_csv: ok\n");
+    return failures ? 1 : 0;
+}
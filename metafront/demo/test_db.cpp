@@ -0,0 +1,84 @@
+// db::updateSQL(obj, dirty) on keyed and unkeyed records: the UPDATE is
+// keyed by the Prop::PrimaryKey field, and a record without one throws
+// instead of producing an UPDATE with no WHERE. Exits non-zero on failure.
+// Usage: test_db
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "meta.h"
+#include "meta_db.h"
+#include "meta_tracked.h"
+
+struct Account
+{
+    int64_t id;
+    std::string name;
+    double balance;
+};
+
+struct Unkeyed
+{
+    std::string name;
+    double balance;
+};
+
+namespace meta
+{
+template <> struct MetaTuple<::Account>
+{
+    static constexpr auto fields =
+        std::make_tuple(meta::StaticField<&::Account::id, "id", "int64_t", meta::Prop::PrimaryKey>{},
+                        meta::StaticField<&::Account::name, "name", "std::string">{},
+                        meta::StaticField<&::Account::balance, "balance", "double">{});
+    static constexpr auto tableName = "Account";
+    static constexpr auto query = "SELECT id, name, balance FROM Account";
+};
+
+template <> struct MetaTuple<::Unkeyed>
+{
+    static constexpr auto fields =
+        std::make_tuple(meta::StaticField<&::Unkeyed::name, "name", "std::string">{},
+                        meta::StaticField<&::Unkeyed::balance, "balance", "double">{});
+    static constexpr auto tableName = "Unkeyed";
+    static constexpr auto query = "SELECT name, balance FROM Unkeyed";
+};
+} // namespace meta
+
+static int failures = 0;
+
+static void check(const char* what, bool ok)
+{
+    if (!ok)
+    {
+        ++failures;
+        std::cout << "FAIL " << what << "\n";
+    }
+}
+
+int main()
+{
+    meta::tracked<Account> account(Account{42, "ann", 10});
+    account.set<&Account::name>("bob");
+    std::string sql = db::updateSQL(account.value(), account.dirty());
+    check("keyed UPDATE sets the dirty column", sql.find("SET name = 'bob'") != std::string::npos);
+    check("keyed UPDATE has a WHERE", sql.find(" WHERE id = 42") != std::string::npos);
+    check("nothing dirty, nothing to send", db::updateSQL(Account{42, "ann", 10}, 0).empty());
+
+    meta::tracked<Unkeyed> unkeyed(Unkeyed{"ann", 10});
+    unkeyed.set<&Unkeyed::balance>(20);
+    bool threw = false;
+    try
+    {
+        (void)db::updateSQL(unkeyed.value(), unkeyed.dirty());
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    check("unkeyed UPDATE throws", threw);
+
+    std::cout << (failures ? "test_db: FAILED\n" : "test_db: ok\n");
+    return failures ? 1 : 0;
+}
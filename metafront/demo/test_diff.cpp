@@ -0,0 +1,306 @@
+// meta::diff / apply_patch on scalars, optionals, nested structs and
+// vectors that grow, shrink and empty, checked directly and through the
+// binary and JSON patch encodings; plus the patches both decoders and
+// apply_patch must reject: mask bits past the last field, vector indexes
+// past the length, more changes than elements, a different schema, and
+// truncated or trailing input. Exits non-zero on failure.
+// Usage: test_diff
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "meta.h"
+#include "meta_diff.h"
+
+struct Inner
+{
+    int32_t x;
+    std::string label;
+};
+
+struct Doc
+{
+    int64_t id;
+    std::string name;
+    double score;
+    std::optional<int32_t> rank;
+    Inner inner;
+    std::vector<int32_t> nums;
+    std::vector<Inner> items;
+    std::vector<std::string> tags;
+    bool flag;
+};
+
+// A different struct, so a different schema hash
+struct OtherDoc
+{
+    int64_t key;
+};
+
+namespace meta
+{
+template <> struct MetaTuple<::Inner>
+{
+    static constexpr auto fields = std::make_tuple(
+        meta::StaticField<&::Inner::x, "x", "int32_t">{},
+        meta::StaticField<&::Inner::label, "label", "std::string">{});
+    static constexpr auto tableName = "Inner";
+    static constexpr auto query = "SELECT x, label FROM Inner";
+};
+
+template <> struct MetaTuple<::Doc>
+{
+    static constexpr auto fields = std::make_tuple(
+        meta::StaticField<&::Doc::id, "id", "int64_t">{},
+        meta::StaticField<&::Doc::name, "name", "std::string">{},
+        meta::StaticField<&::Doc::score, "score", "double">{},
+        meta::StaticField<&::Doc::rank, "rank", "std::optional<int32_t>">{},
+        meta::StaticField<&::Doc::inner, "inner", "Inner">{},
+        meta::StaticField<&::Doc::nums, "nums", "std::vector<int32_t>">{},
+        meta::StaticField<&::Doc::items, "items", "std::vector<Inner>">{},
+        meta::StaticField<&::Doc::tags, "tags", "std::vector<std::string>">{},
+        meta::StaticField<&::Doc::flag, "flag", "bool">{});
+    static constexpr auto tableName = "Doc";
+    static constexpr auto query =
+        "SELECT id, name, score, rank, inner, nums, items, tags, flag FROM Doc";
+};
+
+template <> struct MetaTuple<::OtherDoc>
+{
+    static constexpr auto fields =
+        std::make_tuple(meta::StaticField<&::OtherDoc::key, "key", "int64_t">{});
+    static constexpr auto tableName = "OtherDoc";
+    static constexpr auto query = "SELECT key FROM OtherDoc";
+};
+} // namespace meta
+
+static int failures = 0;
+
+static void check(const std::string& what, bool ok)
+{
+    if (!ok)
+    {
+        ++failures;
+        std::cout << "FAIL " << what << "\n";
+    }
+}
+
+// fn() must throw E
+template <typename E, typename Fn> static void expectThrow(const std::string& what, Fn&& fn)
+{
+    try
+    {
+        fn();
+        ++failures;
+        std::cout << "FAIL " << what << ": no error\n";
+    }
+    catch (const E&)
+    {
+    }
+    catch (const std::exception& e)
+    {
+        ++failures;
+        std::cout << "FAIL " << what << ": wrong exception " << e.what() << "\n";
+    }
+}
+
+// parse_patch<T> must reject the input
+template <typename T = Doc>
+static void rejectBinary(const std::string& what, std::string_view bytes)
+{
+    expectThrow<meta::binary::parse_error>("binary: " + what,
+                                           [&] { meta::binary::parse_patch<T>(bytes); });
+}
+
+static void rejectJson(const std::string& what, std::string_view text)
+{
+    expectThrow<meta::json::parse_error>("JSON: " + what,
+                                         [&] { meta::json::parse_patch<Doc>(text); });
+}
+
+// JSON for diff(a, b)
+static std::string jsonDiff(const Doc& a, const Doc& b)
+{
+    return meta::json::serialize_patch(meta::diff(a, b));
+}
+
+// diff(a, b) applied to a copy of a gives b, directly and after a trip
+// through each encoding
+static void roundTrip(const std::string& what, const Doc& a, const Doc& b)
+{
+    const meta::equal<Doc> same;
+    const auto delta = meta::diff(a, b);
+    check(what + ": empty exactly when equal", delta.empty() == same(a, b));
+
+    Doc direct = a;
+    meta::apply_patch(direct, delta);
+    check(what + ": apply", same(direct, b));
+
+    try
+    {
+        Doc viaBinary = a;
+        meta::apply_patch(viaBinary,
+                          meta::binary::parse_patch<Doc>(meta::binary::serialize_patch(delta)));
+        check(what + ": binary patch", same(viaBinary, b));
+
+        Doc viaJson = a;
+        meta::apply_patch(viaJson,
+                          meta::json::parse_patch<Doc>(meta::json::serialize_patch(delta)));
+        check(what + ": JSON patch", same(viaJson, b));
+    }
+    catch (const std::exception& e)
+    {
+        check(what + ": " + e.what(), false);
+    }
+}
+
+int main()
+{
+    const Doc base{7,
+                   "ann",
+                   1.5,
+                   std::nullopt,
+                   {1, "one"},
+                   {1, 2, 3},
+                   {{1, "a"}, {2, "b"}},
+                   {"x", "y"},
+                   false};
+
+    // what a single change records
+    {
+        Doc b = base;
+        b.name = "bob";
+        auto delta = meta::diff(base, b);
+        check("one field: mask", delta.mask == 2 && delta.size() == 1);
+        check("one field: changed<>", delta.changed<&Doc::name>() && !delta.changed<&Doc::id>());
+        check("one field: value", delta.get<&Doc::name>() == "bob");
+        check("one field: JSON", meta::json::serialize_patch(delta) == R"({"name":"bob"})");
+
+        b = base;
+        b.inner.x = 5;
+        check("nested: JSON", jsonDiff(base, b) == R"({"inner":{"x":5}})");
+
+        b = base;
+        b.nums = {1, 9};
+        check("shrink and change: JSON",
+              jsonDiff(base, b) == R"({"nums":{"size":2,"set":[[1,9]]}})");
+
+        b = base;
+        b.nums.pop_back();
+        auto shrink = meta::diff(base, b);
+        check("shrink only: no element changes",
+              shrink.changed<&Doc::nums>() && shrink.get<&Doc::nums>().size == 2 &&
+                  shrink.get<&Doc::nums>().changes.empty());
+
+        const auto none = meta::diff(base, base);
+        check("no change: empty", none.empty());
+        check("no change: JSON", meta::json::serialize_patch(none) == "{}");
+        // "MTD1", schema hash, a two-byte mask for nine fields
+        check("no change: binary", meta::binary::serialize_patch(none).size() == 4 + 8 + 2);
+    }
+
+    // apply and both encodings over scalar, optional, nested and vector edits
+    std::vector<std::pair<std::string, Doc>> edits;
+    auto edit = [&](const std::string& name, auto&& change)
+    {
+        Doc b = base;
+        change(b);
+        edits.emplace_back(name, b);
+    };
+    edit("nothing", [](Doc&) {});
+    edit("id", [](Doc& d) { d.id = -1; });
+    edit("score", [](Doc& d) { d.score = -0.0; });
+    edit("rank set", [](Doc& d) { d.rank = 3; });
+    edit("flag", [](Doc& d) { d.flag = true; });
+    edit("inner label", [](Doc& d) { d.inner.label = "uno"; });
+    edit("nums grow", [](Doc& d) { d.nums.insert(d.nums.end(), {4, 5, 0}); });
+    edit("nums shrink", [](Doc& d) { d.nums.resize(1); });
+    edit("nums empty", [](Doc& d) { d.nums.clear(); });
+    edit("nums insert at front", [](Doc& d) { d.nums.insert(d.nums.begin(), 0); });
+    edit("items element field", [](Doc& d) { d.items[1].label = "B"; });
+    edit("items append default", [](Doc& d) { d.items.push_back({}); });
+    edit("items append", [](Doc& d) { d.items.push_back({3, ""}); });
+    edit("items shrink", [](Doc& d) { d.items.pop_back(); });
+    edit("items empty", [](Doc& d) { d.items.clear(); });
+    edit("tags shrink and change", [](Doc& d) { d.tags = {"z"}; });
+    edit("tags to empty strings", [](Doc& d) { d.tags = {"", "", ""}; });
+    edit("everything",
+         [](Doc& d)
+         {
+             d = {0, "", 0, 0, {}, {}, {{0, "z"}}, {"q"}, true};
+         });
+    for (const auto& [name, b] : edits)
+    {
+        roundTrip(name, base, b);
+        roundTrip(name + " (reversed)", b, base);
+    }
+    for (const auto& [from, a] : edits)
+        for (const auto& [to, b] : edits)
+            roundTrip(from + " -> " + to, a, b);
+
+    // binary patches the decoder must reject
+    Doc changed = base;
+    changed.nums = {1, 9, 3, 4};
+    const std::string good = meta::binary::serialize_patch(meta::diff(base, changed));
+    const size_t maskAt = 4 + 8;
+    {
+        std::string bad = good;
+        bad[maskAt + 1] = 0x02; // bit 9 of the uint16 mask: Doc has fields 0-8
+        rejectBinary("mask bit past the last field", bad);
+
+        // nums delta after the mask: u32 size, u32 count, (u32 index, i32 value)...
+        const size_t sizeAt = maskAt + 2;
+        // {1, 2, 3} -> {1, 9, 3, 4} changes indexes 1 and 3
+        bad = good;
+        std::memcpy(bad.data() + sizeAt, "\x03\x00\x00\x00", 4);
+        rejectBinary("index past the length", bad);
+
+        // two changes to index 0 of a one-element vector
+        bad = good;
+        std::memcpy(bad.data() + sizeAt, "\x01\x00\x00\x00", 4);
+        std::memcpy(bad.data() + sizeAt + 8, "\x00\x00\x00\x00", 4);
+        std::memcpy(bad.data() + sizeAt + 16, "\x00\x00\x00\x00", 4);
+        rejectBinary("more changes than elements", bad);
+
+        bad = good;
+        std::memcpy(bad.data() + sizeAt + 4, "\xff\xff\xff\x0f", 4);
+        rejectBinary("change count past the input", bad);
+
+        rejectBinary<OtherDoc>("other schema", good);
+        rejectBinary("whole record, not a patch", meta::binary::serialize(changed));
+        rejectBinary("trailing bytes", good + '\0');
+        for (size_t n = 0; n < good.size(); ++n)
+            rejectBinary("truncated to " + std::to_string(n) + " bytes",
+                         std::string_view(good).substr(0, n));
+    }
+
+    // JSON patches the decoder must reject, and what it tolerates
+    {
+        rejectJson("index past the length", R"({"nums":{"size":2,"set":[[2,1]]}})");
+        rejectJson("vector without size", R"({"nums":{"set":[[0,1]]}})");
+        rejectJson("trailing characters", R"({"id":1} x)");
+        rejectJson("truncated", R"({"id":)");
+
+        auto delta = meta::json::parse_patch<Doc>(R"({"unknown":[1,{"a":2}],"id":4})");
+        check("JSON: unknown keys skipped", delta.mask == 1 && delta.get<&Doc::id>() == 4);
+    }
+
+    // apply_patch on a hand-built patch whose index is past its own length
+    {
+        meta::patch<Doc> delta;
+        delta.mask = 1u << 5;
+        auto& nums = std::get<5>(delta.values);
+        nums.size = 1;
+        nums.changes.push_back({3, 7});
+        Doc target = base;
+        expectThrow<std::out_of_range>("apply: index past the patched length",
+                                       [&] { meta::apply_patch(target, delta); });
+    }
+
+    std::cout << (failures ? "test_diff: FAILED\n" : "test_diff: ok\n");
+    return failures ? 1 : 0;
+}
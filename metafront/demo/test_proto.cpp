@@ -0,0 +1,351 @@
+// Protobuf wire format against fixed byte vectors (the protobuf encoding
+// guide's {a = 150} -> 08 96 01, packed repeated, zigzag, sign-extended
+// negatives, strings, nested messages, doubles), parse() of unpacked and
+// unknown fields, and a round trip whose wire tags are checked against the
+// field numbers and types GenerateProto<T>() declares. Exits non-zero on
+// failure.
+// Usage: test_proto
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "meta.h"
+#include "meta_proto.h"
+
+struct Test1
+{
+    int32_t a;
+};
+
+struct Packed
+{
+    std::vector<int32_t> d;
+};
+
+struct ZigZag
+{
+    int32_t s;
+    int64_t l;
+};
+
+struct Negative
+{
+    int64_t v;
+    int32_t w;
+};
+
+struct Nested
+{
+    std::string name;
+    Test1 c;
+    double x;
+};
+
+struct Mixed
+{
+    uint32_t id;
+    int32_t delta;
+    bool flag;
+    float ratio;
+    double value;
+    std::string label;
+    std::optional<int64_t> extra;
+    std::vector<uint64_t> counts;
+    std::vector<std::string> tags;
+    std::vector<Test1> items;
+};
+
+namespace meta
+{
+template <> struct MetaTuple<::Test1>
+{
+    static constexpr auto fields =
+        std::make_tuple(meta::StaticField<&::Test1::a, "a", "int32_t">{});
+    static constexpr auto tableName = "Test1";
+    static constexpr auto query = "SELECT a FROM Test1";
+};
+
+template <> struct MetaTuple<::Packed>
+{
+    static constexpr auto fields =
+        std::make_tuple(meta::StaticField<&::Packed::d, "d", "std::vector<int32_t>">{});
+    static constexpr auto tableName = "Packed";
+    static constexpr auto query = "SELECT d FROM Packed";
+};
+
+template <> struct MetaTuple<::ZigZag>
+{
+    static constexpr auto fields = std::make_tuple(
+        meta::StaticField<&::ZigZag::s,
+                          "s",
+                          "int32_t",
+                          meta::Prop::None,
+                          meta::Attr{"proto_type", "sint32"}>{},
+        meta::StaticField<&::ZigZag::l,
+                          "l",
+                          "int64_t",
+                          meta::Prop::None,
+                          meta::Attr{"proto_type", "sint64"}>{});
+    static constexpr auto tableName = "ZigZag";
+    static constexpr auto query = "SELECT s, l FROM ZigZag";
+};
+
+template <> struct MetaTuple<::Negative>
+{
+    static constexpr auto fields = std::make_tuple(
+        meta::StaticField<&::Negative::v, "v", "int64_t">{},
+        meta::StaticField<&::Negative::w, "w", "int32_t">{});
+    static constexpr auto tableName = "Negative";
+    static constexpr auto query = "SELECT v, w FROM Negative";
+};
+
+template <> struct MetaTuple<::Nested>
+{
+    static constexpr auto fields = std::make_tuple(
+        meta::StaticField<&::Nested::name, "name", "std::string">{},
+        meta::StaticField<&::Nested::c, "c", "Test1">{},
+        meta::StaticField<&::Nested::x, "x", "double">{});
+    static constexpr auto tableName = "Nested";
+    static constexpr auto query = "SELECT name, c, x FROM Nested";
+};
+
+template <> struct MetaTuple<::Mixed>
+{
+    static constexpr auto fields = std::make_tuple(
+        meta::StaticField<&::Mixed::id, "id", "uint32_t">{},
+        meta::StaticField<&::Mixed::delta,
+                          "delta",
+                          "int32_t",
+                          meta::Prop::None,
+                          meta::Attr{"proto_type", "sint32"}>{},
+        meta::StaticField<&::Mixed::flag, "flag", "bool">{},
+        meta::StaticField<&::Mixed::ratio, "ratio", "float">{},
+        meta::StaticField<&::Mixed::value, "value", "double">{},
+        meta::StaticField<&::Mixed::label, "label", "std::string">{},
+        meta::StaticField<&::Mixed::extra, "extra", "std::optional<int64_t>">{},
+        meta::StaticField<&::Mixed::counts, "counts", "std::vector<uint64_t>">{},
+        meta::StaticField<&::Mixed::tags, "tags", "std::vector<std::string>">{},
+        meta::StaticField<&::Mixed::items, "items", "std::vector<Test1>">{});
+    static constexpr auto tableName = "Mixed";
+    static constexpr auto query =
+        "SELECT id, delta, flag, ratio, value, label, extra, counts, tags, items FROM Mixed";
+};
+} // namespace meta
+
+static int failures = 0;
+
+static void check(const std::string& what, bool ok)
+{
+    if (!ok)
+    {
+        ++failures;
+        std::cout << "FAIL " << what << "\n";
+    }
+}
+
+static std::string hex(std::string_view bytes)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    for (unsigned char c : bytes)
+    {
+        if (!out.empty())
+            out += ' ';
+        out += digits[c >> 4];
+        out += digits[c & 15];
+    }
+    return out;
+}
+
+static std::string bytes(std::initializer_list<unsigned> values)
+{
+    std::string out;
+    for (unsigned v : values)
+        out += static_cast<char>(v);
+    return out;
+}
+
+// serialize(obj) must be exactly `expected`, and byte_size must agree
+template <typename T>
+static void expectBytes(const char* what, const T& obj, const std::string& expected)
+{
+    const std::string got = meta::proto::serialize(obj);
+    if (got != expected || meta::proto::byte_size(obj) != expected.size())
+    {
+        ++failures;
+        std::cout << "FAIL " << what << "\n  expected " << hex(expected) << "\n  got      "
+                  << hex(got) << "\n";
+    }
+}
+
+// Field numbers and wire types declared by a GenerateProto message
+static std::map<std::string, std::pair<uint64_t, uint8_t>> declaredFields(const std::string& proto)
+{
+    std::map<std::string, std::pair<uint64_t, uint8_t>> out;
+    std::istringstream lines(proto);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        std::istringstream words(line);
+        std::string label, type, name, eq;
+        uint64_t number = 0;
+        if (!(words >> label >> type >> name >> eq >> number) || eq != "=")
+            continue;
+        // varint scalars are 0, packed repeated and strings and messages 2
+        static const std::set<std::string> varints = {
+            "int32", "int64", "uint32", "uint64", "sint32", "sint64", "bool"};
+        uint8_t wire = 2;
+        if (line.find("[packed = true]") != std::string::npos)
+            wire = 2;
+        else if (type == "double" || type == "fixed64" || type == "sfixed64")
+            wire = 1;
+        else if (type == "float" || type == "fixed32" || type == "sfixed32")
+            wire = 5;
+        else if (varints.count(type))
+            wire = 0;
+        out[name] = {number, wire};
+    }
+    return out;
+}
+
+static uint64_t readVarint(std::string_view bytes, size_t& pos)
+{
+    uint64_t value = 0;
+    for (int shift = 0; pos < bytes.size(); shift += 7)
+    {
+        auto b = static_cast<unsigned char>(bytes[pos++]);
+        value |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if (!(b & 0x80))
+            break;
+    }
+    return value;
+}
+
+// (field number, wire type) of every top-level record, in order
+static std::vector<std::pair<uint64_t, uint8_t>> wireTags(std::string_view bytes)
+{
+    std::vector<std::pair<uint64_t, uint8_t>> out;
+    size_t pos = 0;
+    while (pos < bytes.size())
+    {
+        uint64_t tag = readVarint(bytes, pos);
+        auto wire = static_cast<uint8_t>(tag & 7);
+        out.push_back({tag >> 3, wire});
+        if (wire == 0)
+            readVarint(bytes, pos);
+        else if (wire == 1)
+            pos += 8;
+        else if (wire == 5)
+            pos += 4;
+        else
+            pos += readVarint(bytes, pos);
+    }
+    return out;
+}
+
+int main()
+{
+    // https://protobuf.dev/programming-guides/encoding/ examples
+    expectBytes("int32 150", Test1{150}, bytes({0x08, 0x96, 0x01}));
+    expectBytes("int32 0 is still written", Test1{0}, bytes({0x08, 0x00}));
+    expectBytes("packed int32", Packed{{3, 270, 86942}},
+                bytes({0x0a, 0x06, 0x03, 0x8e, 0x02, 0x9e, 0xa7, 0x05}));
+    expectBytes("empty repeated writes nothing", Packed{}, "");
+    expectBytes("zigzag", ZigZag{-1, -3}, bytes({0x08, 0x01, 0x10, 0x05}));
+    expectBytes("zigzag extremes", ZigZag{INT32_MIN, 1},
+                bytes({0x08, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x10, 0x02}));
+    expectBytes("negative int64 and int32 are ten-byte varints", Negative{-1, -2},
+                bytes({0x08, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01,
+                       0x10, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01}));
+    expectBytes("string, nested message, double", Nested{"testing", {150}, 1.0},
+                bytes({0x0a, 0x07, 't', 'e', 's', 't', 'i', 'n', 'g', 0x12, 0x03, 0x08, 0x96, 0x01,
+                       0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x3f}));
+
+    // parse: the fixed vectors back, unpacked repeated numbers, unknown fields
+    check("parse int32 150", meta::proto::parse<Test1>(bytes({0x08, 0x96, 0x01})).a == 150);
+    Packed packed =
+        meta::proto::parse<Packed>(bytes({0x0a, 0x06, 0x03, 0x8e, 0x02, 0x9e, 0xa7, 0x05}));
+    check("parse packed", packed.d == std::vector<int32_t>{3, 270, 86942});
+    packed = meta::proto::parse<Packed>(bytes({0x08, 0x03, 0x08, 0x8e, 0x02}));
+    check("parse unpacked", packed.d == std::vector<int32_t>{3, 270});
+    {
+        ZigZag z = meta::proto::parse<ZigZag>(bytes({0x08, 0x01, 0x10, 0x05}));
+        check("parse zigzag", z.s == -1 && z.l == -3);
+        const std::string extremes = meta::proto::serialize(Negative{INT64_MIN, INT32_MIN});
+        Negative n = meta::proto::parse<Negative>(extremes);
+        check("parse negative", n.v == INT64_MIN && n.w == INT32_MIN);
+    }
+    // unknown fields 7 (varint), 8 (length), 9 (fixed32), 10 (fixed64) around a=150
+    const std::string unknown = bytes({0x38, 0x01, 0x42, 0x02, 'h', 'i', 0x08, 0x96, 0x01,
+                                       0x4d, 0,    0,    0,    0,   0x51, 0, 0, 0, 0, 0, 0, 0, 0});
+    check("parse skips unknown fields", meta::proto::parse<Test1>(unknown).a == 150);
+
+    // round trip, with every tag on the wire matching GenerateProto's schema
+    Mixed mixed{7,
+                -42,
+                true,
+                0.5f,
+                3.25,
+                "label",
+                1ll << 40,
+                {1, 300, 1ull << 63},
+                {"a", "", "bc"},
+                {{1}, {-1}}};
+    const std::string proto = GenerateProto<Mixed>();
+    const std::string wire = meta::proto::serialize(mixed);
+    const auto declared = declaredFields(proto);
+    check("GenerateProto declares every field", declared.size() == 10);
+
+    std::map<uint64_t, uint8_t> wireByNumber;
+    for (const auto& [name, field] : declared)
+        wireByNumber[field.first] = field.second;
+    std::vector<uint64_t> seen;
+    for (const auto& [number, type] : wireTags(wire))
+    {
+        auto it = wireByNumber.find(number);
+        if (it == wireByNumber.end() || it->second != type)
+        {
+            ++failures;
+            std::cout << "FAIL tag " << number << " wire " << int(type) << " does not match\n"
+                      << proto;
+        }
+        seen.push_back(number);
+    }
+    check("tags in field order",
+          seen == std::vector<uint64_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 9, 9, 10, 10});
+    check("sint32 declared", proto.find("optional sint32 delta = 2;") != std::string::npos);
+    check("packed declared",
+          proto.find("repeated uint64 counts = 8 [packed = true];") != std::string::npos);
+
+    Mixed back = meta::proto::parse<Mixed>(wire);
+    check("round trip",
+          back.id == mixed.id && back.delta == mixed.delta && back.flag == mixed.flag &&
+              back.ratio == mixed.ratio && back.value == mixed.value && back.label == mixed.label &&
+              back.extra == mixed.extra && back.counts == mixed.counts && back.tags == mixed.tags &&
+              back.items.size() == 2 && back.items[0].a == 1 && back.items[1].a == -1);
+
+    mixed.extra.reset();
+    back = meta::proto::parse<Mixed>(meta::proto::serialize(mixed));
+    check("unset optional is not written",
+          !back.extra && wireTags(meta::proto::serialize(mixed)).size() == 12);
+
+    std::string small(2, '\0');
+    bool threw = false;
+    try
+    {
+        meta::proto::serialize_to(Test1{150}, std::span<char>(small.data(), small.size()));
+    }
+    catch (const std::length_error&)
+    {
+        threw = true;
+    }
+    check("serialize_to into a short buffer throws", threw);
+
+    std::cout << (failures ? "test_proto: FAILED\n" : "test_proto: ok\n");
+    return failures ? 1 : 0;
+}
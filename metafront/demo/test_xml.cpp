@@ -0,0 +1,256 @@
+// XML round trip through serialize() and serialize_compact() (attributes),
+// and hand-written documents the reader must accept: elements out of
+// declaration order, unknown elements and attributes, nested records and a
+// type with many fields; plus duplicate field names and malformed input,
+// which must be rejected. Exits non-zero on failure.
+// Usage: test_xml
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "meta.h"
+#include "meta_xml.h"
+
+struct Item
+{
+    int32_t id;
+    std::string name;
+    double price;
+    bool active;
+    std::optional<int32_t> qty;
+    std::vector<int32_t> codes;
+};
+
+struct Inner
+{
+    int32_t x;
+    std::string label;
+};
+
+struct Outer
+{
+    int64_t key;
+    Inner inner;
+    std::vector<std::string> tags;
+};
+
+// Sixteen fields, so lookups go through the hash rather than a short table
+struct Wide
+{
+    int32_t f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15;
+};
+
+// Two members under one name: no table can tell them apart
+struct Duplicate
+{
+    int32_t a;
+    int32_t b;
+};
+
+#define WIDE_FIELD(n) meta::StaticField<&::Wide::f##n, "f" #n, "int32_t">{}
+
+namespace meta
+{
+template <> struct MetaTuple<::Item>
+{
+    static constexpr auto fields = std::make_tuple(
+        meta::StaticField<&::Item::id, "id", "int32_t">{},
+        meta::StaticField<&::Item::name, "name", "std::string">{},
+        meta::StaticField<&::Item::price, "price", "double">{},
+        meta::StaticField<&::Item::active, "active", "bool">{},
+        meta::StaticField<&::Item::qty, "qty", "std::optional<int32_t>">{},
+        meta::StaticField<&::Item::codes, "codes", "std::vector<int32_t>">{});
+    static constexpr auto tableName = "Item";
+    static constexpr auto query = "SELECT id, name, price, active, qty, codes FROM Item";
+};
+
+template <> struct MetaTuple<::Inner>
+{
+    static constexpr auto fields = std::make_tuple(
+        meta::StaticField<&::Inner::x, "x", "int32_t">{},
+        meta::StaticField<&::Inner::label, "label", "std::string">{});
+    static constexpr auto tableName = "Inner";
+    static constexpr auto query = "SELECT x, label FROM Inner";
+};
+
+template <> struct MetaTuple<::Outer>
+{
+    static constexpr auto fields = std::make_tuple(
+        meta::StaticField<&::Outer::key, "key", "int64_t">{},
+        meta::StaticField<&::Outer::inner, "inner", "Inner">{},
+        meta::StaticField<&::Outer::tags, "tags", "std::vector<std::string>">{});
+    static constexpr auto tableName = "Outer";
+    static constexpr auto query = "SELECT key, inner, tags FROM Outer";
+};
+
+template <> struct MetaTuple<::Wide>
+{
+    static constexpr auto fields = std::make_tuple(
+        WIDE_FIELD(0), WIDE_FIELD(1), WIDE_FIELD(2), WIDE_FIELD(3), WIDE_FIELD(4), WIDE_FIELD(5),
+        WIDE_FIELD(6), WIDE_FIELD(7), WIDE_FIELD(8), WIDE_FIELD(9), WIDE_FIELD(10), WIDE_FIELD(11),
+        WIDE_FIELD(12), WIDE_FIELD(13), WIDE_FIELD(14), WIDE_FIELD(15));
+    static constexpr auto tableName = "Wide";
+    static constexpr auto query = "SELECT * FROM Wide";
+};
+
+template <> struct MetaTuple<::Duplicate>
+{
+    static constexpr auto fields = std::make_tuple(
+        meta::StaticField<&::Duplicate::a, "x", "int32_t">{},
+        meta::StaticField<&::Duplicate::b, "x", "int32_t">{});
+    static constexpr auto tableName = "Duplicate";
+    static constexpr auto query = "SELECT x, x FROM Duplicate";
+};
+} // namespace meta
+
+static int failures = 0;
+
+static void check(const std::string& what, bool ok)
+{
+    if (!ok)
+    {
+        ++failures;
+        std::cout << "FAIL " << what << "\n";
+    }
+}
+
+// fn() must throw E
+template <typename E, typename Fn> static void expectThrow(const std::string& what, Fn&& fn)
+{
+    try
+    {
+        fn();
+        ++failures;
+        std::cout << "FAIL " << what << ": no error\n";
+    }
+    catch (const E&)
+    {
+    }
+    catch (const std::exception& e)
+    {
+        ++failures;
+        std::cout << "FAIL " << what << ": wrong exception " << e.what() << "\n";
+    }
+}
+
+static bool same(const Item& a, const Item& b)
+{
+    return a.id == b.id && a.name == b.name && a.price == b.price && a.active == b.active &&
+           a.qty == b.qty && a.codes == b.codes;
+}
+
+static bool same(const std::vector<Item>& a, const std::vector<Item>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (!same(a[i], b[i]))
+            return false;
+    return true;
+}
+
+static constexpr int32_t Wide::*wideMembers[] = {
+    &Wide::f0, &Wide::f1, &Wide::f2,  &Wide::f3,  &Wide::f4,  &Wide::f5,  &Wide::f6,  &Wide::f7,
+    &Wide::f8, &Wide::f9, &Wide::f10, &Wide::f11, &Wide::f12, &Wide::f13, &Wide::f14, &Wide::f15};
+
+// the Wide record whose field fN holds N * 7 - 50
+static bool isWideSample(const Wide& w)
+{
+    for (int32_t n = 0; n < 16; ++n)
+        if (w.*wideMembers[n] != n * 7 - 50)
+            return false;
+    return true;
+}
+
+int main()
+{
+    const std::vector<Item> items = {
+        {1, "ann", 1.5, true, 10, {1, 2, 3}},
+        {-2, "<b & \"c\" 'd'>", -0.25, false, std::nullopt, {}},
+        {3, "", 0, true, -7, {-4}},
+    };
+
+    // what the writers produce reads back
+    try
+    {
+        const std::string pretty = meta::xml::serialize(items);
+        check("serialize / parse", same(items, meta::xml::parse<Item>(pretty)));
+        const std::string compact = meta::xml::serialize_compact(items);
+        check("serialize_compact writes attributes",
+              compact.find(" id=\"1\"") != std::string::npos);
+        check("serialize_compact / parse", same(items, meta::xml::parse<Item>(compact)));
+        const std::string empty = meta::xml::serialize(std::vector<Item>{});
+        check("no records", meta::xml::parse<Item>(empty).empty());
+    }
+    catch (const std::exception& e)
+    {
+        check(std::string("round trip: ") + e.what(), false);
+    }
+
+    // elements out of order, unknown elements and attributes, nested records
+    try
+    {
+        auto parsed = meta::xml::parse<Item>(
+            "<data><object index=\"0\" colour=\"red\" price=\"9.5\">"
+            "<unknown><id>99</id><deeper/></unknown>"
+            "<codes><item>5</item><item>6</item></codes>"
+            "<active>true</active><qty>4</qty><id>42</id><name>z</name>"
+            "<ID>7</ID><nam>y</nam>"
+            "</object></data>");
+        check("out of order and unknown",
+              parsed.size() == 1 && same(parsed[0], Item{42, "z", 9.5, true, 4, {5, 6}}));
+
+        auto outer = meta::xml::parse<Outer>(
+            "<data><object><tags><item>p</item></tags>"
+            "<inner><label>in</label><skip>1</skip><x>-3</x></inner><key>8</key>"
+            "</object></data>");
+        check("nested record", outer.size() == 1 && outer[0].key == 8 && outer[0].inner.x == -3 &&
+                                   outer[0].inner.label == "in" && outer[0].tags.size() == 1);
+    }
+    catch (const std::exception& e)
+    {
+        check(std::string("hand-written: ") + e.what(), false);
+    }
+
+    // many fields, in declaration order, reversed, and with near-miss names
+    try
+    {
+        Wide sample{};
+        for (int32_t n = 0; n < 16; ++n)
+            sample.*wideMembers[n] = n * 7 - 50;
+        auto back = meta::xml::parse<Wide>(meta::xml::serialize(std::vector<Wide>{sample}));
+        check("wide round trip", back.size() == 1 && isWideSample(back[0]));
+
+        std::string reversed = "<data><object>";
+        for (int32_t n = 15; n >= 0; --n)
+        {
+            const std::string name = "f" + std::to_string(n);
+            reversed += "<f0" + std::to_string(n) + ">1</f0" + std::to_string(n) + ">";
+            reversed += "<" + name + ">" + std::to_string(n * 7 - 50) + "</" + name + ">";
+            reversed += "<" + name + "x>2</" + name + "x>";
+        }
+        reversed += "<f16>3</f16><f>4</f></object></data>";
+        back = meta::xml::parse<Wide>(reversed);
+        check("wide reversed with near misses", back.size() == 1 && isWideSample(back[0]));
+    }
+    catch (const std::exception& e)
+    {
+        check(std::string("wide: ") + e.what(), false);
+    }
+
+    // duplicate field names and malformed documents
+    expectThrow<std::logic_error>("duplicate field names",
+                                  [] { meta::xml::parse<Duplicate>("<object><x>1</x></object>"); });
+    expectThrow<meta::xml::parse_error>("unterminated record",
+                                        [] { meta::xml::parse<Item>("<object><id>1</id>"); });
+    expectThrow<meta::xml::parse_error>(
+        "mismatched end tag", [] { meta::xml::parse<Item>("<object><id>1</name></object>"); });
+    expectThrow<meta::xml::parse_error>(
+        "number that is not one", [] { meta::xml::parse<Item>("<object><id>x1</id></object>"); });
+
+    std::cout << (failures ? "test_xml: FAILED\n" : "test_xml: ok\n");
+    return failures ? 1 : 0;
+}
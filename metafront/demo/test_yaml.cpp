@@ -0,0 +1,57 @@
+// YAML round trip of strings the reader would otherwise take for null or a
+// scalar of another type, through serialize(), serialize_compact() and
+// parse_each<T>. Exits non-zero on the first mismatch.
+// Usage: test_yaml
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "meta.h"
+#include "meta_yaml.h"
+
+struct Note
+{
+    std::string text;
+    std::optional<std::string> remark;
+};
+
+#include "test_yaml.meta"
+
+static int failures = 0;
+
+static void check(const char* what, const std::vector<Note>& expected, const std::vector<Note>& got)
+{
+    bool same = expected.size() == got.size();
+    for (size_t i = 0; same && i < expected.size(); ++i)
+        same = expected[i].text == got[i].text && expected[i].remark == got[i].remark;
+    if (!same)
+    {
+        ++failures;
+        std::cout << "FAIL " << what << "\n";
+    }
+}
+
+int main()
+{
+    std::vector<Note> notes;
+    for (const char* text : {"null", "Null", "NULL", "~", "true", "no", "42", "nul", "NULLS"})
+        notes.push_back({text, std::string(text)});
+    notes.push_back({"", std::nullopt});
+
+    const std::string block = meta::yaml::serialize(notes);
+    const std::string flow = meta::yaml::serialize_compact(notes);
+
+    check("serialize / parse", notes, meta::yaml::parse<std::vector<Note>>(block));
+    check("serialize_compact / parse", notes, meta::yaml::parse<std::vector<Note>>(flow));
+
+    for (const std::string* yaml : {&block, &flow})
+    {
+        std::vector<Note> each;
+        meta::yaml::parse_each<Note>(*yaml, [&](Note&& note) { each.push_back(std::move(note)); });
+        check(yaml == &block ? "serialize / parse_each" : "serialize_compact / parse_each", notes, each);
+    }
+
+    std::cout << (failures ? "test_yaml: FAILED\n" : "test_yaml: ok\n");
+    return failures ? 1 : 0;
+}
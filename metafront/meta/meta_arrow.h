@@ -0,0 +1,1763 @@
+/*
+ * ================================================================
+ * APACHE ARROW IPC
+ *
+ * Writes and reads reflected records as Arrow IPC, in the streaming
+ * format or the file format (the stream between "ARROW1" magics, plus a
+ * footer indexing the record batches), so pyarrow, polars, DuckDB and the
+ * other Arrow tools read them with their types intact. Self-contained:
+ * the FlatBuffers metadata is built and parsed here, with no Arrow or
+ * FlatBuffers dependency.
+ *
+ * Schema, one field per MetaTuple<T>::fields entry:
+ *   integers                  Int (bit width and signedness of the member)
+ *   float, double             FloatingPoint SINGLE / DOUBLE
+ *   bool                      Bool (bit-packed)
+ *   std::string               Utf8 (int32 offsets + data)
+ *   system_clock::time_point  Timestamp(NANOSECOND, "UTC")
+ *   std::vector<E>            List<item: E> (int32 offsets + child array)
+ *   std::optional<U>          U, nullable, with a validity bitmap
+ * Columns without nulls omit the validity bitmap. Buffers start on 64-byte
+ * boundaries in the message body, so readers that memory-map the output
+ * use the columns in place.
+ *
+ * Record batches are encoded straight into the output: fixed-width
+ * columns are one pass over the rows (one memcpy per column from a
+ * meta::soa_vector), strings one pass for the offsets and one copy of the
+ * bytes.
+ *
+ * Reading takes either format (and the pre-0.15 stream framing). Columns
+ * are matched to fields by name, columns the struct lacks are skipped,
+ * and LargeUtf8 / LargeList and every Timestamp unit are accepted.
+ * Dictionary-encoded and compressed data is rejected.
+ *
+ * Usage:
+ *   std::string ipc = meta::arrow::serialize(rows);                      // stream
+ *   std::string file = meta::arrow::serialize(rows, meta::arrow::Format::File);
+ *   meta::arrow::serialize_to(buf, columns);                            // appends; buf reused
+ *   auto back = meta::arrow::parse<Row>(file);                          // std::vector<Row>
+ *   meta::arrow::writer<Row> out(meta::Sink::file("rows.arrows"));
+ *   out.write_all(FetchRowsBlockGeneratorT<Row>(conn));
+ *   out.close();
+ * ================================================================
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "meta_sink.h"
+#include "meta_soa.h"
+
+namespace meta
+{
+namespace arrow
+{
+
+static_assert(std::endian::native == std::endian::little, "meta::arrow writes little-endian IPC");
+
+class parse_error : public std::runtime_error
+{
+  public:
+    parse_error(const std::string& what, size_t offset)
+        : std::runtime_error("arrow: " + what + " at offset " + std::to_string(offset)), offset_(offset)
+    {
+    }
+
+    size_t offset() const
+    {
+        return offset_;
+    }
+
+  private:
+    size_t offset_;
+};
+
+enum class Format
+{
+    Stream, // .arrows: schema, record batches, end-of-stream marker
+    File,   // .arrow / Feather v2: the stream plus a footer, for random access
+};
+
+inline constexpr size_t default_batch_rows = 64 * 1024;
+
+namespace detail
+{
+
+template <typename> inline constexpr bool dependent_false = false;
+
+template <typename T> struct is_optional : std::false_type
+{
+};
+template <typename T> struct is_optional<std::optional<T>> : std::true_type
+{
+};
+
+template <typename T> struct unwrap_optional
+{
+    using type = T;
+};
+template <typename T> struct unwrap_optional<std::optional<T>>
+{
+    using type = T;
+};
+
+inline constexpr char file_magic[6] = {'A', 'R', 'R', 'O', 'W', '1'};
+inline constexpr uint32_t continuation = 0xFFFFFFFF;
+inline constexpr size_t body_alignment = 64;
+
+// Schema.fbs Type union
+enum TypeId : uint8_t
+{
+    Null = 1,
+    Int = 2,
+    FloatingPoint = 3,
+    Binary = 4,
+    Utf8 = 5,
+    Bool = 6,
+    Decimal = 7,
+    Date = 8,
+    Time = 9,
+    Timestamp = 10,
+    Interval = 11,
+    List = 12,
+    Struct = 13,
+    Union = 14,
+    FixedSizeBinary = 15,
+    FixedSizeList = 16,
+    Map = 17,
+    Duration = 18,
+    LargeBinary = 19,
+    LargeUtf8 = 20,
+    LargeList = 21,
+};
+
+// Message.fbs MessageHeader union
+enum MessageType : uint8_t
+{
+    SchemaMessage = 1,
+    DictionaryBatchMessage = 2,
+    RecordBatchMessage = 3,
+};
+
+inline constexpr int16_t metadata_v5 = 4;
+
+template <typename V> void store(char* p, V value)
+{
+    std::memcpy(p, &value, sizeof(V));
+}
+
+template <typename V> V load(const char* p)
+{
+    V value;
+    std::memcpy(&value, p, sizeof(V));
+    return value;
+}
+
+// ----------------------------------------------------------------
+// FlatBuffers
+// ----------------------------------------------------------------
+
+// Builds a flatbuffer back to front, as the reference builder does: objects
+// are prepended, so every offset points forward. Positions are distances
+// from the end of the buffer; bytes are kept reversed until finish().
+class FlatBuilder
+{
+  public:
+    size_t size() const
+    {
+        return bytes_.size();
+    }
+
+    // Pads so that the next `bytes` bytes end on an `alignment` boundary
+    void prealign(size_t bytes, size_t alignment)
+    {
+        while ((bytes_.size() + bytes) % alignment != 0)
+            bytes_.push_back(0);
+        if (alignment > max_align_)
+            max_align_ = alignment;
+    }
+
+    template <typename V> size_t scalar(V value)
+    {
+        prealign(sizeof(V), sizeof(V));
+        push(&value, sizeof(V));
+        return size();
+    }
+
+    // A uoffset to an object created earlier
+    size_t offset(size_t target)
+    {
+        prealign(4, 4);
+        return scalar<uint32_t>(static_cast<uint32_t>(size() + 4 - target));
+    }
+
+    size_t string(std::string_view text)
+    {
+        prealign(text.size() + 1, 4);
+        bytes_.push_back(0);
+        push(text.data(), text.size());
+        return scalar<uint32_t>(static_cast<uint32_t>(text.size()));
+    }
+
+    size_t offsets(const std::vector<size_t>& targets)
+    {
+        prealign(targets.size() * 4, 4);
+        for (size_t i = targets.size(); i-- > 0;)
+            offset(targets[i]);
+        return scalar<uint32_t>(static_cast<uint32_t>(targets.size()));
+    }
+
+    // A vector of structs given as their little-endian bytes
+    size_t structs(const void* data, size_t count, size_t struct_size, size_t alignment)
+    {
+        prealign(count * struct_size, 4);
+        prealign(count * struct_size, alignment);
+        push(data, count * struct_size);
+        return scalar<uint32_t>(static_cast<uint32_t>(count));
+    }
+
+    void start_table()
+    {
+        fields_.clear();
+        table_start_ = size();
+    }
+
+    // Every field is written, defaults included, so a table's size depends
+    // only on its shape
+    template <typename V> void add(uint16_t slot, V value)
+    {
+        fields_.push_back({slot, scalar(value)});
+    }
+
+    void add_offset(uint16_t slot, size_t target)
+    {
+        fields_.push_back({slot, offset(target)});
+    }
+
+    size_t end_table()
+    {
+        size_t table = scalar<int32_t>(0);
+
+        uint16_t slots = 0;
+        for (const auto& field : fields_)
+            slots = std::max<uint16_t>(slots, static_cast<uint16_t>(field.slot + 1));
+        std::vector<uint16_t> vtable(2 + slots, 0);
+        vtable[0] = static_cast<uint16_t>(vtable.size() * 2);
+        vtable[1] = static_cast<uint16_t>(table - table_start_);
+        for (const auto& field : fields_)
+            vtable[2 + field.slot] = static_cast<uint16_t>(table - field.position);
+        for (size_t i = vtable.size(); i-- > 0;)
+            scalar(vtable[i]);
+
+        // the vtable sits right before the table
+        patch<int32_t>(table, static_cast<int32_t>(size() - table));
+        return table;
+    }
+
+    std::string finish(size_t root)
+    {
+        prealign(4, max_align_);
+        offset(root);
+        return std::string(bytes_.rbegin(), bytes_.rend());
+    }
+
+  private:
+    struct FieldSlot
+    {
+        uint16_t slot;
+        size_t position;
+    };
+
+    void push(const void* data, size_t size)
+    {
+        const char* p = static_cast<const char*>(data);
+        for (size_t i = size; i-- > 0;)
+            bytes_.push_back(p[i]);
+    }
+
+    template <typename V> void patch(size_t position, V value)
+    {
+        char raw[sizeof(V)];
+        std::memcpy(raw, &value, sizeof(V));
+        for (size_t k = 0; k < sizeof(V); ++k)
+            bytes_[position - 1 - k] = raw[k];
+    }
+
+    std::vector<char> bytes_;
+    std::vector<FieldSlot> fields_;
+    size_t table_start_ = 0;
+    size_t max_align_ = 8;
+};
+
+// Bounds-checked view of one flatbuffer table; base is the buffer's offset
+// in the input, for errors
+class FlatTable
+{
+  public:
+    FlatTable(std::string_view buf, size_t base, size_t position) : buf_(buf), base_(base), pos_(position)
+    {
+        check(pos_, 4);
+        int64_t vtable = static_cast<int64_t>(pos_) - load<int32_t>(buf_.data() + pos_);
+        if (vtable < 0)
+            fail("bad vtable offset", pos_);
+        vtable_ = static_cast<size_t>(vtable);
+        check(vtable_, 4);
+        vsize_ = load<uint16_t>(buf_.data() + vtable_);
+        check(vtable_, vsize_);
+    }
+
+    static FlatTable root(std::string_view buf, size_t base)
+    {
+        FlatTable probe(buf, base);
+        probe.check(0, 4);
+        return FlatTable(buf, base, probe.follow(0));
+    }
+
+    bool has(uint16_t slot) const
+    {
+        return field(slot) != 0;
+    }
+
+    template <typename V> V get(uint16_t slot, V fallback) const
+    {
+        size_t p = field(slot);
+        if (p == 0)
+            return fallback;
+        check(p, sizeof(V));
+        return load<V>(buf_.data() + p);
+    }
+
+    std::optional<FlatTable> table(uint16_t slot) const
+    {
+        size_t p = field(slot);
+        if (p == 0)
+            return std::nullopt;
+        return FlatTable(buf_, base_, follow(p));
+    }
+
+    std::string_view string(uint16_t slot) const
+    {
+        auto [start, length] = vector(slot, 1);
+        return buf_.substr(start, length);
+    }
+
+    // First element and element count of a vector field (empty when absent)
+    std::pair<size_t, size_t> vector(uint16_t slot, size_t element_size) const
+    {
+        size_t p = field(slot);
+        if (p == 0)
+            return {0, 0};
+        size_t v = follow(p);
+        check(v, 4);
+        size_t count = load<uint32_t>(buf_.data() + v);
+        check(v + 4, count * element_size);
+        return {v + 4, count};
+    }
+
+    // Element i of a vector of tables
+    FlatTable table_at(std::pair<size_t, size_t> vector, size_t i) const
+    {
+        return FlatTable(buf_, base_, follow(vector.first + i * 4));
+    }
+
+    const char* data(size_t position) const
+    {
+        return buf_.data() + position;
+    }
+
+    [[noreturn]] void fail(const std::string& what, size_t position) const
+    {
+        throw parse_error(what, base_ + position);
+    }
+
+  private:
+    FlatTable(std::string_view buf, size_t base) : buf_(buf), base_(base)
+    {
+    }
+
+    void check(size_t position, size_t size) const
+    {
+        if (position > buf_.size() || size > buf_.size() - position)
+            fail("metadata out of bounds", position);
+    }
+
+    size_t field(uint16_t slot) const
+    {
+        size_t entry = 4 + 2 * static_cast<size_t>(slot);
+        if (entry + 2 > vsize_)
+            return 0;
+        uint16_t offset = load<uint16_t>(buf_.data() + vtable_ + entry);
+        return offset == 0 ? 0 : pos_ + offset;
+    }
+
+    size_t follow(size_t position) const
+    {
+        check(position, 4);
+        size_t target = position + load<uint32_t>(buf_.data() + position);
+        check(target, 0);
+        return target;
+    }
+
+    std::string_view buf_;
+    size_t base_ = 0;
+    size_t pos_ = 0;
+    size_t vtable_ = 0;
+    size_t vsize_ = 0;
+};
+
+// ----------------------------------------------------------------
+// Record batch bodies
+// ----------------------------------------------------------------
+
+struct FieldNode
+{
+    int64_t length;
+    int64_t null_count;
+};
+
+struct BufferSpec
+{
+    int64_t offset;
+    int64_t length;
+};
+
+// Appends a record batch body to out: buffers on 64-byte boundaries,
+// offsets relative to the body start
+class BatchBuilder
+{
+  public:
+    explicit BatchBuilder(std::string& out) : out_(out), start_(out.size())
+    {
+    }
+
+    void node(size_t length, size_t null_count)
+    {
+        nodes_.push_back({static_cast<int64_t>(length), static_cast<int64_t>(null_count)});
+    }
+
+    void empty_buffer()
+    {
+        buffers_.push_back({static_cast<int64_t>(out_.size() - start_), 0});
+    }
+
+    // Zeroed space for one buffer; valid until the next buffer() call
+    char* buffer(size_t length)
+    {
+        pad(body_alignment);
+        size_t offset = out_.size() - start_;
+        buffers_.push_back({static_cast<int64_t>(offset), static_cast<int64_t>(length)});
+        out_.resize(out_.size() + length);
+        return out_.data() + start_ + offset;
+    }
+
+    // Pads the body to a multiple of 8 bytes and returns its length
+    size_t finish()
+    {
+        pad(8);
+        return out_.size() - start_;
+    }
+
+    const std::vector<FieldNode>& nodes() const
+    {
+        return nodes_;
+    }
+    const std::vector<BufferSpec>& buffers() const
+    {
+        return buffers_;
+    }
+
+  private:
+    void pad(size_t alignment)
+    {
+        size_t length = out_.size() - start_;
+        out_.append((alignment - length % alignment) % alignment, '\0');
+    }
+
+    std::string& out_;
+    size_t start_;
+    std::vector<FieldNode> nodes_;
+    std::vector<BufferSpec> buffers_;
+};
+
+// A field of the schema being read
+struct FieldType
+{
+    std::string name;
+    bool nullable = false;
+    uint8_t type = 0;
+    int32_t bit_width = 0;
+    bool is_signed = false;
+    int16_t precision = 0; // FloatingPoint: 0 half, 1 single, 2 double
+    int16_t unit = 0;      // Timestamp: 0 s, 1 ms, 2 us, 3 ns
+    std::vector<FieldType> children;
+};
+
+inline std::string describe(const FieldType& field)
+{
+    switch (field.type)
+    {
+    case Int:
+        return (field.is_signed ? "int" : "uint") + std::to_string(field.bit_width);
+    case FloatingPoint:
+        return field.precision == 0 ? "halffloat" : field.precision == 1 ? "float" : "double";
+    case Bool:
+        return "bool";
+    case Utf8:
+        return "utf8";
+    case LargeUtf8:
+        return "large_utf8";
+    case Timestamp:
+        return "timestamp";
+    case List:
+    case LargeList:
+        return std::string(field.type == List ? "list<" : "large_list<") +
+               (field.children.empty() ? "?" : describe(field.children[0])) + ">";
+    default:
+        return "type " + std::to_string(field.type);
+    }
+}
+
+// Reads the nodes and buffers of one record batch in schema order
+class BatchReader
+{
+  public:
+    BatchReader(const FlatTable& batch, std::string_view body, size_t body_offset)
+        : batch_(batch), body_(body), body_offset_(body_offset)
+    {
+        if (batch.has(3))
+            batch.fail("compressed record batches are not supported", 0);
+        nodes_ = batch.vector(1, sizeof(FieldNode));
+        buffers_ = batch.vector(2, sizeof(BufferSpec));
+        length_ = batch.get<int64_t>(0, 0);
+        if (length_ < 0)
+            batch.fail("negative record batch length", 0);
+    }
+
+    size_t length() const
+    {
+        return static_cast<size_t>(length_);
+    }
+
+    FieldNode node()
+    {
+        if (next_node_ == nodes_.second)
+            batch_.fail("record batch has fewer field nodes than the schema", 0);
+        const char* p = batch_.data(nodes_.first + next_node_++ * sizeof(FieldNode));
+        FieldNode node{load<int64_t>(p), load<int64_t>(p + 8)};
+        if (node.length < 0 || node.null_count < 0 || node.null_count > node.length)
+            batch_.fail("bad field node", 0);
+        return node;
+    }
+
+    std::string_view buffer()
+    {
+        if (next_buffer_ == buffers_.second)
+            batch_.fail("record batch has fewer buffers than the schema", 0);
+        const char* p = batch_.data(buffers_.first + next_buffer_++ * sizeof(BufferSpec));
+        int64_t offset = load<int64_t>(p);
+        int64_t length = load<int64_t>(p + 8);
+        if (offset < 0 || length < 0 || static_cast<uint64_t>(offset) > body_.size() ||
+            static_cast<uint64_t>(length) > body_.size() - static_cast<uint64_t>(offset))
+            throw parse_error("buffer outside the message body", body_offset_);
+        return body_.substr(static_cast<size_t>(offset), static_cast<size_t>(length));
+    }
+
+    // Buffer holding at least `size` bytes
+    std::string_view buffer(size_t size, const char* what)
+    {
+        std::string_view data = buffer();
+        if (data.size() < size)
+            fail(std::string(what) + " buffer too short");
+        return data;
+    }
+
+    // Consumes the nodes and buffers of a column the struct has no field for
+    void skip(const FieldType& field)
+    {
+        node();
+        size_t buffers = 0;
+        switch (field.type)
+        {
+        case Null:
+            break;
+        case Int:
+        case FloatingPoint:
+        case Bool:
+        case Decimal:
+        case Date:
+        case Time:
+        case Timestamp:
+        case Interval:
+        case FixedSizeBinary:
+        case Duration:
+        case List:
+        case LargeList:
+        case Map:
+            buffers = 2;
+            break;
+        case Binary:
+        case Utf8:
+        case LargeBinary:
+        case LargeUtf8:
+            buffers = 3;
+            break;
+        case Struct:
+        case FixedSizeList:
+            buffers = 1;
+            break;
+        default:
+            fail("cannot skip column '" + field.name + "' of " + describe(field));
+        }
+        for (size_t i = 0; i < buffers; ++i)
+            buffer();
+        for (const auto& child : field.children)
+            skip(child);
+    }
+
+    [[noreturn]] void fail(const std::string& what) const
+    {
+        throw parse_error(what, body_offset_);
+    }
+
+  private:
+    FlatTable batch_;
+    std::string_view body_;
+    size_t body_offset_;
+    std::pair<size_t, size_t> nodes_;
+    std::pair<size_t, size_t> buffers_;
+    size_t next_node_ = 0;
+    size_t next_buffer_ = 0;
+    int64_t length_ = 0;
+};
+
+// Offsets buffer of a Utf8 / List column (int32, or int64 for the Large types)
+class OffsetsView
+{
+  public:
+    OffsetsView(BatchReader& in, size_t length, bool large)
+        : width_(large ? 8 : 4), data_(in.buffer((length + 1) * (large ? 8 : 4), "offsets").data())
+    {
+    }
+
+    size_t operator[](size_t i) const
+    {
+        int64_t value = width_ == 8 ? load<int64_t>(data_ + i * 8) : load<int32_t>(data_ + i * 4);
+        return static_cast<size_t>(value);
+    }
+
+    // Checks that offsets [0, length] are ascending and end within limit
+    void check(BatchReader& in, size_t length, size_t limit) const
+    {
+        size_t previous = (*this)[0];
+        for (size_t i = 1; i <= length; ++i)
+        {
+            size_t next = (*this)[i];
+            if (next < previous)
+                in.fail("offsets are not ascending");
+            previous = next;
+        }
+        if (previous > limit)
+            in.fail("offsets run past the data");
+    }
+
+  private:
+    size_t width_;
+    const char* data_;
+};
+
+// ----------------------------------------------------------------
+// Column types
+//
+// Column<V> maps a (non-optional) member type to Arrow: its type table, the
+// buffers after the validity bitmap, and their decoding. `each(fn)` calls
+// fn(const V*) for every value in order, nullptr for nulls.
+// ----------------------------------------------------------------
+
+template <typename V> struct Column
+{
+    static_assert(dependent_false<V>, "meta::arrow: no Arrow type for this member type");
+};
+
+template <typename M> constexpr size_t column_nodes();
+template <typename M> constexpr size_t column_buffers();
+template <typename M> size_t build_field(FlatBuilder& b, std::string_view name);
+template <typename M, typename Each>
+void encode_column(BatchBuilder& b, size_t length, const Each& each, const M* contiguous);
+template <typename M> bool column_matches(const FieldType& field);
+template <typename M> std::string column_name();
+template <typename M> std::vector<M> decode_column(BatchReader& in, const FieldType& field, size_t length);
+
+template <typename V>
+    requires std::is_arithmetic_v<V> && (!std::is_same_v<V, bool>)
+struct Column<V>
+{
+    static constexpr size_t nodes = 1;
+    static constexpr size_t buffers = 2;
+    static constexpr uint8_t type_id = std::is_integral_v<V> ? Int : FloatingPoint;
+
+    static size_t type_table(FlatBuilder& b)
+    {
+        b.start_table();
+        if constexpr (std::is_integral_v<V>)
+        {
+            b.add<int32_t>(0, static_cast<int32_t>(sizeof(V) * 8));
+            b.add<uint8_t>(1, std::is_signed_v<V>);
+        }
+        else
+        {
+            static_assert(sizeof(V) == 4 || sizeof(V) == 8, "meta::arrow: unsupported floating-point type");
+            b.add<int16_t>(0, sizeof(V) == 4 ? 1 : 2);
+        }
+        return b.end_table();
+    }
+
+    static size_t children(FlatBuilder& b)
+    {
+        return b.offsets({});
+    }
+
+    static bool matches(const FieldType& field)
+    {
+        if constexpr (std::is_integral_v<V>)
+            return field.type == Int && field.bit_width == static_cast<int32_t>(sizeof(V) * 8) &&
+                   field.is_signed == std::is_signed_v<V>;
+        else
+            return field.type == FloatingPoint && field.precision == (sizeof(V) == 4 ? 1 : 2);
+    }
+
+    static std::string name()
+    {
+        if constexpr (std::is_integral_v<V>)
+            return (std::is_signed_v<V> ? "int" : "uint") + std::to_string(sizeof(V) * 8);
+        else
+            return sizeof(V) == 4 ? "float" : "double";
+    }
+
+    template <typename Each> static void encode(BatchBuilder& b, size_t length, const Each& each, const V* contiguous)
+    {
+        char* out = b.buffer(length * sizeof(V));
+        if (contiguous)
+        {
+            std::memcpy(out, contiguous, length * sizeof(V));
+            return;
+        }
+        each(
+            [&](const V* value)
+            {
+                if (value)
+                    store(out, *value);
+                out += sizeof(V);
+            });
+    }
+
+    static void decode(BatchReader& in, const FieldType&, size_t length, std::vector<V>& out)
+    {
+        std::string_view data = in.buffer(length * sizeof(V), "values");
+        out.resize(length);
+        if (length != 0)
+            std::memcpy(out.data(), data.data(), length * sizeof(V));
+    }
+};
+
+template <> struct Column<bool>
+{
+    static constexpr size_t nodes = 1;
+    static constexpr size_t buffers = 2;
+    static constexpr uint8_t type_id = Bool;
+
+    static size_t type_table(FlatBuilder& b)
+    {
+        b.start_table();
+        return b.end_table();
+    }
+
+    static size_t children(FlatBuilder& b)
+    {
+        return b.offsets({});
+    }
+
+    static bool matches(const FieldType& field)
+    {
+        return field.type == Bool;
+    }
+
+    static std::string name()
+    {
+        return "bool";
+    }
+
+    template <typename Each> static void encode(BatchBuilder& b, size_t length, const Each& each, const bool*)
+    {
+        unsigned char* bits = reinterpret_cast<unsigned char*>(b.buffer((length + 7) / 8));
+        size_t i = 0;
+        each(
+            [&](const bool* value)
+            {
+                if (value && *value)
+                    bits[i >> 3] = static_cast<unsigned char>(bits[i >> 3] | (1u << (i & 7)));
+                ++i;
+            });
+    }
+
+    static void decode(BatchReader& in, const FieldType&, size_t length, std::vector<bool>& out)
+    {
+        const char* bits = in.buffer((length + 7) / 8, "values").data();
+        out.resize(length);
+        for (size_t i = 0; i < length; ++i)
+            out[i] = (static_cast<unsigned char>(bits[i >> 3]) >> (i & 7)) & 1;
+    }
+};
+
+template <> struct Column<std::string>
+{
+    static constexpr size_t nodes = 1;
+    static constexpr size_t buffers = 3;
+    static constexpr uint8_t type_id = Utf8;
+
+    static size_t type_table(FlatBuilder& b)
+    {
+        b.start_table();
+        return b.end_table();
+    }
+
+    static size_t children(FlatBuilder& b)
+    {
+        return b.offsets({});
+    }
+
+    static bool matches(const FieldType& field)
+    {
+        return field.type == Utf8 || field.type == LargeUtf8;
+    }
+
+    static std::string name()
+    {
+        return "utf8";
+    }
+
+    template <typename Each> static void encode(BatchBuilder& b, size_t length, const Each& each, const std::string*)
+    {
+        char* offsets = b.buffer((length + 1) * 4);
+        size_t total = 0;
+        store<int32_t>(offsets, 0);
+        each(
+            [&](const std::string* value)
+            {
+                if (value)
+                    total += value->size();
+                if (total > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+                    throw std::length_error("arrow: over 2 GiB of string data in one batch; lower batch_rows");
+                offsets += 4;
+                store<int32_t>(offsets, static_cast<int32_t>(total));
+            });
+
+        char* data = b.buffer(total);
+        each(
+            [&](const std::string* value)
+            {
+                if (value && !value->empty())
+                {
+                    std::memcpy(data, value->data(), value->size());
+                    data += value->size();
+                }
+            });
+    }
+
+    static void decode(BatchReader& in, const FieldType& field, size_t length, std::vector<std::string>& out)
+    {
+        OffsetsView offsets(in, length, field.type == LargeUtf8);
+        std::string_view data = in.buffer();
+        offsets.check(in, length, data.size());
+        out.resize(length);
+        for (size_t i = 0; i < length; ++i)
+            out[i].assign(data.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+};
+
+template <> struct Column<std::chrono::system_clock::time_point>
+{
+    using time_point = std::chrono::system_clock::time_point;
+    static constexpr size_t nodes = 1;
+    static constexpr size_t buffers = 2;
+    static constexpr uint8_t type_id = Timestamp;
+
+    static size_t type_table(FlatBuilder& b)
+    {
+        size_t timezone = b.string("UTC");
+        b.start_table();
+        b.add<int16_t>(0, 3); // NANOSECOND
+        b.add_offset(1, timezone);
+        return b.end_table();
+    }
+
+    static size_t children(FlatBuilder& b)
+    {
+        return b.offsets({});
+    }
+
+    static bool matches(const FieldType& field)
+    {
+        return field.type == Timestamp && field.unit >= 0 && field.unit <= 3;
+    }
+
+    static std::string name()
+    {
+        return "timestamp";
+    }
+
+    template <typename Each> static void encode(BatchBuilder& b, size_t length, const Each& each, const time_point*)
+    {
+        char* out = b.buffer(length * 8);
+        each(
+            [&](const time_point* value)
+            {
+                if (value)
+                    store<int64_t>(out, std::chrono::duration_cast<std::chrono::nanoseconds>(value->time_since_epoch()).count());
+                out += 8;
+            });
+    }
+
+    static void decode(BatchReader& in, const FieldType& field, size_t length, std::vector<time_point>& out)
+    {
+        static constexpr int64_t to_nanos[] = {1000000000, 1000000, 1000, 1};
+        const char* data = in.buffer(length * 8, "values").data();
+        out.resize(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            std::chrono::nanoseconds since(load<int64_t>(data + i * 8) * to_nanos[field.unit]);
+            out[i] = time_point(std::chrono::duration_cast<time_point::duration>(since));
+        }
+    }
+};
+
+template <typename E> struct Column<std::vector<E>>
+{
+    static constexpr size_t nodes = 1 + column_nodes<E>();
+    static constexpr size_t buffers = 2 + column_buffers<E>();
+    static constexpr uint8_t type_id = List;
+
+    static size_t type_table(FlatBuilder& b)
+    {
+        b.start_table();
+        return b.end_table();
+    }
+
+    static size_t children(FlatBuilder& b)
+    {
+        return b.offsets({build_field<E>(b, "item")});
+    }
+
+    static bool matches(const FieldType& field)
+    {
+        return (field.type == List || field.type == LargeList) && field.children.size() == 1 &&
+               column_matches<E>(field.children[0]);
+    }
+
+    static std::string name()
+    {
+        return "list<" + column_name<E>() + ">";
+    }
+
+    // Visits the elements of every list in order
+    template <typename Each> static auto elements(const Each& each)
+    {
+        return [&each](auto&& fn)
+        {
+            each(
+                [&](const std::vector<E>* list)
+                {
+                    if (!list)
+                        return;
+                    if constexpr (std::is_same_v<E, bool>)
+                    {
+                        for (bool element : *list)
+                            fn(&element);
+                    }
+                    else
+                    {
+                        for (const E& element : *list)
+                            fn(&element);
+                    }
+                });
+        };
+    }
+
+    template <typename Each>
+    static void encode(BatchBuilder& b, size_t length, const Each& each, const std::vector<E>*)
+    {
+        char* offsets = b.buffer((length + 1) * 4);
+        size_t total = 0;
+        store<int32_t>(offsets, 0);
+        each(
+            [&](const std::vector<E>* list)
+            {
+                if (list)
+                    total += list->size();
+                if (total > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+                    throw std::length_error("arrow: over 2^31 list elements in one batch; lower batch_rows");
+                offsets += 4;
+                store<int32_t>(offsets, static_cast<int32_t>(total));
+            });
+
+        encode_column<E>(b, total, elements(each), nullptr);
+    }
+
+    static void decode(BatchReader& in, const FieldType& field, size_t length, std::vector<std::vector<E>>& out)
+    {
+        OffsetsView offsets(in, length, field.type == LargeList);
+        size_t first = offsets[0];
+        size_t end = offsets[length];
+        if (end < first)
+            in.fail("offsets are not ascending");
+        std::vector<E> items = decode_column<E>(in, field.children[0], end);
+        offsets.check(in, length, items.size());
+
+        out.resize(length);
+        for (size_t i = 0; i < length; ++i)
+            out[i].assign(std::make_move_iterator(items.begin() + static_cast<std::ptrdiff_t>(offsets[i])),
+                          std::make_move_iterator(items.begin() + static_cast<std::ptrdiff_t>(offsets[i + 1])));
+    }
+};
+
+// ----------------------------------------------------------------
+// Members: Column<V> plus the field node and validity bitmap, where
+// std::optional<V> is the nullable form of V
+// ----------------------------------------------------------------
+
+template <typename M> constexpr size_t column_nodes()
+{
+    return Column<typename unwrap_optional<M>::type>::nodes;
+}
+
+template <typename M> constexpr size_t column_buffers()
+{
+    return Column<typename unwrap_optional<M>::type>::buffers;
+}
+
+template <typename M> bool column_matches(const FieldType& field)
+{
+    return Column<typename unwrap_optional<M>::type>::matches(field);
+}
+
+template <typename M> std::string column_name()
+{
+    return Column<typename unwrap_optional<M>::type>::name();
+}
+
+template <typename M> size_t build_field(FlatBuilder& b, std::string_view name)
+{
+    using V = typename unwrap_optional<M>::type;
+    size_t name_offset = b.string(name);
+    size_t type_offset = Column<V>::type_table(b);
+    size_t children = Column<V>::children(b);
+
+    b.start_table();
+    b.add_offset(0, name_offset);
+    b.add<uint8_t>(1, is_optional<M>::value); // nullable
+    b.add<uint8_t>(2, Column<V>::type_id);
+    b.add_offset(3, type_offset);
+    b.add_offset(5, children);
+    return b.end_table();
+}
+
+template <typename M, typename Each>
+void encode_column(BatchBuilder& b, size_t length, const Each& each, const M* contiguous)
+{
+    if constexpr (is_optional<M>::value)
+    {
+        using V = typename M::value_type;
+        size_t nulls = 0;
+        each([&](const M* value) { nulls += !*value; });
+        b.node(length, nulls);
+
+        if (nulls == 0)
+            b.empty_buffer();
+        else
+        {
+            unsigned char* bits = reinterpret_cast<unsigned char*>(b.buffer((length + 7) / 8));
+            size_t i = 0;
+            each(
+                [&](const M* value)
+                {
+                    if (*value)
+                        bits[i >> 3] = static_cast<unsigned char>(bits[i >> 3] | (1u << (i & 7)));
+                    ++i;
+                });
+        }
+
+        auto values = [&each](auto&& fn) { each([&](const M* value) { fn(*value ? &**value : nullptr); }); };
+        Column<V>::encode(b, length, values, nullptr);
+    }
+    else
+    {
+        b.node(length, 0);
+        b.empty_buffer();
+        Column<M>::encode(b, length, each, contiguous);
+    }
+}
+
+template <typename M> std::vector<M> decode_column(BatchReader& in, const FieldType& field, size_t length)
+{
+    FieldNode node = in.node();
+    if (static_cast<size_t>(node.length) != length)
+        in.fail("column '" + field.name + "' has " + std::to_string(node.length) + " values, expected " +
+                std::to_string(length));
+    std::string_view validity = in.buffer();
+    if (node.null_count != 0 && validity.size() < (length + 7) / 8)
+        in.fail("column '" + field.name + "' validity bitmap too short");
+
+    if constexpr (is_optional<M>::value)
+    {
+        using V = typename M::value_type;
+        std::vector<V> values;
+        Column<V>::decode(in, field, length, values);
+        std::vector<M> out(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            bool valid = node.null_count == 0 || ((static_cast<unsigned char>(validity[i >> 3]) >> (i & 7)) & 1);
+            if (valid)
+                out[i] = std::move(values[i]);
+        }
+        return out;
+    }
+    else
+    {
+        if (node.null_count != 0)
+            in.fail("column '" + field.name + "' has nulls but its member is not std::optional");
+        std::vector<M> out;
+        Column<M>::decode(in, field, length, out);
+        return out;
+    }
+}
+
+// ----------------------------------------------------------------
+// Reflected structs
+// ----------------------------------------------------------------
+
+template <typename T>
+using Fields = std::remove_cvref_t<decltype(MetaTuple<T>::fields)>;
+
+template <typename T> inline constexpr size_t field_count = std::tuple_size_v<Fields<T>>;
+
+template <typename T, size_t I> using FieldMeta = std::remove_cvref_t<std::tuple_element_t<I, Fields<T>>>;
+
+template <typename T, size_t I> inline constexpr bool has_member = FieldMeta<T, I>::memberPtr != nullptr;
+
+template <typename T, size_t I> using Member = typename FieldMeta<T, I>::type;
+
+template <typename FieldMetaType> std::string_view field_name(const FieldMetaType& fieldMeta)
+{
+    if constexpr (requires { fieldMeta.fieldName; })
+        return fieldMeta.fieldName;
+    else
+        return fieldMeta.memberName;
+}
+
+template <typename T> constexpr size_t batch_nodes()
+{
+    return []<size_t... I>(std::index_sequence<I...>)
+    {
+        return (size_t{0} + ... + (has_member<T, I> ? column_nodes<Member<T, I>>() : 0));
+    }(std::make_index_sequence<field_count<T>>{});
+}
+
+template <typename T> constexpr size_t batch_buffers()
+{
+    return []<size_t... I>(std::index_sequence<I...>)
+    {
+        return (size_t{0} + ... + (has_member<T, I> ? column_buffers<Member<T, I>>() : 0));
+    }(std::make_index_sequence<field_count<T>>{});
+}
+
+template <typename T> size_t build_schema(FlatBuilder& b)
+{
+    std::vector<size_t> fields;
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (
+            [&]
+            {
+                if constexpr (has_member<T, I>)
+                    fields.push_back(build_field<Member<T, I>>(b, field_name(std::get<I>(MetaTuple<T>::fields))));
+            }(),
+            ...);
+    }(std::make_index_sequence<field_count<T>>{});
+
+    size_t vector = b.offsets(fields);
+    b.start_table();
+    b.add<int16_t>(0, 0); // little endian
+    b.add_offset(1, vector);
+    return b.end_table();
+}
+
+inline std::string message_metadata(FlatBuilder& b, uint8_t type, size_t header, size_t body_length)
+{
+    b.start_table();
+    b.add<int16_t>(0, metadata_v5);
+    b.add<uint8_t>(1, type);
+    b.add_offset(2, header);
+    b.add<int64_t>(3, static_cast<int64_t>(body_length));
+    return b.finish(b.end_table());
+}
+
+inline std::string batch_metadata(size_t length, const std::vector<FieldNode>& nodes,
+                                  const std::vector<BufferSpec>& buffers, size_t body_length)
+{
+    FlatBuilder b;
+    size_t node_vector = b.structs(nodes.data(), nodes.size(), sizeof(FieldNode), 8);
+    size_t buffer_vector = b.structs(buffers.data(), buffers.size(), sizeof(BufferSpec), 8);
+    b.start_table();
+    b.add<int64_t>(0, static_cast<int64_t>(length));
+    b.add_offset(1, node_vector);
+    b.add_offset(2, buffer_vector);
+    size_t batch = b.end_table();
+    return message_metadata(b, RecordBatchMessage, batch, body_length);
+}
+
+// Continuation marker, metadata length, metadata padded to 8 bytes
+inline void append_metadata(std::string& out, const std::string& metadata)
+{
+    size_t padded = (metadata.size() + 7) / 8 * 8;
+    char prefix[8];
+    store<uint32_t>(prefix, continuation);
+    store<int32_t>(prefix + 4, static_cast<int32_t>(padded));
+    out.append(prefix, 8);
+    out += metadata;
+    out.append(padded - metadata.size(), '\0');
+}
+
+struct Block
+{
+    int64_t offset;
+    int32_t metadata_length;
+    int32_t padding;
+    int64_t body_length;
+};
+
+// Field I of rows [first, first + count) as an `each` source, and the
+// column's contiguous values when there are any
+template <typename T, size_t I> auto field_source(const std::vector<T>& rows, size_t first, size_t count)
+{
+    using M = Member<T, I>;
+    auto each = [&rows, first, count](auto&& fn)
+    {
+        constexpr auto memberPtr = FieldMeta<T, I>::memberPtr;
+        for (size_t i = first; i < first + count; ++i)
+            fn(&(rows[i].*memberPtr));
+    };
+    return std::pair{each, static_cast<const M*>(nullptr)};
+}
+
+template <typename T, size_t I> auto field_source(const soa_vector<T>& rows, size_t first, size_t count)
+{
+    using M = Member<T, I>;
+    auto column = rows.template column<I>().subspan(first, count);
+    auto each = [column](auto&& fn)
+    {
+        for (const M& value : column)
+            fn(&value);
+    };
+    return std::pair{each, column.data()};
+}
+
+// Writes the stream or file framing around record batches; positions are
+// counted from the first byte written
+template <typename T> class Encoder
+{
+  public:
+    explicit Encoder(Format format) : format_(format)
+    {
+    }
+
+    void begin(std::string& out)
+    {
+        size_t start = out.size();
+        if (format_ == Format::File)
+        {
+            out.append(file_magic, sizeof(file_magic));
+            out.append(2, '\0');
+        }
+        FlatBuilder b;
+        size_t schema = build_schema<T>(b);
+        append_metadata(out, message_metadata(b, SchemaMessage, schema, 0));
+        position_ += out.size() - start;
+    }
+
+    template <typename Rows> void batch(std::string& out, const Rows& rows, size_t first, size_t count)
+    {
+        // Batch metadata has the same size for every batch of T: reserve it,
+        // encode the body after it, then fill it in
+        const size_t start = out.size();
+        const size_t prefix = batch_prefix();
+        out.resize(start + prefix);
+
+        BatchBuilder b(out);
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (
+                [&]
+                {
+                    if constexpr (has_member<T, I>)
+                    {
+                        auto [each, contiguous] = field_source<T, I>(rows, first, count);
+                        encode_column<Member<T, I>>(b, count, each, contiguous);
+                    }
+                }(),
+                ...);
+        }(std::make_index_sequence<field_count<T>>{});
+        size_t body = b.finish();
+
+        std::string metadata = batch_metadata(count, b.nodes(), b.buffers(), body);
+        if (metadata.size() + 8 > prefix)
+            throw std::logic_error("arrow: record batch metadata outgrew its reserved space");
+        char* p = out.data() + start;
+        store<uint32_t>(p, continuation);
+        store<int32_t>(p + 4, static_cast<int32_t>(prefix - 8));
+        std::memcpy(p + 8, metadata.data(), metadata.size());
+        std::memset(p + 8 + metadata.size(), 0, prefix - 8 - metadata.size());
+
+        blocks_.push_back({static_cast<int64_t>(position_), static_cast<int32_t>(prefix), 0,
+                           static_cast<int64_t>(body)});
+        position_ += out.size() - start;
+    }
+
+    void end(std::string& out)
+    {
+        char eos[8];
+        store<uint32_t>(eos, continuation);
+        store<int32_t>(eos + 4, 0);
+        out.append(eos, 8);
+        if (format_ != Format::File)
+            return;
+
+        FlatBuilder b;
+        size_t schema = build_schema<T>(b);
+        size_t dictionaries = b.structs(nullptr, 0, sizeof(Block), 8);
+        size_t batches = b.structs(blocks_.data(), blocks_.size(), sizeof(Block), 8);
+        b.start_table();
+        b.add<int16_t>(0, metadata_v5);
+        b.add_offset(1, schema);
+        b.add_offset(2, dictionaries);
+        b.add_offset(3, batches);
+        std::string footer = b.finish(b.end_table());
+
+        out += footer;
+        char length[4];
+        store<int32_t>(length, static_cast<int32_t>(footer.size()));
+        out.append(length, 4);
+        out.append(file_magic, sizeof(file_magic));
+    }
+
+  private:
+    static size_t batch_prefix()
+    {
+        static const size_t prefix = []
+        {
+            std::vector<FieldNode> nodes(batch_nodes<T>());
+            std::vector<BufferSpec> buffers(batch_buffers<T>());
+            return 8 + (batch_metadata(0, nodes, buffers, 0).size() + 7) / 8 * 8;
+        }();
+        return prefix;
+    }
+
+    Format format_;
+    size_t position_ = 0;
+    std::vector<Block> blocks_;
+};
+
+// ----------------------------------------------------------------
+// Reading
+// ----------------------------------------------------------------
+
+struct Message
+{
+    uint8_t type = 0; // 0: end of stream
+    std::optional<FlatTable> header;
+    std::string_view body;
+    size_t body_offset = 0;
+    size_t next = 0;
+};
+
+inline Message read_message(std::string_view bytes, size_t position)
+{
+    Message message;
+    if (position + 4 > bytes.size())
+    {
+        message.next = bytes.size(); // a stream may end without the marker
+        return message;
+    }
+    size_t metadata = position + 4;
+    uint32_t length = load<uint32_t>(bytes.data() + position);
+    if (length == continuation)
+    {
+        if (position + 8 > bytes.size())
+            throw parse_error("truncated message length", position);
+        length = load<uint32_t>(bytes.data() + position + 4);
+        metadata += 4;
+    }
+    if (length == 0)
+    {
+        message.next = metadata;
+        return message;
+    }
+    if (length > bytes.size() - metadata)
+        throw parse_error("truncated message metadata", position);
+
+    FlatTable root = FlatTable::root(bytes.substr(metadata, length), metadata);
+    message.type = root.get<uint8_t>(1, 0);
+    message.header = root.table(2);
+    if (!message.header)
+        throw parse_error("message without a header", position);
+    int64_t body = root.get<int64_t>(3, 0);
+    size_t body_start = metadata + length;
+    if (body < 0 || static_cast<uint64_t>(body) > bytes.size() - body_start)
+        throw parse_error("truncated message body", body_start);
+    message.body = bytes.substr(body_start, static_cast<size_t>(body));
+    message.body_offset = body_start;
+    message.next = body_start + static_cast<size_t>(body);
+    return message;
+}
+
+inline FieldType read_field(const FlatTable& table)
+{
+    FieldType field;
+    field.name = std::string(table.string(0));
+    field.nullable = table.get<uint8_t>(1, 0) != 0;
+    field.type = table.get<uint8_t>(2, 0);
+    if (table.has(4))
+        table.fail("dictionary-encoded column '" + field.name + "' is not supported", 0);
+    if (auto type = table.table(3))
+    {
+        if (field.type == Int)
+        {
+            field.bit_width = type->get<int32_t>(0, 0);
+            field.is_signed = type->get<uint8_t>(1, 0) != 0;
+        }
+        else if (field.type == FloatingPoint)
+            field.precision = type->get<int16_t>(0, 0);
+        else if (field.type == Timestamp)
+            field.unit = type->get<int16_t>(0, 0);
+    }
+    auto children = table.vector(5, 4);
+    for (size_t i = 0; i < children.second; ++i)
+        field.children.push_back(read_field(table.table_at(children, i)));
+    return field;
+}
+
+inline std::vector<FieldType> read_schema(const FlatTable& schema)
+{
+    if (schema.get<int16_t>(0, 0) != 0)
+        schema.fail("big-endian data is not supported", 0);
+    std::vector<FieldType> fields;
+    auto vector = schema.vector(1, 4);
+    for (size_t i = 0; i < vector.second; ++i)
+        fields.push_back(read_field(schema.table_at(vector, i)));
+    return fields;
+}
+
+// Decodes record batches into T, matching columns to fields by name
+template <typename T> class Decoder
+{
+  public:
+    explicit Decoder(std::vector<FieldType> schema) : schema_(std::move(schema))
+    {
+        column_of_.fill(none);
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (
+                [&]
+                {
+                    if constexpr (has_member<T, I>)
+                        bind<I>(field_name(std::get<I>(MetaTuple<T>::fields)));
+                }(),
+                ...);
+        }(std::make_index_sequence<field_count<T>>{});
+    }
+
+    void batch(const Message& message, std::vector<T>& out)
+    {
+        BatchReader in(*message.header, message.body, message.body_offset);
+        const size_t length = in.length();
+        const size_t first = out.size();
+        out.resize(first + length);
+
+        for (size_t column = 0; column < schema_.size(); ++column)
+        {
+            bool read = false;
+            [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                (
+                    [&]
+                    {
+                        if constexpr (has_member<T, I>)
+                        {
+                            if (column_of_[I] != column)
+                                return;
+                            constexpr auto memberPtr = FieldMeta<T, I>::memberPtr;
+                            auto values = decode_column<Member<T, I>>(in, schema_[column], length);
+                            for (size_t i = 0; i < length; ++i)
+                                out[first + i].*memberPtr = std::move(values[i]);
+                            read = true;
+                        }
+                    }(),
+                    ...);
+            }(std::make_index_sequence<field_count<T>>{});
+            if (!read)
+                in.skip(schema_[column]);
+        }
+    }
+
+  private:
+    static constexpr size_t none = static_cast<size_t>(-1);
+
+    template <size_t I> void bind(std::string_view name)
+    {
+        for (size_t column = 0; column < schema_.size(); ++column)
+        {
+            if (schema_[column].name != name)
+                continue;
+            if (!column_matches<Member<T, I>>(schema_[column]))
+                throw parse_error("column '" + std::string(name) + "' is " + describe(schema_[column]) +
+                                      ", expected " + column_name<Member<T, I>>(),
+                                  0);
+            column_of_[I] = column;
+            return;
+        }
+        throw parse_error("no column named '" + std::string(name) + "'", 0);
+    }
+
+    std::vector<FieldType> schema_;
+    std::array<size_t, field_count<T>> column_of_;
+};
+
+template <typename T> void parse_stream(std::string_view bytes, size_t position, std::vector<T>& out)
+{
+    Message schema = read_message(bytes, position);
+    if (schema.type != SchemaMessage)
+        throw parse_error("stream does not start with a schema", position);
+    Decoder<T> decoder(read_schema(*schema.header));
+
+    for (position = schema.next; position < bytes.size();)
+    {
+        Message message = read_message(bytes, position);
+        if (message.type == 0)
+            break;
+        if (message.type == DictionaryBatchMessage)
+            throw parse_error("dictionary batches are not supported", position);
+        if (message.type == RecordBatchMessage)
+            decoder.batch(message, out);
+        position = message.next;
+    }
+}
+
+template <typename T> void parse_file(std::string_view bytes, std::vector<T>& out)
+{
+    constexpr size_t trailer = 4 + sizeof(file_magic);
+    if (bytes.size() < 8 + trailer || std::memcmp(bytes.data() + bytes.size() - sizeof(file_magic), file_magic,
+                                                  sizeof(file_magic)) != 0)
+        throw parse_error("missing trailing ARROW1 magic", bytes.size());
+    int32_t length = load<int32_t>(bytes.data() + bytes.size() - trailer);
+    if (length <= 0 || static_cast<size_t>(length) > bytes.size() - 8 - trailer)
+        throw parse_error("bad footer length", bytes.size() - trailer);
+    size_t start = bytes.size() - trailer - static_cast<size_t>(length);
+
+    FlatTable footer = FlatTable::root(bytes.substr(start, static_cast<size_t>(length)), start);
+    auto schema = footer.table(1);
+    if (!schema)
+        footer.fail("footer without a schema", 0);
+    if (footer.vector(2, sizeof(Block)).second != 0)
+        footer.fail("dictionary batches are not supported", 0);
+    Decoder<T> decoder(read_schema(*schema));
+
+    auto blocks = footer.vector(3, sizeof(Block));
+    for (size_t i = 0; i < blocks.second; ++i)
+    {
+        int64_t offset = load<int64_t>(footer.data(blocks.first + i * sizeof(Block)));
+        if (offset < 0 || static_cast<uint64_t>(offset) >= start)
+            footer.fail("record batch block out of range", 0);
+        Message message = read_message(bytes, static_cast<size_t>(offset));
+        if (message.type != RecordBatchMessage)
+            throw parse_error("block is not a record batch", static_cast<size_t>(offset));
+        decoder.batch(message, out);
+    }
+}
+
+} // namespace detail
+
+// ================================================================
+// Public API
+// ================================================================
+
+namespace detail
+{
+
+template <typename T, typename Rows> void serialize_rows(std::string& out, const Rows& rows, Format format, size_t batch_rows)
+{
+    Encoder<T> encoder(format);
+    encoder.begin(out);
+    batch_rows = batch_rows == 0 ? default_batch_rows : batch_rows;
+    for (size_t first = 0; first < rows.size(); first += batch_rows)
+        encoder.batch(out, rows, first, std::min(batch_rows, rows.size() - first));
+    encoder.end(out);
+}
+
+} // namespace detail
+
+// Appends Arrow IPC for the rows, in record batches of batch_rows; reusing
+// out across calls keeps its capacity
+template <typename T>
+void serialize_to(std::string& out, const std::vector<T>& rows, Format format = Format::Stream,
+                  size_t batch_rows = default_batch_rows)
+{
+    detail::serialize_rows<T>(out, rows, format, batch_rows);
+}
+
+// Same bytes, encoded from the columns
+template <typename T>
+void serialize_to(std::string& out, const soa_vector<T>& rows, Format format = Format::Stream,
+                  size_t batch_rows = default_batch_rows)
+{
+    detail::serialize_rows<T>(out, rows, format, batch_rows);
+}
+
+template <typename T>
+std::string serialize(const std::vector<T>& rows, Format format = Format::Stream,
+                      size_t batch_rows = default_batch_rows)
+{
+    std::string out;
+    serialize_to(out, rows, format, batch_rows);
+    return out;
+}
+
+template <typename T>
+std::string serialize(const soa_vector<T>& rows, Format format = Format::Stream,
+                      size_t batch_rows = default_batch_rows)
+{
+    std::string out;
+    serialize_to(out, rows, format, batch_rows);
+    return out;
+}
+
+// Appends the record batches of bytes (stream or file format) to out
+template <typename T> void parse(std::string_view bytes, std::vector<T>& out)
+{
+    if (bytes.size() >= 8 && std::memcmp(bytes.data(), detail::file_magic, sizeof(detail::file_magic)) == 0)
+        detail::parse_file(bytes, out);
+    else
+        detail::parse_stream(bytes, 0, out);
+}
+
+template <typename T> std::vector<T> parse(std::string_view bytes)
+{
+    std::vector<T> out;
+    parse(bytes, out);
+    return out;
+}
+
+// ================================================================
+// Streaming writer
+//
+// writer<T> collects batch_rows records and writes each batch to a
+// meta::Sink as one record batch, so an export of any size holds one
+// batch of rows. The bytes match serialize() with the same batch_rows.
+//
+// Usage:
+//   meta::arrow::writer<Row> out(meta::Sink::file("rows.arrow"), meta::arrow::Format::File);
+//   for (const Row& row : rows)
+//       out.write(row);
+//   out.close();   // the end-of-stream marker (and the file footer)
+// ================================================================
+
+template <typename T> class writer
+{
+  public:
+    explicit writer(meta::Sink sink, Format format = Format::Stream, size_t batch_rows = default_batch_rows)
+        : sink_(std::move(sink)), encoder_(format), batch_rows_(batch_rows == 0 ? default_batch_rows : batch_rows)
+    {
+        encoder_.begin(sink_.buffer());
+        pending_.reserve(batch_rows_);
+    }
+
+    ~writer()
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    writer(const writer&) = delete;
+    writer& operator=(const writer&) = delete;
+
+    void write(const T& row)
+    {
+        if (closed_)
+            throw std::logic_error("arrow: write after close");
+        pending_.push_back(row);
+        ++count_;
+        if (pending_.size() == batch_rows_)
+            flush_batch();
+    }
+
+    // Writes every row of a range or generator (rows may be pointers); returns the count
+    template <typename Range> size_t write_all(Range&& rows)
+    {
+        return meta::write_rows(*this, std::forward<Range>(rows));
+    }
+
+    // Writes the last batch and the end of the stream, flushes and releases the sink
+    void close()
+    {
+        if (closed_)
+            return;
+        closed_ = true;
+        flush_batch();
+        encoder_.end(sink_.buffer());
+        sink_.close();
+    }
+
+    size_t count() const
+    {
+        return count_;
+    }
+
+  private:
+    void flush_batch()
+    {
+        if (pending_.empty())
+            return;
+        encoder_.batch(sink_.buffer(), pending_, 0, pending_.size());
+        pending_.clear();
+        sink_.commit();
+    }
+
+    meta::Sink sink_;
+    detail::Encoder<T> encoder_;
+    size_t batch_rows_;
+    std::vector<T> pending_;
+    size_t count_ = 0;
+    bool closed_ = false;
+};
+
+} // namespace arrow
+} // namespace meta
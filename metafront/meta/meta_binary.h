@@ -0,0 +1,810 @@
+/*
+ * ================================================================
+ * COMPACT BINARY FORMAT
+ *
+ * Reflection-driven binary codec for IPC and caches, where both ends
+ * are built from the same structs:
+ * - header: magic "MTB1" and a 64-bit schema hash of the top-level type
+ * - scalars: fixed-width little-endian (bool is one byte, enums their
+ *   underlying integer)
+ * - std::string: u32 byte length + bytes
+ * - std::vector: u32 element count + elements; vectors of numbers, and
+ *   of reflected structs whose fields are all numbers laid out without
+ *   padding, are copied in bulk (one memcpy on little-endian hosts)
+ * - std::optional: one presence byte + the value when set
+ * - reflected structs: their fields in MetaTuple order, no framing
+ *
+ * The schema hash covers field names and type shapes, recursively, so
+ * parse() rejects data written from a different struct layout instead of
+ * misreading it. It is a constant expression when the fields are
+ * StaticField (metafront --static-fields) and computed once otherwise.
+ *
+ * Zero-copy decoding: std::string_view members and array_view<T> members
+ * of the target point into the input buffer instead of owning a copy.
+ * They hash like std::string and std::vector<T>, so a view struct with
+ * the same field names reads data written from the owning struct. The
+ * input must outlive the decoded views.
+ *
+ * Usage:
+ *   std::string bytes = meta::binary::serialize(rows);       // std::vector<Row>
+ *   auto back = meta::binary::parse<std::vector<Row>>(bytes);
+ *   auto views = meta::binary::parse<std::vector<RowView>>(bytes);
+ * ================================================================
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace meta
+{
+namespace binary
+{
+
+class parse_error : public std::runtime_error
+{
+  public:
+    parse_error(const std::string& what, size_t offset)
+        : std::runtime_error("binary: " + what + " at offset " + std::to_string(offset)),
+          offset_(offset)
+    {
+    }
+
+    size_t offset() const
+    {
+        return offset_;
+    }
+
+  private:
+    size_t offset_;
+};
+
+inline constexpr char magic[4] = {'M', 'T', 'B', '1'};
+inline constexpr size_t header_size = sizeof(magic) + sizeof(uint64_t);
+
+// Read-only array of T over encoded bytes (no copy, no alignment needed):
+// elements are loaded on access
+template <typename T> class array_view
+{
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                  "array_view holds numbers");
+
+  public:
+    using value_type = T;
+
+    class iterator
+    {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = T;
+
+        iterator() = default;
+        explicit iterator(const char* p) : p_(p)
+        {
+        }
+
+        T operator*() const
+        {
+            return load(p_);
+        }
+        T operator[](difference_type n) const
+        {
+            return load(p_ + n * static_cast<difference_type>(sizeof(T)));
+        }
+        iterator& operator++()
+        {
+            p_ += sizeof(T);
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+        iterator& operator--()
+        {
+            p_ -= sizeof(T);
+            return *this;
+        }
+        iterator operator--(int)
+        {
+            iterator old = *this;
+            --*this;
+            return old;
+        }
+        iterator& operator+=(difference_type n)
+        {
+            p_ += n * static_cast<difference_type>(sizeof(T));
+            return *this;
+        }
+        iterator& operator-=(difference_type n)
+        {
+            return *this += -n;
+        }
+        friend iterator operator+(iterator it, difference_type n)
+        {
+            return it += n;
+        }
+        friend iterator operator+(difference_type n, iterator it)
+        {
+            return it += n;
+        }
+        friend iterator operator-(iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+        friend difference_type operator-(const iterator& a, const iterator& b)
+        {
+            return (a.p_ - b.p_) / static_cast<difference_type>(sizeof(T));
+        }
+        friend bool operator==(const iterator& a, const iterator& b) = default;
+        friend auto operator<=>(const iterator& a, const iterator& b) = default;
+
+      private:
+        const char* p_ = nullptr;
+    };
+
+    array_view() = default;
+    array_view(const char* data, size_t size) : data_(data), size_(size)
+    {
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+    T operator[](size_t i) const
+    {
+        return load(data_ + i * sizeof(T));
+    }
+    iterator begin() const
+    {
+        return iterator(data_);
+    }
+    iterator end() const
+    {
+        return iterator(data_ + size_ * sizeof(T));
+    }
+
+    // The encoded (little-endian) bytes
+    std::string_view bytes() const
+    {
+        return {data_, size_ * sizeof(T)};
+    }
+
+    std::vector<T> to_vector() const
+    {
+        return std::vector<T>(begin(), end());
+    }
+
+  private:
+    static T load(const char* p)
+    {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1)
+        {
+            auto* bytes = reinterpret_cast<unsigned char*>(&value);
+            for (size_t i = 0; i < sizeof(T) / 2; ++i)
+                std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+        }
+        return value;
+    }
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+namespace detail
+{
+
+template <typename> inline constexpr bool dependent_false = false;
+
+template <typename T> struct is_vector : std::false_type
+{
+};
+template <typename T, typename A> struct is_vector<std::vector<T, A>> : std::true_type
+{
+};
+
+template <typename T> struct is_optional : std::false_type
+{
+};
+template <typename T> struct is_optional<std::optional<T>> : std::true_type
+{
+};
+
+template <typename T> struct is_array_view : std::false_type
+{
+};
+template <typename T> struct is_array_view<array_view<T>> : std::true_type
+{
+};
+
+template <typename T>
+concept Message = requires { meta::MetaTuple<T>::fields; };
+
+template <typename T>
+concept Number = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+template <typename FieldMeta> constexpr std::string_view member_name(const FieldMeta& fieldMeta)
+{
+    if constexpr (requires { fieldMeta.fieldName; })
+        return fieldMeta.fieldName;
+    else
+        return fieldMeta.memberName;
+}
+
+// ----------------------------------------------------------------
+// Schema hash (FNV-1a over names and type shapes)
+// ----------------------------------------------------------------
+
+struct Hasher
+{
+    uint64_t value = 14695981039346656037ull;
+
+    constexpr void add(std::string_view text)
+    {
+        for (char c : text)
+        {
+            value ^= static_cast<unsigned char>(c);
+            value *= 1099511628211ull;
+        }
+        value ^= 0xFF; // separator: "ab","c" differs from "a","bc"
+        value *= 1099511628211ull;
+    }
+};
+
+template <typename T> constexpr void hash_type(Hasher& h)
+{
+    if constexpr (std::is_same_v<T, bool>)
+        h.add("b");
+    else if constexpr (std::is_enum_v<T>)
+        hash_type<std::underlying_type_t<T>>(h);
+    else if constexpr (std::is_floating_point_v<T>)
+        h.add(sizeof(T) == 4 ? "f4" : sizeof(T) == 8 ? "f8" : "f16");
+    else if constexpr (std::is_integral_v<T>)
+    {
+        constexpr char sig[3] = {std::is_signed_v<T> ? 'i' : 'u', static_cast<char>('0' + sizeof(T)), 0};
+        h.add(sig);
+    }
+    else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+        h.add("s");
+    else if constexpr (is_vector<T>::value || is_array_view<T>::value)
+    {
+        h.add("v");
+        hash_type<typename T::value_type>(h);
+    }
+    else if constexpr (is_optional<T>::value)
+    {
+        h.add("o");
+        hash_type<typename T::value_type>(h);
+    }
+    else if constexpr (Message<T>)
+    {
+        h.add("{");
+        std::apply(
+            [&](const auto&... fieldMeta)
+            {
+                ((h.add(member_name(fieldMeta)),
+                  hash_type<typename std::remove_cvref_t<decltype(fieldMeta)>::type>(h)),
+                 ...);
+            },
+            meta::MetaTuple<T>::fields);
+        h.add("}");
+    }
+    else
+        static_assert(dependent_false<T>, "meta::binary: no encoding for this type");
+}
+
+// ----------------------------------------------------------------
+// Bulk copy
+// ----------------------------------------------------------------
+
+// Encoded form equals the in-memory form on little-endian hosts (bool and
+// enums are excluded: not every byte pattern is a valid value)
+template <typename T>
+inline constexpr bool raw_number =
+    std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && std::endian::native == std::endian::little;
+
+// A reflected struct encodes as its raw bytes when it is trivially copyable,
+// every member is a raw number, and the members follow each other in field
+// order with no padding. Checked once per type.
+template <typename T> bool raw_struct()
+{
+    if constexpr (!std::is_trivially_copyable_v<T> || !std::is_default_constructible_v<T>)
+        return false;
+    else
+    {
+        static const bool raw = []
+        {
+            bool ok = true;
+            size_t expected = 0;
+            const T probe{};
+            const char* base = reinterpret_cast<const char*>(&probe);
+            std::apply(
+                [&](const auto&... fieldMeta)
+                {
+                    (
+                        [&](const auto& field)
+                        {
+                            using FieldMeta = std::remove_cvref_t<decltype(field)>;
+                            using M = typename FieldMeta::type;
+                            if constexpr (FieldMeta::memberPtr == nullptr || !raw_number<M>)
+                                ok = false;
+                            else if (ok)
+                            {
+                                auto offset = static_cast<size_t>(
+                                    reinterpret_cast<const char*>(&(probe.*(FieldMeta::memberPtr))) - base);
+                                ok = offset == expected;
+                                expected += sizeof(M);
+                            }
+                        }(fieldMeta),
+                        ...);
+                },
+                meta::MetaTuple<T>::fields);
+            return ok && expected == sizeof(T);
+        }();
+        return raw;
+    }
+}
+
+template <typename T> bool raw_element()
+{
+    if constexpr (raw_number<T>)
+        return true;
+    else if constexpr (Message<T>)
+        return raw_struct<T>();
+    else
+        return false;
+}
+
+// Smallest encoding of a T (guards element counts read from the input)
+template <typename T> constexpr size_t min_size()
+{
+    if constexpr (Number<T>)
+        return sizeof(T);
+    else if constexpr (is_optional<T>::value)
+        return 1;
+    else if constexpr (Message<T>)
+    {
+        return std::apply([](const auto&... fieldMeta)
+                          { return (size_t{0} + ... + min_size<typename std::remove_cvref_t<decltype(fieldMeta)>::type>()); },
+                          meta::MetaTuple<T>::fields);
+    }
+    else
+        return 4; // strings and vectors: the length prefix
+}
+
+// ----------------------------------------------------------------
+// Encoding
+// ----------------------------------------------------------------
+
+template <typename T> void store(char* p, T value)
+{
+    if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1)
+    {
+        auto* bytes = reinterpret_cast<unsigned char*>(&value);
+        for (size_t i = 0; i < sizeof(T) / 2; ++i)
+            std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+    }
+    std::memcpy(p, &value, sizeof(T));
+}
+
+template <typename T> T load(const char* p)
+{
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1)
+    {
+        auto* bytes = reinterpret_cast<unsigned char*>(&value);
+        for (size_t i = 0; i < sizeof(T) / 2; ++i)
+            std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+    }
+    return value;
+}
+
+inline uint32_t length_prefix(size_t size)
+{
+    if (size > std::numeric_limits<uint32_t>::max())
+        throw std::length_error("binary: string or vector longer than 2^32-1");
+    return static_cast<uint32_t>(size);
+}
+
+class Writer
+{
+  public:
+    Writer(char* data, size_t size) : begin_(data), p_(data), end_(data + size)
+    {
+    }
+
+    size_t written() const
+    {
+        return static_cast<size_t>(p_ - begin_);
+    }
+
+    template <typename T> void number(T value)
+    {
+        need(sizeof(T));
+        store(p_, value);
+        p_ += sizeof(T);
+    }
+
+    void bytes(const void* data, size_t size)
+    {
+        need(size);
+        if (size != 0)
+            std::memcpy(p_, data, size);
+        p_ += size;
+    }
+
+  private:
+    void need(size_t size)
+    {
+        if (static_cast<size_t>(end_ - p_) < size)
+            throw std::length_error("binary: output buffer too small");
+    }
+
+    char* begin_;
+    char* p_;
+    char* end_;
+};
+
+template <typename T> size_t value_size(const T& value);
+
+template <typename T> size_t message_size(const T& obj)
+{
+    size_t size = 0;
+    std::apply(
+        [&](const auto&... fieldMeta)
+        {
+            (
+                [&](const auto& field)
+                {
+                    using FieldMeta = std::remove_cvref_t<decltype(field)>;
+                    if constexpr (FieldMeta::memberPtr != nullptr)
+                        size += value_size(obj.*(FieldMeta::memberPtr));
+                    else
+                        size += min_size<typename FieldMeta::type>();
+                }(fieldMeta),
+                ...);
+        },
+        meta::MetaTuple<T>::fields);
+    return size;
+}
+
+template <typename T> size_t value_size(const T& value)
+{
+    if constexpr (std::is_same_v<T, bool>)
+        return 1;
+    else if constexpr (Number<T>)
+        return sizeof(T);
+    else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+        return 4 + value.size();
+    else if constexpr (is_array_view<T>::value)
+        return 4 + value.bytes().size();
+    else if constexpr (is_vector<T>::value)
+    {
+        using E = typename T::value_type;
+        if constexpr (Number<E>)
+            return 4 + value.size() * sizeof(E);
+        else
+        {
+            if (!value.empty() && raw_element<E>())
+                return 4 + value.size() * sizeof(E);
+            size_t size = 4;
+            for (const auto& element : value)
+                size += value_size(element);
+            return size;
+        }
+    }
+    else if constexpr (is_optional<T>::value)
+        return 1 + (value ? value_size(*value) : 0);
+    else if constexpr (Message<T>)
+        return message_size(value);
+    else
+        static_assert(dependent_false<T>, "meta::binary: no encoding for this type");
+}
+
+template <typename T> void write_value(Writer& out, const T& value);
+
+template <typename T> void write_message(Writer& out, const T& obj)
+{
+    std::apply(
+        [&](const auto&... fieldMeta)
+        {
+            (
+                [&](const auto& field)
+                {
+                    using FieldMeta = std::remove_cvref_t<decltype(field)>;
+                    if constexpr (FieldMeta::memberPtr != nullptr)
+                        write_value(out, obj.*(FieldMeta::memberPtr));
+                    else
+                        write_value(out, typename FieldMeta::type{});
+                }(fieldMeta),
+                ...);
+        },
+        meta::MetaTuple<T>::fields);
+}
+
+template <typename T> void write_value(Writer& out, const T& value)
+{
+    if constexpr (std::is_same_v<T, bool>)
+        out.number<uint8_t>(value ? 1 : 0);
+    else if constexpr (std::is_enum_v<T>)
+        out.number(static_cast<std::underlying_type_t<T>>(value));
+    else if constexpr (Number<T>)
+        out.number(value);
+    else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+    {
+        out.number(length_prefix(value.size()));
+        out.bytes(value.data(), value.size());
+    }
+    else if constexpr (is_array_view<T>::value)
+    {
+        out.number(length_prefix(value.size()));
+        out.bytes(value.bytes().data(), value.bytes().size());
+    }
+    else if constexpr (is_vector<T>::value)
+    {
+        using E = typename T::value_type;
+        out.number(length_prefix(value.size()));
+        if constexpr (std::is_trivially_copyable_v<E> && !std::is_same_v<E, bool>)
+        {
+            if (!value.empty() && raw_element<E>())
+            {
+                out.bytes(value.data(), value.size() * sizeof(E));
+                return;
+            }
+        }
+        for (const auto& element : value)
+            write_value(out, element);
+    }
+    else if constexpr (is_optional<T>::value)
+    {
+        out.number<uint8_t>(value ? 1 : 0);
+        if (value)
+            write_value(out, *value);
+    }
+    else if constexpr (Message<T>)
+        write_message(out, value);
+    else
+        static_assert(dependent_false<T>, "meta::binary: no encoding for this type");
+}
+
+// ----------------------------------------------------------------
+// Decoding
+// ----------------------------------------------------------------
+
+class Reader
+{
+  public:
+    Reader(const char* begin, const char* end) : begin_(begin), p_(begin), end_(end)
+    {
+    }
+
+    size_t offset() const
+    {
+        return static_cast<size_t>(p_ - begin_);
+    }
+
+    size_t remaining() const
+    {
+        return static_cast<size_t>(end_ - p_);
+    }
+
+    [[noreturn]] void fail(const std::string& what) const
+    {
+        throw parse_error(what, offset());
+    }
+
+    template <typename T> T number()
+    {
+        return load<T>(take(sizeof(T)));
+    }
+
+    const char* take(size_t size)
+    {
+        if (remaining() < size)
+            fail("unexpected end of input");
+        const char* data = p_;
+        p_ += size;
+        return data;
+    }
+
+    // Element count, checked against what is left of the input
+    size_t count(size_t minElement)
+    {
+        size_t n = number<uint32_t>();
+        if (minElement != 0 && n > remaining() / minElement)
+            fail("element count past end of input");
+        return n;
+    }
+
+  private:
+    const char* begin_;
+    const char* p_;
+    const char* end_;
+};
+
+template <typename T> void read_value(Reader& in, T& value);
+
+template <typename T> void read_message(Reader& in, T& obj)
+{
+    std::apply(
+        [&](const auto&... fieldMeta)
+        {
+            (
+                [&](const auto& field)
+                {
+                    using FieldMeta = std::remove_cvref_t<decltype(field)>;
+                    if constexpr (FieldMeta::memberPtr != nullptr)
+                        read_value(in, obj.*(FieldMeta::memberPtr));
+                    else
+                    {
+                        typename FieldMeta::type skipped{};
+                        read_value(in, skipped);
+                    }
+                }(fieldMeta),
+                ...);
+        },
+        meta::MetaTuple<T>::fields);
+}
+
+template <typename T> void read_value(Reader& in, T& value)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        auto byte = in.number<uint8_t>();
+        if (byte > 1)
+            in.fail("bad bool");
+        value = byte != 0;
+    }
+    else if constexpr (std::is_enum_v<T>)
+        value = static_cast<T>(in.number<std::underlying_type_t<T>>());
+    else if constexpr (Number<T>)
+        value = in.number<T>();
+    else if constexpr (std::is_same_v<T, std::string>)
+    {
+        size_t size = in.number<uint32_t>();
+        value.assign(in.take(size), size);
+    }
+    else if constexpr (std::is_same_v<T, std::string_view>)
+    {
+        size_t size = in.number<uint32_t>();
+        value = std::string_view(in.take(size), size);
+    }
+    else if constexpr (is_array_view<T>::value)
+    {
+        using E = typename T::value_type;
+        size_t n = in.count(sizeof(E));
+        value = T(in.take(n * sizeof(E)), n);
+    }
+    else if constexpr (is_vector<T>::value)
+    {
+        using E = typename T::value_type;
+        size_t n = in.count(min_size<E>());
+        value.clear();
+        if constexpr (std::is_trivially_copyable_v<E> && !std::is_same_v<E, bool>)
+        {
+            if (n != 0 && raw_element<E>())
+            {
+                const char* data = in.take(n * sizeof(E));
+                value.resize(n);
+                std::memcpy(value.data(), data, n * sizeof(E));
+                return;
+            }
+        }
+        value.resize(n);
+        if constexpr (std::is_same_v<E, bool>)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                bool element;
+                read_value(in, element);
+                value[i] = element;
+            }
+        }
+        else
+        {
+            for (auto& element : value)
+                read_value(in, element);
+        }
+    }
+    else if constexpr (is_optional<T>::value)
+    {
+        auto present = in.number<uint8_t>();
+        if (present > 1)
+            in.fail("bad optional flag");
+        if (present)
+            read_value(in, value.emplace());
+        else
+            value.reset();
+    }
+    else if constexpr (Message<T>)
+        read_message(in, value);
+    else
+        static_assert(dependent_false<T>, "meta::binary: no encoding for this type");
+}
+
+} // namespace detail
+
+// Hash of T's field names and type shapes, written in the header
+template <typename T> constexpr uint64_t schema_hash()
+{
+    detail::Hasher h;
+    detail::hash_type<T>(h);
+    return h.value;
+}
+
+// Encoded size of value, header included
+template <typename T> size_t byte_size(const T& value)
+{
+    return header_size + detail::value_size(value);
+}
+
+// Encodes value into out without allocating and returns the bytes written;
+// throws std::length_error when out is smaller than byte_size(value)
+template <typename T> size_t serialize_to(const T& value, std::span<char> out)
+{
+    static const uint64_t hash = schema_hash<T>();
+    detail::Writer writer(out.data(), out.size());
+    writer.bytes(magic, sizeof(magic));
+    writer.number(hash);
+    detail::write_value(writer, value);
+    return writer.written();
+}
+
+template <typename T> std::string serialize(const T& value)
+{
+    std::string out(byte_size(value), '\0');
+    serialize_to(value, std::span<char>(out.data(), out.size()));
+    return out;
+}
+
+// Decodes bytes into out. string_view and array_view members of out point
+// into bytes.
+template <typename T> void parse(std::string_view bytes, T& out)
+{
+    static const uint64_t hash = schema_hash<T>();
+    detail::Reader in(bytes.data(), bytes.data() + bytes.size());
+    if (std::memcmp(in.take(sizeof(magic)), magic, sizeof(magic)) != 0)
+        throw parse_error("not meta::binary data", 0);
+    if (in.number<uint64_t>() != hash)
+        throw parse_error("schema hash mismatch", sizeof(magic));
+    detail::read_value(in, out);
+    if (in.remaining() != 0)
+        in.fail("trailing bytes");
+}
+
+template <typename T> T parse(std::string_view bytes)
+{
+    T out{};
+    parse(bytes, out);
+    return out;
+}
+
+} // namespace binary
+} // namespace meta
@@ -5,103 +5,230 @@
 #include <vector>
 #include <cstring>
 #include <optional>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <exception>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "meta_escape.h"
+#include "meta_generator.h"
+#include "meta_parallel.h"
+#include "meta_sink.h"
+#include "meta_soa.h"
 
 namespace meta {
 namespace csv {
 
-// Helper to write CSV values with proper escaping
+// Helper to get CSV column name from mapping (a constant for StaticField)
+template<typename FieldMeta>
+constexpr std::string_view getCSVColumnName(const FieldMeta& fieldMeta) {
+    if constexpr (requires { FieldMeta::csvColumn; }) {
+        return FieldMeta::csvColumn;
+    } else {
+        // Check if csv_column exists in mapping
+        if (const std::string* column = fieldMeta.findAttribute(CSV_COLUMN)) {
+            return *column;
+        }
+        // Fall back to fieldName
+        return fieldMeta.fieldName;
+    }
+}
+
+// Helper to check if field should be skipped (always false for now, can be extended)
+template<typename FieldMeta>
+bool shouldSkipField(const FieldMeta& fieldMeta) {
+    // Could check for special properties or annotations in the future
+    return false;
+}
+
+namespace detail {
+
 template<typename T>
-void writeCSVValue(std::ostringstream& os, const T& value) {
+inline constexpr bool is_character_v =
+    std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>;
+
+}
+
+// True when a field must be quoted: it holds a quote, a line end or the delimiter
+inline bool needsCSVQuotes(std::string_view str, std::string_view delimiter) {
+    static constexpr meta::escape::CharSet commaQuoteLine(",\"\n\r");
+    static constexpr meta::escape::CharSet quoteLine("\"\n\r");
+    if (delimiter == ",")
+        return meta::escape::contains_any(str, commaQuoteLine);
+    return meta::escape::contains_any(str, quoteLine) ||
+           (!delimiter.empty() && str.find(delimiter) != std::string_view::npos);
+}
+
+// One CSV value onto a std::string without a stream per value. A char is
+// written as a one-character string, so the delimiter, '"' and line ends are
+// quoted.
+// Integers and floating point go through std::to_chars; floating point uses
+// the shortest form that std::from_chars reads back to the same value.
+template<typename T>
+void appendCSVValue(std::string& out, const T& value, std::string_view delimiter = ",") {
+    if constexpr (std::is_same_v<T, std::string>) {
+        static constexpr meta::escape::CharSet quote("\"");
+
+        if (needsCSVQuotes(value, delimiter)) {
+            out += '"';
+            meta::escape::append_escaped(out, value, quote, [](std::string& s, char) { s += "\"\""; });
+            out += '"';
+        } else {
+            out += value;
+        }
+    } else if constexpr (std::is_same_v<T, bool>) {
+        out += value ? '1' : '0';
+    } else if constexpr (detail::is_character_v<T>) {
+        appendCSVValue(out, std::string(1, static_cast<char>(value)), delimiter);
+    } else if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(long long) &&
+                         !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char8_t> &&
+                         !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>) {
+        char buf[24];
+        auto result = std::to_chars(buf, buf + sizeof(buf), value);
+        out.append(buf, result.ptr);
+    } else if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+        char buf[32];
+        auto result = std::to_chars(buf, buf + sizeof(buf), value);
+        out.append(buf, result.ptr);
+    } else {
+        std::ostringstream os;
+        os << value;
+        out += os.str();
+    }
+}
+
+// Helper to write CSV values with proper escaping (same bytes as appendCSVValue)
+template<typename T>
+void writeCSVValue(std::ostringstream& os, const T& value, std::string_view delimiter = ",") {
     if constexpr (std::is_same_v<T, std::string>) {
+        static constexpr meta::escape::CharSet quote("\"");
+
         const std::string& str = value;
-        if (str.find(',') != std::string::npos || 
-            str.find('"') != std::string::npos || 
-            str.find('\n') != std::string::npos || 
-            str.find('\r') != std::string::npos) {
-            
+        if (needsCSVQuotes(str, delimiter)) {
             // Escape the field by wrapping in quotes and doubling internal quotes
             os << '"';
-            for (char c : str) {
-                if (c == '"') {
-                    os << "\"\"";
-                } else {
-                    os << c;
-                }
-            }
+            meta::escape::scan_runs(
+                str, quote,
+                [&](std::string_view run) { os.write(run.data(), static_cast<std::streamsize>(run.size())); },
+                [&](char) { os << "\"\""; });
             os << '"';
         } else {
             os << str;
         }
+    } else if constexpr (detail::is_character_v<T> || std::is_floating_point_v<T>) {
+        // quoting and round-trip digits as in appendCSVValue
+        std::string text;
+        appendCSVValue(text, value, delimiter);
+        os << text;
     } else {
         // For non-string types, just output directly
         os << value;
     }
 }
 
-// Helper to get CSV column name from mapping
-template<typename FieldMeta>
-std::string getCSVColumnName(const FieldMeta& fieldMeta) {
-    // Check if csv_column exists in mapping
-  if (fieldMeta.getCsvColumn().has_value()) {
-    return fieldMeta.getCsvColumn().value();
-    }
-    // Fall back to fieldName
-    return fieldMeta.fieldName;
+// Appends the header line (without the newline)
+template<typename ObjectType>
+void appendHeader(std::string& out, std::string_view delimiter = ",") {
+    std::apply([&](auto&&... fieldMeta) {
+        bool first = true;
+        auto writeHeader = [&](const auto& field) {
+            if (!shouldSkipField(field)) {
+                if (!first) out += delimiter;
+                first = false;
+                out += getCSVColumnName(field);
+            }
+        };
+        (writeHeader(fieldMeta), ...);
+    }, meta::MetaTuple<ObjectType>::fields);
 }
 
-// Helper to check if field should be skipped (always false for now, can be extended)
-template<typename FieldMeta>
-bool shouldSkipField(const FieldMeta& fieldMeta) {
-    // Could check for special properties or annotations in the future
-    return false;
+// Appends one data row (without the newline)
+template<typename ObjectType>
+void appendRow(std::string& out, const ObjectType& obj, std::string_view delimiter = ",") {
+    std::apply([&](auto&&... fieldMeta) {
+        bool first = true;
+        auto writeData = [&](const auto& field) {
+            if (!shouldSkipField(field)) {
+                if (!first) out += delimiter;
+                first = false;
+
+                if constexpr (field.memberPtr != nullptr) {
+                    appendCSVValue(out, obj.*(field.memberPtr), delimiter);
+                }
+            }
+        };
+        (writeData(fieldMeta), ...);
+    }, meta::MetaTuple<ObjectType>::fields);
 }
 
 // Main CSV serialization function
 template <typename ObjectType>
 std::string serialize(const std::vector<ObjectType>& objects, const std::string& delimiter = ",")
 {
-    std::ostringstream os;
+    std::string out;
     if (objects.empty()) {
-        return "";
+        return out;
     }
-    
-    constexpr auto& fields = meta::MetaTuple<ObjectType>::fields;
-    
-    // Write header
-    std::apply([&](auto&&... fieldMeta) {
-        bool first = true;
-        auto writeHeader = [&](const auto& field) {
-            if (!shouldSkipField(field)) {
-                if (!first) os << delimiter;
-                first = false;
-                os << getCSVColumnName(field);
-            }
-        };
-        (writeHeader(fieldMeta), ...);
-        os << "\n";
-    }, fields);
-    
-    // Write data rows
+
+    appendHeader<ObjectType>(out, delimiter);
+    out += '\n';
     for (const auto& obj : objects) {
-        std::apply([&](auto&&... fieldMeta) {
-            bool first = true;
-            auto writeData = [&](const auto& field) {
-                if (!shouldSkipField(field)) {
-                    if (!first) os << delimiter;
-                    first = false;
-                    
-                    if constexpr (field.memberPtr != nullptr) {
-                        auto value = obj.*(field.memberPtr);
-                        writeCSVValue(os, value);
-                    }
-                }
-            };
-            (writeData(fieldMeta), ...);
-            os << "\n";
-        }, fields);
+        appendRow(out, obj, delimiter);
+        out += '\n';
     }
-    
-    return os.str();
+    return out;
+}
+
+// Columnar records, rebuilt one at a time; same bytes as for a vector
+template <typename ObjectType>
+std::string serialize(const meta::soa_vector<ObjectType>& objects, const std::string& delimiter = ",")
+{
+    std::string out;
+    if (objects.empty()) {
+        return out;
+    }
+
+    appendHeader<ObjectType>(out, delimiter);
+    out += '\n';
+    for (const ObjectType& obj : objects.rows()) {
+        appendRow(out, obj, delimiter);
+        out += '\n';
+    }
+    return out;
+}
+
+// serialize() with the rows formatted on up to `threads` threads (0 = one per core); same bytes
+template <typename ObjectType>
+std::string serializeParallel(const std::vector<ObjectType>& objects,
+                              const std::string& delimiter = ",",
+                              size_t threads = 0)
+{
+    std::string out;
+    if (objects.empty()) {
+        return out;
+    }
+
+    appendHeader<ObjectType>(out, delimiter);
+    out += '\n';
+    meta::append_parallel(out, objects, [&](std::string& buf, const ObjectType& obj, size_t) {
+        appendRow(buf, obj, delimiter);
+        buf += '\n';
+    }, threads);
+    return out;
 }
 
 // Advanced CSV serialization with more options
@@ -146,7 +273,7 @@ std::string serializeAdvanced(const std::vector<ObjectType>& objects,
                     if constexpr (field.memberPtr != nullptr) {
                         auto value = obj.*(field.memberPtr);
                         if (escapeStrings) {
-                            writeCSVValue(os, value);
+                            writeCSVValue(os, value, delimiter);
                         } else {
                             os << value;
                         }
@@ -171,7 +298,7 @@ std::vector<std::string> getHeaders()
     std::apply([&](auto&&... fieldMeta) {
         auto addHeader = [&](const auto& field) {
             if (!shouldSkipField(field)) {
-                headers.push_back(getCSVColumnName(field));
+                headers.emplace_back(getCSVColumnName(field));
             }
         };
         (addHeader(fieldMeta), ...);
@@ -203,48 +330,18 @@ size_t getFieldCount()
 template <typename ObjectType>
 std::string serializeRow(const ObjectType& obj, const std::string& delimiter = ",")
 {
-    std::ostringstream os;
-    constexpr auto& fields = meta::MetaTuple<ObjectType>::fields;
-    
-    std::apply([&](auto&&... fieldMeta) {
-        bool first = true;
-        auto writeData = [&](const auto& field) {
-            if (!shouldSkipField(field)) {
-                if (!first) os << delimiter;
-                first = false;
-                
-                if constexpr (field.memberPtr != nullptr) {
-                    auto value = obj.*(field.memberPtr);
-                    writeCSVValue(os, value);
-                }
-            }
-        };
-        (writeData(fieldMeta), ...);
-    }, fields);
-    
-    return os.str();
+    std::string out;
+    appendRow(out, obj, delimiter);
+    return out;
 }
 
 // Get header row as string
 template <typename ObjectType>
 std::string getHeaderRow(const std::string& delimiter = ",")
 {
-    std::ostringstream os;
-    constexpr auto& fields = meta::MetaTuple<ObjectType>::fields;
-    
-    std::apply([&](auto&&... fieldMeta) {
-        bool first = true;
-        auto writeHeader = [&](const auto& field) {
-            if (!shouldSkipField(field)) {
-                if (!first) os << delimiter;
-                first = false;
-                os << getCSVColumnName(field);
-            }
-        };
-        (writeHeader(fieldMeta), ...);
-    }, fields);
-    
-    return os.str();
+    std::string out;
+    appendHeader<ObjectType>(out, delimiter);
+    return out;
 }
 
 // Debug: Print field mappings
@@ -261,7 +358,7 @@ void printFieldMappings()
             if (shouldSkipField(field)) {
                 std::cout << " -> SKIPPED";
             } else {
-                std::string csvName = getCSVColumnName(field);
+                std::string_view csvName = getCSVColumnName(field);
                 if (csvName != field.fieldName) {
                     std::cout << " -> CSV column: " << csvName;
                 } else {
@@ -293,5 +390,680 @@ bool hasCSVMappings()
     return hasMappings;
 }
 
+// ================================================================
+// Streaming writer
+//
+// writer<T> formats one record at a time into a meta::Sink, which flushes
+// in blocks: output is byte-identical to serialize() (header included, and
+// nothing at all for zero records) without holding the rows or the text.
+//
+// Usage:
+//   meta::csv::writer<Row> out(meta::Sink::file("rows.csv"));
+//   out.write_all(meta::csv::file_records<Row>("in.csv"));
+//   out.close();
+// ================================================================
+
+template<typename T>
+class writer {
+public:
+    explicit writer(meta::Sink sink, std::string delimiter = ",")
+        : sink_(std::move(sink)), delimiter_(std::move(delimiter)) {}
+
+    ~writer() {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    writer(const writer&) = delete;
+    writer& operator=(const writer&) = delete;
+
+    void write(const T& obj) {
+        if (closed_)
+            throw std::logic_error("csv: write after close");
+        auto& out = sink_.buffer();
+        if (count_++ == 0) {
+            appendHeader<T>(out, delimiter_);
+            out += '\n';
+        }
+        appendRow(out, obj, delimiter_);
+        out += '\n';
+        sink_.commit();
+    }
+
+    // Writes every row of a range or generator (rows may be pointers); returns the count
+    template<typename Range>
+    size_t write_all(Range&& rows) { return meta::write_rows(*this, std::forward<Range>(rows)); }
+
+    // Flushes the remaining output and releases the sink
+    void close() {
+        if (closed_)
+            return;
+        closed_ = true;
+        sink_.close();
+    }
+
+    size_t count() const { return count_; }
+
+private:
+    meta::Sink sink_;
+    std::string delimiter_;
+    size_t count_ = 0;
+    bool closed_ = false;
+};
+
+// ================================================================
+// Reader
+//
+// meta::csv::parse<T>(text) maps the header row onto T's fields once per
+// input (by getCSVColumnName, so csv_column renames are honoured) and then
+// walks the records with the shared scanner from meta_escape.h, stopping
+// only at the delimiter, the quote and line ends. Unquoted fields reach the
+// setters as string_views into the input; numbers go through
+// std::from_chars. Columns without a matching field are skipped, and
+// fields without a column keep their default value. A record with more
+// fields than the header (or than T has, without one) throws parse_error.
+//
+// parse_file<T>(path) memory-maps the file. With ReadOptions::threads other
+// than 1 the body is split at record boundaries (quote parity is tracked, so
+// a newline inside a quoted field is never a split point), the chunks are
+// parsed on separate threads and joined in file order. Splitting assumes
+// RFC 4180 quoting: a quote inside an unquoted field is read literally by the
+// serial path but would throw off the parity.
+//
+// Usage:
+//   auto rows = meta::csv::parse_file<Row>("rows.csv", {.threads = 0});
+//   for (Row& row : meta::csv::records<Row>(text)) { ... }
+// ================================================================
+
+class parse_error : public std::runtime_error {
+public:
+    parse_error(const std::string& what, size_t offset)
+        : std::runtime_error("csv: " + what + " at offset " + std::to_string(offset)),
+          offset_(offset) {}
+
+    size_t offset() const { return offset_; }
+
+private:
+    size_t offset_;
+};
+
+struct ReadOptions {
+    char delimiter = ',';
+    char quote = '"';
+    bool header = true;  // first record names the columns; otherwise columns follow field order
+    size_t threads = 1;  // chunks parsed in parallel by parse/parse_file (0 = one per core)
+};
+
+// Read-only view of a whole file, unmapped on destruction
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("csv: cannot open " + path);
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            throw std::runtime_error("csv: cannot stat " + path);
+        }
+        size_ = static_cast<size_t>(size.QuadPart);
+        if (size_ != 0) {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping != nullptr) {
+                // the view keeps the mapping alive
+                data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+        if (size_ != 0 && data_ == nullptr)
+            throw std::runtime_error("csv: cannot map " + path);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("csv: cannot open " + path + ": " + std::strerror(errno));
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            int err = errno;
+            ::close(fd);
+            throw std::runtime_error("csv: cannot stat " + path + ": " + std::strerror(err));
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ != 0) {
+            void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                int err = errno;
+                ::close(fd);
+                throw std::runtime_error("csv: cannot map " + path + ": " + std::strerror(err));
+            }
+            ::madvise(data, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(data);
+        }
+        ::close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+        if (data_ == nullptr)
+            return;
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+#else
+        ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view view() const { return {data_, size_}; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+namespace detail {
+
+template<typename T> struct is_optional : std::false_type {};
+template<typename T> struct is_optional<std::optional<T>> : std::true_type {};
+
+// Converts one field; false if text is not a valid T. Mirrors writeCSVValue:
+// bools are 1/0 (true/false also accepted), char types are a single character
+// (quoted by the writer when it is ',', '"' or a line end).
+template<typename T>
+bool from_field(std::string_view text, T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        if (text == "1" || text == "true" || text == "TRUE" || text == "True")
+            value = true;
+        else if (text.empty() || text == "0" || text == "false" || text == "FALSE" || text == "False")
+            value = false;
+        else
+            return false;
+    } else if constexpr (is_character_v<T>) {
+        // operator<< writes these as characters, not numbers
+        if (text.size() > 1)
+            return false;
+        value = text.empty() ? T{} : static_cast<T>(text[0]);
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        if (text.empty()) {
+            value = T{};
+            return true;
+        }
+        const char* begin = text.data();
+        const char* end = begin + text.size();
+        if (*begin == '+')  // from_chars has no leading '+'
+            ++begin;
+        auto [ptr, ec] = std::from_chars(begin, end, value);
+        return ec == std::errc() && ptr == end;
+    } else if constexpr (std::is_enum_v<T>) {
+        std::underlying_type_t<T> raw{};
+        if (!from_field(text, raw))
+            return false;
+        value = static_cast<T>(raw);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        value.assign(text.data(), text.size());
+    } else if constexpr (is_optional<T>::value) {
+        if (text.empty()) {
+            value.reset();
+            return true;
+        }
+        typename T::value_type inner{};
+        if (!from_field(text, inner))
+            return false;
+        value = std::move(inner);
+    } else if constexpr (std::is_constructible_v<T, std::string>) {
+        value = T(std::string(text));
+    }
+    // anything else has no CSV form: leave the member as is
+    return true;
+}
+
+// Field names and setters of ObjectType in declaration order, built once per type
+template<typename ObjectType>
+struct FieldSetters {
+    using Setter = bool (*)(std::string_view, ObjectType&);
+
+    std::vector<std::string_view> names;  // views into the static field metadata
+    std::vector<Setter> setters;            // nullptr: the field has no member to fill
+
+    static const FieldSetters& get() {
+        static const FieldSetters fields;
+        return fields;
+    }
+
+private:
+    template<typename FieldMeta>
+    static Setter make_setter() {
+        if constexpr (FieldMeta::memberPtr != nullptr)
+            return [](std::string_view text, ObjectType& obj) {
+                return from_field(text, obj.*(FieldMeta::memberPtr));
+            };
+        else
+            return nullptr;
+    }
+
+    FieldSetters() {
+        std::apply([&](const auto&... fieldMeta) {
+            auto add = [&](const auto& field) {
+                if (shouldSkipField(field))
+                    return;
+                names.push_back(getCSVColumnName(field));
+                setters.push_back(make_setter<std::remove_cvref_t<decltype(field)>>());
+            };
+            (add(fieldMeta), ...);
+        }, meta::MetaTuple<ObjectType>::fields);
+    }
+};
+
+// Column -> field mapping for one input
+template<typename ObjectType>
+class Columns {
+public:
+    static constexpr size_t none = static_cast<size_t>(-1);
+
+    // No header: columns follow the field order, as serializeAdvanced writes them
+    Columns() {
+        const auto& fields = FieldSetters<ObjectType>::get();
+        for (size_t i = 0; i < fields.names.size(); ++i)
+            field_.push_back(i);
+    }
+
+    explicit Columns(const std::vector<std::string>& header) {
+        const auto& fields = FieldSetters<ObjectType>::get();
+        for (const auto& column : header) {
+            size_t match = none;
+            for (size_t i = 0; i < fields.names.size(); ++i) {
+                if (fields.names[i] == column) {
+                    match = i;
+                    break;
+                }
+            }
+            field_.push_back(match);
+        }
+    }
+
+    void set(size_t column, std::string_view text, ObjectType& obj, size_t offset) const {
+        if (column >= field_.size())
+            throw parse_error("record has more fields than the header", offset);
+        if (field_[column] == none)
+            return;
+        const auto& fields = FieldSetters<ObjectType>::get();
+        auto setter = fields.setters[field_[column]];
+        if (setter != nullptr && !setter(text, obj))
+            throw parse_error("bad value for column '" + std::string(fields.names[field_[column]]) + "'",
+                              offset);
+    }
+
+private:
+    std::vector<size_t> field_;
+};
+
+// Splits CSV text into fields and records
+class Scanner {
+public:
+    // base: offset of text in the whole input (for error messages)
+    Scanner(std::string_view text, const ReadOptions& options, size_t base = 0)
+        : begin_(text.data()),
+          p_(text.data()),
+          end_(text.data() + text.size()),
+          base_(base),
+          delimiter_(options.delimiter),
+          quote_(options.quote),
+          specials_(specials(options)),
+          quotes_(std::string_view(&quote_, 1)) {}
+
+    bool at_end() const { return p_ == end_; }
+    size_t offset() const { return base_ + static_cast<size_t>(p_ - begin_); }
+    std::string_view rest() const { return {p_, static_cast<size_t>(end_ - p_)}; }
+
+    void skip_bom() {
+        if (end_ - p_ >= 3 && std::memcmp(p_, "\xEF\xBB\xBF", 3) == 0)
+            p_ += 3;
+    }
+
+    // Skips empty lines; false once the input is exhausted
+    bool next_record() {
+        while (p_ != end_ && (*p_ == '\n' || *p_ == '\r'))
+            ++p_;
+        return p_ != end_;
+    }
+
+    // Reads one field into out (a view into the input, or into scratch when
+    // quotes had to be collapsed); true if another field of the same record follows
+    bool field(std::string_view& out) {
+        if (p_ != end_ && *p_ == quote_)
+            return quoted(out);
+
+        const char* start = p_;
+        for (;;) {
+            p_ += meta::escape::find_first(rest(), specials_);
+            if (p_ == end_) {
+                out = {start, static_cast<size_t>(p_ - start)};
+                return false;
+            }
+            char c = *p_;
+            if (c == delimiter_) {
+                out = {start, static_cast<size_t>(p_ - start)};
+                ++p_;
+                return true;
+            }
+            if (c == '\n' || c == '\r') {
+                out = {start, static_cast<size_t>(p_ - start)};
+                end_line();
+                return false;
+            }
+            ++p_;  // stray quote inside an unquoted field is kept literally
+        }
+    }
+
+    // Reads a whole record into names (header row)
+    void record(std::vector<std::string>& names) {
+        bool more = true;
+        while (more) {
+            std::string_view text;
+            more = field(text);
+            names.emplace_back(text);
+        }
+    }
+
+    [[noreturn]] void fail(const std::string& what, size_t offset) const {
+        throw parse_error(what, offset);
+    }
+
+private:
+    static meta::escape::CharSet specials(const ReadOptions& options) {
+        const char set[] = {options.delimiter, options.quote, '\n', '\r'};
+        return meta::escape::CharSet(std::string_view(set, sizeof(set)));
+    }
+
+    bool quoted(std::string_view& out) {
+        size_t open = offset();
+        const char* start = ++p_;
+        bool doubled = false;
+        for (;;) {
+            p_ += meta::escape::find_first(rest(), quotes_);
+            if (p_ == end_)
+                fail("unterminated quoted field", open);
+            if (p_ + 1 != end_ && p_[1] == quote_) {
+                doubled = true;
+                p_ += 2;
+                continue;
+            }
+            break;
+        }
+        out = {start, static_cast<size_t>(p_ - start)};
+        ++p_;
+
+        if (doubled) {
+            // "" -> ": keep every other quote
+            scratch_.clear();
+            bool skip = false;
+            meta::escape::append_escaped(scratch_, out, quotes_, [&](std::string& s, char c) {
+                if (!skip)
+                    s += c;
+                skip = !skip;
+            });
+            out = scratch_;
+        }
+
+        if (p_ == end_)
+            return false;
+        if (*p_ == delimiter_) {
+            ++p_;
+            return true;
+        }
+        if (*p_ == '\n' || *p_ == '\r') {
+            end_line();
+            return false;
+        }
+        fail("expected delimiter after quoted field", offset());
+    }
+
+    void end_line() {
+        if (*p_++ == '\r' && p_ != end_ && *p_ == '\n')
+            ++p_;
+    }
+
+    const char* begin_;
+    const char* p_;
+    const char* end_;
+    size_t base_;
+    char delimiter_;
+    char quote_;
+    meta::escape::CharSet specials_;
+    meta::escape::CharSet quotes_;
+    std::string scratch_;
+};
+
+// Reads the record under scanner into obj; false at end of input
+template<typename ObjectType>
+bool read_record(Scanner& scanner, const Columns<ObjectType>& columns, ObjectType& obj) {
+    if (!scanner.next_record())
+        return false;
+    size_t column = 0;
+    bool more = true;
+    while (more) {
+        size_t at = scanner.offset();
+        std::string_view text;
+        more = scanner.field(text);
+        columns.set(column++, text, obj, at);
+    }
+    return true;
+}
+
+// Upper bound on the records in text (quoted newlines and blank lines overcount)
+inline size_t count_lines(std::string_view text) {
+    size_t lines = 0;
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p != end) {
+        const void* hit = std::memchr(p, '\n', static_cast<size_t>(end - p));
+        ++lines;
+        if (hit == nullptr)
+            break;
+        p = static_cast<const char*>(hit) + 1;
+    }
+    return lines;
+}
+
+template<typename ObjectType>
+void parse_chunk(std::string_view text, size_t base, const Columns<ObjectType>& columns,
+                 const ReadOptions& options, std::vector<ObjectType>& out) {
+    Scanner scanner(text, options, base);
+    out.reserve(out.size() + count_lines(text));
+    for (;;) {
+        ObjectType obj{};
+        if (!read_record(scanner, columns, obj))
+            break;
+        out.push_back(std::move(obj));
+    }
+}
+
+// Offsets splitting text into at most `chunks` pieces, each starting at a
+// record. The quotes before every tentative cut are counted in parallel; from
+// the cut, the split moves forward to the first newline outside quotes.
+inline std::vector<size_t> split_records(std::string_view text, size_t chunks, char quote) {
+    const char q[] = {quote};
+    const meta::escape::CharSet quotes(std::string_view(q, 1));
+
+    std::vector<size_t> cuts(chunks + 1);
+    for (size_t k = 0; k <= chunks; ++k)
+        cuts[k] = text.size() / chunks * k;
+    cuts[chunks] = text.size();
+
+    std::vector<size_t> counts(chunks);
+    {
+        std::vector<std::thread> workers;
+        for (size_t k = 0; k < chunks; ++k) {
+            workers.emplace_back([&, k] {
+                std::string_view slice = text.substr(cuts[k], cuts[k + 1] - cuts[k]);
+                size_t n = 0;
+                for (size_t at = meta::escape::find_first(slice, quotes); at != slice.size();
+                     at += 1 + meta::escape::find_first(slice.substr(at + 1), quotes))
+                    ++n;
+                counts[k] = n;
+            });
+        }
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    std::vector<size_t> bounds{0};
+    size_t quotesBefore = 0;
+    for (size_t k = 1; k < chunks; ++k) {
+        quotesBefore += counts[k - 1];
+        bool inQuotes = (quotesBefore & 1) != 0;
+        size_t at = cuts[k];
+        while (at < text.size() && (inQuotes || text[at] != '\n')) {
+            if (text[at] == quote)
+                inQuotes = !inQuotes;
+            ++at;
+        }
+        if (at < text.size() && at + 1 > bounds.back())
+            bounds.push_back(at + 1);
+    }
+    if (bounds.back() != text.size())
+        bounds.push_back(text.size());
+    return bounds;
+}
+
+// Inputs below this are parsed on the calling thread
+inline constexpr size_t min_chunk_bytes = size_t(1) << 20;
+
+} // namespace detail
+
+// Pulls the records of a CSV text one at a time
+template<typename T>
+class record_reader {
+public:
+    explicit record_reader(std::string_view csv, const ReadOptions& options = {})
+        : scanner_(csv, options) {
+        scanner_.skip_bom();
+        if (options.header && scanner_.next_record()) {
+            std::vector<std::string> header;
+            scanner_.record(header);
+            columns_ = detail::Columns<T>(header);
+        }
+    }
+
+    // Parses the next record into out (fields without a column keep their
+    // value); false once the input is exhausted
+    bool next(T& out) { return detail::read_record(scanner_, columns_, out); }
+
+    // Offset of the first record not yet read (where the body starts, right after construction)
+    size_t offset() const { return scanner_.offset(); }
+
+    const detail::Columns<T>& columns() const { return columns_; }
+
+private:
+    detail::Scanner scanner_;
+    detail::Columns<T> columns_;
+};
+
+// Calls fn(T&&) for every record; returns the count
+template<typename T, typename Fn>
+size_t parse_each(std::string_view csv, Fn&& fn, const ReadOptions& options = {}) {
+    record_reader<T> reader(csv, options);
+    size_t count = 0;
+    for (;;) {
+        T item{};
+        if (!reader.next(item))
+            break;
+        fn(std::move(item));
+        ++count;
+    }
+    return count;
+}
+
+template<typename T>
+std::vector<T> parse(std::string_view csv, const ReadOptions& options = {}) {
+    record_reader<T> reader(csv, options);
+    size_t start = reader.offset();
+    std::string_view body = csv.substr(start);
+
+    size_t threads = options.threads != 0 ? options.threads
+                                          : static_cast<size_t>(std::thread::hardware_concurrency());
+    size_t chunks = body.size() / detail::min_chunk_bytes + 1;
+    if (threads < chunks)
+        chunks = threads;
+
+    std::vector<T> out;
+    if (chunks <= 1) {
+        detail::parse_chunk(body, start, reader.columns(), options, out);
+        return out;
+    }
+
+    std::vector<size_t> bounds = detail::split_records(body, chunks, options.quote);
+    size_t pieces = bounds.size() - 1;
+    std::vector<std::vector<T>> parts(pieces);
+    std::vector<std::exception_ptr> errors(pieces);
+    auto work = [&](size_t k) {
+        try {
+            detail::parse_chunk(body.substr(bounds[k], bounds[k + 1] - bounds[k]),
+                                start + bounds[k], reader.columns(), options, parts[k]);
+        } catch (...) {
+            errors[k] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t k = 1; k < pieces; ++k)
+        workers.emplace_back(work, k);
+    work(0);
+    for (auto& worker : workers)
+        worker.join();
+    for (auto& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    size_t total = 0;
+    for (const auto& part : parts)
+        total += part.size();
+    out = std::move(parts[0]);
+    out.reserve(total);
+    for (size_t k = 1; k < pieces; ++k)
+        out.insert(out.end(), std::make_move_iterator(parts[k].begin()),
+                   std::make_move_iterator(parts[k].end()));
+    return out;
+}
+
+// parse<T> over a memory-mapped file
+template<typename T>
+std::vector<T> parse_file(const std::string& path, const ReadOptions& options = {}) {
+    MappedFile file(path);
+    return parse<T>(file.view(), options);
+}
+
+// Lazily yields the records of csv (which must outlive the generator)
+template<typename T>
+Generator<T> records(std::string_view csv, ReadOptions options = {}) {
+    record_reader<T> reader(csv, options);
+    for (;;) {
+        T item{};
+        if (!reader.next(item))
+            break;
+        co_yield std::move(item);
+    }
+}
+
+// records<T> over a memory-mapped file, unmapped when the generator is destroyed
+template<typename T>
+Generator<T> file_records(std::string path, ReadOptions options = {}) {
+    MappedFile file(path);
+    record_reader<T> reader(file.view(), options);
+    for (;;) {
+        T item{};
+        if (!reader.next(item))
+            break;
+        co_yield std::move(item);
+    }
+}
+
 } // namespace csv
 } // namespace meta
@@ -1,5 +1,7 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <vector>
 #include <map>
@@ -7,6 +9,8 @@
 #include <concepts>
 #include <optional>
 #include <iostream>
+#include <tuple>
+#include <utility>
 
 // ==============================================================================
 // DATABASE WRITER FOR METAFRONT REFLECTION SYSTEM
@@ -14,15 +18,19 @@
 
 namespace db {
 
-// Helper to get field name from mapping
+// Helper to get field name from mapping (a constant for StaticField)
 template<typename FieldMeta>
-std::string getFieldName(const FieldMeta& fieldMeta) {
-    // Check if table_column exists in mapping
-    if (fieldMeta.getSqlColumn().has_value()) {
-      return fieldMeta.getSqlColumn().value();
+constexpr std::string_view getFieldName(const FieldMeta& fieldMeta) {
+    if constexpr (requires { FieldMeta::sqlColumn; }) {
+        return FieldMeta::sqlColumn;
+    } else {
+        // Check if table_column exists in mapping
+        if (const std::string* column = fieldMeta.findAttribute(meta::SQL_COLUMN)) {
+            return *column;
+        }
+        // Fall back to fieldName
+        return fieldMeta.fieldName;
     }
-    // Fall back to fieldName
-    return fieldMeta.fieldName;
 }
 
 // Helper to get table name from metadata
@@ -149,7 +157,7 @@ private:
         sql << "    " << getFieldName(fieldMeta) << " ";
         
         // Get SQL type from fieldType string
-        std::string sqlType = SQLTypeMapper::mapCppToSQL(fieldMeta.fieldType);
+        std::string sqlType = SQLTypeMapper::mapCppToSQL(std::string(fieldMeta.fieldType));
         sql << sqlType;
         
         // Get constraints
@@ -162,6 +170,22 @@ public:
     // ==============================================================================
     
     static std::string generateInsert() {
+        std::ostringstream sql;
+        sql << generateInsertHead() << "(";
+        
+        // Add placeholders
+        for (size_t i = 0; i < getInsertFieldCount(); ++i) {
+            if (i > 0) sql << ", ";
+            sql << "?";
+        }
+        
+        sql << ")";
+        return sql.str();
+    }
+    
+    // "INSERT INTO table (a, b) VALUES " - the part shared by the prepared
+    // statement and multi-row VALUES lists
+    static std::string generateInsertHead() {
         if (tableName.empty()) {
             throw std::runtime_error("Type must have a tableName in MetaTuple");
         }
@@ -181,18 +205,27 @@ public:
             sql << fieldNames[i];
         }
         
-        sql << ") VALUES (";
-        
-        // Add placeholders
-        for (size_t i = 0; i < fieldNames.size(); ++i) {
-            if (i > 0) sql << ", ";
-            sql << "?";
-        }
-        
-        sql << ")";
+        sql << ") VALUES ";
         return sql.str();
     }
     
+    // Fields written by INSERT: public fields backed by a member
+    template<typename FieldMeta>
+    static constexpr bool isInsertField() {
+        if constexpr (FieldMeta::properties & meta::Prop::Private) {
+            return false;
+        } else {
+            return FieldMeta::memberPtr != nullptr;
+        }
+    }
+    
+    static constexpr size_t getInsertFieldCount() {
+        using Fields = std::decay_t<decltype(fields)>;
+        return []<size_t... I>(std::index_sequence<I...>) {
+            return (size_t{0} + ... + (isInsertField<std::tuple_element_t<I, Fields>>() ? 1 : 0));
+        }(std::make_index_sequence<std::tuple_size_v<Fields>>{});
+    }
+    
     static std::string generateInsertWithValues(const T& obj) {
         if (tableName.empty()) {
             throw std::runtime_error("Type must have a tableName in MetaTuple");
@@ -229,11 +262,8 @@ public:
 private:
     template<typename FieldMeta>
     static void addInsertField(std::vector<std::string>& fieldNames, const FieldMeta& fieldMeta) {
-        // Include public fields
-        if constexpr (!(FieldMeta::properties & meta::Prop::Private)) {
-            if constexpr (FieldMeta::memberPtr != nullptr) {
-                fieldNames.push_back(getFieldName(fieldMeta));
-            }
+        if constexpr (isInsertField<FieldMeta>()) {
+            fieldNames.emplace_back(getFieldName(fieldMeta));
         }
     }
     
@@ -244,7 +274,7 @@ private:
                                        const T& obj) {
         if constexpr (!(FieldMeta::properties & meta::Prop::Private)) {
             if constexpr (FieldMeta::memberPtr != nullptr) {
-                fieldNames.push_back(getFieldName(fieldMeta));
+                fieldNames.emplace_back(getFieldName(fieldMeta));
                 
                 // Get value and convert to SQL string
                 auto value = fieldMeta.get(obj);
@@ -305,7 +335,102 @@ public:
         }
         return sql.str();
     }
-    
+
+    // Partial UPDATE: only the fields whose bit is set in dirty (bit i is
+    // field i of MetaTuple<T>::fields, as meta::tracked<T>::dirty() gives),
+    // keyed by the primary key column. Empty when no updatable field is
+    // dirty, so there is nothing to send.
+    static std::string generateUpdate(uint64_t dirty) {
+        std::vector<std::string> setFields;
+        forEachDirtyField(dirty, [&](const auto& fieldMeta) {
+            setFields.emplace_back(getFieldName(fieldMeta));
+        });
+        if (setFields.empty()) {
+            return "";
+        }
+
+        std::ostringstream sql;
+        sql << "UPDATE " << tableName << " SET ";
+        for (size_t i = 0; i < setFields.size(); ++i) {
+            if (i > 0) sql << ", ";
+            sql << setFields[i] << " = ?";
+        }
+        sql << " WHERE " << primaryKeyColumn() << " = ?";
+        return sql.str();
+    }
+
+    // generateUpdate(dirty) with the values inlined. Throws when T has no
+    // Prop::PrimaryKey field rather than emit an UPDATE without a WHERE.
+    static std::string generateUpdateWithValues(const T& obj, uint64_t dirty) {
+        std::vector<std::string> updates;
+        forEachDirtyField(dirty, [&](const auto& fieldMeta) {
+            updates.push_back(std::string(getFieldName(fieldMeta)) + " = " + valueToSQL(fieldMeta.get(obj)));
+        });
+        if (updates.empty()) {
+            return "";
+        }
+
+        std::ostringstream sql;
+        sql << "UPDATE " << tableName << " SET ";
+        for (size_t i = 0; i < updates.size(); ++i) {
+            if (i > 0) sql << ", ";
+            sql << updates[i];
+        }
+
+        // without a key value the statement would rewrite every row
+        std::string primaryKeyValue;
+        std::apply([&](const auto&... field_metas) {
+            ((addPrimaryKeyValue(primaryKeyValue, field_metas, obj)), ...);
+        }, fields);
+        if (primaryKeyValue.empty()) {
+            throw std::runtime_error("Type must have a Prop::PrimaryKey field to UPDATE dirty fields");
+        }
+        sql << " WHERE " << primaryKeyColumn() << " = " << primaryKeyValue;
+        return sql.str();
+    }
+
+private:
+    // Calls fn with each public, non-key field backed by a member whose bit
+    // is set in dirty
+    template<typename Fn>
+    static void forEachDirtyField(uint64_t dirty, Fn&& fn) {
+        if (tableName.empty()) {
+            throw std::runtime_error("Type must have a tableName in MetaTuple");
+        }
+        using Fields = std::decay_t<decltype(fields)>;
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ([&] {
+                using FieldMeta = std::tuple_element_t<I, Fields>;
+                if constexpr (isInsertField<FieldMeta>() && !(FieldMeta::properties & meta::Prop::PrimaryKey)) {
+                    if ((dirty >> I) & 1) {
+                        fn(std::get<I>(fields));
+                    }
+                }
+            }(), ...);
+        }(std::make_index_sequence<std::tuple_size_v<Fields>>{});
+    }
+
+    // The primary key's column name; "id" when no field is flagged, as the
+    // other UPDATE and DELETE statements assume
+    static std::string primaryKeyColumn() {
+        std::string column;
+        std::apply([&column](const auto&... field_metas) {
+            ((column.empty() && (std::decay_t<decltype(field_metas)>::properties & meta::Prop::PrimaryKey)
+                  ? (void)(column = getFieldName(field_metas))
+                  : (void)0), ...);
+        }, fields);
+        return column.empty() ? "id" : column;
+    }
+
+    template<typename FieldMeta>
+    static void addPrimaryKeyValue(std::string& primaryKeyValue, const FieldMeta& fieldMeta, const T& obj) {
+        if constexpr ((FieldMeta::properties & meta::Prop::PrimaryKey) && FieldMeta::memberPtr != nullptr) {
+            if (primaryKeyValue.empty()) {
+                primaryKeyValue = valueToSQL(fieldMeta.get(obj));
+            }
+        }
+    }
+
 private:
     template<typename FieldMeta>
     static void addUpdateField(std::vector<std::string>& setFields, const FieldMeta& fieldMeta) {
@@ -313,7 +438,7 @@ private:
             if constexpr (FieldMeta::memberPtr != nullptr) {
                 // Skip primary key fields
                 if constexpr (!(FieldMeta::properties & meta::Prop::PrimaryKey)) {
-                    setFields.push_back(getFieldName(fieldMeta));
+                    setFields.emplace_back(getFieldName(fieldMeta));
                 }
             }
         }
@@ -331,7 +456,7 @@ private:
                 if constexpr (FieldMeta::properties & meta::Prop::PrimaryKey) {
                     primaryKeyValue = valueToSQL(value);
                 } else {
-                    updates.push_back(getFieldName(fieldMeta) + " = " + valueToSQL(value));
+                    updates.push_back(std::string(getFieldName(fieldMeta)) + " = " + valueToSQL(value));
                 }
             }
         }
@@ -380,7 +505,7 @@ private:
     static void addFieldName(std::vector<std::string>& names, const FieldMeta& fieldMeta) {
         if constexpr (!(FieldMeta::properties & meta::Prop::Private)) {
             if constexpr (FieldMeta::memberPtr != nullptr) {
-                names.push_back(getFieldName(fieldMeta));
+                names.emplace_back(getFieldName(fieldMeta));
             }
         }
     }
@@ -468,6 +593,13 @@ std::string updateSQL(const T& obj) {
     return DatabaseWriter<T>::generateUpdateWithValues(obj);
 }
 
+// UPDATE of the fields set in dirty, e.g. meta::tracked<T>::dirty()
+template<typename T>
+requires HasMetadata<T>
+std::string updateSQL(const T& obj, uint64_t dirty) {
+    return DatabaseWriter<T>::generateUpdateWithValues(obj, dirty);
+}
+
 template<typename T>
 requires HasMetadata<T>
 std::string selectSQL() {
@@ -0,0 +1,644 @@
+/*
+ * ================================================================
+ * FIELD-LEVEL DIFF AND PATCH
+ *
+ * meta::diff(a, b) compares two reflected records field by field through
+ * MetaTuple<T>::fields and returns a meta::patch<T>: a change mask (bit i
+ * for field i) and, for each changed field, what apply_patch needs to turn
+ * a into b:
+ *   reflected structs   a nested patch<Field>, recursively
+ *   std::vector<E>      the new length and the (index, element delta)
+ *                       pairs where a and b differ position by position,
+ *                       appended elements included (no LCS: an insert in
+ *                       the middle shows up as changes to every later index)
+ *   anything else       the new value
+ * Values are compared with meta::equal (meta_hash.h).
+ *
+ * Encodings, for sending updates instead of records:
+ *   meta::binary::serialize_patch / parse_patch<T>
+ *       "MTD1", the meta::binary schema hash of T, then the patch: the mask
+ *       (1, 2, 4 or 8 bytes by field count), then the changed fields in
+ *       field order, values in meta::binary encoding; vectors as u32
+ *       length, u32 change count and (u32 index, delta) pairs
+ *   meta::json::serialize_patch / parse_patch<T>
+ *       an object of the changed fields; nested structs as nested
+ *       objects, vectors as {"size": n, "set": [[index, delta], ...]}
+ * An update costs the mask plus the changed values, so a record with one
+ * field changed in ten sends about a tenth of the bytes.
+ *
+ * Usage:
+ *   auto delta = meta::diff(before, after);
+ *   if (!delta.empty())
+ *       send(meta::binary::serialize_patch(delta));
+ *   ...
+ *   meta::apply_patch(replica, meta::binary::parse_patch<Row>(bytes));
+ * ================================================================
+ */
+
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "meta_binary.h"
+#include "meta_hash.h"
+#include "meta_json.h"
+
+namespace meta
+{
+
+template <typename T> struct patch;
+template <typename E> struct vector_patch;
+
+namespace detail
+{
+
+template <typename T>
+concept diff_reflected = requires { MetaTuple<T>::fields; };
+
+template <typename T> struct is_diff_vector : std::false_type
+{
+};
+template <typename E, typename A> struct is_diff_vector<std::vector<E, A>> : std::true_type
+{
+};
+
+// What a change to a value of type V carries
+template <typename V> struct delta_of
+{
+    using type = V;
+};
+template <diff_reflected V> struct delta_of<V>
+{
+    using type = patch<V>;
+};
+template <typename E, typename A> struct delta_of<std::vector<E, A>>
+{
+    using type = vector_patch<E>;
+};
+
+template <typename V> using delta_t = typename delta_of<V>::type;
+
+template <typename T>
+using diff_fields = std::remove_cvref_t<decltype(MetaTuple<T>::fields)>;
+
+template <typename T> inline constexpr size_t diff_field_count = std::tuple_size_v<diff_fields<T>>;
+
+template <typename T, size_t I> using diff_field = std::remove_cvref_t<std::tuple_element_t<I, diff_fields<T>>>;
+
+template <typename T, size_t I> inline constexpr bool diff_has_member = diff_field<T, I>::memberPtr != nullptr;
+
+// Smallest unsigned integer with a bit per field
+template <size_t N> auto diff_mask_type()
+{
+    static_assert(N <= 64, "meta::patch: at most 64 fields");
+    if constexpr (N <= 8)
+        return uint8_t{};
+    else if constexpr (N <= 16)
+        return uint16_t{};
+    else if constexpr (N <= 32)
+        return uint32_t{};
+    else
+        return uint64_t{};
+}
+
+template <typename T> using patch_mask = decltype(diff_mask_type<diff_field_count<T>>());
+
+template <typename T, size_t... I>
+auto make_patch_values(std::index_sequence<I...>) -> std::tuple<delta_t<typename diff_field<T, I>::type>...>;
+
+template <typename T>
+using patch_values = decltype(make_patch_values<T>(std::make_index_sequence<diff_field_count<T>>{}));
+
+// Index of the field whose member pointer is MemberPtr
+template <typename T, auto MemberPtr> constexpr size_t diff_index()
+{
+    constexpr size_t index = []<size_t... I>(std::index_sequence<I...>)
+    {
+        size_t found = sizeof...(I);
+        (
+            [&]
+            {
+                constexpr auto candidate = diff_field<T, I>::memberPtr;
+                if constexpr (std::is_same_v<std::remove_const_t<decltype(candidate)>, decltype(MemberPtr)>)
+                {
+                    if (found == sizeof...(I) && candidate == MemberPtr)
+                        found = I;
+                }
+            }(),
+            ...);
+        return found;
+    }(std::make_index_sequence<diff_field_count<T>>{});
+    static_assert(index < diff_field_count<T>, "meta::patch: member is not in MetaTuple<T>::fields");
+    return index;
+}
+
+} // namespace detail
+
+// The changes to one std::vector<E>: its new length and the elements that
+// differ, by index
+template <typename E> struct vector_patch
+{
+    size_t size = 0;
+    std::vector<std::pair<uint32_t, detail::delta_t<E>>> changes;
+};
+
+template <typename T> struct patch
+{
+    using mask_type = detail::patch_mask<T>;
+
+    mask_type mask = 0;             // bit i: field i of MetaTuple<T>::fields changed
+    detail::patch_values<T> values; // per field: the new value or nested delta, where mask is set
+
+    bool empty() const
+    {
+        return mask == 0;
+    }
+
+    // Number of fields changed
+    size_t size() const
+    {
+        return static_cast<size_t>(std::popcount(mask));
+    }
+
+    bool changed(size_t field) const
+    {
+        return (mask >> field) & 1;
+    }
+
+    template <auto Member> bool changed() const
+    {
+        return changed(detail::diff_index<T, Member>());
+    }
+
+    // The delta of field I (meaningful when changed(I))
+    template <size_t I> const auto& get() const
+    {
+        return std::get<I>(values);
+    }
+    template <auto Member> const auto& get() const
+    {
+        return std::get<detail::diff_index<T, Member>()>(values);
+    }
+};
+
+namespace detail
+{
+
+// Sets delta to what turns a into b and returns whether they differ
+template <typename V> bool diff_value(const V& a, const V& b, delta_t<V>& delta);
+
+template <typename T> patch<T> diff_object(const T& a, const T& b)
+{
+    patch<T> result;
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (
+            [&]
+            {
+                if constexpr (diff_has_member<T, I>)
+                {
+                    constexpr auto member = diff_field<T, I>::memberPtr;
+                    if (diff_value(a.*member, b.*member, std::get<I>(result.values)))
+                        result.mask |= static_cast<typename patch<T>::mask_type>(uint64_t{1} << I);
+                }
+            }(),
+            ...);
+    }(std::make_index_sequence<diff_field_count<T>>{});
+    return result;
+}
+
+template <typename V> bool diff_value(const V& a, const V& b, delta_t<V>& delta)
+{
+    if constexpr (diff_reflected<V>)
+    {
+        delta = diff_object(a, b);
+        return !delta.empty();
+    }
+    else if constexpr (is_diff_vector<V>::value)
+    {
+        using E = typename V::value_type;
+        if (b.size() > UINT32_MAX)
+            throw std::length_error("meta::diff: vector longer than 2^32-1");
+        delta.size = b.size();
+        delta.changes.clear();
+        static const E blank{};
+        for (size_t i = 0; i < b.size(); ++i)
+        {
+            delta_t<E> element{};
+            if (diff_value(i < a.size() ? a[i] : blank, b[i], element) || i >= a.size())
+                delta.changes.emplace_back(static_cast<uint32_t>(i), std::move(element));
+        }
+        return a.size() != b.size() || !delta.changes.empty();
+    }
+    else
+    {
+        if (equal_value(a, b))
+            return false;
+        delta = b;
+        return true;
+    }
+}
+
+template <typename V> void apply_value(V& target, const delta_t<V>& delta);
+
+template <typename T> void apply_object(T& obj, const patch<T>& delta)
+{
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (
+            [&]
+            {
+                if constexpr (diff_has_member<T, I>)
+                {
+                    if (delta.changed(I))
+                        apply_value(obj.*diff_field<T, I>::memberPtr, std::get<I>(delta.values));
+                }
+            }(),
+            ...);
+    }(std::make_index_sequence<diff_field_count<T>>{});
+}
+
+template <typename V> void apply_value(V& target, const delta_t<V>& delta)
+{
+    if constexpr (diff_reflected<V>)
+        apply_object(target, delta);
+    else if constexpr (is_diff_vector<V>::value)
+    {
+        target.resize(delta.size);
+        for (const auto& [index, element] : delta.changes)
+        {
+            if (index >= target.size())
+                throw std::out_of_range("meta::apply_patch: vector index past the patched length");
+            if constexpr (std::is_same_v<typename V::value_type, bool>)
+                target[index] = element;
+            else
+                apply_value(target[index], element);
+        }
+    }
+    else
+        target = delta;
+}
+
+} // namespace detail
+
+// What turns a into b
+template <typename T> patch<T> diff(const T& a, const T& b)
+{
+    return detail::diff_object(a, b);
+}
+
+// Applies the changes of delta to obj (diff(a, b) applied to a gives b)
+template <typename T> void apply_patch(T& obj, const patch<T>& delta)
+{
+    detail::apply_object(obj, delta);
+}
+
+// ================================================================
+// Binary encoding
+// ================================================================
+
+namespace binary
+{
+namespace detail
+{
+
+inline constexpr char patch_magic[4] = {'M', 'T', 'D', '1'};
+
+template <typename T> size_t patch_body_size(const patch<T>& delta);
+template <typename T> void write_patch_body(Writer& out, const patch<T>& delta);
+template <typename T> void read_patch_body(Reader& in, patch<T>& delta);
+
+template <typename V> size_t delta_size(const meta::detail::delta_t<V>& delta)
+{
+    if constexpr (meta::detail::diff_reflected<V>)
+        return patch_body_size(delta);
+    else if constexpr (meta::detail::is_diff_vector<V>::value)
+    {
+        size_t size = 8;
+        for (const auto& change : delta.changes)
+            size += 4 + delta_size<typename V::value_type>(change.second);
+        return size;
+    }
+    else
+        return value_size(delta);
+}
+
+template <typename V> void write_delta(Writer& out, const meta::detail::delta_t<V>& delta)
+{
+    if constexpr (meta::detail::diff_reflected<V>)
+        write_patch_body(out, delta);
+    else if constexpr (meta::detail::is_diff_vector<V>::value)
+    {
+        out.number(length_prefix(delta.size));
+        out.number(length_prefix(delta.changes.size()));
+        for (const auto& [index, element] : delta.changes)
+        {
+            out.number(index);
+            write_delta<typename V::value_type>(out, element);
+        }
+    }
+    else
+        write_value(out, delta);
+}
+
+template <typename V> void read_delta(Reader& in, meta::detail::delta_t<V>& delta)
+{
+    if constexpr (meta::detail::diff_reflected<V>)
+        read_patch_body(in, delta);
+    else if constexpr (meta::detail::is_diff_vector<V>::value)
+    {
+        delta.size = in.number<uint32_t>();
+        size_t count = in.count(4);
+        if (count > delta.size)
+            in.fail("more vector changes than elements");
+        delta.changes.clear();
+        delta.changes.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t index = in.number<uint32_t>();
+            if (index >= delta.size)
+                in.fail("vector change index past the length");
+            delta.changes.emplace_back(index, meta::detail::delta_t<typename V::value_type>{});
+            read_delta<typename V::value_type>(in, delta.changes.back().second);
+        }
+    }
+    else
+        read_value(in, delta);
+}
+
+template <typename T> size_t patch_body_size(const patch<T>& delta)
+{
+    size_t size = sizeof(typename patch<T>::mask_type);
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        ((size += delta.changed(I) ? delta_size<typename meta::detail::diff_field<T, I>::type>(std::get<I>(delta.values))
+                                   : 0),
+         ...);
+    }(std::make_index_sequence<meta::detail::diff_field_count<T>>{});
+    return size;
+}
+
+template <typename T> void write_patch_body(Writer& out, const patch<T>& delta)
+{
+    out.number(delta.mask);
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (
+            [&]
+            {
+                if (delta.changed(I))
+                    write_delta<typename meta::detail::diff_field<T, I>::type>(out, std::get<I>(delta.values));
+            }(),
+            ...);
+    }(std::make_index_sequence<meta::detail::diff_field_count<T>>{});
+}
+
+template <typename T> void read_patch_body(Reader& in, patch<T>& delta)
+{
+    using mask_type = typename patch<T>::mask_type;
+    constexpr size_t count = meta::detail::diff_field_count<T>;
+    delta.mask = in.number<mask_type>();
+    if constexpr (count < sizeof(mask_type) * 8)
+    {
+        if (delta.mask >> count)
+            in.fail("patch mask names a field past the end of the struct");
+    }
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (
+            [&]
+            {
+                if (delta.changed(I))
+                {
+                    if constexpr (meta::detail::diff_has_member<T, I>)
+                        read_delta<typename meta::detail::diff_field<T, I>::type>(in, std::get<I>(delta.values));
+                    else
+                        in.fail("patch changes a field without a member");
+                }
+            }(),
+            ...);
+    }(std::make_index_sequence<count>{});
+}
+
+} // namespace detail
+
+// "MTD1", T's schema hash, then the patch
+template <typename T> std::string serialize_patch(const patch<T>& delta)
+{
+    static const uint64_t hash = schema_hash<T>();
+    std::string out(sizeof(detail::patch_magic) + sizeof(hash) + detail::patch_body_size(delta), '\0');
+    detail::Writer writer(out.data(), out.size());
+    writer.bytes(detail::patch_magic, sizeof(detail::patch_magic));
+    writer.number(hash);
+    detail::write_patch_body(writer, delta);
+    return out;
+}
+
+template <typename T> patch<T> parse_patch(std::string_view bytes)
+{
+    static const uint64_t hash = schema_hash<T>();
+    detail::Reader in(bytes.data(), bytes.data() + bytes.size());
+    if (std::memcmp(in.take(sizeof(detail::patch_magic)), detail::patch_magic, sizeof(detail::patch_magic)) != 0)
+        throw parse_error("not a meta::binary patch", 0);
+    if (in.number<uint64_t>() != hash)
+        throw parse_error("schema hash mismatch", sizeof(detail::patch_magic));
+    patch<T> delta;
+    detail::read_patch_body(in, delta);
+    if (in.remaining() != 0)
+        in.fail("trailing bytes");
+    return delta;
+}
+
+} // namespace binary
+
+// ================================================================
+// JSON encoding
+// ================================================================
+
+namespace json
+{
+namespace detail
+{
+
+template <typename T> void append_patch(std::string& out, const patch<T>& delta);
+template <typename T> void parse_patch_object(Reader& reader, patch<T>& delta);
+
+template <typename V> void append_delta(std::string& out, const meta::detail::delta_t<V>& delta)
+{
+    if constexpr (meta::detail::diff_reflected<V>)
+        append_patch(out, delta);
+    else if constexpr (meta::detail::is_diff_vector<V>::value)
+    {
+        out += "{\"size\":";
+        append_number(out, delta.size);
+        out += ",\"set\":[";
+        bool first = true;
+        for (const auto& [index, element] : delta.changes)
+        {
+            out += first ? "[" : ",[";
+            first = false;
+            append_number(out, index);
+            out += ',';
+            append_delta<typename V::value_type>(out, element);
+            out += ']';
+        }
+        out += "]}";
+    }
+    else
+        append_json_value(out, delta);
+}
+
+template <typename V> void parse_delta(Reader& reader, meta::detail::delta_t<V>& delta)
+{
+    if constexpr (meta::detail::diff_reflected<V>)
+        parse_patch_object(reader, delta);
+    else if constexpr (meta::detail::is_diff_vector<V>::value)
+    {
+        using E = typename V::value_type;
+        delta.changes.clear();
+        bool sized = false;
+        reader.expect('{');
+        if (!reader.consume('}'))
+        {
+            do
+            {
+                bool escaped = false;
+                std::string_view key = reader.string_token(escaped);
+                reader.expect(':');
+                if (key == "size")
+                {
+                    parse_value(reader, delta.size);
+                    sized = true;
+                }
+                else if (key == "set")
+                {
+                    reader.expect('[');
+                    if (!reader.consume(']'))
+                    {
+                        do
+                        {
+                            reader.expect('[');
+                            uint32_t index = 0;
+                            parse_value(reader, index);
+                            reader.expect(',');
+                            delta.changes.emplace_back(index, meta::detail::delta_t<E>{});
+                            parse_delta<E>(reader, delta.changes.back().second);
+                            reader.expect(']');
+                        } while (reader.consume(','));
+                        reader.expect(']');
+                    }
+                }
+                else
+                    reader.skip_value();
+            } while (reader.consume(','));
+            reader.expect('}');
+        }
+        if (!sized)
+            reader.fail("vector patch without \"size\"");
+        for (const auto& change : delta.changes)
+            if (change.first >= delta.size)
+                reader.fail("vector change index past the length");
+    }
+    else
+        parse_value(reader, delta);
+}
+
+template <typename T> void append_patch(std::string& out, const patch<T>& delta)
+{
+    out += '{';
+    bool first = true;
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (
+            [&]
+            {
+                if (!delta.changed(I))
+                    return;
+                if (!first)
+                    out += ',';
+                first = false;
+                append_quoted(out, field_name(std::get<I>(MetaTuple<T>::fields)));
+                out += ':';
+                append_delta<typename meta::detail::diff_field<T, I>::type>(out, std::get<I>(delta.values));
+            }(),
+            ...);
+    }(std::make_index_sequence<meta::detail::diff_field_count<T>>{});
+    out += '}';
+}
+
+template <typename T> void parse_patch_object(Reader& reader, patch<T>& delta)
+{
+    using mask_type = typename patch<T>::mask_type;
+    delta.mask = 0;
+    reader.expect('{');
+    if (reader.consume('}'))
+        return;
+
+    std::string scratch;
+    do
+    {
+        bool escaped = false;
+        std::string_view key = reader.string_token(escaped);
+        if (escaped)
+        {
+            scratch.clear();
+            reader.unescape(key, scratch);
+            key = scratch;
+        }
+        reader.expect(':');
+
+        bool found = false;
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (
+                [&]
+                {
+                    if constexpr (meta::detail::diff_has_member<T, I>)
+                    {
+                        if (found || field_name(std::get<I>(MetaTuple<T>::fields)) != key)
+                            return;
+                        found = true;
+                        parse_delta<typename meta::detail::diff_field<T, I>::type>(reader, std::get<I>(delta.values));
+                        delta.mask |= static_cast<mask_type>(uint64_t{1} << I);
+                    }
+                }(),
+                ...);
+        }(std::make_index_sequence<meta::detail::diff_field_count<T>>{});
+        if (!found)
+            reader.skip_value();
+    } while (reader.consume(','));
+    reader.expect('}');
+}
+
+} // namespace detail
+
+// The changed fields as a JSON object
+template <typename T> std::string serialize_patch(const patch<T>& delta)
+{
+    std::string out;
+    detail::append_patch(out, delta);
+    return out;
+}
+
+template <typename T> patch<T> parse_patch(std::string_view text)
+{
+    Reader reader(text);
+    patch<T> delta;
+    detail::parse_patch_object(reader, delta);
+    if (!reader.at_end())
+        reader.fail("trailing characters");
+    return delta;
+}
+
+} // namespace json
+} // namespace meta
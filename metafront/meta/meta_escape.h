@@ -0,0 +1,284 @@
+/*
+ * ================================================================
+ * ESCAPE KERNELS
+ *
+ * Shared scanning kernels for the JSON, XML, CSV and YAML writers (and
+ * the JSON reader). Text is scanned 32 (AVX2) or 16 (SSSE3) bytes at a
+ * time for any byte of a CharSet; clean runs are handed back in bulk and
+ * only the rare special bytes are handled one at a time.
+ *
+ * The SIMD path is a nibble lookup ("shufti"): each byte's low and high
+ * nibble index two 16-entry tables and the byte is special when the two
+ * entries share a bit. That matches any set whose members span at most 8
+ * distinct high nibbles, which covers every escape set used here; larger
+ * sets use the scalar table. The kernel is picked once at startup from
+ * the CPU features (AVX2, then SSSE3, then scalar).
+ *
+ * Usage:
+ *   static constexpr meta::escape::CharSet specials("<>&", true);
+ *   meta::escape::scan_runs(text, specials,
+ *       [&](std::string_view run) { out += run; },
+ *       [&](char c) { out += entity(c); });
+ * ================================================================
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define META_ESCAPE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace meta
+{
+namespace escape
+{
+
+// A set of bytes to stop at, usable by both the scalar and SIMD kernels
+class CharSet
+{
+  public:
+    // specials: the bytes in the set; controls: also every byte below 0x20
+    constexpr CharSet(std::string_view specials, bool controls = false)
+    {
+        if (controls)
+        {
+            for (int c = 0; c < 0x20; ++c)
+                add(static_cast<unsigned char>(c));
+        }
+        for (char c : specials)
+            add(static_cast<unsigned char>(c));
+    }
+
+    constexpr bool contains(unsigned char c) const
+    {
+        return table_[c];
+    }
+
+    // The nibble tables match exactly (at most 8 distinct high nibbles)
+    constexpr bool vectorizable() const
+    {
+        return buckets_ <= 8;
+    }
+
+    const uint8_t* low_table() const
+    {
+        return low_.data();
+    }
+    const uint8_t* high_table() const
+    {
+        return high_.data();
+    }
+
+  private:
+    constexpr void add(unsigned char c)
+    {
+        table_[c] = true;
+
+        // one bucket bit per distinct high nibble
+        unsigned hi = c >> 4;
+        if (bucket_[hi] == 0)
+        {
+            ++buckets_;
+            if (buckets_ > 8)
+                return;
+            bucket_[hi] = static_cast<uint8_t>(1u << (buckets_ - 1));
+        }
+        high_[hi] = bucket_[hi];
+        low_[c & 0xF] = static_cast<uint8_t>(low_[c & 0xF] | bucket_[hi]);
+    }
+
+    std::array<bool, 256> table_{};
+    alignas(16) std::array<uint8_t, 16> low_{};
+    alignas(16) std::array<uint8_t, 16> high_{};
+    std::array<uint8_t, 16> bucket_{};
+    unsigned buckets_ = 0;
+};
+
+enum class Kernel
+{
+    Scalar,
+    SSSE3,
+    AVX2,
+};
+
+namespace detail
+{
+
+inline size_t find_scalar(const char* data, size_t size, const CharSet& set)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (set.contains(static_cast<unsigned char>(data[i])))
+            return i;
+    }
+    return size;
+}
+
+#ifdef META_ESCAPE_X86
+
+__attribute__((target("ssse3"))) inline size_t find_ssse3(const char* data,
+                                                         size_t size,
+                                                         const CharSet& set)
+{
+    const __m128i low = _mm_load_si128(reinterpret_cast<const __m128i*>(set.low_table()));
+    const __m128i high = _mm_load_si128(reinterpret_cast<const __m128i*>(set.high_table()));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i lo = _mm_shuffle_epi8(low, _mm_and_si128(v, nibble));
+        __m128i hi = _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        __m128i clean = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), zero);
+        unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(clean)) & 0xFFFFu;
+        if (mask != 0)
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    return i + find_scalar(data + i, size - i, set);
+}
+
+__attribute__((target("avx2"))) inline size_t find_avx2(const char* data,
+                                                       size_t size,
+                                                       const CharSet& set)
+{
+    const __m256i low = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(set.low_table())));
+    const __m256i high = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(set.high_table())));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i lo = _mm256_shuffle_epi8(low, _mm256_and_si256(v, nibble));
+        __m256i hi =
+            _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        __m256i clean = _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), zero);
+        unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(clean));
+        if (mask != 0)
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    return i + find_ssse3(data + i, size - i, set);
+}
+
+#endif
+
+using FindFn = size_t (*)(const char*, size_t, const CharSet&);
+
+inline Kernel best_kernel()
+{
+#ifdef META_ESCAPE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return Kernel::AVX2;
+    if (__builtin_cpu_supports("ssse3"))
+        return Kernel::SSSE3;
+#endif
+    return Kernel::Scalar;
+}
+
+inline FindFn kernel_fn(Kernel kernel)
+{
+    switch (kernel)
+    {
+#ifdef META_ESCAPE_X86
+    case Kernel::AVX2:
+        return find_avx2;
+    case Kernel::SSSE3:
+        return find_ssse3;
+#endif
+    default:
+        return find_scalar;
+    }
+}
+
+struct Dispatch
+{
+    Kernel kernel = best_kernel();
+    FindFn find = kernel_fn(kernel);
+};
+
+inline Dispatch& dispatch()
+{
+    static Dispatch state;
+    return state;
+}
+
+} // namespace detail
+
+// Kernel in use (chosen from the CPU on first use)
+inline Kernel active_kernel()
+{
+    return detail::dispatch().kernel;
+}
+
+// Override the kernel (benchmarks and tests); kernels the CPU lacks are not checked
+inline void use_kernel(Kernel kernel)
+{
+    detail::dispatch() = {kernel, detail::kernel_fn(kernel)};
+}
+
+inline const char* kernel_name(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Kernel::AVX2:
+        return "avx2";
+    case Kernel::SSSE3:
+        return "ssse3";
+    default:
+        return "scalar";
+    }
+}
+
+// Offset of the first byte of str in set, or str.size()
+inline size_t find_first(std::string_view str, const CharSet& set)
+{
+    // short strings are not worth the indirect call
+    if (str.size() < 16 || !set.vectorizable())
+        return detail::find_scalar(str.data(), str.size(), set);
+    return detail::dispatch().find(str.data(), str.size(), set);
+}
+
+inline bool contains_any(std::string_view str, const CharSet& set)
+{
+    return find_first(str, set) != str.size();
+}
+
+// Splits str at bytes of set: run(string_view) gets each clean stretch
+// (possibly empty runs are skipped), special(char) each byte in the set.
+template <typename RunFn, typename SpecialFn>
+void scan_runs(std::string_view str, const CharSet& set, RunFn&& run, SpecialFn&& special)
+{
+    while (!str.empty())
+    {
+        size_t hit = find_first(str, set);
+        if (hit != 0)
+            run(str.substr(0, hit));
+        if (hit == str.size())
+            return;
+        special(str[hit]);
+        str.remove_prefix(hit + 1);
+    }
+}
+
+// scan_runs into a std::string
+template <typename SpecialFn>
+void append_escaped(std::string& out, std::string_view str, const CharSet& set, SpecialFn&& special)
+{
+    scan_runs(
+        str, set, [&](std::string_view run) { out.append(run); }, [&](char c) { special(out, c); });
+}
+
+} // namespace escape
+} // namespace meta
@@ -7,6 +7,7 @@
 #include <array>
 #include <string_view>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace meta
@@ -76,6 +77,7 @@ using Attributes = std::unordered_map<std::string, std::string>;
 inline constexpr const char* CSV_COLUMN = "csv_column";
 inline constexpr const char* SQL_COLUMN = "sql_column";
 inline constexpr const char* SRC_NAME   = "src_name";
+inline constexpr const char* PROTO_TYPE = "proto_type";  // sint32, fixed64, ... (meta_proto.h)
 
 // Helper: detect if member pointer is accessible
 template <typename T, typename U, U T::* MemberPtr> struct is_member_accessible
@@ -158,6 +160,13 @@ struct Field
         return !attributes.empty();
     }
     
+    // Attribute value without copying it out; nullptr if absent
+    const std::string* findAttribute(const std::string& key) const
+    {
+        auto it = attributes.find(key);
+        return it != attributes.end() ? &it->second : nullptr;
+    }
+
     std::optional<std::string> getCsvColumn() const 
     {
         return getAttribute(CSV_COLUMN);
@@ -192,10 +201,142 @@ struct Field
     }
 };
 
-// Primary template (generic types will fail)
+// ----------------------------------------------------------------
+// Compile-time field metadata
+//
+// StaticField takes the name, the type spelling and the attributes as
+// template arguments, so they are constexpr string_views: nothing is built
+// during static initialization, and getCsvColumn()/getSqlColumn() (and the
+// resolved csvColumn/sqlColumn) are constants. It has the members of Field,
+// plus memberName/typeName as spelled by the FieldMeta-based serializers,
+// so every serializer accepts either. metafront --static-fields emits it:
+//
+//   inline constexpr auto FieldsMeta = std::make_tuple(
+//       meta::StaticField<&::Row::id, "id", "int", meta::Prop::PrimaryKey>{},
+//       meta::StaticField<&::Row::name, "name", "std::string", meta::Prop::None,
+//                         meta::Attr{"csv_column", "NAME"}>{});
+// ----------------------------------------------------------------
+
+// String literal usable as a template argument
+template <size_t N> struct fixed_string
+{
+    char value[N]{};
+
+    constexpr fixed_string(const char (&str)[N])
+    {
+        for (size_t i = 0; i < N; ++i)
+            value[i] = str[i];
+    }
+
+    constexpr std::string_view view() const
+    {
+        return {value, N - 1};
+    }
+};
+
+// One key/value annotation of a StaticField
+template <size_t K, size_t V> struct Attr
+{
+    fixed_string<K> key;
+    fixed_string<V> value;
+
+    constexpr Attr(const char (&k)[K], const char (&v)[V]) : key(k), value(v)
+    {
+    }
+};
+
+namespace detail
+{
+
+template <auto MemberPtr> struct member_pointer_traits;
+template <typename C, typename T, T C::* M> struct member_pointer_traits<M>
+{
+    using class_type = C;
+    using member_type = T;
+};
+
+// First value for key among Attrs
+template <auto... Attrs>
+constexpr std::optional<std::string_view> find_attribute([[maybe_unused]] std::string_view key)
+{
+    std::optional<std::string_view> found;
+    ((!found && Attrs.key.view() == key ? (void)(found = Attrs.value.view()) : (void)0), ...);
+    return found;
+}
+
+} // namespace detail
+
+template <auto MemberPtr,
+          fixed_string Name,
+          fixed_string TypeName = "",
+          Prop Props = Prop::None,
+          auto... Attrs>
+struct StaticField
+{
+    using Class = typename detail::member_pointer_traits<MemberPtr>::class_type;
+    using type = typename detail::member_pointer_traits<MemberPtr>::member_type;
+    using FieldType = type;
+    static constexpr Prop properties = Props;
+    static constexpr type Class::* memberPtr = MemberPtr;
+
+    // No accessor pointers: metafront only sees the data member (the runtime
+    // meta::field it emits leaves them null too), so get/set and meta::tracked
+    // always go through memberPtr.
+    static constexpr GetterPtr_t<Class, type> getterPtr = nullptr;
+    static constexpr SetterPtr_t<Class, type> setterPtr = nullptr;
+
+    static constexpr std::string_view fieldName = Name.view();
+    static constexpr std::string_view fieldType = TypeName.view();
+    static constexpr std::string_view cleanName = fieldName;
+    static constexpr std::string_view memberName = fieldName;
+    static constexpr std::string_view typeName = fieldType;
+
+    static constexpr std::array<std::pair<std::string_view, std::string_view>, sizeof...(Attrs)>
+        attributes{{{Attrs.key.view(), Attrs.value.view()}...}};
+
+    static constexpr std::optional<std::string_view> getAttribute(std::string_view key)
+    {
+        return detail::find_attribute<Attrs...>(key);
+    }
+    static constexpr bool hasAttribute(std::string_view key)
+    {
+        return detail::find_attribute<Attrs...>(key).has_value();
+    }
+    static constexpr bool hasAttributes()
+    {
+        return sizeof...(Attrs) != 0;
+    }
+    static constexpr std::optional<std::string_view> getCsvColumn()
+    {
+        return detail::find_attribute<Attrs...>(CSV_COLUMN);
+    }
+    static constexpr std::optional<std::string_view> getSqlColumn()
+    {
+        return detail::find_attribute<Attrs...>(SQL_COLUMN);
+    }
+
+    // Column names with the attribute applied (the field name otherwise)
+    static constexpr std::string_view csvColumn =
+        detail::find_attribute<Attrs...>(CSV_COLUMN).value_or(fieldName);
+    static constexpr std::string_view sqlColumn =
+        detail::find_attribute<Attrs...>(SQL_COLUMN).value_or(fieldName);
+
+    static constexpr type get(const Class& obj)
+    {
+        return obj.*MemberPtr;
+    }
+    static constexpr void set(Class& obj, const type& value)
+    {
+        obj.*MemberPtr = value;
+    }
+};
+
+// Primary template: metafront generates a specialization with fields,
+// tableName and query for every reflected type. It stays empty (rather than
+// static_assert) so serializers can test for reflection with
+// requires { MetaTuple<T>::fields; }.
 template <typename T> struct MetaTuple
 {
-    static_assert(sizeof(T) == 0, "No metadata tuple defined for this type");
 };
 
 } // namespace meta
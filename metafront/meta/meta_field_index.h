@@ -0,0 +1,109 @@
+/*
+ * ================================================================
+ * FIELD NAME INDEX
+ *
+ * Shared name-to-field lookup for the readers (meta::json, meta::xml,
+ * meta::yaml): each key, element or attribute name they read is turned
+ * into a position in MetaTuple<T>::fields. The names of a meta::Field are
+ * only known at run time, so the table is built once per type on first
+ * use: a perfect hash (a seed and a power-of-two slot count with no
+ * collisions) that answers with one hash, one slot load and one compare.
+ *
+ * Readers pass a hint, the field after the previous match; records
+ * written by the matching writer list their fields in order, so the
+ * hint usually hits and the hash is skipped.
+ *
+ * Usage (inside a reader's per-type table):
+ *   meta::detail::FieldNameIndex<count> index_(names(), "meta::json");
+ *   size_t field = index_.find(key, hint);   // count when there is no such field
+ * ================================================================
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace meta
+{
+namespace detail
+{
+
+// FNV-1a of a field name, folded so the low bits (the slot) see the high ones
+constexpr uint32_t field_name_hash(std::string_view name, uint32_t seed)
+{
+    uint32_t h = 2166136261u ^ seed;
+    for (char c : name)
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+template <size_t N> class FieldNameIndex
+{
+  public:
+    // names must outlive the index (they are the MetaTuple field names);
+    // format prefixes the duplicate-name error
+    FieldNameIndex(const std::array<std::string_view, N>& names, const char* format) : names_(names)
+    {
+        auto sorted = names;
+        std::sort(sorted.begin(), sorted.end());
+        auto duplicate = std::adjacent_find(sorted.begin(), sorted.end());
+        if (duplicate != sorted.end())
+            throw std::logic_error(std::string(format) + ": duplicate field name '" +
+                                   std::string(*duplicate) + "'");
+
+        size_t size = 1;
+        while (size < N * 2)
+            size <<= 1;
+        for (;; size <<= 1)
+        {
+            for (uint32_t seed = 0; seed < 256; ++seed)
+            {
+                if (build(size, seed))
+                    return;
+            }
+        }
+    }
+
+    // Index of the field named name, or N; hint is tried first
+    size_t find(std::string_view name, size_t hint = N) const
+    {
+        if (hint < N && names_[hint] == name)
+            return hint;
+        int field = slots_[field_name_hash(name, seed_) & mask_];
+        return field >= 0 && names_[static_cast<size_t>(field)] == name ? static_cast<size_t>(field)
+                                                                         : N;
+    }
+
+  private:
+    bool build(size_t size, uint32_t seed)
+    {
+        slots_.assign(size, -1);
+        mask_ = static_cast<uint32_t>(size - 1);
+        seed_ = seed;
+        for (size_t i = 0; i < N; ++i)
+        {
+            int& slot = slots_[field_name_hash(names_[i], seed) & mask_];
+            if (slot >= 0)
+                return false;
+            slot = static_cast<int>(i);
+        }
+        return true;
+    }
+
+    std::array<std::string_view, N> names_;
+    std::vector<int> slots_;
+    uint32_t mask_ = 0;
+    uint32_t seed_ = 0;
+};
+
+} // namespace detail
+} // namespace meta
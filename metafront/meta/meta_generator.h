@@ -0,0 +1,139 @@
+#pragma once
+// Single-pass coroutine generator shared by the row sources (FetchRowsGeneratorT
+// in meta_sql.h, meta::csv::records) and anything that consumes them with a
+// range-for. Values are produced lazily, one per resume.
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <utility>
+
+//-------------------- GENERATOR --------------------
+template <typename T> class Generator
+{
+  public:
+    using YieldType = T;
+
+    struct promise_type
+    {
+        YieldType current_value;
+        std::exception_ptr exception;
+
+        Generator get_return_object()
+        {
+            return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+        std::suspend_always final_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_always yield_value(YieldType value) noexcept
+        {
+            current_value = std::move(value);
+            return {};
+        }
+
+        void return_void() noexcept
+        {
+        }
+        void unhandled_exception()
+        {
+            exception = std::current_exception();
+        }
+    };
+
+    using handle_type = std::coroutine_handle<promise_type>;
+    explicit Generator(handle_type h) : coro_(h)
+    {
+    }
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+    Generator(Generator&& other) noexcept : coro_(other.coro_)
+    {
+        other.coro_ = {};
+    }
+    Generator& operator=(Generator&& other) noexcept
+    {
+        if (coro_)
+            coro_.destroy();
+        coro_ = other.coro_;
+        other.coro_ = {};
+        return *this;
+    }
+    ~Generator()
+    {
+        if (coro_)
+            coro_.destroy();
+    }
+
+    class iterator
+    {
+      public:
+        using value_type = YieldType;
+        using reference = YieldType&;
+        using pointer = YieldType*;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::input_iterator_tag;
+
+        iterator() : coro_(), done_(true)
+        {
+        }
+        explicit iterator(handle_type h) : coro_(h), done_(!h || h.done())
+        {
+        }
+
+        iterator& operator++()
+        {
+            coro_.resume();
+            if (coro_.promise().exception)
+                std::rethrow_exception(coro_.promise().exception);
+            done_ = coro_.done();
+            return *this;
+        }
+
+        reference operator*() const
+        {
+            return coro_.promise().current_value;
+        }
+        pointer operator->() const
+        {
+            return &coro_.promise().current_value;
+        }
+        bool operator==(std::default_sentinel_t) const
+        {
+            return done_;
+        }
+        bool operator!=(std::default_sentinel_t) const
+        {
+            return !done_;
+        }
+
+      private:
+        handle_type coro_;
+        bool done_ = true;
+    };
+
+    iterator begin()
+    {
+        if (coro_)
+        {
+            coro_.resume();
+            if (coro_.promise().exception)
+                std::rethrow_exception(coro_.promise().exception);
+        }
+        return iterator{coro_};
+    }
+
+    std::default_sentinel_t end()
+    {
+        return {};
+    }
+
+  private:
+    handle_type coro_;
+};
@@ -0,0 +1,482 @@
+/*
+ * ================================================================
+ * REFLECTED HASHING AND EQUALITY
+ *
+ * meta::hash<T> and meta::equal<T> hash and compare reflected records by
+ * folding over MetaTuple<T>::fields: the fields flagged Prop::Hashable when
+ * there are any, every field otherwise. They drop into the standard
+ * containers in place of hand-written hashers:
+ *
+ *   std::unordered_map<CacheKey, Entry, meta::hash<CacheKey>, meta::equal<CacheKey>> cache;
+ *
+ * Values, recursively:
+ *   reflected structs         their fields, as above
+ *   integers, enums, bool     the value
+ *   float, double             the value, with -0.0 hashed as 0.0
+ *   strings, string_views     the bytes (a std::string and a string_view of
+ *                             it hash the same)
+ *   time_point, duration      the tick count
+ *   optional, variant         engaged flag / index, then the value
+ *   pair, tuple               the elements
+ *   ranges                    the elements, then the length; unordered
+ *                             containers combine element hashes without
+ *                             regard to order
+ *   anything else             std::hash and operator==
+ *
+ * Mixing is 64x64->128-bit multiply-and-fold (the wyhash construction):
+ * fast, not cryptographic. Bytes go through 48-byte blocks. Runs of
+ * adjacent integer/enum fields with no padding between them, and vectors of
+ * such values, are hashed and compared as one block of memory.
+ *
+ * Usage:
+ *   size_t h = meta::hash<Row>{}(row);
+ *   bool same = meta::equal<Row>{}(a, b);
+ *   uint64_t h64 = meta::hash_value(row, seed);
+ * ================================================================
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace meta
+{
+
+namespace detail
+{
+
+inline constexpr uint64_t hash_secret[4] = {0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull,
+                                            0x589965cc75374cc3ull};
+
+// a * b as 128 bits, low half to a, high half to b
+inline void hash_mum(uint64_t& a, uint64_t& b)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    a = static_cast<uint64_t>(r);
+    b = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    a = _umul128(a, b, &b);
+#else
+    uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    a = lo;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+inline uint64_t hash_mix(uint64_t a, uint64_t b)
+{
+    hash_mum(a, b);
+    return a ^ b;
+}
+
+inline uint64_t hash_read8(const unsigned char* p)
+{
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint64_t hash_read4(const unsigned char* p)
+{
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+// One integer folded into the running hash
+inline uint64_t hash_word(uint64_t seed, uint64_t value)
+{
+    return hash_mix(value ^ hash_secret[1], seed ^ hash_secret[0]);
+}
+
+// Bytes folded into the running hash; the length is part of the result
+inline uint64_t hash_bytes(const void* data, size_t length, uint64_t seed)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    seed ^= hash_mix(seed ^ hash_secret[0], hash_secret[1]);
+    uint64_t a, b;
+    if (length <= 16)
+    {
+        if (length >= 4)
+        {
+            size_t step = (length >> 3) << 2;
+            a = (hash_read4(p) << 32) | hash_read4(p + step);
+            b = (hash_read4(p + length - 4) << 32) | hash_read4(p + length - 4 - step);
+        }
+        else if (length > 0)
+        {
+            a = (uint64_t{p[0]} << 16) | (uint64_t{p[length >> 1]} << 8) | p[length - 1];
+            b = 0;
+        }
+        else
+            a = b = 0;
+    }
+    else
+    {
+        size_t i = length;
+        if (i > 48)
+        {
+            uint64_t see1 = seed, see2 = seed;
+            do
+            {
+                seed = hash_mix(hash_read8(p) ^ hash_secret[1], hash_read8(p + 8) ^ seed);
+                see1 = hash_mix(hash_read8(p + 16) ^ hash_secret[2], hash_read8(p + 24) ^ see1);
+                see2 = hash_mix(hash_read8(p + 32) ^ hash_secret[3], hash_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16)
+        {
+            seed = hash_mix(hash_read8(p) ^ hash_secret[1], hash_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = hash_read8(p + i - 16);
+        b = hash_read8(p + i - 8);
+    }
+    a ^= hash_secret[1];
+    b ^= seed;
+    hash_mum(a, b);
+    return hash_mix(a ^ hash_secret[0] ^ length, b ^ hash_secret[1]);
+}
+
+template <typename T>
+concept hash_reflected = requires { MetaTuple<T>::fields; };
+
+template <typename T>
+concept hash_string = std::is_convertible_v<const T&, std::string_view> && !std::is_same_v<T, std::nullptr_t>;
+
+template <typename T>
+concept hash_unordered = requires { typename T::hasher; };
+
+template <typename T> struct is_hash_optional : std::false_type
+{
+};
+template <typename T> struct is_hash_optional<std::optional<T>> : std::true_type
+{
+};
+
+template <typename T> struct is_hash_variant : std::false_type
+{
+};
+template <typename... T> struct is_hash_variant<std::variant<T...>> : std::true_type
+{
+};
+
+template <typename T> struct is_hash_chrono : std::false_type
+{
+};
+template <typename C, typename D> struct is_hash_chrono<std::chrono::time_point<C, D>> : std::true_type
+{
+};
+template <typename R, typename P> struct is_hash_chrono<std::chrono::duration<R, P>> : std::true_type
+{
+};
+
+template <typename T>
+concept hash_tuple_like = requires { std::tuple_size<T>::value; } && !std::ranges::range<T>;
+
+// Values whose bytes are their identity: equal exactly when their bytes are
+template <typename V>
+inline constexpr bool hash_block = (std::is_integral_v<V> || std::is_enum_v<V>) &&
+                                   std::has_unique_object_representations_v<V>;
+
+template <> inline constexpr bool hash_block<bool> = false;
+
+template <typename T> uint64_t hash_append(uint64_t seed, const T& value);
+template <typename T> bool equal_value(const T& a, const T& b);
+
+// ----------------------------------------------------------------
+// Reflected fields
+// ----------------------------------------------------------------
+
+template <typename T>
+using hash_fields = std::remove_cvref_t<decltype(MetaTuple<T>::fields)>;
+
+template <typename T, size_t I> using hash_field = std::remove_cvref_t<std::tuple_element_t<I, hash_fields<T>>>;
+
+template <typename T, size_t I> inline constexpr bool hash_has_member = hash_field<T, I>::memberPtr != nullptr;
+
+// The fields taking part: the Prop::Hashable ones, or all of them
+template <typename T> constexpr auto select_hashed_fields()
+{
+    constexpr size_t count = std::tuple_size_v<hash_fields<T>>;
+    constexpr auto flagged = []<size_t... I>(std::index_sequence<I...>)
+    {
+        return (size_t{0} + ... + (hash_has_member<T, I> && (hash_field<T, I>::properties & Prop::Hashable) ? 1 : 0));
+    }(std::make_index_sequence<count>{});
+    constexpr auto members = []<size_t... I>(std::index_sequence<I...>)
+    {
+        return (size_t{0} + ... + (hash_has_member<T, I> ? 1 : 0));
+    }(std::make_index_sequence<count>{});
+
+    std::array<size_t, flagged != 0 ? flagged : members> selected{};
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        size_t next = 0;
+        auto take = [&](size_t index, bool chosen)
+        {
+            if (chosen)
+                selected[next++] = index;
+        };
+        (take(I, hash_has_member<T, I> &&
+                     (flagged == 0 || (hash_field<T, I>::properties & Prop::Hashable))),
+         ...);
+    }(std::make_index_sequence<count>{});
+    return selected;
+}
+
+template <typename T> inline constexpr auto hashed_fields = select_hashed_fields<T>();
+
+template <typename T, size_t Pos> using hashed_type = typename hash_field<T, hashed_fields<T>[Pos]>::type;
+
+template <typename T, size_t Pos> const auto& hashed_member(const T& obj)
+{
+    return obj.*hash_field<T, hashed_fields<T>[Pos]>::memberPtr;
+}
+
+// Last position of the run of block fields starting at Pos
+template <typename T, size_t Pos> constexpr size_t block_run_end()
+{
+    if constexpr (Pos + 1 < hashed_fields<T>.size())
+    {
+        if constexpr (hash_block<hashed_type<T, Pos>> && hash_block<hashed_type<T, Pos + 1>>)
+            return block_run_end<T, Pos + 1>();
+        else
+            return Pos;
+    }
+    else
+        return Pos;
+}
+
+template <typename T, size_t First, size_t Last> constexpr size_t block_run_bytes()
+{
+    return []<size_t... K>(std::index_sequence<K...>)
+    {
+        return (size_t{0} + ... + sizeof(hashed_type<T, First + K>));
+    }(std::make_index_sequence<Last - First + 1>{});
+}
+
+// Whether fields First..Last sit back to back in memory (a constant the
+// compiler folds: the offsets do not depend on obj)
+template <typename T, size_t First, size_t Last> bool block_run_contiguous(const T& obj)
+{
+    bool adjacent = true;
+    [&]<size_t... K>(std::index_sequence<K...>)
+    {
+        ((adjacent = adjacent && reinterpret_cast<const char*>(&hashed_member<T, First + K>(obj)) +
+                                         sizeof(hashed_type<T, First + K>) ==
+                                     reinterpret_cast<const char*>(&hashed_member<T, First + K + 1>(obj))),
+         ...);
+    }(std::make_index_sequence<Last - First>{});
+    return adjacent;
+}
+
+template <typename T, size_t Pos = 0> uint64_t hash_fields_from(const T& obj, uint64_t seed)
+{
+    if constexpr (Pos == hashed_fields<T>.size())
+        return seed;
+    else
+    {
+        constexpr size_t last = block_run_end<T, Pos>();
+        if constexpr (last > Pos)
+        {
+            if (block_run_contiguous<T, Pos, last>(obj))
+                seed = hash_bytes(&hashed_member<T, Pos>(obj), block_run_bytes<T, Pos, last>(), seed);
+            else
+                [&]<size_t... K>(std::index_sequence<K...>)
+                {
+                    ((seed = hash_append(seed, hashed_member<T, Pos + K>(obj))), ...);
+                }(std::make_index_sequence<last - Pos + 1>{});
+        }
+        else
+            seed = hash_append(seed, hashed_member<T, Pos>(obj));
+        return hash_fields_from<T, last + 1>(obj, seed);
+    }
+}
+
+template <typename T, size_t Pos = 0> bool equal_fields_from(const T& a, const T& b)
+{
+    if constexpr (Pos == hashed_fields<T>.size())
+        return true;
+    else
+    {
+        constexpr size_t last = block_run_end<T, Pos>();
+        bool same;
+        if constexpr (last > Pos)
+        {
+            if (block_run_contiguous<T, Pos, last>(a))
+                same = std::memcmp(&hashed_member<T, Pos>(a), &hashed_member<T, Pos>(b),
+                                   block_run_bytes<T, Pos, last>()) == 0;
+            else
+                same = [&]<size_t... K>(std::index_sequence<K...>)
+                {
+                    return (... && equal_value(hashed_member<T, Pos + K>(a), hashed_member<T, Pos + K>(b)));
+                }(std::make_index_sequence<last - Pos + 1>{});
+        }
+        else
+            same = equal_value(hashed_member<T, Pos>(a), hashed_member<T, Pos>(b));
+        return same && equal_fields_from<T, last + 1>(a, b);
+    }
+}
+
+// ----------------------------------------------------------------
+// Values
+// ----------------------------------------------------------------
+
+template <typename T> uint64_t hash_append(uint64_t seed, const T& value)
+{
+    if constexpr (hash_reflected<T>)
+        return hash_fields_from(value, seed);
+    else if constexpr (hash_string<T>)
+    {
+        std::string_view bytes(value);
+        return hash_bytes(bytes.data(), bytes.size(), seed);
+    }
+    else if constexpr (std::is_enum_v<T>)
+        return hash_word(seed, static_cast<uint64_t>(static_cast<std::underlying_type_t<T>>(value)));
+    else if constexpr (std::is_integral_v<T>)
+        return hash_word(seed, static_cast<uint64_t>(value));
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        double number = value == 0 ? 0.0 : static_cast<double>(value);
+        return hash_word(seed, std::bit_cast<uint64_t>(number));
+    }
+    else if constexpr (is_hash_chrono<T>::value)
+    {
+        if constexpr (requires { value.time_since_epoch(); })
+            return hash_append(seed, value.time_since_epoch().count());
+        else
+            return hash_append(seed, value.count());
+    }
+    else if constexpr (is_hash_optional<T>::value)
+        return value ? hash_append(hash_word(seed, 1), *value) : hash_word(seed, 0);
+    else if constexpr (is_hash_variant<T>::value)
+        return std::visit([&](const auto& alternative) { return hash_append(hash_word(seed, value.index()), alternative); },
+                          value);
+    else if constexpr (hash_unordered<T>)
+    {
+        // order-independent: a sum of element hashes
+        uint64_t sum = 0;
+        for (const auto& element : value)
+            sum += hash_append(hash_secret[2], element);
+        return hash_word(hash_word(seed, value.size()), sum);
+    }
+    else if constexpr (std::ranges::range<T>)
+    {
+        using Element = std::ranges::range_value_t<T>;
+        if constexpr (std::ranges::contiguous_range<T> && hash_block<Element>)
+            return hash_bytes(std::ranges::data(value), std::ranges::size(value) * sizeof(Element), seed);
+        else
+        {
+            size_t count = 0;
+            for (const auto& element : value)
+            {
+                seed = hash_append(seed, element);
+                ++count;
+            }
+            return hash_word(seed, count);
+        }
+    }
+    else if constexpr (hash_tuple_like<T>)
+        return std::apply([&](const auto&... elements) { return ((seed = hash_append(seed, elements)), ..., seed); },
+                          value);
+    else if constexpr (requires { std::hash<T>{}(value); })
+        return hash_word(seed, static_cast<uint64_t>(std::hash<T>{}(value)));
+    else
+        static_assert(!sizeof(T), "meta::hash: no hash for this type (reflect it, or specialize std::hash)");
+}
+
+template <typename T> bool equal_value(const T& a, const T& b)
+{
+    if constexpr (hash_reflected<T>)
+        return equal_fields_from(a, b);
+    else if constexpr (hash_string<T>)
+        return std::string_view(a) == std::string_view(b);
+    else if constexpr (is_hash_optional<T>::value)
+        return a.has_value() == b.has_value() && (!a || equal_value(*a, *b));
+    else if constexpr (is_hash_variant<T>::value)
+        return a.index() == b.index() &&
+               std::visit(
+                   [&](const auto& left)
+                   {
+                       using Alternative = std::remove_cvref_t<decltype(left)>;
+                       return equal_value(left, *std::get_if<Alternative>(&b));
+                   },
+                   a);
+    else if constexpr (hash_unordered<T>)
+        return a == b;
+    else if constexpr (std::ranges::range<T>)
+    {
+        using Element = std::ranges::range_value_t<T>;
+        if constexpr (std::ranges::sized_range<T>)
+        {
+            if (std::ranges::size(a) != std::ranges::size(b))
+                return false;
+        }
+        if constexpr (std::ranges::contiguous_range<T> && hash_block<Element>)
+            return std::ranges::size(a) == 0 ||
+                   std::memcmp(std::ranges::data(a), std::ranges::data(b), std::ranges::size(a) * sizeof(Element)) == 0;
+        else
+            return std::ranges::equal(a, b, [](const Element& x, const Element& y) { return equal_value(x, y); });
+    }
+    else if constexpr (hash_tuple_like<T>)
+        return [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            return (... && equal_value(std::get<I>(a), std::get<I>(b)));
+        }(std::make_index_sequence<std::tuple_size_v<T>>{});
+    else
+        return a == b;
+}
+
+} // namespace detail
+
+// 64-bit hash of value, seeded
+template <typename T> uint64_t hash_value(const T& value, uint64_t seed = 0)
+{
+    return detail::hash_append(seed, value);
+}
+
+template <typename T> struct hash
+{
+    size_t operator()(const T& value) const
+    {
+        return static_cast<size_t>(detail::hash_append(0, value));
+    }
+};
+
+template <typename T> struct equal
+{
+    bool operator()(const T& a, const T& b) const
+    {
+        return detail::equal_value(a, b);
+    }
+};
+
+} // namespace meta
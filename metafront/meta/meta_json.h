@@ -5,424 +5,1349 @@
  * Generated by Claude (Anthropic AI Assistant)
  *
  * This serializer automatically handles all C++ types including:
- * - Basic types (int, string, bool, double, etc.)
- * - Vectors (single, nested, triple-nested)
- * - Maps and complex key-value structures
+ * - Basic types (int, string, bool, double, enums, etc.)
+ * - Any range (vector, array, list, set, ...) as a JSON array
+ * - Maps (map, unordered_map, ...) as JSON objects
  * - Optional types with null handling
- * - Tuples as JSON arrays
- * - Mixed complex types and combinations
+ * - Tuples and pairs as JSON arrays
+ * - Variants as their active alternative
+ * - Nested reflected types (anything with a MetaTuple) as JSON objects
  *
  * Usage: meta::json::serialize(your_vector_of_objects)
  * ================================================================
  */
 
 #pragma once
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <concepts>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <optional>
-#include <sstream>
+#include <ranges>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <variant>
 #include <vector>
 
+#include "meta_escape.h"
+#include "meta_field_index.h"
+#include "meta_parallel.h"
+#include "meta_sink.h"
+#include "meta_soa.h"
+
 namespace meta
 {
 namespace json
 {
 
-// Helper function to escape JSON strings
-std::string escape_json_string(const std::string& str)
+// ================================================================
+// Buffer writer
+//
+// Appends into a caller-owned std::string instead of building a
+// stringstream per value: numbers go through std::to_chars, strings
+// through the shared escape kernels (meta_escape.h), and object keys are
+// rendered once per type. Reusing the same buffer (out.clear() keeps its capacity) makes
+// steady-state serialization allocation-free.
+//
+// Values are dispatched on concepts, so any combination of the supported
+// shapes nests: a std::unordered_map<std::string, std::vector<Row>> where
+// Row has a MetaTuple serializes without a dedicated overload.
+//
+// Usage:
+//   std::string buf;
+//   meta::json::serialize_to(buf, rows);   // compact, same shape as serialize_compact
+// ================================================================
+
+namespace detail
 {
-    std::string escaped;
-    for (char c : str)
+
+// Bytes that need escaping in a JSON string, and the end of a raw string token
+inline constexpr meta::escape::CharSet string_specials("\"\\", true);
+inline constexpr meta::escape::CharSet string_end("\"\\");
+
+// The character that follows the backslash for each special byte
+// ('u' means a \u00XX escape)
+inline constexpr std::array<char, 256> escape_table = []
+{
+    std::array<char, 256> table{};
+    for (int c = 0; c < 0x20; ++c)
+        table[c] = 'u';
+    table['"'] = '"';
+    table['\\'] = '\\';
+    table['\b'] = 'b';
+    table['\f'] = 'f';
+    table['\n'] = 'n';
+    table['\r'] = 'r';
+    table['\t'] = 't';
+    return table;
+}();
+
+template <typename T> struct is_optional : std::false_type
+{
+};
+template <typename T> struct is_optional<std::optional<T>> : std::true_type
+{
+};
+
+template <typename T> struct is_variant : std::false_type
+{
+};
+template <typename... Ts> struct is_variant<std::variant<Ts...>> : std::true_type
+{
+};
+
+// Field name as written by the generator (fieldName on meta::Field, memberName on FieldMeta)
+template <typename FieldMeta> std::string_view field_name(const FieldMeta& fieldMeta)
+{
+    if constexpr (requires { fieldMeta.fieldName; })
+        return fieldMeta.fieldName;
+    else
+        return fieldMeta.memberName;
+}
+
+} // namespace detail
+
+// ----------------------------------------------------------------
+// Type shapes
+// ----------------------------------------------------------------
+
+template <typename T>
+concept StringLike = std::is_convertible_v<const T&, std::string_view>;
+
+template <typename T>
+concept Reflected = requires { meta::MetaTuple<T>::fields; };
+
+template <typename T>
+concept Optional = detail::is_optional<T>::value;
+
+template <typename T>
+concept Variant = detail::is_variant<T>::value;
+
+template <typename T>
+concept MapLike = std::ranges::input_range<T> && requires {
+    typename T::key_type;
+    typename T::mapped_type;
+};
+
+template <typename T>
+concept RangeLike = std::ranges::input_range<T> && !StringLike<T> && !MapLike<T>;
+
+template <typename T>
+concept TupleLike = !std::ranges::range<T> && requires { std::tuple_size<T>::value; };
+
+// ----------------------------------------------------------------
+// Scalars
+// ----------------------------------------------------------------
+
+inline void append_escaped(std::string& out, std::string_view str)
+{
+    static constexpr char hex[] = "0123456789abcdef";
+
+    meta::escape::append_escaped(out,
+                                 str,
+                                 detail::string_specials,
+                                 [](std::string& buf, char ch)
+                                 {
+                                     auto c = static_cast<unsigned char>(ch);
+                                     char esc = detail::escape_table[c];
+                                     buf += '\\';
+                                     if (esc == 'u')
+                                     {
+                                         buf += "u00";
+                                         buf += hex[c >> 4];
+                                         buf += hex[c & 0xf];
+                                     }
+                                     else
+                                     {
+                                         buf += esc;
+                                     }
+                                 });
+}
+
+inline void append_quoted(std::string& out, std::string_view str)
+{
+    out += '"';
+    append_escaped(out, str);
+    out += '"';
+}
+
+template <typename T> void append_number(std::string& out, T value)
+{
+    if constexpr (std::is_floating_point_v<T>)
     {
-        switch (c)
+        // JSON has no NaN/Infinity
+        if (!std::isfinite(value))
         {
-        case '"':
-            escaped += "\\\"";
-            break;
-        case '\\':
-            escaped += "\\\\";
-            break;
-        case '\b':
-            escaped += "\\b";
-            break;
-        case '\f':
-            escaped += "\\f";
-            break;
-        case '\n':
-            escaped += "\\n";
-            break;
-        case '\r':
-            escaped += "\\r";
-            break;
-        case '\t':
-            escaped += "\\t";
-            break;
-        default:
-            escaped += c;
-            break;
+            out += "null";
+            return;
         }
     }
-    return escaped;
+
+    char buf[64];
+    auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, end);
 }
 
-// Forward declaration for recursive calls
-template <typename T> std::string format_json_value(const T& value);
+// ----------------------------------------------------------------
+// Recursive dispatch
+// ----------------------------------------------------------------
+
+template <typename T> void append_json_value(std::string& out, const T& value);
+template <typename ObjectType> void append_json_object(std::string& out, const ObjectType& obj);
+
+// Object keys must be strings: numbers and enums are quoted, anything else
+// is serialized and then quoted.
+template <typename K> void append_json_key(std::string& out, const K& key)
+{
+    if constexpr (StringLike<K>)
+    {
+        append_quoted(out, key);
+    }
+    else if constexpr (std::is_enum_v<K>)
+    {
+        out += '"';
+        append_number(out, static_cast<std::underlying_type_t<K>>(key));
+        out += '"';
+    }
+    else if constexpr (std::is_arithmetic_v<K> && !std::is_same_v<K, bool>)
+    {
+        out += '"';
+        append_number(out, key);
+        out += '"';
+    }
+    else
+    {
+        std::string rendered;
+        append_json_value(rendered, key);
+        append_quoted(out, rendered);
+    }
+}
 
-// Helper for tuples
 template <typename Tuple, std::size_t... Is>
-std::string format_tuple_json(const Tuple& t, std::index_sequence<Is...>)
+void append_tuple(std::string& out, const Tuple& t, std::index_sequence<Is...>)
 {
-    std::stringstream ss;
-    ss << "[";
-    ((ss << (Is == 0 ? "" : ",") << format_json_value(std::get<Is>(t))), ...);
-    ss << "]";
-    return ss.str();
+    using std::get;
+    out += '[';
+    ((out += (Is == 0 ? "" : ","), append_json_value(out, get<Is>(t))), ...);
+    out += ']';
 }
 
-// Helper to format vector as JSON array
-template <typename T> std::string format_vector_json(const std::vector<T>& vec)
+template <typename T> void append_json_value(std::string& out, const T& value)
 {
-    std::stringstream ss;
-    ss << "[";
-    for (size_t i = 0; i < vec.size(); ++i)
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        out += value ? "true" : "false";
+    }
+    else if constexpr (std::is_same_v<T, char>)
+    {
+        append_quoted(out, std::string_view(&value, 1));
+    }
+    else if constexpr (std::is_arithmetic_v<T>)
+    {
+        append_number(out, value);
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        append_number(out, static_cast<std::underlying_type_t<T>>(value));
+    }
+    else if constexpr (StringLike<T>)
+    {
+        append_quoted(out, value);
+    }
+    else if constexpr (std::is_same_v<T, std::nullopt_t> || std::is_same_v<T, std::nullptr_t> ||
+                       std::is_same_v<T, std::monostate>)
+    {
+        out += "null";
+    }
+    else if constexpr (Optional<T>)
+    {
+        if (value.has_value())
+            append_json_value(out, *value);
+        else
+            out += "null";
+    }
+    else if constexpr (Variant<T>)
+    {
+        std::visit([&](const auto& alternative) { append_json_value(out, alternative); }, value);
+    }
+    else if constexpr (Reflected<T>)
+    {
+        append_json_object(out, value);
+    }
+    else if constexpr (MapLike<T>)
+    {
+        out += '{';
+        bool first = true;
+        for (const auto& [key, item] : value)
+        {
+            if (!first)
+                out += ',';
+            first = false;
+            append_json_key(out, key);
+            out += ':';
+            append_json_value(out, item);
+        }
+        out += '}';
+    }
+    else if constexpr (RangeLike<T>)
     {
-        ss << format_json_value(vec[i]);
-        if (i < vec.size() - 1)
+        using Item = std::ranges::range_value_t<T>;
+        out += '[';
+        bool first = true;
+        for (auto&& item : value)
         {
-            ss << ",";
+            if (!first)
+                out += ',';
+            first = false;
+            // vector<bool> hands out proxies; convert back to the value type
+            if constexpr (std::is_same_v<Item, bool>)
+                append_json_value(out, static_cast<bool>(item));
+            else
+                append_json_value(out, item);
         }
+        out += ']';
+    }
+    else if constexpr (TupleLike<T>)
+    {
+        append_tuple(out, value, std::make_index_sequence<std::tuple_size_v<T>>{});
+    }
+    else
+    {
+        out += "\"unknown_type:";
+        append_escaped(out, typeid(T).name());
+        out += '"';
     }
-    ss << "]";
-    return ss.str();
 }
 
-// Helper to format map as JSON object
-template <typename K, typename V> std::string format_map_json(const std::map<K, V>& map)
+namespace detail
+{
+
+// "\"name\":" for every field of ObjectType, built on first use
+template <typename ObjectType> const auto& object_keys()
+{
+    using Fields = std::remove_cvref_t<decltype(meta::MetaTuple<ObjectType>::fields)>;
+    static const auto keys = []
+    {
+        std::array<std::string, std::tuple_size_v<Fields>> rendered;
+        std::apply(
+            [&](const auto&... fieldMeta)
+            {
+                size_t i = 0;
+                ((rendered[i] = "\"", append_escaped(rendered[i], field_name(fieldMeta)),
+                  rendered[i++] += "\":"),
+                 ...);
+            },
+            meta::MetaTuple<ObjectType>::fields);
+        return rendered;
+    }();
+    return keys;
+}
+
+// Calls fn(key, value) for every field that has a member pointer
+template <typename ObjectType, typename Fn> void for_each_field(const ObjectType& obj, Fn&& fn)
+{
+    const auto& keys = object_keys<ObjectType>();
+    std::apply(
+        [&](const auto&... fieldMeta)
+        {
+            size_t i = 0;
+            auto visit = [&](const auto& field)
+            {
+                constexpr auto memberPtr = std::remove_cvref_t<decltype(field)>::memberPtr;
+                if constexpr (memberPtr != nullptr)
+                    fn(keys[i], obj.*memberPtr);
+                ++i;
+            };
+            (visit(fieldMeta), ...);
+        },
+        meta::MetaTuple<ObjectType>::fields);
+}
+
+} // namespace detail
+
+template <typename ObjectType> void append_json_object(std::string& out, const ObjectType& obj)
 {
-    std::stringstream ss;
-    ss << "{";
+    out += '{';
     bool first = true;
-    for (const auto& [key, value] : map)
+    detail::for_each_field(obj,
+                           [&](const std::string& key, const auto& value)
+                           {
+                               if (!first)
+                                   out += ',';
+                               first = false;
+                               out += key;
+                               append_json_value(out, value);
+                           });
+    out += '}';
+}
+
+// Appends the objects as a compact JSON array
+template <typename ObjectType>
+void serialize_to(std::string& out, const std::vector<ObjectType>& objects)
+{
+    out += '[';
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        if (i != 0)
+            out += ',';
+        append_json_object(out, objects[i]);
+    }
+    out += ']';
+}
+
+// Columnar records, rebuilt one at a time; same bytes as for a vector
+template <typename ObjectType>
+void serialize_to(std::string& out, const meta::soa_vector<ObjectType>& objects)
+{
+    out += '[';
+    bool first = true;
+    for (const ObjectType& obj : objects.rows())
     {
         if (!first)
-            ss << ",";
-        ss << "\"" << key << "\":" << format_json_value(value);
+            out += ',';
         first = false;
+        append_json_object(out, obj);
     }
-    ss << "}";
-    return ss.str();
+    out += ']';
 }
 
-// Helper to format optional
-template <typename T> std::string format_optional_json(const std::optional<T>& opt)
+// ================================================================
+// String-returning API
+// ================================================================
+
+// Helper function to escape JSON strings
+inline std::string escape_json_string(const std::string& str)
+{
+    std::string escaped;
+    escaped.reserve(str.size());
+    append_escaped(escaped, str);
+    return escaped;
+}
+
+template <typename T> std::string format_json_value(const T& value)
 {
-    if (opt.has_value())
+    std::string out;
+    append_json_value(out, value);
+    return out;
+}
+
+// One element of serialize()'s array: "  {\n    \"key\": value,...\n  }"
+template <typename ObjectType> void append_pretty_object(std::string& out, const ObjectType& obj)
+{
+    out += "  {\n";
+
+    // keys are cached as "\"name\":"; the pretty form adds a space
+    bool first = true;
+    detail::for_each_field(obj,
+                           [&](const std::string& key, const auto& value)
+                           {
+                               out += first ? "    " : ",\n    ";
+                               first = false;
+                               out += key;
+                               out += ' ';
+                               append_json_value(out, value);
+                           });
+    out += "\n  }";
+}
+
+template <typename ObjectType> std::string serialize(const std::vector<ObjectType>& objects)
+{
+    std::string out = "[\n";
+
+    for (size_t i = 0; i < objects.size(); ++i)
     {
-        return format_json_value(opt.value());
+        append_pretty_object(out, objects[i]);
+
+        if (i < objects.size() - 1)
+        {
+            out += ',';
+        }
+        out += '\n';
     }
-    else
+
+    out += "]\n";
+    return out;
+}
+
+template <typename ObjectType> std::string serialize(const meta::soa_vector<ObjectType>& objects)
+{
+    std::string out = "[\n";
+    size_t i = 0;
+    for (const ObjectType& obj : objects.rows())
     {
-        return "null";
+        append_pretty_object(out, obj);
+        if (++i < objects.size())
+            out += ',';
+        out += '\n';
     }
+    out += "]\n";
+    return out;
 }
 
-// Main format function - handles all types
-template <typename T> std::string format_json_value(const T& value)
+// Compact version
+template <typename ObjectType> std::string serialize_compact(const std::vector<ObjectType>& objects)
 {
-    std::stringstream ss;
+    std::string out;
+    serialize_to(out, objects);
+    return out;
+}
+
+template <typename ObjectType> std::string serialize_compact(const meta::soa_vector<ObjectType>& objects)
+{
+    std::string out;
+    serialize_to(out, objects);
+    return out;
+}
 
-    // Basic types
-    if constexpr (std::is_same_v<T, std::string>)
+// serialize() (Layout::Pretty) or serialize_compact() with the records
+// formatted on up to `threads` threads (0 = one per core); same bytes
+template <typename ObjectType>
+std::string serialize_parallel(const std::vector<ObjectType>& objects,
+                               meta::Layout layout = meta::Layout::Pretty,
+                               size_t threads = 0)
+{
+    if (layout == meta::Layout::Compact)
     {
-        ss << "\"" << escape_json_string(value) << "\"";
+        std::string out = "[";
+        meta::append_parallel(
+            out,
+            objects,
+            [](std::string& buf, const ObjectType& obj, size_t i)
+            {
+                if (i != 0)
+                    buf += ',';
+                append_json_object(buf, obj);
+            },
+            threads);
+        out += ']';
+        return out;
     }
-    else if constexpr (std::is_same_v<T, const char*>)
+
+    std::string out = "[\n";
+    const size_t last = objects.size() - 1;
+    meta::append_parallel(
+        out,
+        objects,
+        [last](std::string& buf, const ObjectType& obj, size_t i)
+        {
+            append_pretty_object(buf, obj);
+            if (i != last)
+                buf += ',';
+            buf += '\n';
+        },
+        threads);
+    out += "]\n";
+    return out;
+}
+
+// ================================================================
+// Streaming writer
+//
+// writer<T> writes a JSON array one record at a time into a meta::Sink,
+// which flushes in blocks, so exporting from a generator (for instance
+// FetchRowsGeneratorT) never holds more than one row and one block of
+// text. The bytes match serialize() (Layout::Pretty) or
+// serialize_compact() (Layout::Compact) for the same rows.
+//
+// Usage:
+//   meta::json::writer<Row> out(meta::Sink::fd(1));
+//   for (const Row& row : rows)
+//       out.write(row);
+//   out.close();   // writes the closing bracket
+// ================================================================
+
+template <typename ObjectType> class writer
+{
+  public:
+    explicit writer(meta::Sink sink, meta::Layout layout = meta::Layout::Pretty)
+        : sink_(std::move(sink)), layout_(layout)
     {
-        ss << "\"" << escape_json_string(std::string(value)) << "\"";
+        sink_.buffer() += layout_ == meta::Layout::Pretty ? "[\n" : "[";
     }
-    else if constexpr (std::is_same_v<T, bool>)
+
+    ~writer()
     {
-        ss << (value ? "true" : "false");
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+        }
     }
 
-    // Numeric types
-    else if constexpr (std::is_same_v<T, int> || std::is_same_v<T, int32_t>)
+    writer(const writer&) = delete;
+    writer& operator=(const writer&) = delete;
+
+    void write(const ObjectType& obj)
     {
-        ss << value;
+        if (closed_)
+            throw std::logic_error("json: write after close");
+        auto& out = sink_.buffer();
+        if (layout_ == meta::Layout::Pretty)
+        {
+            // the separator goes before each record, since the last one has none
+            if (count_ != 0)
+                out += ",\n";
+            append_pretty_object(out, obj);
+        }
+        else
+        {
+            if (count_ != 0)
+                out += ',';
+            append_json_object(out, obj);
+        }
+        ++count_;
+        sink_.commit();
     }
-    else if constexpr (std::is_same_v<T, int16_t>)
+
+    // Writes every row of a range or generator (rows may be pointers); returns the count
+    template <typename Range> size_t write_all(Range&& rows)
     {
-        ss << value;
+        return meta::write_rows(*this, std::forward<Range>(rows));
     }
-    else if constexpr (std::is_same_v<T, int64_t>)
+
+    // Closes the array, flushes and releases the sink
+    void close()
     {
-        ss << value;
+        if (closed_)
+            return;
+        closed_ = true;
+        if (layout_ == meta::Layout::Pretty)
+            sink_.buffer() += count_ != 0 ? "\n]\n" : "]\n";
+        else
+            sink_.buffer() += ']';
+        sink_.close();
     }
-    else if constexpr (std::is_same_v<T, uint32_t>)
+
+    size_t count() const
     {
-        ss << value;
+        return count_;
     }
-    else if constexpr (std::is_same_v<T, uint64_t>)
+
+  private:
+    meta::Sink sink_;
+    meta::Layout layout_;
+    size_t count_ = 0;
+    bool closed_ = false;
+};
+
+// ================================================================
+// Reader
+//
+// meta::json::parse<T>(text) fills a T straight from the input text:
+// object keys are matched through a per-type perfect hash of the field
+// names, numbers go through std::from_chars, strings are decoded directly
+// into the destination member, and unknown keys are skipped without
+// building a DOM. The same concept dispatch as the writer applies, so
+// anything append_json_value can write, parse can read back.
+//
+// array_reader<T> and parse_each<T> stream the records of a top-level
+// array one at a time instead of materializing a std::vector<T>.
+//
+// Usage:
+//   auto rows = meta::json::parse<std::vector<Row>>(text);
+//   meta::json::parse_each<Row>(text, [](Row&& row) { ... });
+// ================================================================
+
+class parse_error : public std::runtime_error
+{
+  public:
+    parse_error(const std::string& what, size_t offset)
+        : std::runtime_error("json: " + what + " at offset " + std::to_string(offset)),
+          offset_(offset)
     {
-        ss << value;
     }
-    else if constexpr (std::is_same_v<T, float>)
+
+    size_t offset() const
     {
-        ss << value;
+        return offset_;
     }
-    else if constexpr (std::is_same_v<T, double>)
+
+  private:
+    size_t offset_;
+};
+
+class Reader
+{
+  public:
+    explicit Reader(std::string_view text)
+        : begin_(text.data()), p_(text.data()), end_(text.data() + text.size())
     {
-        ss << value;
     }
 
-    // Single-level vectors
-    else if constexpr (std::is_same_v<T, std::vector<int>>)
+    void skip_ws()
     {
-        return format_vector_json(value);
+        while (p_ != end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t'))
+            ++p_;
     }
-    else if constexpr (std::is_same_v<T, std::vector<int32_t>>)
+
+    // Next significant character, '\0' at the end of input
+    char peek()
     {
-        return format_vector_json(value);
+        skip_ws();
+        return p_ == end_ ? '\0' : *p_;
     }
-    else if constexpr (std::is_same_v<T, std::vector<int64_t>>)
+
+    bool at_end()
     {
-        return format_vector_json(value);
+        skip_ws();
+        return p_ == end_;
     }
-    else if constexpr (std::is_same_v<T, std::vector<float>>)
+
+    bool consume(char c)
     {
-        return format_vector_json(value);
+        if (peek() != c)
+            return false;
+        ++p_;
+        return true;
     }
-    else if constexpr (std::is_same_v<T, std::vector<double>>)
+
+    void expect(char c)
     {
-        return format_vector_json(value);
+        if (!consume(c))
+            fail(std::string("expected '") + c + "'");
     }
-    else if constexpr (std::is_same_v<T, std::vector<bool>>)
+
+    bool consume_literal(std::string_view literal)
     {
-        return format_vector_json(value);
+        skip_ws();
+        if (static_cast<size_t>(end_ - p_) < literal.size() ||
+            std::memcmp(p_, literal.data(), literal.size()) != 0)
+            return false;
+        p_ += literal.size();
+        return true;
     }
-    else if constexpr (std::is_same_v<T, std::vector<std::string>>)
+
+    [[noreturn]] void fail(const std::string& what) const
     {
-        return format_vector_json(value);
+        throw parse_error(what, static_cast<size_t>(p_ - begin_));
     }
 
-    // Nested vectors (2D)
-    else if constexpr (std::is_same_v<T, std::vector<std::vector<int>>>)
+    // Raw contents of the next string (no quotes, escapes left in place)
+    std::string_view string_token(bool& escaped)
     {
-        return format_vector_json(value);
+        expect('"');
+        const char* start = p_;
+        escaped = false;
+        for (;;)
+        {
+            p_ += meta::escape::find_first(std::string_view(p_, static_cast<size_t>(end_ - p_)),
+                                           detail::string_end);
+            if (p_ == end_ || *p_ == '"')
+                break;
+            // backslash: skip the escaped character
+            escaped = true;
+            if (++p_ == end_)
+                break;
+            ++p_;
+        }
+        if (p_ == end_)
+            fail("unterminated string");
+        return std::string_view(start, static_cast<size_t>(p_++ - start));
     }
-    else if constexpr (std::is_same_v<T, std::vector<std::vector<double>>>)
+
+    void read_string(std::string& out)
     {
-        return format_vector_json(value);
+        bool escaped = false;
+        std::string_view raw = string_token(escaped);
+        if (!escaped)
+        {
+            out.assign(raw.data(), raw.size());
+            return;
+        }
+        out.clear();
+        unescape(raw, out);
     }
-    else if constexpr (std::is_same_v<T, std::vector<std::vector<std::string>>>)
+
+    // Decodes JSON escapes (including \u surrogate pairs) into UTF-8
+    void unescape(std::string_view raw, std::string& out) const
     {
-        return format_vector_json(value);
+        out.reserve(out.size() + raw.size());
+        for (size_t i = 0; i < raw.size(); ++i)
+        {
+            char c = raw[i];
+            if (c != '\\')
+            {
+                out += c;
+                continue;
+            }
+            switch (raw[++i])
+            {
+            case 'b':
+                out += '\b';
+                break;
+            case 'f':
+                out += '\f';
+                break;
+            case 'n':
+                out += '\n';
+                break;
+            case 'r':
+                out += '\r';
+                break;
+            case 't':
+                out += '\t';
+                break;
+            case 'u':
+            {
+                uint32_t cp = hex4(raw, i + 1);
+                i += 4;
+                if (cp >= 0xD800 && cp < 0xDC00 && i + 6 < raw.size() && raw[i + 1] == '\\' &&
+                    raw[i + 2] == 'u')
+                {
+                    uint32_t low = hex4(raw, i + 3);
+                    if (low >= 0xDC00 && low < 0xE000)
+                    {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                }
+                append_utf8(out, cp);
+                break;
+            }
+            default: // '"', '\\', '/'
+                out += raw[i];
+                break;
+            }
+        }
     }
-    else if constexpr (std::is_same_v<T, std::vector<std::vector<bool>>>)
+
+    template <typename T> void read_number(T& value)
     {
-        return format_vector_json(value);
+        skip_ws();
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            // the writer emits null for NaN/Infinity
+            if (consume_literal("null"))
+            {
+                value = std::numeric_limits<T>::quiet_NaN();
+                return;
+            }
+        }
+
+        auto [ptr, ec] = std::from_chars(p_, end_, value);
+        if (ec != std::errc())
+            fail("invalid number");
+
+        if constexpr (std::is_integral_v<T>)
+        {
+            // 1.0 / 1e3 into an integer member
+            if (ptr != end_ && (*ptr == '.' || *ptr == 'e' || *ptr == 'E'))
+            {
+                double d = 0;
+                auto [dptr, dec] = std::from_chars(p_, end_, d);
+                if (dec != std::errc())
+                    fail("invalid number");
+                value = static_cast<T>(d);
+                ptr = dptr;
+            }
+        }
+        p_ = ptr;
     }
 
-    // Triple nested vectors (3D)
-    else if constexpr (std::is_same_v<T, std::vector<std::vector<std::vector<int>>>>)
+    void skip_value()
     {
-        return format_vector_json(value);
+        bool escaped = false;
+        char c = peek();
+        if (c == '"')
+        {
+            string_token(escaped);
+            return;
+        }
+        if (c == '{' || c == '[')
+        {
+            size_t depth = 0;
+            do
+            {
+                char d = peek();
+                if (d == '"')
+                {
+                    string_token(escaped);
+                    continue;
+                }
+                if (d == '\0')
+                    fail("unterminated value");
+                if (d == '{' || d == '[')
+                    ++depth;
+                else if (d == '}' || d == ']')
+                    --depth;
+                ++p_;
+            } while (depth != 0);
+            return;
+        }
+        if (consume_literal("true") || consume_literal("false") || consume_literal("null"))
+            return;
+
+        const char* start = p_;
+        while (p_ != end_ && *p_ != '\0' && std::strchr("+-0123456789.eE", *p_) != nullptr)
+            ++p_;
+        if (p_ == start)
+            fail("unexpected character");
     }
-    else if constexpr (std::is_same_v<T, std::vector<std::vector<std::vector<double>>>>)
+
+  private:
+    uint32_t hex4(std::string_view raw, size_t at) const
     {
-        return format_vector_json(value);
+        if (at + 4 > raw.size())
+            fail("truncated \\u escape");
+        uint32_t cp = 0;
+        for (size_t k = at; k < at + 4; ++k)
+        {
+            char h = raw[k];
+            cp <<= 4;
+            if (h >= '0' && h <= '9')
+                cp |= static_cast<uint32_t>(h - '0');
+            else if (h >= 'a' && h <= 'f')
+                cp |= static_cast<uint32_t>(h - 'a' + 10);
+            else if (h >= 'A' && h <= 'F')
+                cp |= static_cast<uint32_t>(h - 'A' + 10);
+            else
+                fail("invalid \\u escape");
+        }
+        return cp;
     }
-    else if constexpr (std::is_same_v<T, std::vector<std::vector<std::vector<std::string>>>>)
+
+    static void append_utf8(std::string& out, uint32_t cp)
     {
-        return format_vector_json(value);
+        if (cp < 0x80)
+        {
+            out += static_cast<char>(cp);
+        }
+        else if (cp < 0x800)
+        {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else if (cp < 0x10000)
+        {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else
+        {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
     }
 
-    // Maps
-    else if constexpr (std::is_same_v<T, std::map<std::string, int>>)
+    const char* begin_;
+    const char* p_;
+    const char* end_;
+};
+
+template <typename T> void parse_value(Reader& reader, T& value);
+template <typename ObjectType> void parse_object(Reader& reader, ObjectType& obj);
+
+namespace detail
+{
+
+enum class ValueKind
+{
+    Null,
+    Bool,
+    Number,
+    String,
+    Object,
+    Array,
+};
+
+// What a JSON value must look like to land in a T (used to pick a variant alternative)
+template <typename T> constexpr bool accepts(ValueKind kind)
+{
+    if constexpr (std::is_same_v<T, std::monostate> || std::is_same_v<T, std::nullptr_t>)
+        return kind == ValueKind::Null;
+    else if constexpr (Optional<T>)
+        return kind == ValueKind::Null || accepts<typename T::value_type>(kind);
+    else if constexpr (std::is_same_v<T, bool>)
+        return kind == ValueKind::Bool;
+    else if constexpr (std::is_same_v<T, char> || StringLike<T>)
+        return kind == ValueKind::String;
+    else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+        return kind == ValueKind::Number;
+    else if constexpr (Reflected<T> || MapLike<T>)
+        return kind == ValueKind::Object;
+    else if constexpr (RangeLike<T> || TupleLike<T>)
+        return kind == ValueKind::Array;
+    else
+        return false;
+}
+
+inline ValueKind peek_kind(Reader& reader)
+{
+    switch (reader.peek())
     {
-        return format_map_json(value);
+    case 'n':
+        return ValueKind::Null;
+    case 't':
+    case 'f':
+        return ValueKind::Bool;
+    case '"':
+        return ValueKind::String;
+    case '{':
+        return ValueKind::Object;
+    case '[':
+        return ValueKind::Array;
+    default:
+        return ValueKind::Number;
     }
-    else if constexpr (std::is_same_v<T, std::map<std::string, double>>)
+}
+
+template <typename Variant, std::size_t... Is>
+void parse_variant(Reader& reader, Variant& value, std::index_sequence<Is...>)
+{
+    ValueKind kind = peek_kind(reader);
+    bool matched = false;
+    auto tryAlternative = [&]<std::size_t I>(std::integral_constant<std::size_t, I>)
     {
-        return format_map_json(value);
+        using Alt = std::variant_alternative_t<I, Variant>;
+        if (matched || !accepts<Alt>(kind))
+            return;
+        matched = true;
+        parse_value(reader, value.template emplace<I>());
+    };
+    (tryAlternative(std::integral_constant<std::size_t, Is>{}), ...);
+    if (!matched)
+        reader.fail("no variant alternative matches value");
+}
+
+template <typename Tuple, std::size_t... Is>
+void parse_tuple(Reader& reader, Tuple& value, std::index_sequence<Is...>)
+{
+    using std::get;
+    reader.expect('[');
+    ((Is == 0 ? void() : reader.expect(','), parse_value(reader, get<Is>(value))), ...);
+    reader.expect(']');
+}
+
+template <typename K> void parse_key(Reader& reader, K& key)
+{
+    if constexpr (std::is_same_v<K, std::string>)
+    {
+        reader.read_string(key);
     }
-    else if constexpr (std::is_same_v<T, std::map<std::string, std::string>>)
+    else
     {
-        return format_map_json(value);
+        // numeric and enum keys are quoted numbers
+        std::string text;
+        reader.read_string(text);
+        Reader inner(text);
+        if constexpr (std::is_enum_v<K>)
+        {
+            std::underlying_type_t<K> raw{};
+            inner.read_number(raw);
+            key = static_cast<K>(raw);
+        }
+        else
+        {
+            parse_value(inner, key);
+        }
     }
-    else if constexpr (std::is_same_v<T, std::map<std::string, bool>>)
+}
+
+// JSON key to field index for ObjectType: the shared perfect-hash
+// FieldNameIndex over the field names, plus one setter per field.
+template <typename ObjectType> class FieldIndex
+{
+  public:
+    using Fields = std::remove_cvref_t<decltype(meta::MetaTuple<ObjectType>::fields)>;
+    static constexpr size_t count = std::tuple_size_v<Fields>;
+    using Setter = void (*)(Reader&, ObjectType&);
+
+    static const FieldIndex& get()
     {
-        return format_map_json(value);
+        static const FieldIndex index;
+        return index;
     }
-    else if constexpr (std::is_same_v<T, std::map<int, std::string>>)
+
+    // Field index for key, count if the type has no such field
+    size_t find(std::string_view key, size_t hint) const
     {
-        return format_map_json(value);
+        return index_.find(key, hint);
     }
-    else if constexpr (std::is_same_v<T, std::map<int, int>>)
+
+    void set(size_t field, Reader& reader, ObjectType& obj) const
     {
-        return format_map_json(value);
+        setters_[field](reader, obj);
     }
 
-    // Nested maps
-    else if constexpr (std::is_same_v<T, std::map<std::string, std::vector<int>>>)
+  private:
+    template <typename FieldMeta> static Setter make_setter()
     {
-        return format_map_json(value);
+        if constexpr (FieldMeta::memberPtr != nullptr)
+            return [](Reader& reader, ObjectType& obj)
+            { parse_value(reader, obj.*(FieldMeta::memberPtr)); };
+        else
+            return [](Reader& reader, ObjectType&) { reader.skip_value(); };
     }
-    else if constexpr (std::is_same_v<T, std::map<std::string, std::vector<std::string>>>)
+
+    static std::array<std::string_view, count> names()
     {
-        return format_map_json(value);
+        std::array<std::string_view, count> result{};
+        std::apply(
+            [&](const auto&... fieldMeta)
+            {
+                size_t i = 0;
+                ((result[i++] = field_name(fieldMeta)), ...);
+            },
+            meta::MetaTuple<ObjectType>::fields);
+        return result;
     }
-    else if constexpr (std::is_same_v<T, std::vector<std::map<std::string, int>>>)
+
+    FieldIndex() : index_(names(), "meta::json")
     {
-        return format_vector_json(value);
+        std::apply(
+            [&](const auto&... fieldMeta)
+            {
+                size_t i = 0;
+                ((setters_[i++] = make_setter<std::remove_cvref_t<decltype(fieldMeta)>>()), ...);
+            },
+            meta::MetaTuple<ObjectType>::fields);
     }
 
-    // Optionals
-    else if constexpr (std::is_same_v<T, std::optional<int>>)
+    meta::detail::FieldNameIndex<count> index_;
+    std::array<Setter, count> setters_{};
+};
+
+} // namespace detail
+
+template <typename ObjectType> void parse_object(Reader& reader, ObjectType& obj)
+{
+    const auto& index = detail::FieldIndex<ObjectType>::get();
+
+    reader.expect('{');
+    if (reader.consume('}'))
+        return;
+
+    std::string scratch; // only used for keys containing escapes
+    // the hint is the field after the previous key, so keys in declaration
+    // order skip the hash
+    constexpr size_t count = detail::FieldIndex<ObjectType>::count;
+    size_t hint = 0;
+    do
+    {
+        bool escaped = false;
+        std::string_view key = reader.string_token(escaped);
+        if (escaped)
+        {
+            scratch.clear();
+            reader.unescape(key, scratch);
+            key = scratch;
+        }
+        reader.expect(':');
+
+        size_t field = index.find(key, hint);
+        if (field == count)
+        {
+            reader.skip_value();
+        }
+        else
+        {
+            index.set(field, reader, obj);
+            hint = field + 1;
+        }
+    } while (reader.consume(','));
+    reader.expect('}');
+}
+
+template <typename T> void parse_value(Reader& reader, T& value)
+{
+    if constexpr (std::is_same_v<T, bool>)
     {
-        return format_optional_json(value);
+        if (reader.consume_literal("true"))
+            value = true;
+        else if (reader.consume_literal("false"))
+            value = false;
+        else
+            reader.fail("expected true or false");
     }
-    else if constexpr (std::is_same_v<T, std::optional<double>>)
+    else if constexpr (std::is_same_v<T, char>)
     {
-        return format_optional_json(value);
+        std::string text;
+        reader.read_string(text);
+        value = text.empty() ? '\0' : text[0];
     }
-    else if constexpr (std::is_same_v<T, std::optional<std::string>>)
+    else if constexpr (std::is_arithmetic_v<T>)
     {
-        return format_optional_json(value);
+        reader.read_number(value);
     }
-    else if constexpr (std::is_same_v<T, std::optional<bool>>)
+    else if constexpr (std::is_enum_v<T>)
     {
-        return format_optional_json(value);
+        std::underlying_type_t<T> raw{};
+        reader.read_number(raw);
+        value = static_cast<T>(raw);
     }
-    else if constexpr (std::is_same_v<T, std::optional<std::vector<int>>>)
+    else if constexpr (std::is_same_v<T, std::string>)
     {
-        return format_optional_json(value);
+        reader.read_string(value);
     }
-    else if constexpr (std::is_same_v<T, std::optional<std::vector<std::string>>>)
+    else if constexpr (std::is_same_v<T, std::monostate> || std::is_same_v<T, std::nullptr_t>)
     {
-        return format_optional_json(value);
+        if (!reader.consume_literal("null"))
+            reader.fail("expected null");
     }
-
-    // Tuples
-    else if constexpr (std::is_same_v<T, std::tuple<int, int>>)
+    else if constexpr (Optional<T>)
     {
-        return format_tuple_json(value, std::index_sequence_for<int, int>{});
+        if (reader.consume_literal("null"))
+            value.reset();
+        else
+            parse_value(reader, value.emplace());
     }
-    else if constexpr (std::is_same_v<T, std::tuple<int, std::string>>)
+    else if constexpr (Variant<T>)
     {
-        return format_tuple_json(value, std::index_sequence_for<int, std::string>{});
+        detail::parse_variant(reader, value, std::make_index_sequence<std::variant_size_v<T>>{});
     }
-    else if constexpr (std::is_same_v<T, std::tuple<std::string, int, double>>)
+    else if constexpr (Reflected<T>)
     {
-        return format_tuple_json(value, std::index_sequence_for<std::string, int, double>{});
+        parse_object(reader, value);
     }
-    else if constexpr (std::is_same_v<T, std::tuple<int, int, int>>)
+    else if constexpr (MapLike<T>)
     {
-        return format_tuple_json(value, std::index_sequence_for<int, int, int>{});
+        value.clear();
+        reader.expect('{');
+        if (reader.consume('}'))
+            return;
+        do
+        {
+            typename T::key_type key{};
+            typename T::mapped_type item{};
+            detail::parse_key(reader, key);
+            reader.expect(':');
+            parse_value(reader, item);
+            value.insert_or_assign(std::move(key), std::move(item));
+        } while (reader.consume(','));
+        reader.expect('}');
     }
-    else if constexpr (std::is_same_v<T, std::tuple<std::string, std::string>>)
+    else if constexpr (RangeLike<T> && requires { std::tuple_size<T>::value; })
     {
-        return format_tuple_json(value, std::index_sequence_for<std::string, std::string>{});
+        // std::array: fixed element count
+        reader.expect('[');
+        size_t i = 0;
+        if (!reader.consume(']'))
+        {
+            do
+            {
+                if (i == std::tuple_size_v<T>)
+                    reader.fail("too many array elements");
+                parse_value(reader, value[i++]);
+            } while (reader.consume(','));
+            reader.expect(']');
+        }
     }
-
-    // Mixed complex types
-    else if constexpr (std::is_same_v<T, std::vector<std::tuple<int, std::string>>>)
+    else if constexpr (RangeLike<T>)
     {
-        return format_vector_json(value);
+        using Item = std::ranges::range_value_t<T>;
+        value.clear();
+        reader.expect('[');
+        if (reader.consume(']'))
+            return;
+        do
+        {
+            if constexpr (requires {
+                              { value.emplace_back() } -> std::same_as<Item&>;
+                          })
+            {
+                // parse in place (not vector<bool>, whose elements are proxies)
+                parse_value(reader, value.emplace_back());
+            }
+            else
+            {
+                Item item{};
+                parse_value(reader, item);
+                if constexpr (requires { value.push_back(std::move(item)); })
+                    value.push_back(std::move(item));
+                else
+                    value.insert(std::move(item));
+            }
+        } while (reader.consume(','));
+        reader.expect(']');
     }
-    else if constexpr (std::is_same_v<T, std::tuple<std::vector<int>, std::string>>)
+    else if constexpr (TupleLike<T>)
     {
-        return format_tuple_json(value, std::index_sequence_for<std::vector<int>, std::string>{});
+        detail::parse_tuple(reader, value, std::make_index_sequence<std::tuple_size_v<T>>{});
     }
-
-    // Fallback for unknown types
     else
     {
-        ss << "\"unknown_type:" << typeid(T).name() << "\"";
+        // no mapping (the writer emits "unknown_type:..."): leave the member as is
+        reader.skip_value();
     }
-
-    return ss.str();
 }
 
-template <typename ObjectType> std::string serialize(const std::vector<ObjectType>& objects)
+template <typename T> void parse(std::string_view json, T& out)
 {
-    std::stringstream os;
-
-    os << "[" << std::endl;
+    Reader reader(json);
+    parse_value(reader, out);
+    if (!reader.at_end())
+        reader.fail("trailing characters");
+}
 
-    constexpr auto& fields = meta::MetaTuple<ObjectType>::fields;
+template <typename T> T parse(std::string_view json)
+{
+    T out{};
+    parse(json, out);
+    return out;
+}
 
-    for (size_t i = 0; i < objects.size(); ++i)
+// Pulls the elements of a top-level JSON array one at a time
+template <typename T> class array_reader
+{
+  public:
+    explicit array_reader(std::string_view json) : reader_(json)
     {
-        const auto& obj = objects[i];
-
-        os << "  {" << std::endl;
-
-	// Write object fields
-	std::apply(
-		   [&](auto&&... fieldMeta) -> void
-		   {
-		     bool first = true;
-		     ((os << (first ? (first = false, "    ") : ",\n    ")
-		       << "\"" << fieldMeta.fieldName
-		       << "\": " << format_json_value(obj.*(fieldMeta.memberPtr))),
-		      ...);
-		     os << std::endl;
-		   },
-		   fields);
-	
-
+        reader_.expect('[');
+        done_ = reader_.consume(']');
+        if (done_ && !reader_.at_end())
+            reader_.fail("trailing characters");
+    }
 
-        os << "  }";
-        if (i < objects.size() - 1)
+    // Parses the next element into out; false once the array is exhausted
+    bool next(T& out)
+    {
+        if (done_)
+            return false;
+        parse_value(reader_, out);
+        if (!reader_.consume(','))
         {
-            os << ",";
+            reader_.expect(']');
+            if (!reader_.at_end())
+                reader_.fail("trailing characters");
+            done_ = true;
         }
-        os << std::endl;
+        return true;
     }
 
-    os << "]" << std::endl;
-    return os.str();
-}
+  private:
+    Reader reader_;
+    bool done_ = false;
+};
 
-// Compact version
-template <typename ObjectType> std::string serialize_compact(const std::vector<ObjectType>& objects)
+// Calls fn(T&&) for every element of a top-level JSON array; returns the count
+template <typename T, typename Fn> size_t parse_each(std::string_view json, Fn&& fn)
 {
-    std::stringstream os;
-
-    os << "[";
-
-    constexpr auto& fields = meta::MetaTuple<ObjectType>::fields;
-
-    for (size_t i = 0; i < objects.size(); ++i)
+    array_reader<T> reader(json);
+    size_t count = 0;
+    for (;;)
     {
-        const auto& obj = objects[i];
-
-        os << "{";
-
-        std::apply(
-            [&](auto&&... fieldMeta) -> void
-            {
-                bool first = true;
-                ((os << (first ? "" : ",") << (first ? (first = false, "") : "") << "\""
-                     << fieldMeta.memberName
-                     << "\":" << format_json_value(obj.*(fieldMeta.memberPtr))),
-                 ...);
-            },
-            fields);
-
-        os << "}";
-        if (i < objects.size() - 1)
-        {
-            os << ",";
-        }
+        T item{};
+        if (!reader.next(item))
+            break;
+        fn(std::move(item));
+        ++count;
     }
-
-    os << "]";
-    return os.str();
+    return count;
 }
 
 } // namespace json
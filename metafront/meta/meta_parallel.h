@@ -0,0 +1,105 @@
+/*
+ * ================================================================
+ * PARALLEL FORMATTING
+ *
+ * Backs the parallel serializers (json/yaml/xml::serialize_parallel and
+ * csv::serializeParallel). The records are cut into contiguous chunks,
+ * each chunk is formatted on its own thread into its own buffer, and the
+ * buffers are appended to the output in order.
+ *
+ * The per-record appenders get the record's global index, so anything
+ * that depends on position (JSON commas, the last-record newline, XML
+ * index attributes) comes out exactly as the serial loop writes it, and
+ * the result is byte-identical to serialize(). Document headers (the CSV
+ * header row, YAML "---", XML prologue) are written once by the caller
+ * around the chunks.
+ *
+ * Threads are started per call: a call is only worth it for large
+ * inputs, where thread start-up is noise next to the formatting.
+ * ================================================================
+ */
+
+#pragma once
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace meta
+{
+
+// Chunks smaller than this are not worth a thread
+inline constexpr size_t min_parallel_records = 4096;
+
+// Calls append(out, record, index) for every record of rows, in order, with
+// the formatting spread over up to `threads` threads (0 = one per core).
+// append must depend only on its record and index.
+template <std::ranges::random_access_range Range, typename AppendFn>
+void append_parallel(std::string& out, const Range& rows, AppendFn append, size_t threads = 0)
+{
+    const size_t count = static_cast<size_t>(std::ranges::size(rows));
+    const auto first = std::ranges::begin(rows);
+
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    size_t chunks = count / min_parallel_records;
+    if (chunks > threads)
+        chunks = threads;
+
+    if (chunks <= 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+            append(out, first[static_cast<std::ptrdiff_t>(i)], i);
+        return;
+    }
+
+    std::vector<std::string> parts(chunks);
+    std::vector<std::exception_ptr> errors(chunks);
+    auto work = [&](size_t k)
+    {
+        try
+        {
+            size_t begin = count * k / chunks;
+            size_t end = count * (k + 1) / chunks;
+            std::string& part = parts[k];
+
+            // size the buffer from the first record
+            append(part, first[static_cast<std::ptrdiff_t>(begin)], begin);
+            part.reserve(part.size() * (end - begin) + part.size() * (end - begin) / 8);
+            for (size_t i = begin + 1; i < end; ++i)
+                append(part, first[static_cast<std::ptrdiff_t>(i)], i);
+        }
+        catch (...)
+        {
+            errors[k] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    for (size_t k = 1; k < chunks; ++k)
+        workers.emplace_back(work, k);
+    work(0);
+    for (auto& worker : workers)
+        worker.join();
+    for (auto& error : errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    size_t total = out.size();
+    for (const auto& part : parts)
+        total += part.size();
+    out.reserve(total);
+    for (auto& part : parts)
+    {
+        out += part;
+        std::string().swap(part); // release as we go
+    }
+}
+
+} // namespace meta
@@ -1,10 +1,54 @@
+/*
+ * ================================================================
+ * PROTOBUF SCHEMA AND WIRE FORMAT
+ *
+ * GenerateProto<T>() writes the .proto message for a reflected type;
+ * meta::proto::serialize / parse read and write the matching binary
+ * wire format straight from the struct, without generated classes.
+ *
+ * Field numbers are the position in the field tuple (1, 2, ...), the
+ * order GenerateProto numbers them in. Encoding follows the schema:
+ * - integers and bool are varints (int32 sign-extended to 10 bytes, as
+ *   protoc does); the proto_type attribute switches a field to sint32 /
+ *   sint64 (zigzag) or (s)fixed32 / (s)fixed64
+ * - float and double are fixed32 / fixed64; enums are int32
+ * - std::string and nested reflected structs are length-delimited
+ * - std::vector of numbers is a packed repeated field, of strings or
+ *   messages one record per element
+ * - std::optional members are written only when set; every other member
+ *   is always written (the schema marks all of them optional)
+ *
+ * serialize_to() encodes into a caller-provided buffer without
+ * allocating; size it with byte_size(). Nested message sizes are
+ * recomputed per level, which is cheap for the shallow nesting of
+ * reflected structs. parse() accepts packed and unpacked repeated
+ * numbers and skips unknown fields, as protobuf parsers do.
+ *
+ * Usage:
+ *   std::string proto = GenerateProto<Row>();
+ *   std::string bytes = meta::proto::serialize(row);
+ *   Row back = meta::proto::parse<Row>(bytes);
+ * ================================================================
+ */
+
 #pragma once
 
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <optional>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 // Map C++ types to proto types
 template <typename T> struct ProtoType
@@ -53,24 +97,732 @@ template <> struct ProtoType<std::chrono::system_clock::time_point>
     static constexpr const char* name = "int64";
 };
 
+namespace meta
+{
+namespace proto
+{
+
+class parse_error : public std::runtime_error
+{
+  public:
+    parse_error(const std::string& what, size_t offset)
+        : std::runtime_error("proto: " + what + " at offset " + std::to_string(offset)),
+          offset_(offset)
+    {
+    }
+
+    size_t offset() const
+    {
+        return offset_;
+    }
+
+  private:
+    size_t offset_;
+};
+
+// How a value goes on the wire
+enum class Encoding : uint8_t
+{
+    Varint,
+    ZigZag,
+    Fixed32,
+    Fixed64,
+    Length, // strings and nested messages
+};
+
+namespace detail
+{
+
+template <typename> inline constexpr bool dependent_false = false;
+
+template <typename T> struct is_vector : std::false_type
+{
+};
+template <typename T, typename A> struct is_vector<std::vector<T, A>> : std::true_type
+{
+};
+
+template <typename T> struct is_optional : std::false_type
+{
+};
+template <typename T> struct is_optional<std::optional<T>> : std::true_type
+{
+};
+
+// Element type of a member: T for std::vector<T> and std::optional<T>
+template <typename T> struct element
+{
+    using type = T;
+};
+template <typename T, typename A> struct element<std::vector<T, A>>
+{
+    using type = T;
+};
+template <typename T> struct element<std::optional<T>>
+{
+    using type = T;
+};
+template <typename T> using element_t = typename element<T>::type;
+
+template <typename T>
+concept Message = requires { meta::MetaTuple<T>::fields; };
+
+// Numbers (packable when repeated)
+template <typename T>
+concept Number = std::is_enum_v<T> || std::is_integral_v<T> ||
+                 (std::is_floating_point_v<T> && (sizeof(T) == 4 || sizeof(T) == 8));
+
+template <typename T>
+using fields_t = std::remove_cvref_t<decltype(meta::MetaTuple<T>::fields)>;
+
+template <typename T> inline constexpr size_t field_count = std::tuple_size_v<fields_t<T>>;
+
+template <typename FieldMeta> constexpr std::string_view member_name(const FieldMeta& fieldMeta)
+{
+    if constexpr (requires { fieldMeta.memberName; })
+        return fieldMeta.memberName;
+    else
+        return fieldMeta.fieldName;
+}
+
+// The proto_type attribute, empty when absent
+template <typename FieldMeta> std::string_view proto_type(const FieldMeta& fieldMeta)
+{
+    if constexpr (requires { fieldMeta.findAttribute(PROTO_TYPE); })
+    {
+        const std::string* type = fieldMeta.findAttribute(PROTO_TYPE);
+        return type ? std::string_view(*type) : std::string_view();
+    }
+    else if constexpr (requires { FieldMeta::getAttribute(std::string_view()); })
+        return FieldMeta::getAttribute(PROTO_TYPE).value_or(std::string_view());
+    else
+        return {};
+}
+
+// Encoding of an element type, with the proto_type attribute applied to integers
+template <typename E> constexpr Encoding encoding_of(std::string_view protoType)
+{
+    if constexpr (std::is_same_v<E, bool>)
+        return Encoding::Varint;
+    else if constexpr (std::is_enum_v<E> || std::is_integral_v<E>)
+    {
+        if (protoType == "sint32" || protoType == "sint64")
+            return Encoding::ZigZag;
+        if (protoType == "fixed32" || protoType == "sfixed32")
+            return Encoding::Fixed32;
+        if (protoType == "fixed64" || protoType == "sfixed64")
+            return Encoding::Fixed64;
+        return Encoding::Varint;
+    }
+    else if constexpr (std::is_floating_point_v<E>)
+        return sizeof(E) == 4 ? Encoding::Fixed32 : Encoding::Fixed64;
+    else
+        return Encoding::Length;
+}
+
+// Per-field encodings of T, resolved once
+template <typename T> const std::array<Encoding, field_count<T>>& encodings()
+{
+    static const auto table = []
+    {
+        std::array<Encoding, field_count<T>> out{};
+        size_t i = 0;
+        std::apply(
+            [&](const auto&... fieldMeta)
+            {
+                ((out[i++] = encoding_of<element_t<
+                      typename std::remove_cvref_t<decltype(fieldMeta)>::type>>(
+                      proto_type(fieldMeta))),
+                 ...);
+            },
+            meta::MetaTuple<T>::fields);
+        return out;
+    }();
+    return table;
+}
+
+constexpr uint8_t wire_type(Encoding encoding)
+{
+    switch (encoding)
+    {
+    case Encoding::Fixed64:
+        return 1;
+    case Encoding::Length:
+        return 2;
+    case Encoding::Fixed32:
+        return 5;
+    default:
+        return 0;
+    }
+}
+
+// ----------------------------------------------------------------
+// Encoding
+// ----------------------------------------------------------------
+
+constexpr size_t varint_size(uint64_t value)
+{
+    // 7 bits per byte: 1 + floor(bit_width / 7), and 1 for zero
+    return 1 + static_cast<size_t>((std::bit_width(value | 1) - 1) / 7);
+}
+
+// Integer (or enum) as the 64-bit varint payload
+template <typename E> constexpr uint64_t to_varint(E value, Encoding encoding)
+{
+    if constexpr (std::is_enum_v<E>)
+        return to_varint(static_cast<std::underlying_type_t<E>>(value), encoding);
+    else if constexpr (std::is_same_v<E, bool>)
+        return value ? 1 : 0;
+    else if constexpr (std::is_signed_v<E>)
+    {
+        int64_t wide = value;
+        if (encoding == Encoding::ZigZag)
+        {
+            if constexpr (sizeof(E) <= 4)
+                return static_cast<uint32_t>((static_cast<uint32_t>(value) << 1) ^
+                                             static_cast<uint32_t>(static_cast<int32_t>(value) >> 31));
+            else
+                return (static_cast<uint64_t>(wide) << 1) ^ static_cast<uint64_t>(wide >> 63);
+        }
+        return static_cast<uint64_t>(wide); // negative int32 is sign-extended
+    }
+    else
+        return static_cast<uint64_t>(value);
+}
+
+class Writer
+{
+  public:
+    Writer(char* data, size_t size) : begin_(data), p_(data), end_(data + size)
+    {
+    }
+
+    size_t written() const
+    {
+        return static_cast<size_t>(p_ - begin_);
+    }
+
+    void varint(uint64_t value)
+    {
+        need(varint_size(value));
+        while (value >= 0x80)
+        {
+            *p_++ = static_cast<char>(value | 0x80);
+            value >>= 7;
+        }
+        *p_++ = static_cast<char>(value);
+    }
+
+    template <typename U> void fixed(U value)
+    {
+        need(sizeof(U));
+        for (size_t i = 0; i < sizeof(U); ++i)
+            *p_++ = static_cast<char>(value >> (8 * i));
+    }
+
+    void bytes(std::string_view data)
+    {
+        need(data.size());
+        if (!data.empty())
+            std::char_traits<char>::copy(p_, data.data(), data.size());
+        p_ += data.size();
+    }
+
+  private:
+    void need(size_t size)
+    {
+        if (static_cast<size_t>(end_ - p_) < size)
+            throw std::length_error("proto: output buffer too small");
+    }
+
+    char* begin_;
+    char* p_;
+    char* end_;
+};
+
+template <typename T> size_t message_size(const T& obj);
+template <typename T> void write_message(Writer& out, const T& obj);
+
+// Size of one value without its tag
+template <typename E> size_t value_size(const E& value, Encoding encoding)
+{
+    if constexpr (std::is_same_v<E, std::string>)
+        return varint_size(value.size()) + value.size();
+    else if constexpr (Message<E>)
+    {
+        size_t size = message_size(value);
+        return varint_size(size) + size;
+    }
+    else if constexpr (Number<E>)
+    {
+        if (encoding == Encoding::Fixed32)
+            return 4;
+        if (encoding == Encoding::Fixed64)
+            return 8;
+        if constexpr (std::is_floating_point_v<E>)
+            return sizeof(E);
+        else
+            return varint_size(to_varint(value, encoding));
+    }
+    else
+        static_assert(dependent_false<E>, "meta::proto: no wire encoding for this member type");
+}
+
+template <typename E> void write_value(Writer& out, const E& value, Encoding encoding)
+{
+    if constexpr (std::is_same_v<E, std::string>)
+    {
+        out.varint(value.size());
+        out.bytes(value);
+    }
+    else if constexpr (Message<E>)
+    {
+        out.varint(message_size(value));
+        write_message(out, value);
+    }
+    else if constexpr (std::is_same_v<E, float>)
+        out.fixed(std::bit_cast<uint32_t>(value));
+    else if constexpr (std::is_same_v<E, double>)
+        out.fixed(std::bit_cast<uint64_t>(value));
+    else if constexpr (Number<E>)
+    {
+        uint64_t bits = to_varint(value, encoding);
+        if (encoding == Encoding::Fixed32)
+            out.fixed(static_cast<uint32_t>(bits));
+        else if (encoding == Encoding::Fixed64)
+            out.fixed(bits);
+        else
+            out.varint(bits);
+    }
+    else
+        static_assert(dependent_false<E>, "meta::proto: no wire encoding for this member type");
+}
+
+template <typename E> size_t packed_size(const std::vector<E>& values, Encoding encoding)
+{
+    if (encoding == Encoding::Fixed32)
+        return 4 * values.size();
+    if (encoding == Encoding::Fixed64)
+        return 8 * values.size();
+    size_t size = 0;
+    for (const auto& value : values)
+        size += value_size(value, encoding);
+    return size;
+}
+
+constexpr uint64_t tag(size_t number, Encoding encoding)
+{
+    return (static_cast<uint64_t>(number) << 3) | wire_type(encoding);
+}
+
+// Size of field `number` holding member, tags included
+template <typename M> size_t field_size(size_t number, const M& member, Encoding encoding)
+{
+    if constexpr (is_optional<M>::value)
+        return member ? field_size(number, *member, encoding) : 0;
+    else if constexpr (is_vector<M>::value)
+    {
+        if (member.empty())
+            return 0;
+        if constexpr (Number<element_t<M>>)
+        {
+            size_t payload = packed_size(member, encoding);
+            return varint_size(tag(number, Encoding::Length)) + varint_size(payload) + payload;
+        }
+        else
+        {
+            size_t size = varint_size(tag(number, encoding)) * member.size();
+            for (const auto& value : member)
+                size += value_size(value, encoding);
+            return size;
+        }
+    }
+    else
+        return varint_size(tag(number, encoding)) + value_size(member, encoding);
+}
+
+template <typename M> void write_field(Writer& out, size_t number, const M& member, Encoding encoding)
+{
+    if constexpr (is_optional<M>::value)
+    {
+        if (member)
+            write_field(out, number, *member, encoding);
+    }
+    else if constexpr (is_vector<M>::value)
+    {
+        if (member.empty())
+            return;
+        if constexpr (Number<element_t<M>>)
+        {
+            out.varint(tag(number, Encoding::Length));
+            out.varint(packed_size(member, encoding));
+            for (const auto& value : member)
+                write_value(out, value, encoding);
+        }
+        else
+        {
+            for (const auto& value : member)
+            {
+                out.varint(tag(number, encoding));
+                write_value(out, value, encoding);
+            }
+        }
+    }
+    else
+    {
+        out.varint(tag(number, encoding));
+        write_value(out, member, encoding);
+    }
+}
+
+// Calls fn(number, member, encoding) for every field with a member pointer
+template <typename T, typename Fn> void for_each_member(const T& obj, Fn&& fn)
+{
+    const auto& encoding = encodings<T>();
+    size_t index = 0;
+    std::apply(
+        [&](const auto&... fieldMeta)
+        {
+            (
+                [&](const auto& field)
+                {
+                    using FieldMeta = std::remove_cvref_t<decltype(field)>;
+                    if constexpr (FieldMeta::memberPtr != nullptr)
+                        fn(index + 1, obj.*(FieldMeta::memberPtr), encoding[index]);
+                    ++index;
+                }(fieldMeta),
+                ...);
+        },
+        meta::MetaTuple<T>::fields);
+}
+
+template <typename T> size_t message_size(const T& obj)
+{
+    size_t size = 0;
+    for_each_member(obj,
+                    [&](size_t number, const auto& member, Encoding encoding)
+                    { size += field_size(number, member, encoding); });
+    return size;
+}
+
+template <typename T> void write_message(Writer& out, const T& obj)
+{
+    for_each_member(obj,
+                    [&](size_t number, const auto& member, Encoding encoding)
+                    { write_field(out, number, member, encoding); });
+}
+
+// ----------------------------------------------------------------
+// Decoding
+// ----------------------------------------------------------------
+
+class Reader
+{
+  public:
+    Reader(const char* begin, const char* p, const char* end) : begin_(begin), p_(p), end_(end)
+    {
+    }
+
+    bool done() const
+    {
+        return p_ == end_;
+    }
+
+    size_t offset() const
+    {
+        return static_cast<size_t>(p_ - begin_);
+    }
+
+    [[noreturn]] void fail(const std::string& what) const
+    {
+        throw parse_error(what, offset());
+    }
+
+    uint64_t varint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (p_ == end_)
+                fail("truncated varint");
+            auto byte = static_cast<uint8_t>(*p_++);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (byte < 0x80)
+                return value;
+        }
+        fail("varint longer than 10 bytes");
+    }
+
+    template <typename U> U fixed()
+    {
+        if (static_cast<size_t>(end_ - p_) < sizeof(U))
+            fail("truncated fixed-width value");
+        U value = 0;
+        for (size_t i = 0; i < sizeof(U); ++i)
+            value |= static_cast<U>(static_cast<uint8_t>(*p_++)) << (8 * i);
+        return value;
+    }
+
+    // Length-delimited payload
+    std::string_view bytes()
+    {
+        uint64_t size = varint();
+        if (size > static_cast<uint64_t>(end_ - p_))
+            fail("length past end of input");
+        std::string_view data(p_, static_cast<size_t>(size));
+        p_ += size;
+        return data;
+    }
+
+    // Reader over a length-delimited payload (offsets stay relative to the input)
+    Reader sub()
+    {
+        std::string_view data = bytes();
+        return Reader(begin_, data.data(), data.data() + data.size());
+    }
+
+    void skip(uint8_t wire)
+    {
+        switch (wire)
+        {
+        case 0:
+            varint();
+            break;
+        case 1:
+            fixed<uint64_t>();
+            break;
+        case 2:
+            bytes();
+            break;
+        case 5:
+            fixed<uint32_t>();
+            break;
+        default:
+            fail("unsupported wire type " + std::to_string(wire));
+        }
+    }
+
+  private:
+    const char* begin_;
+    const char* p_;
+    const char* end_;
+};
+
+template <typename T> void read_message(Reader& in, T& obj);
+
+// Integer (or enum) from its varint payload, truncated to the member width as protobuf does
+template <typename E> E from_varint(uint64_t bits, Encoding encoding)
+{
+    if constexpr (std::is_enum_v<E>)
+        return static_cast<E>(from_varint<std::underlying_type_t<E>>(bits, encoding));
+    else if constexpr (std::is_same_v<E, bool>)
+        return bits != 0;
+    else if constexpr (std::is_signed_v<E>)
+    {
+        if (encoding == Encoding::ZigZag)
+            return static_cast<E>(static_cast<int64_t>(bits >> 1) ^ -static_cast<int64_t>(bits & 1));
+        return static_cast<E>(static_cast<int64_t>(bits));
+    }
+    else
+        return static_cast<E>(bits);
+}
+
+template <typename E> void read_value(Reader& in, E& value, Encoding encoding)
+{
+    if constexpr (std::is_same_v<E, std::string>)
+        value.assign(in.bytes());
+    else if constexpr (Message<E>)
+    {
+        Reader sub = in.sub();
+        read_message(sub, value);
+    }
+    else if constexpr (std::is_same_v<E, float>)
+        value = std::bit_cast<float>(in.fixed<uint32_t>());
+    else if constexpr (std::is_same_v<E, double>)
+        value = std::bit_cast<double>(in.fixed<uint64_t>());
+    else if constexpr (Number<E>)
+    {
+        if (encoding == Encoding::Fixed32)
+            value = from_varint<E>(in.fixed<uint32_t>(), Encoding::Varint);
+        else if (encoding == Encoding::Fixed64)
+            value = from_varint<E>(in.fixed<uint64_t>(), Encoding::Varint);
+        else
+            value = from_varint<E>(in.varint(), encoding);
+    }
+    else
+        static_assert(dependent_false<E>, "meta::proto: no wire encoding for this member type");
+}
+
+template <typename M> void read_field(Reader& in, M& member, uint8_t wire, Encoding encoding)
+{
+    using E = element_t<M>;
+
+    if constexpr (is_vector<M>::value && Number<E>)
+    {
+        // packed, or one element per record
+        if (wire == 2)
+        {
+            Reader packed = in.sub();
+            while (!packed.done())
+                read_value(packed, member.emplace_back(), encoding);
+            return;
+        }
+    }
+
+    if (wire != wire_type(encoding))
+        in.fail("wire type " + std::to_string(wire) + " does not match the schema");
+
+    if constexpr (is_vector<M>::value)
+        read_value(in, member.emplace_back(), encoding);
+    else if constexpr (is_optional<M>::value)
+        read_value(in, member ? *member : member.emplace(), encoding);
+    else
+        read_value(in, member, encoding);
+}
+
+// Reads field `number` into obj; false when T has no such field
+template <typename T, size_t... I>
+bool read_known(Reader& in, T& obj, uint64_t number, uint8_t wire, std::index_sequence<I...>)
+{
+    const auto& encoding = encodings<T>();
+    return ((number == I + 1 &&
+             [&]
+             {
+                 using FieldMeta = std::tuple_element_t<I, fields_t<T>>;
+                 if constexpr (FieldMeta::memberPtr == nullptr)
+                     return false;
+                 else
+                 {
+                     read_field(in, obj.*(FieldMeta::memberPtr), wire, encoding[I]);
+                     return true;
+                 }
+             }()) ||
+            ...);
+}
+
+template <typename T> void read_message(Reader& in, T& obj)
+{
+    while (!in.done())
+    {
+        uint64_t key = in.varint();
+        uint64_t number = key >> 3;
+        auto wire = static_cast<uint8_t>(key & 7);
+        if (number == 0)
+            in.fail("field number 0");
+        if (!read_known(in, obj, number, wire, std::make_index_sequence<field_count<T>>{}))
+            in.skip(wire);
+    }
+}
+
+// ----------------------------------------------------------------
+// Schema
+// ----------------------------------------------------------------
+
+// Schema type of an element: the proto_type attribute, ProtoType<E>, or the
+// type's category (nested messages use their tableName)
+template <typename E> std::string proto_type_name(std::string_view protoType)
+{
+    if constexpr (std::is_integral_v<E> && !std::is_same_v<E, bool>)
+    {
+        if (!protoType.empty())
+            return std::string(protoType);
+    }
+
+    if constexpr (std::string_view(ProtoType<E>::name) != "unknown")
+        return ProtoType<E>::name;
+    else if constexpr (std::is_enum_v<E>)
+        return "int32";
+    else if constexpr (std::is_integral_v<E>)
+        return std::is_signed_v<E> ? (sizeof(E) <= 4 ? "int32" : "int64")
+                                   : (sizeof(E) <= 4 ? "uint32" : "uint64");
+    else if constexpr (requires { meta::MetaTuple<E>::tableName; })
+        return meta::MetaTuple<E>::tableName;
+    else
+        return "unknown";
+}
+
+
+} // namespace detail
+
+// Exact encoded size of obj
+template <typename T> size_t byte_size(const T& obj)
+{
+    return detail::message_size(obj);
+}
+
+// Encodes obj into out without allocating and returns the bytes written;
+// throws std::length_error when out is smaller than byte_size(obj)
+template <typename T> size_t serialize_to(const T& obj, std::span<char> out)
+{
+    detail::Writer writer(out.data(), out.size());
+    detail::write_message(writer, obj);
+    return writer.written();
+}
+
+template <typename T> std::string serialize(const T& obj)
+{
+    std::string out(byte_size(obj), '\0');
+    serialize_to(obj, std::span<char>(out.data(), out.size()));
+    return out;
+}
+
+// Merges the message in bytes into out (repeated fields append, as protobuf does)
+template <typename T> void parse(std::string_view bytes, T& out)
+{
+    detail::Reader in(bytes.data(), bytes.data(), bytes.data() + bytes.size());
+    detail::read_message(in, out);
+}
+
+template <typename T> T parse(std::string_view bytes)
+{
+    T out{};
+    parse(bytes, out);
+    return out;
+}
+
+} // namespace proto
+} // namespace meta
+
 // Generate proto message from MetaMappable type
-template <typename T, std::size_t... I> std::string GenerateProtoImpl(std::index_sequence<I...>)
+template <typename T, typename Fields, std::size_t... I>
+std::string GenerateProtoImpl(const std::string& name, const Fields& fields, std::index_sequence<I...>)
 {
     std::ostringstream os;
-    os << "message " << T::table << " {\n";
+    os << "message " << name << " {\n";
 
     // Fold expression over all fields
-    ((os << "  optional "
-         << ProtoType<typename std::tuple_element<I, decltype(T::fields)>::type::type>::name << " "
-         << std::get<I>(T::fields).memberName // <-- pick the correct FieldMeta member
-         << " = " << (I + 1) << ";\n"),
-     ...);
+    (
+        [&]
+        {
+            using Member = typename std::remove_cvref_t<std::tuple_element_t<I, Fields>>::type;
+            using Element = meta::proto::detail::element_t<Member>;
+            const auto& fieldMeta = std::get<I>(fields);
+            constexpr bool repeated = meta::proto::detail::is_vector<Member>::value;
+            constexpr bool packed = repeated && meta::proto::detail::Number<Element>;
+
+            os << (repeated ? "  repeated " : "  optional ")
+               << meta::proto::detail::proto_type_name<Element>(meta::proto::detail::proto_type(fieldMeta))
+               << " " << meta::proto::detail::member_name(fieldMeta) // <-- pick the correct FieldMeta member
+               << " = " << (I + 1) << (packed ? " [packed = true]" : "") << ";\n";
+        }(),
+        ...);
 
     os << "}\n";
     return os.str();
 }
 
+// Reflected types (MetaTuple<T>) are named after their tableName;
+// MetaMappable types (static fields and table) after T::table
 template <typename T> std::string GenerateProto()
 {
-    return GenerateProtoImpl<T>(std::make_index_sequence<std::tuple_size_v<decltype(T::fields)>>{});
+    if constexpr (requires { meta::MetaTuple<T>::fields; })
+        return GenerateProtoImpl<T>(
+            meta::MetaTuple<T>::tableName,
+            meta::MetaTuple<T>::fields,
+            std::make_index_sequence<std::tuple_size_v<meta::proto::detail::fields_t<T>>>{});
+    else
+        return GenerateProtoImpl<T>(
+            T::table,
+            T::fields,
+            std::make_index_sequence<std::tuple_size_v<std::remove_cvref_t<decltype(T::fields)>>>{});
 }
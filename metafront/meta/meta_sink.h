@@ -0,0 +1,195 @@
+/*
+ * ================================================================
+ * OUTPUT SINKS
+ *
+ * Buffered destination for the streaming writers (meta::json::writer,
+ * meta::csv::writer, meta::yaml::writer, meta::xml::writer). Records are
+ * formatted straight into buffer(); once it passes the block size it is
+ * handed to the target in one write and reused, so a writer holds one
+ * block of output no matter how many records go through it.
+ *
+ * Targets: a file descriptor (left open), a file path (created or
+ * truncated, closed with the sink), a std::ostream, a std::string, or any
+ * callable taking a std::string_view.
+ *
+ * Usage:
+ *   meta::json::writer<Row> out(meta::Sink::file("rows.json"));
+ *   out.write_all(FetchRowsGeneratorT<Row>(conn));   // or any range
+ *   out.close();
+ * ================================================================
+ */
+
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace meta
+{
+
+// Record layout shared by the writers: Pretty is what serialize() produces,
+// Compact what serialize_compact() produces
+enum class Layout
+{
+    Pretty,
+    Compact,
+};
+
+class Sink
+{
+  public:
+    using Target = std::function<void(std::string_view)>;
+    static constexpr size_t default_block = 64 * 1024;
+
+    explicit Sink(Target target, size_t block = default_block)
+        : target_(std::move(target)), block_(block)
+    {
+        buffer_.reserve(block_ + block_ / 4);
+    }
+
+    // write(2) to fd; the descriptor is not closed
+    static Sink fd(int fd, size_t block = default_block)
+    {
+        return Sink([fd](std::string_view data) { write_fd(fd, data); }, block);
+    }
+
+    // Creates or truncates path; the file is closed with the sink
+    static Sink file(const std::string& path, size_t block = default_block)
+    {
+#ifdef _WIN32
+        int fd = ::_open(path.c_str(),
+                         _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+                         _S_IREAD | _S_IWRITE);
+#else
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+        if (fd < 0)
+            throw std::runtime_error("meta: cannot open " + path + ": " + std::strerror(errno));
+
+        auto handle = std::shared_ptr<int>(new int(fd),
+                                           [](int* p)
+                                           {
+#ifdef _WIN32
+                                               ::_close(*p);
+#else
+                                               ::close(*p);
+#endif
+                                               delete p;
+                                           });
+        return Sink([handle](std::string_view data) { write_fd(*handle, data); }, block);
+    }
+
+    static Sink stream(std::ostream& os, size_t block = default_block)
+    {
+        return Sink(
+            [&os](std::string_view data)
+            {
+                os.write(data.data(), static_cast<std::streamsize>(data.size()));
+                if (!os)
+                    throw std::runtime_error("meta: stream write failed");
+            },
+            block);
+    }
+
+    static Sink string(std::string& out, size_t block = default_block)
+    {
+        return Sink([&out](std::string_view data) { out.append(data); }, block);
+    }
+
+    Sink(Sink&&) = default;
+    Sink& operator=(Sink&&) = default;
+    Sink(const Sink&) = delete;
+    Sink& operator=(const Sink&) = delete;
+
+    // Append formatted output here, then call commit()
+    std::string& buffer()
+    {
+        return buffer_;
+    }
+
+    // Hands the buffer to the target once it holds a full block
+    void commit()
+    {
+        if (buffer_.size() >= block_)
+            flush();
+    }
+
+    void flush()
+    {
+        if (buffer_.empty())
+            return;
+        if (!target_)
+            throw std::logic_error("meta: write to a closed sink");
+        target_(buffer_);
+        buffer_.clear();
+    }
+
+    // Flushes and releases the target (closing a file opened by Sink::file)
+    void close()
+    {
+        flush();
+        target_ = nullptr;
+    }
+
+  private:
+    static void write_fd(int fd, std::string_view data)
+    {
+        while (!data.empty())
+        {
+#ifdef _WIN32
+            int chunk = data.size() > 0x40000000 ? 0x40000000 : static_cast<int>(data.size());
+            auto written = ::_write(fd, data.data(), static_cast<unsigned>(chunk));
+#else
+            auto written = ::write(fd, data.data(), data.size());
+#endif
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                throw std::runtime_error(std::string("meta: write failed: ") +
+                                         std::strerror(errno));
+            }
+            data.remove_prefix(static_cast<size_t>(written));
+        }
+    }
+
+    Target target_;
+    size_t block_;
+    std::string buffer_;
+};
+
+// Writes every row of rows through writer.write and returns the count. Rows
+// may be records or pointers to them (FetchRowsGeneratorT yields
+// std::unique_ptr<T>); any range or Generator works, and only the current row
+// is alive at a time when the source is a generator.
+template <typename Writer, typename Range> size_t write_rows(Writer& writer, Range&& rows)
+{
+    size_t count = 0;
+    for (auto&& row : rows)
+    {
+        if constexpr (requires { writer.write(row); })
+            writer.write(row);
+        else
+            writer.write(*row);
+        ++count;
+    }
+    return count;
+}
+
+} // namespace meta
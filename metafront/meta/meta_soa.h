@@ -0,0 +1,608 @@
+/*
+ * ================================================================
+ * STRUCT-OF-ARRAYS CONTAINER
+ *
+ * meta::soa_vector<T> stores reflected records column by column: one
+ * contiguous array per MetaTuple<T>::fields entry, laid out at compile time
+ * from the field types and member pointers. A scan over one field touches
+ * only that field's memory, and column<&T::member>() hands it out as a
+ * std::span for plain loops the compiler can vectorize.
+ *
+ * Trivially copyable columns (numbers, bool, time_point) live in 64-byte
+ * aligned buffers; everything else (strings, vectors, optionals) in a
+ * std::vector. bool columns hold real bools, one byte each.
+ *
+ * Access:
+ *   soa[i]                       row proxy: get<&T::member>(), get<I>(),
+ *                                assignment from T, conversion to T
+ *   column<&T::member>()         std::span over one field
+ *   rows()                       the rows as const T&, rebuilt one at a time
+ *                                into a reused T (for writers and
+ *                                InsertRowsT: no allocation per row)
+ *
+ * json::serialize / serialize_compact / serialize_to and csv::serialize
+ * take a soa_vector directly; writers and the ODBC bulk insert take
+ * soa.rows(). Members outside MetaTuple<T>::fields are not stored.
+ *
+ * Usage:
+ *   meta::soa_vector<Car> cars;
+ *   cars.push_back(car);
+ *   uint64_t miles = 0;
+ *   for (unsigned m : cars.column<&Car::howmanymiles>())
+ *       miles += m;
+ *   std::string json = meta::json::serialize(cars);
+ * ================================================================
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace meta
+{
+
+namespace detail
+{
+
+// Growable buffer of trivially copyable values on 64-byte boundaries
+template <typename V> class pod_column
+{
+  public:
+    static constexpr std::align_val_t alignment{64};
+
+    pod_column() = default;
+    pod_column(const pod_column& other)
+    {
+        reserve(other.size_);
+        copy_from(other);
+    }
+    pod_column(pod_column&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0))
+    {
+    }
+    pod_column& operator=(const pod_column& other)
+    {
+        if (this != &other)
+        {
+            size_ = 0;
+            reserve(other.size_);
+            copy_from(other);
+        }
+        return *this;
+    }
+    pod_column& operator=(pod_column&& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        return *this;
+    }
+    ~pod_column()
+    {
+        release(data_);
+    }
+
+    V* data()
+    {
+        return data_;
+    }
+    const V* data() const
+    {
+        return data_;
+    }
+    size_t size() const
+    {
+        return size_;
+    }
+    V& operator[](size_t i)
+    {
+        return data_[i];
+    }
+    const V& operator[](size_t i) const
+    {
+        return data_[i];
+    }
+
+    void reserve(size_t capacity)
+    {
+        if (capacity <= capacity_)
+            return;
+        V* data = static_cast<V*>(::operator new(capacity * sizeof(V), alignment));
+        if (size_ != 0)
+            std::memcpy(data, data_, size_ * sizeof(V));
+        release(data_);
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    void push_back(const V& value)
+    {
+        if (size_ == capacity_)
+            reserve(capacity_ == 0 ? 16 : capacity_ * 2);
+        data_[size_++] = value;
+    }
+
+    // new elements are value-initialized
+    void resize(size_t size)
+    {
+        reserve(size);
+        for (size_t i = size_; i < size; ++i)
+            data_[i] = V{};
+        size_ = size;
+    }
+
+    void pop_back()
+    {
+        --size_;
+    }
+
+    void clear()
+    {
+        size_ = 0;
+    }
+
+  private:
+    void copy_from(const pod_column& other)
+    {
+        if (other.size_ != 0)
+            std::memcpy(data_, other.data_, other.size_ * sizeof(V));
+        size_ = other.size_;
+    }
+
+    static void release(V* data)
+    {
+        if (data)
+            ::operator delete(data, alignment);
+    }
+
+    V* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+template <typename V>
+using soa_column = std::conditional_t<std::is_trivially_copyable_v<V>, pod_column<V>, std::vector<V>>;
+
+template <typename T, size_t I>
+using soa_field = std::remove_cvref_t<std::tuple_element_t<I, std::remove_cvref_t<decltype(MetaTuple<T>::fields)>>>;
+
+template <typename T>
+inline constexpr size_t soa_field_count = std::tuple_size_v<std::remove_cvref_t<decltype(MetaTuple<T>::fields)>>;
+
+template <typename T, size_t... I>
+auto make_soa_columns(std::index_sequence<I...>) -> std::tuple<soa_column<typename soa_field<T, I>::type>...>;
+
+template <typename T>
+using soa_columns = decltype(make_soa_columns<T>(std::make_index_sequence<soa_field_count<T>>{}));
+
+// Index of the field whose member pointer is MemberPtr
+template <typename T, auto MemberPtr> constexpr size_t soa_index()
+{
+    constexpr size_t index = []<size_t... I>(std::index_sequence<I...>)
+    {
+        size_t found = sizeof...(I);
+        (
+            [&]
+            {
+                constexpr auto candidate = soa_field<T, I>::memberPtr;
+                if constexpr (std::is_same_v<std::remove_const_t<decltype(candidate)>, decltype(MemberPtr)>)
+                {
+                    if (found == sizeof...(I) && candidate == MemberPtr)
+                        found = I;
+                }
+            }(),
+            ...);
+        return found;
+    }(std::make_index_sequence<soa_field_count<T>>{});
+    static_assert(index < soa_field_count<T>, "soa_vector: member is not in MetaTuple<T>::fields");
+    return index;
+}
+
+} // namespace detail
+
+template <typename T> class soa_vector
+{
+    static constexpr size_t field_count = detail::soa_field_count<T>;
+    using indices = std::make_index_sequence<field_count>;
+
+    template <size_t I> static constexpr auto member_ptr = detail::soa_field<T, I>::memberPtr;
+    template <size_t I> static constexpr bool has_member = member_ptr<I> != nullptr;
+
+  public:
+    using value_type = T;
+    using size_type = size_t;
+
+    // Type stored for field I
+    template <size_t I> using column_type = typename detail::soa_field<T, I>::type;
+
+    // A row: reads and writes go to the columns
+    template <bool Const> class basic_row
+    {
+        using owner = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+      public:
+        basic_row(owner& soa, size_t index) : soa_(&soa), index_(index)
+        {
+        }
+
+        template <auto MemberPtr>
+            requires std::is_member_object_pointer_v<decltype(MemberPtr)>
+        decltype(auto) get() const
+        {
+            return soa_->template column<MemberPtr>()[index_];
+        }
+        template <size_t I> decltype(auto) get() const
+        {
+            return soa_->template column<I>()[index_];
+        }
+
+        // Copies the row out
+        operator T() const
+        {
+            return soa_->get(index_);
+        }
+
+        const basic_row& operator=(const T& row) const
+            requires(!Const)
+        {
+            soa_->set(index_, row);
+            return *this;
+        }
+
+        size_t index() const
+        {
+            return index_;
+        }
+
+      private:
+        owner* soa_;
+        size_t index_;
+    };
+    using reference = basic_row<false>;
+    using const_reference = basic_row<true>;
+
+    // Random access over row proxies
+    template <bool Const> class basic_iterator
+    {
+        using owner = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = basic_row<Const>;
+        using pointer = void;
+
+        basic_iterator() = default;
+        basic_iterator(owner* soa, size_t index) : soa_(soa), index_(index)
+        {
+        }
+
+        reference operator*() const
+        {
+            return reference(*soa_, index_);
+        }
+        reference operator[](difference_type n) const
+        {
+            return reference(*soa_, index_ + static_cast<size_t>(n));
+        }
+
+        basic_iterator& operator++()
+        {
+            ++index_;
+            return *this;
+        }
+        basic_iterator operator++(int)
+        {
+            return {soa_, index_++};
+        }
+        basic_iterator& operator--()
+        {
+            --index_;
+            return *this;
+        }
+        basic_iterator operator--(int)
+        {
+            return {soa_, index_--};
+        }
+        basic_iterator& operator+=(difference_type n)
+        {
+            index_ += static_cast<size_t>(n);
+            return *this;
+        }
+        basic_iterator& operator-=(difference_type n)
+        {
+            index_ -= static_cast<size_t>(n);
+            return *this;
+        }
+        friend basic_iterator operator+(basic_iterator it, difference_type n)
+        {
+            return it += n;
+        }
+        friend basic_iterator operator+(difference_type n, basic_iterator it)
+        {
+            return it += n;
+        }
+        friend basic_iterator operator-(basic_iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+        friend difference_type operator-(const basic_iterator& a, const basic_iterator& b)
+        {
+            return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+        }
+        friend bool operator==(const basic_iterator& a, const basic_iterator& b)
+        {
+            return a.index_ == b.index_;
+        }
+        friend auto operator<=>(const basic_iterator& a, const basic_iterator& b)
+        {
+            return a.index_ <=> b.index_;
+        }
+
+      private:
+        owner* soa_ = nullptr;
+        size_t index_ = 0;
+    };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    // The rows as const T&, each rebuilt into one reused T; a row stays valid
+    // until the next one is read
+    class row_view
+    {
+      public:
+        class iterator
+        {
+          public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            iterator(const row_view* view, size_t index) : view_(view), index_(index)
+            {
+            }
+
+            const T& operator*() const
+            {
+                return view_->load(index_);
+            }
+            iterator& operator++()
+            {
+                ++index_;
+                return *this;
+            }
+            void operator++(int)
+            {
+                ++index_;
+            }
+            friend bool operator==(const iterator& a, const iterator& b)
+            {
+                return a.index_ == b.index_;
+            }
+
+          private:
+            const row_view* view_ = nullptr;
+            size_t index_ = 0;
+        };
+
+        explicit row_view(const soa_vector& soa) : soa_(&soa)
+        {
+        }
+
+        iterator begin() const
+        {
+            return {this, 0};
+        }
+        iterator end() const
+        {
+            return {this, soa_->size()};
+        }
+        size_t size() const
+        {
+            return soa_->size();
+        }
+
+      private:
+        const T& load(size_t index) const
+        {
+            if (index != loaded_)
+            {
+                soa_->load(index, row_);
+                loaded_ = index;
+            }
+            return row_;
+        }
+
+        const soa_vector* soa_;
+        mutable T row_{};
+        mutable size_t loaded_ = static_cast<size_t>(-1);
+    };
+
+    soa_vector() = default;
+
+    size_t size() const
+    {
+        return size_;
+    }
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    void reserve(size_t capacity)
+    {
+        for_each_column([capacity](auto& column) { column.reserve(capacity); });
+    }
+
+    // New rows are value-initialized
+    void resize(size_t size)
+    {
+        for_each_column([size](auto& column) { column.resize(size); });
+        size_ = size;
+    }
+
+    void clear()
+    {
+        for_each_column([](auto& column) { column.clear(); });
+        size_ = 0;
+    }
+
+    void push_back(const T& row)
+    {
+        append(row, indices{});
+        ++size_;
+    }
+
+    // Moves the members (strings, vectors) into the columns
+    void push_back(T&& row)
+    {
+        append(std::move(row), indices{});
+        ++size_;
+    }
+
+    void pop_back()
+    {
+        for_each_column([](auto& column) { column.pop_back(); });
+        --size_;
+    }
+
+    reference operator[](size_t index)
+    {
+        return reference(*this, index);
+    }
+    const_reference operator[](size_t index) const
+    {
+        return const_reference(*this, index);
+    }
+
+    iterator begin()
+    {
+        return {this, 0};
+    }
+    iterator end()
+    {
+        return {this, size_};
+    }
+    const_iterator begin() const
+    {
+        return {this, 0};
+    }
+    const_iterator end() const
+    {
+        return {this, size_};
+    }
+
+    row_view rows() const
+    {
+        return row_view(*this);
+    }
+
+    // Field I, or the field of member MemberPtr, as one contiguous span
+    template <size_t I> std::span<column_type<I>> column()
+    {
+        auto& column = std::get<I>(columns_);
+        return {column.data(), column.size()};
+    }
+    template <size_t I> std::span<const column_type<I>> column() const
+    {
+        const auto& column = std::get<I>(columns_);
+        return {column.data(), column.size()};
+    }
+    template <auto MemberPtr>
+        requires std::is_member_object_pointer_v<decltype(MemberPtr)>
+    auto column()
+    {
+        return column<detail::soa_index<T, MemberPtr>()>();
+    }
+    template <auto MemberPtr>
+        requires std::is_member_object_pointer_v<decltype(MemberPtr)>
+    auto column() const
+    {
+        return column<detail::soa_index<T, MemberPtr>()>();
+    }
+
+    // Copies row index into out; strings and vectors reuse out's storage
+    void load(size_t index, T& out) const
+    {
+        load(index, out, indices{});
+    }
+
+    T get(size_t index) const
+    {
+        T out{};
+        load(index, out);
+        return out;
+    }
+
+    T at(size_t index) const
+    {
+        if (index >= size_)
+            throw std::out_of_range("soa_vector: index " + std::to_string(index) + " out of range");
+        return get(index);
+    }
+
+    void set(size_t index, const T& row)
+    {
+        store(index, row, indices{});
+    }
+
+  private:
+    template <typename Fn> void for_each_column(Fn&& fn)
+    {
+        std::apply([&](auto&... columns) { (fn(columns), ...); }, columns_);
+    }
+
+    // Fields without a member keep default values
+    template <typename Row, size_t... I> void append(Row&& row, std::index_sequence<I...>)
+    {
+        (
+            [&]
+            {
+                if constexpr (has_member<I>)
+                    std::get<I>(columns_).push_back(std::forward<Row>(row).*member_ptr<I>);
+                else
+                    std::get<I>(columns_).push_back(column_type<I>{});
+            }(),
+            ...);
+    }
+
+    template <size_t... I> void load(size_t index, T& out, std::index_sequence<I...>) const
+    {
+        (
+            [&]
+            {
+                if constexpr (has_member<I>)
+                    out.*member_ptr<I> = std::get<I>(columns_)[index];
+            }(),
+            ...);
+    }
+
+    template <size_t... I> void store(size_t index, const T& row, std::index_sequence<I...>)
+    {
+        (
+            [&]
+            {
+                if constexpr (has_member<I>)
+                    std::get<I>(columns_)[index] = row.*member_ptr<I>;
+            }(),
+            ...);
+    }
+
+    detail::soa_columns<T> columns_;
+    size_t size_ = 0;
+};
+
+} // namespace meta
@@ -1,13 +1,21 @@
 #pragma once
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <chrono>
+#include <cmath>
 #include <coroutine>
 #include <cstdint>
+#include <cstdio>
+#include <ctime>
 #include <exception>
 #include <memory>
+#include <optional>
+#include <stdexcept>
 #include <sql.h>
 #include <sqlext.h>
 #include <sqltypes.h>
@@ -18,8 +26,119 @@
 #include <utility>
 #include <vector>
 
+// immutable.h (ImmutableString, Field<T, FieldMutability>, ImmutableClass) is not
+// part of metafront; the row-at-a-time reader for those types is only built when
+// the including project provides it.
+#if __has_include("immutable.h")
 #include "immutable.h"
+#define META_SQL_IMMUTABLE 1
+#endif
 #include "meta_field.h"
+#include "meta_db.h" // after meta_field.h, which it relies on
+#include "meta_generator.h"
+
+//-------------------- ODBC HELPERS --------------------
+// ANSI entry points (the plain names map to the W variants under UNICODE on Windows)
+inline SQLRETURN ExecDirect(SQLHANDLE stmt, const char* sql)
+{
+#ifdef _WIN32
+    return SQLExecDirectA(stmt, reinterpret_cast<SQLCHAR*>(const_cast<char*>(sql)), SQL_NTS);
+#else
+    return SQLExecDirect(stmt, reinterpret_cast<SQLCHAR*>(const_cast<char*>(sql)), SQL_NTS);
+#endif
+}
+
+inline SQLRETURN Prepare(SQLHANDLE stmt, const char* sql)
+{
+#ifdef _WIN32
+    return SQLPrepareA(stmt, reinterpret_cast<SQLCHAR*>(const_cast<char*>(sql)), SQL_NTS);
+#else
+    return SQLPrepare(stmt, reinterpret_cast<SQLCHAR*>(const_cast<char*>(sql)), SQL_NTS);
+#endif
+}
+
+// Throws std::runtime_error with the first diagnostic record unless ret succeeded
+inline void CheckOdbc(SQLRETURN ret, SQLSMALLINT handleType, SQLHANDLE handle, const char* what)
+{
+    if (SQL_SUCCEEDED(ret))
+        return;
+
+    std::string message = std::string("odbc: ") + what + " failed";
+    SQLCHAR state[6]{};
+    SQLCHAR text[512]{};
+    SQLINTEGER native = 0;
+    SQLSMALLINT length = 0;
+#ifdef _WIN32
+    SQLRETURN diag = SQLGetDiagRecA(handleType, handle, 1, state, &native, text, sizeof(text), &length);
+#else
+    SQLRETURN diag = SQLGetDiagRec(handleType, handle, 1, state, &native, text, sizeof(text), &length);
+#endif
+    if (SQL_SUCCEEDED(diag))
+        message += std::string(" [") + reinterpret_cast<char*>(state) + "] " + reinterpret_cast<char*>(text);
+    throw std::runtime_error(message);
+}
+
+// Frees a statement handle when the owner (e.g. a suspended generator) goes away
+struct StatementCloser
+{
+    void operator()(SQLHANDLE stmt) const
+    {
+        SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    }
+};
+using StatementPtr = std::unique_ptr<void, StatementCloser>;
+
+inline StatementPtr AllocStatement(SQLHANDLE conn)
+{
+    SQLHANDLE stmt = SQL_NULL_HANDLE;
+    CheckOdbc(SQLAllocHandle(SQL_HANDLE_STMT, conn, &stmt), SQL_HANDLE_DBC, conn, "SQLAllocHandle");
+    return StatementPtr(stmt);
+}
+
+inline std::chrono::system_clock::time_point TimestampToTimePoint(const SQL_TIMESTAMP_STRUCT& timestamp)
+{
+    std::tm time{};
+    time.tm_year = timestamp.year - 1900;
+    time.tm_mon = timestamp.month - 1;
+    time.tm_mday = timestamp.day;
+    time.tm_hour = timestamp.hour;
+    time.tm_min = timestamp.minute;
+    time.tm_sec = timestamp.second;
+    time.tm_isdst = 0;
+
+#ifdef _WIN32
+    std::time_t t = _mkgmtime(&time);
+#else
+    std::time_t t = timegm(&time);
+#endif
+    return std::chrono::system_clock::from_time_t(t) +
+           std::chrono::duration_cast<std::chrono::system_clock::duration>(
+               std::chrono::nanoseconds(timestamp.fraction));
+}
+
+// UTC, truncated to microseconds (the precision parameters are bound with)
+inline SQL_TIMESTAMP_STRUCT TimePointToTimestamp(std::chrono::system_clock::time_point point)
+{
+    auto seconds = std::chrono::floor<std::chrono::seconds>(point);
+    std::time_t t = std::chrono::system_clock::to_time_t(seconds);
+    std::tm time{};
+#ifdef _WIN32
+    gmtime_s(&time, &t);
+#else
+    gmtime_r(&t, &time);
+#endif
+
+    SQL_TIMESTAMP_STRUCT timestamp{};
+    timestamp.year = static_cast<SQLSMALLINT>(time.tm_year + 1900);
+    timestamp.month = static_cast<SQLUSMALLINT>(time.tm_mon + 1);
+    timestamp.day = static_cast<SQLUSMALLINT>(time.tm_mday);
+    timestamp.hour = static_cast<SQLUSMALLINT>(time.tm_hour);
+    timestamp.minute = static_cast<SQLUSMALLINT>(time.tm_min);
+    timestamp.second = static_cast<SQLUSMALLINT>(time.tm_sec);
+    auto micros = std::chrono::floor<std::chrono::microseconds>(point - seconds);
+    timestamp.fraction = static_cast<SQLUINTEGER>(micros.count() * 1000);
+    return timestamp;
+}
 
 //-------------------- GET COLUMN VALUE --------------------
 template <typename T> T inline GetColumnValue(SQLHANDLE& stmt, uint16_t col)
@@ -97,11 +216,13 @@ template <> inline std::string GetColumnValue<std::string>(SQLHANDLE& stmt, uint
     return str;
 }
 
+#ifdef META_SQL_IMMUTABLE
 // ImmutableString wrapper
 template <> inline ImmutableString GetColumnValue<ImmutableString>(SQLHANDLE& stmt, uint16_t col)
 {
     return ImmutableString(GetColumnValue<std::string>(stmt, col));
 }
+#endif
 
 // std::chrono::system_clock::time_point
 template <>
@@ -118,18 +239,10 @@ inline std::chrono::system_clock::time_point GetColumnValue<std::chrono::system_
     if (ind == SQL_NULL_DATA)
         return {};
 
-    std::tm time{};
-    time.tm_year = timestamp.year - 1900;
-    time.tm_mon = timestamp.month - 1;
-    time.tm_mday = timestamp.day;
-    time.tm_hour = timestamp.hour;
-    time.tm_min = timestamp.minute;
-    time.tm_sec = timestamp.second;
-    time.tm_isdst = 0;
-
-    std::time_t t = _mkgmtime(&time);
-    return std::chrono::system_clock::from_time_t(t);
+    return TimestampToTimePoint(timestamp);
 }
+
+#ifdef META_SQL_IMMUTABLE
 // -------------------- Explicit specializations for immutable Field<T, FieldMutability::Immutable>
 // --------------------
 
@@ -262,150 +375,746 @@ template <typename T> T ReadObjT(SQLHANDLE& stmt)
                            std::make_index_sequence<std::tuple_size_v<decltype(T::fields)>>{});
 }
 
-//-------------------- GENERATOR --------------------
-template <typename T> class Generator
+//-------------------- FETCH ROWS GENERATOR --------------------
+template <typename T> Generator<std::unique_ptr<T>> FetchRowsGeneratorT(SQLHANDLE conn)
 {
-  public:
-    using YieldType = T;
+    SQLHANDLE stmt;
+    SQLAllocHandle(SQL_HANDLE_STMT, conn, &stmt);
+    ExecDirect(stmt, T::query);
 
-    struct promise_type
+    using Raw = typename WrapperType<T>::Raw;
+
+    while (SQLFetch(stmt) == SQL_SUCCESS)
     {
-        YieldType current_value;
-        std::exception_ptr exception;
+        Raw raw = ReadObjT<Raw>(stmt);                 // fetch raw data
+        co_yield WrapperType<T>::wrap(std::move(raw)); // wrap mutable/immutable
+    }
+
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+}
+#endif // META_SQL_IMMUTABLE
+
+//-------------------- BLOCK FETCH --------------------
+// FetchRowsBlockGeneratorT binds every MetaTuple<T> column once with SQLBindCol
+// into column arrays of options.rows entries and sets SQL_ATTR_ROW_ARRAY_SIZE,
+// so each SQLFetch returns a whole block. Rows are built from the bound
+// buffers: no SQLGetData calls and no per-cell allocations apart from the
+// strings being copied into the rows.
+//
+// Builds on Windows (odbc32) and on Linux against unixODBC (-lodbc); the
+// SQLite ODBC driver (libsqlite3odbc) is the local test target:
+//   for (Row& row : FetchRowsBlockGeneratorT<Row>(conn, {.rows = 4096}))
+struct BlockFetchOptions
+{
+    size_t rows = 1024;       // rows per SQLFetch (drivers may lower it)
+    size_t stringBytes = 256; // bound width of string columns; longer values throw
+};
 
-        Generator get_return_object()
+// C type and buffer element used to bind a member type
+template <typename T> struct BoundType
+{
+    static_assert(sizeof(T) == 0, "BoundType<T> not implemented for this type");
+};
+
+template <typename T>
+    requires std::is_integral_v<T> && (!std::is_same_v<T, bool>)
+struct BoundType<T>
+{
+    using Buffer = T;
+    static constexpr SQLSMALLINT cType = [] {
+        if constexpr (sizeof(T) == 1)
+            return std::is_signed_v<T> ? SQL_C_STINYINT : SQL_C_UTINYINT;
+        else if constexpr (sizeof(T) == 2)
+            return std::is_signed_v<T> ? SQL_C_SSHORT : SQL_C_USHORT;
+        else if constexpr (sizeof(T) == 4)
+            return std::is_signed_v<T> ? SQL_C_SLONG : SQL_C_ULONG;
+        else
+            return std::is_signed_v<T> ? SQL_C_SBIGINT : SQL_C_UBIGINT;
+    }();
+    static constexpr SQLSMALLINT sqlType = sizeof(T) == 1   ? SQL_TINYINT
+                                           : sizeof(T) == 2 ? SQL_SMALLINT
+                                           : sizeof(T) == 4 ? SQL_INTEGER
+                                                            : SQL_BIGINT;
+    static T get(const Buffer& value)
+    {
+        return value;
+    }
+    static Buffer put(T value)
+    {
+        return value;
+    }
+};
+
+template <> struct BoundType<bool>
+{
+    using Buffer = unsigned char;
+    static constexpr SQLSMALLINT cType = SQL_C_BIT;
+    static constexpr SQLSMALLINT sqlType = SQL_BIT;
+    static bool get(const Buffer& value)
+    {
+        return value != 0;
+    }
+    static Buffer put(bool value)
+    {
+        return value ? 1 : 0;
+    }
+};
+
+template <> struct BoundType<float>
+{
+    using Buffer = float;
+    static constexpr SQLSMALLINT cType = SQL_C_FLOAT;
+    static constexpr SQLSMALLINT sqlType = SQL_REAL;
+    static float get(const Buffer& value)
+    {
+        return value;
+    }
+    static Buffer put(float value)
+    {
+        return value;
+    }
+};
+
+template <> struct BoundType<double>
+{
+    using Buffer = double;
+    static constexpr SQLSMALLINT cType = SQL_C_DOUBLE;
+    static constexpr SQLSMALLINT sqlType = SQL_DOUBLE;
+    static double get(const Buffer& value)
+    {
+        return value;
+    }
+    static Buffer put(double value)
+    {
+        return value;
+    }
+};
+
+// Bound as fixed-width character rows (see BoundColumn and BoundParam)
+template <> struct BoundType<std::string>
+{
+    using Buffer = char;
+    static constexpr SQLSMALLINT cType = SQL_C_CHAR;
+    static constexpr SQLSMALLINT sqlType = SQL_VARCHAR;
+};
+
+template <> struct BoundType<std::chrono::system_clock::time_point>
+{
+    using Buffer = SQL_TIMESTAMP_STRUCT;
+    static constexpr SQLSMALLINT cType = SQL_C_TYPE_TIMESTAMP;
+    static constexpr SQLSMALLINT sqlType = SQL_TYPE_TIMESTAMP;
+    static std::chrono::system_clock::time_point get(const Buffer& value)
+    {
+        return TimestampToTimePoint(value);
+    }
+    static Buffer put(std::chrono::system_clock::time_point value)
+    {
+        return TimePointToTimestamp(value);
+    }
+};
+
+// Member type to bind: std::optional<U> binds as U, with NULL as nullopt
+template <typename Member> struct BoundMember
+{
+    using type = Member;
+    static constexpr bool optional = false;
+};
+template <typename U> struct BoundMember<std::optional<U>>
+{
+    using type = U;
+    static constexpr bool optional = true;
+};
+
+// One bound column: values and length/NULL indicators for every row of a block
+template <typename Member> class BoundColumn
+{
+    using Value = typename BoundMember<Member>::type;
+    static constexpr bool isString = std::is_same_v<Value, std::string>;
+
+  public:
+    void bind(SQLHANDLE stmt, SQLUSMALLINT column, size_t rows, size_t stringBytes)
+    {
+        column_ = column;
+        indicators_.assign(rows, 0);
+        SQLRETURN ret;
+        if constexpr (isString)
         {
-            return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+            width_ = stringBytes + 1; // NUL terminator
+            chars_.assign(rows * width_, '\0');
+            ret = SQLBindCol(stmt, column, BoundType<Value>::cType, chars_.data(),
+                             static_cast<SQLLEN>(width_), indicators_.data());
         }
-        std::suspend_always initial_suspend() noexcept
+        else
         {
-            return {};
+            values_.assign(rows, {});
+            ret = SQLBindCol(stmt, column, BoundType<Value>::cType, values_.data(),
+                             sizeof(typename BoundType<Value>::Buffer), indicators_.data());
         }
-        std::suspend_always final_suspend() noexcept
+        CheckOdbc(ret, SQL_HANDLE_STMT, stmt, "SQLBindCol");
+    }
+
+    // NULL reads as nullopt for optional members and as a default value otherwise
+    void read(size_t row, Member& out) const
+    {
+        SQLLEN indicator = indicators_[row];
+        if (indicator == SQL_NULL_DATA)
         {
-            return {};
+            out = Member{};
+            return;
         }
 
-        std::suspend_always yield_value(YieldType value) noexcept
+        if constexpr (isString)
         {
-            current_value = std::move(value);
-            return {};
+            if (indicator == SQL_NO_TOTAL || static_cast<size_t>(indicator) >= width_)
+                throw std::runtime_error("odbc: column " + std::to_string(column_) +
+                                         " is longer than BlockFetchOptions::stringBytes");
+            const char* text = chars_.data() + row * width_;
+            out = Value(text, static_cast<size_t>(indicator));
         }
+        else
+            out = BoundType<Value>::get(values_[row]);
+    }
+
+  private:
+    SQLUSMALLINT column_ = 0;
+    size_t width_ = 0;
+    std::vector<char> chars_;                                   // strings: width_ bytes per row
+    std::vector<typename BoundType<Value>::Buffer> values_;     // everything else
+    std::vector<SQLLEN> indicators_;
+};
+
+template <typename T, typename Fields, std::size_t... I>
+auto MakeBoundColumns(std::index_sequence<I...>)
+    -> std::tuple<BoundColumn<typename std::remove_cvref_t<std::tuple_element_t<I, Fields>>::type>...>;
+
+template <typename T>
+using BoundColumnsT = decltype(MakeBoundColumns<
+                               T,
+                               std::remove_cvref_t<decltype(meta::MetaTuple<T>::fields)>>(
+    std::make_index_sequence<
+        std::tuple_size_v<std::remove_cvref_t<decltype(meta::MetaTuple<T>::fields)>>>{}));
+
+// Column I + 1 of the result goes to field I
+template <typename T, std::size_t... I>
+void BindColumnsT(SQLHANDLE stmt, BoundColumnsT<T>& columns, size_t rows, size_t stringBytes,
+                  std::index_sequence<I...>)
+{
+    (std::get<I>(columns).bind(stmt, static_cast<SQLUSMALLINT>(I + 1), rows, stringBytes), ...);
+}
 
-        void return_void() noexcept
+template <typename T, std::size_t... I>
+void ReadRowT(const BoundColumnsT<T>& columns, size_t row, T& out, std::index_sequence<I...>)
+{
+    using Fields = std::remove_cvref_t<decltype(meta::MetaTuple<T>::fields)>;
+    (
+        [&]
         {
-        }
-        void unhandled_exception()
+            using FieldMeta = std::remove_cvref_t<std::tuple_element_t<I, Fields>>;
+            if constexpr (FieldMeta::memberPtr != nullptr)
+                std::get<I>(columns).read(row, out.*(FieldMeta::memberPtr));
+        }(),
+        ...);
+}
+
+// Rows of MetaTuple<T>::query, fetched options.rows at a time
+template <typename T>
+Generator<T> FetchRowsBlockGeneratorT(SQLHANDLE conn, BlockFetchOptions options = {})
+{
+    constexpr size_t fieldCount =
+        std::tuple_size_v<std::remove_cvref_t<decltype(meta::MetaTuple<T>::fields)>>;
+    StatementPtr stmt = AllocStatement(conn);
+    SQLHANDLE h = stmt.get();
+
+    // The driver may lower the block size (01S02); read back what it took
+    CheckOdbc(SQLSetStmtAttr(h, SQL_ATTR_ROW_BIND_TYPE, reinterpret_cast<SQLPOINTER>(SQL_BIND_BY_COLUMN), 0),
+              SQL_HANDLE_STMT, h, "SQL_ATTR_ROW_BIND_TYPE");
+    CheckOdbc(SQLSetStmtAttr(h, SQL_ATTR_ROW_ARRAY_SIZE,
+                             reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(std::max<size_t>(options.rows, 1))), 0),
+              SQL_HANDLE_STMT, h, "SQL_ATTR_ROW_ARRAY_SIZE");
+    SQLULEN rows = 1;
+    CheckOdbc(SQLGetStmtAttr(h, SQL_ATTR_ROW_ARRAY_SIZE, &rows, 0, nullptr), SQL_HANDLE_STMT, h,
+              "SQL_ATTR_ROW_ARRAY_SIZE");
+
+    SQLULEN fetched = 0;
+    std::vector<SQLUSMALLINT> status(rows);
+    CheckOdbc(SQLSetStmtAttr(h, SQL_ATTR_ROW_STATUS_PTR, status.data(), 0), SQL_HANDLE_STMT, h,
+              "SQL_ATTR_ROW_STATUS_PTR");
+    CheckOdbc(SQLSetStmtAttr(h, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0), SQL_HANDLE_STMT, h,
+              "SQL_ATTR_ROWS_FETCHED_PTR");
+
+    BoundColumnsT<T> columns;
+    BindColumnsT<T>(h, columns, rows, options.stringBytes, std::make_index_sequence<fieldCount>{});
+    CheckOdbc(ExecDirect(h, meta::MetaTuple<T>::query), SQL_HANDLE_STMT, h, "SQLExecDirect");
+
+    SQLRETURN ret;
+    while ((ret = SQLFetch(h)) != SQL_NO_DATA)
+    {
+        CheckOdbc(ret, SQL_HANDLE_STMT, h, "SQLFetch");
+        for (SQLULEN i = 0; i < fetched; ++i)
         {
-            exception = std::current_exception();
+            if (status[i] != SQL_ROW_SUCCESS && status[i] != SQL_ROW_SUCCESS_WITH_INFO)
+                continue;
+            T row{};
+            ReadRowT<T>(columns, i, row, std::make_index_sequence<fieldCount>{});
+            co_yield std::move(row);
         }
-    };
+    }
+}
+
+#ifndef META_SQL_IMMUTABLE
+// Row source for MetaTuple<T> types when immutable.h is absent: the same
+// unique_ptr<T> rows, read through the block fetch
+template <typename T> Generator<std::unique_ptr<T>> FetchRowsGeneratorT(SQLHANDLE conn)
+{
+    for (T& row : FetchRowsBlockGeneratorT<T>(conn))
+        co_yield std::make_unique<T>(std::move(row));
+}
+#endif
 
-    using handle_type = std::coroutine_handle<promise_type>;
-    explicit Generator(handle_type h) : coro_(h)
+//-------------------- BULK INSERT --------------------
+// BulkWriterT prepares DatabaseWriter<T>::generateInsert() once and binds
+// every INSERT column as a parameter array (SQL_ATTR_PARAMSET_SIZE) laid out
+// column-wise, so one SQLExecute sends options.batchRows rows. Rows are copied
+// from their members straight into the bound arrays. Drivers that refuse
+// parameter arrays get the same rows as multi-row VALUES lists instead.
+//
+// Autocommit is turned off for the writer's lifetime and a commit is issued
+// every options.commitRows rows and at close(). A failed batch rolls back
+// the open transaction and closes the writer; rows committed before it stay.
+// A writer destroyed without close() rolls back what was not committed.
+//   BulkWriterT<Row> out(conn, {.batchRows = 2000});
+//   for (const Row& row : rows)
+//       out.write(row);
+//   out.close();
+struct BulkInsertOptions
+{
+    size_t batchRows = 1000;   // rows per SQLExecute / VALUES statement (drivers may lower it)
+    size_t commitRows = 10000; // rows per transaction; 0 commits at close() only
+    size_t stringBytes = 256;  // bound width of string parameters; longer values throw
+    bool arrayBinding = true;  // false always uses VALUES lists
+};
+
+// One bound parameter: values and length/NULL indicators for every row of a batch
+template <typename Member> class BoundParam
+{
+    using Value = typename BoundMember<Member>::type;
+    static constexpr bool isString = std::is_same_v<Value, std::string>;
+    static constexpr bool isTimestamp = std::is_same_v<Value, std::chrono::system_clock::time_point>;
+
+  public:
+    void bind(SQLHANDLE stmt, SQLUSMALLINT param, size_t rows, size_t stringBytes)
     {
+        param_ = param;
+        indicators_.assign(rows, 0);
+        SQLRETURN ret;
+        if constexpr (isString)
+        {
+            width_ = stringBytes;
+            chars_.assign(rows * width_, '\0');
+            ret = SQLBindParameter(stmt, param, SQL_PARAM_INPUT, BoundType<Value>::cType,
+                                   BoundType<Value>::sqlType, width_, 0, chars_.data(),
+                                   static_cast<SQLLEN>(width_), indicators_.data());
+        }
+        else
+        {
+            // timestamps go with microseconds: SQL_TYPE_TIMESTAMP(26, 6)
+            values_.assign(rows, {});
+            ret = SQLBindParameter(stmt, param, SQL_PARAM_INPUT, BoundType<Value>::cType,
+                                   BoundType<Value>::sqlType, isTimestamp ? 26 : 0, isTimestamp ? 6 : 0,
+                                   values_.data(), sizeof(typename BoundType<Value>::Buffer),
+                                   indicators_.data());
+        }
+        CheckOdbc(ret, SQL_HANDLE_STMT, stmt, "SQLBindParameter");
     }
-    Generator(const Generator&) = delete;
-    Generator& operator=(const Generator&) = delete;
-    Generator(Generator&& other) noexcept : coro_(other.coro_)
+
+    // nullopt is sent as NULL
+    void write(size_t row, const Member& in)
     {
-        other.coro_ = {};
+        const Value* value = nullptr;
+        if constexpr (BoundMember<Member>::optional)
+        {
+            if (!in)
+            {
+                indicators_[row] = SQL_NULL_DATA;
+                return;
+            }
+            value = &*in;
+        }
+        else
+            value = &in;
+
+        if constexpr (isString)
+        {
+            if (value->size() > width_)
+                throw std::runtime_error("odbc: parameter " + std::to_string(param_) +
+                                         " is longer than BulkInsertOptions::stringBytes");
+            std::copy(value->begin(), value->end(), chars_.begin() + static_cast<std::ptrdiff_t>(row * width_));
+            indicators_[row] = static_cast<SQLLEN>(value->size());
+        }
+        else
+        {
+            values_[row] = BoundType<Value>::put(*value);
+            indicators_[row] = 0;
+        }
     }
-    Generator& operator=(Generator&& other) noexcept
+
+    // The value as an SQL literal, for VALUES lists
+    static void appendLiteral(std::string& out, const Member& in)
     {
-        if (coro_)
-            coro_.destroy();
-        coro_ = other.coro_;
-        other.coro_ = {};
-        return *this;
+        if constexpr (BoundMember<Member>::optional)
+        {
+            if (!in)
+            {
+                out += "NULL";
+                return;
+            }
+            appendValue(out, *in);
+        }
+        else
+            appendValue(out, in);
     }
-    ~Generator()
+
+  private:
+    static void appendValue(std::string& out, const Value& value)
     {
-        if (coro_)
-            coro_.destroy();
+        char buf[64];
+        if constexpr (isString)
+        {
+            out += '\'';
+            for (size_t start = 0;;)
+            {
+                size_t quote = value.find('\'', start);
+                out.append(value, start, quote == std::string::npos ? std::string::npos : quote - start);
+                if (quote == std::string::npos)
+                    break;
+                out += "''";
+                start = quote + 1;
+            }
+            out += '\'';
+        }
+        else if constexpr (std::is_same_v<Value, bool>)
+            out += value ? '1' : '0';
+        else if constexpr (std::is_floating_point_v<Value>)
+        {
+            if (!std::isfinite(value))
+            {
+                out += "NULL";
+                return;
+            }
+            out.append(buf, std::to_chars(buf, buf + sizeof(buf), value).ptr);
+        }
+        else if constexpr (isTimestamp)
+        {
+            SQL_TIMESTAMP_STRUCT t = TimePointToTimestamp(value);
+            int n = std::snprintf(buf, sizeof(buf), "{ts '%04d-%02u-%02u %02u:%02u:%02u.%06u'}", t.year,
+                                  static_cast<unsigned>(t.month), static_cast<unsigned>(t.day),
+                                  static_cast<unsigned>(t.hour), static_cast<unsigned>(t.minute),
+                                  static_cast<unsigned>(t.second), static_cast<unsigned>(t.fraction / 1000));
+            out.append(buf, static_cast<size_t>(n));
+        }
+        else
+            out.append(buf, std::to_chars(buf, buf + sizeof(buf), value).ptr);
     }
 
-    class iterator
+    SQLUSMALLINT param_ = 0;
+    size_t width_ = 0;
+    std::vector<char> chars_;                               // strings: width_ bytes per row
+    std::vector<typename BoundType<Value>::Buffer> values_; // everything else
+    std::vector<SQLLEN> indicators_;
+};
+
+// Slot for a field generateInsert() leaves out (private, or no member)
+struct UnboundParam
+{
+};
+
+template <typename T, std::size_t I>
+using FieldMetaT = std::remove_cvref_t<std::tuple_element_t<I, std::remove_cvref_t<decltype(meta::MetaTuple<T>::fields)>>>;
+
+template <typename T, std::size_t I>
+inline constexpr bool IsInsertFieldT = db::DatabaseWriter<T>::template isInsertField<FieldMetaT<T, I>>();
+
+template <typename T, std::size_t... I>
+auto MakeInsertParams(std::index_sequence<I...>)
+    -> std::tuple<std::conditional_t<IsInsertFieldT<T, I>, BoundParam<typename FieldMetaT<T, I>::type>, UnboundParam>...>;
+
+template <typename T>
+using InsertParamsT = decltype(MakeInsertParams<T>(
+    std::make_index_sequence<std::tuple_size_v<std::remove_cvref_t<decltype(meta::MetaTuple<T>::fields)>>>{}));
+
+// Parameters are numbered in generateInsert() column order
+template <typename T, std::size_t... I>
+void BindParamsT(SQLHANDLE stmt, InsertParamsT<T>& params, size_t rows, size_t stringBytes,
+                 std::index_sequence<I...>)
+{
+    SQLUSMALLINT param = 0;
+    (
+        [&]
+        {
+            if constexpr (IsInsertFieldT<T, I>)
+                std::get<I>(params).bind(stmt, ++param, rows, stringBytes);
+        }(),
+        ...);
+}
+
+template <typename T, std::size_t... I>
+void WriteParamsT(InsertParamsT<T>& params, size_t row, const T& in, std::index_sequence<I...>)
+{
+    (
+        [&]
+        {
+            if constexpr (IsInsertFieldT<T, I>)
+                std::get<I>(params).write(row, in.*(FieldMetaT<T, I>::memberPtr));
+        }(),
+        ...);
+}
+
+// "(v1, v2, ...)" for one row of a VALUES list
+template <typename T, std::size_t... I>
+void AppendValuesT(std::string& out, const T& in, std::index_sequence<I...>)
+{
+    bool first = true;
+    out += '(';
+    (
+        [&]
+        {
+            if constexpr (IsInsertFieldT<T, I>)
+            {
+                if (!first)
+                    out += ", ";
+                first = false;
+                using Param = std::tuple_element_t<I, InsertParamsT<T>>;
+                Param::appendLiteral(out, in.*(FieldMetaT<T, I>::memberPtr));
+            }
+        }(),
+        ...);
+    out += ')';
+}
+
+template <typename T> class BulkWriterT
+{
+    static constexpr size_t fieldCount =
+        std::tuple_size_v<std::remove_cvref_t<decltype(meta::MetaTuple<T>::fields)>>;
+    using Indices = std::make_index_sequence<fieldCount>;
+
+  public:
+    explicit BulkWriterT(SQLHANDLE conn, BulkInsertOptions options = {})
+        : conn_(conn), options_(options), stmt_(AllocStatement(conn))
     {
-      public:
-        using value_type = YieldType;
-        using reference = YieldType&;
-        using pointer = YieldType*;
-        using difference_type = std::ptrdiff_t;
-        using iterator_category = std::input_iterator_tag;
+        SQLHANDLE h = stmt_.get();
+        batch_ = std::max<size_t>(options_.batchRows, 1);
+        arrayBinding_ = options_.arrayBinding && setParamsetSize(batch_);
+
+        if (arrayBinding_)
+        {
+            // The driver may lower the batch size (01S02); read back what it took
+            SQLULEN size = 1;
+            CheckOdbc(SQLGetStmtAttr(h, SQL_ATTR_PARAMSET_SIZE, &size, 0, nullptr), SQL_HANDLE_STMT, h,
+                      "SQL_ATTR_PARAMSET_SIZE");
+            arrayBinding_ = size > 1 || batch_ == 1;
+            batch_ = size;
+            paramset_ = size;
+        }
 
-        iterator() : coro_(), done_(true)
+        if (arrayBinding_)
         {
+            status_.assign(batch_, 0);
+            CheckOdbc(SQLSetStmtAttr(h, SQL_ATTR_PARAM_STATUS_PTR, status_.data(), 0), SQL_HANDLE_STMT, h,
+                      "SQL_ATTR_PARAM_STATUS_PTR");
+            CheckOdbc(SQLSetStmtAttr(h, SQL_ATTR_PARAMS_PROCESSED_PTR, &processed_, 0), SQL_HANDLE_STMT, h,
+                      "SQL_ATTR_PARAMS_PROCESSED_PTR");
+            CheckOdbc(Prepare(h, db::DatabaseWriter<T>::generateInsert().c_str()), SQL_HANDLE_STMT, h,
+                      "SQLPrepare");
+            BindParamsT<T>(h, params_, batch_, options_.stringBytes, Indices{});
         }
-        explicit iterator(handle_type h) : coro_(h), done_(!h || h.done())
+        else
         {
+            // one row per parameter set again, whatever the driver half-accepted
+            batch_ = std::max<size_t>(options_.batchRows, 1);
+            setParamsetSize(1);
+            head_ = db::DatabaseWriter<T>::generateInsertHead();
         }
 
-        iterator& operator++()
+        CheckOdbc(SQLSetConnectAttr(conn_, SQL_ATTR_AUTOCOMMIT, reinterpret_cast<SQLPOINTER>(SQL_AUTOCOMMIT_OFF), 0),
+                  SQL_HANDLE_DBC, conn_, "SQL_ATTR_AUTOCOMMIT");
+        open_ = true;
+    }
+
+    // Parameter arrays and the status pointers are bound by address
+    BulkWriterT(const BulkWriterT&) = delete;
+    BulkWriterT& operator=(const BulkWriterT&) = delete;
+
+    ~BulkWriterT()
+    {
+        if (open_)
+            abort();
+    }
+
+    void write(const T& row)
+    {
+        if (!open_)
+            throw std::logic_error("odbc: write to a closed BulkWriterT");
+
+        if (arrayBinding_)
+            WriteParamsT<T>(params_, pending_, row, Indices{});
+        else
         {
-            coro_.resume();
-            if (coro_.promise().exception)
-                std::rethrow_exception(coro_.promise().exception);
-            done_ = coro_.done();
-            return *this;
+            size_t mark = sql_.size();
+            sql_ += pending_ == 0 ? head_ : std::string(", ");
+            try
+            {
+                AppendValuesT<T>(sql_, row, Indices{});
+            }
+            catch (...)
+            {
+                sql_.resize(mark);
+                throw;
+            }
         }
 
-        reference operator*() const
+        if (++pending_ == batch_)
+            flush();
+    }
+
+    // Sends the rows written since the last batch
+    void flush()
+    {
+        if (pending_ == 0)
+            return;
+        try
         {
-            return coro_.promise().current_value;
+            execute();
         }
-        pointer operator->() const
+        catch (...)
         {
-            return &coro_.promise().current_value;
+            abort();
+            throw;
         }
-        bool operator==(std::default_sentinel_t) const
+
+        written_ += pending_;
+        uncommitted_ += pending_;
+        pending_ = 0;
+        if (options_.commitRows != 0 && uncommitted_ >= options_.commitRows)
+            commit();
+    }
+
+    // Flushes, commits and restores autocommit
+    void close()
+    {
+        if (!open_)
+            return;
+        flush();
+        commit();
+        open_ = false;
+        SQLSetConnectAttr(conn_, SQL_ATTR_AUTOCOMMIT, reinterpret_cast<SQLPOINTER>(SQL_AUTOCOMMIT_ON), 0);
+    }
+
+    // Rows sent to the database so far
+    size_t rows() const
+    {
+        return written_;
+    }
+
+    // false when the driver took VALUES lists instead of parameter arrays
+    bool arrayBinding() const
+    {
+        return arrayBinding_;
+    }
+
+  private:
+    bool setParamsetSize(size_t size)
+    {
+        SQLHANDLE h = stmt_.get();
+        return SQL_SUCCEEDED(SQLSetStmtAttr(h, SQL_ATTR_PARAM_BIND_TYPE,
+                                            reinterpret_cast<SQLPOINTER>(SQL_PARAM_BIND_BY_COLUMN), 0)) &&
+               SQL_SUCCEEDED(SQLSetStmtAttr(h, SQL_ATTR_PARAMSET_SIZE,
+                                            reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(size)), 0));
+    }
+
+    void execute()
+    {
+        SQLHANDLE h = stmt_.get();
+        if (!arrayBinding_)
         {
-            return done_;
+            CheckOdbc(ExecDirect(h, sql_.c_str()), SQL_HANDLE_STMT, h, "SQLExecDirect");
+            sql_.clear();
+            return;
         }
-        bool operator!=(std::default_sentinel_t) const
+
+        // only the last batch is short
+        if (paramset_ != pending_)
         {
-            return !done_;
+            CheckOdbc(SQLSetStmtAttr(h, SQL_ATTR_PARAMSET_SIZE, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(pending_)), 0),
+                      SQL_HANDLE_STMT, h, "SQL_ATTR_PARAMSET_SIZE");
+            paramset_ = pending_;
         }
+        std::fill(status_.begin(), status_.end(), SQL_PARAM_UNUSED);
+        processed_ = 0;
+        CheckOdbc(SQLExecute(h), SQL_HANDLE_STMT, h, "SQLExecute");
 
-      private:
-        handle_type coro_;
-        bool done_ = true;
-    };
+        // with SQL_SUCCESS_WITH_INFO some rows of the batch may still have failed
+        for (SQLULEN i = 0; i < processed_ && i < pending_; ++i)
+        {
+            if (status_[i] == SQL_PARAM_ERROR)
+                throw std::runtime_error("odbc: SQLExecute failed for row " + std::to_string(written_ + i));
+        }
+    }
 
-    iterator begin()
+    void commit()
     {
-        if (coro_)
+        if (uncommitted_ == 0)
+            return;
+        try
+        {
+            CheckOdbc(SQLEndTran(SQL_HANDLE_DBC, conn_, SQL_COMMIT), SQL_HANDLE_DBC, conn_, "SQLEndTran");
+        }
+        catch (...)
         {
-            coro_.resume();
-            if (coro_.promise().exception)
-                std::rethrow_exception(coro_.promise().exception);
+            abort();
+            throw;
         }
-        return iterator{coro_};
+        uncommitted_ = 0;
     }
 
-    std::default_sentinel_t end()
+    // Rolls back the open transaction and gives the connection its autocommit back
+    void abort() noexcept
     {
-        return {};
+        open_ = false;
+        pending_ = 0;
+        sql_.clear();
+        SQLEndTran(SQL_HANDLE_DBC, conn_, SQL_ROLLBACK);
+        SQLSetConnectAttr(conn_, SQL_ATTR_AUTOCOMMIT, reinterpret_cast<SQLPOINTER>(SQL_AUTOCOMMIT_ON), 0);
     }
 
-  private:
-    handle_type coro_;
+    SQLHANDLE conn_;
+    BulkInsertOptions options_;
+    StatementPtr stmt_;
+    bool open_ = false;
+    bool arrayBinding_ = false;
+    size_t batch_ = 1;        // rows per execute
+    size_t paramset_ = 1;     // SQL_ATTR_PARAMSET_SIZE as last set
+    size_t pending_ = 0;      // rows waiting for the next execute
+    size_t written_ = 0;
+    size_t uncommitted_ = 0;
+    InsertParamsT<T> params_; // array binding
+    std::vector<SQLUSMALLINT> status_;
+    SQLULEN processed_ = 0;
+    std::string head_; // VALUES lists: "INSERT INTO t (...) VALUES "
+    std::string sql_;
 };
 
-//-------------------- FETCH ROWS GENERATOR --------------------
-template <typename T> Generator<std::unique_ptr<T>> FetchRowsGeneratorT(SQLHANDLE conn)
+// Inserts every row of rows (records or pointers to them) with a BulkWriterT
+// and commits; returns the number of rows inserted
+template <typename T, typename Range> size_t InsertRowsT(SQLHANDLE conn, Range&& rows, BulkInsertOptions options = {})
 {
-    SQLHANDLE stmt;
-    SQLAllocHandle(SQL_HANDLE_STMT, conn, &stmt);
-    SQLExecDirectA(stmt, reinterpret_cast<SQLCHAR*>(const_cast<char*>(T::query)), SQL_NTS);
-
-    using Raw = typename WrapperType<T>::Raw;
-
-    while (SQLFetch(stmt) == SQL_SUCCESS)
+    BulkWriterT<T> writer(conn, options);
+    for (auto&& row : rows)
     {
-        Raw raw = ReadObjT<Raw>(stmt);                 // fetch raw data
-        co_yield WrapperType<T>::wrap(std::move(raw)); // wrap mutable/immutable
+        if constexpr (requires { writer.write(row); })
+            writer.write(row);
+        else
+            writer.write(*row);
     }
-
-    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    writer.close();
+    return writer.rows();
 }
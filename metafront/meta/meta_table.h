@@ -0,0 +1,749 @@
+/*
+ * ================================================================
+ * IN-MEMORY INDEXED TABLE
+ *
+ * meta::table<T> holds reflected records in one contiguous std::vector,
+ * keyed by the MetaTuple<T>::fields entry flagged Prop::PrimaryKey (found
+ * at compile time; exactly one is required). An open-addressing hash index
+ * maps each key to its row. Every other field flagged Prop::Hashable gets
+ * a secondary index with the rows of each value chained together.
+ *
+ * Index slots hold the key's hash and the row number, plus the key itself
+ * when it is trivially copyable and at most 8 bytes (integers, enums,
+ * time_point): a lookup for such a key reads one slot cache line and
+ * compares in place; the row is touched only when the caller reads it.
+ * Other keys (strings) compare against the row once the hash matches.
+ * Indexes stay under half full, with linear probing. Keys are hashed and
+ * compared with meta::hash / meta::equal, so reflected structs work as keys.
+ *
+ * Rows stay contiguous: erase() moves the last row into the gap, so
+ * pointers and iterators to rows are invalidated by insert and erase, as
+ * with std::vector. Rows are read-only through the table; modify() applies
+ * a change and re-indexes the row.
+ *
+ * Usage:
+ *   meta::table<Account> accounts(FetchRowsGeneratorT<Account>(conn));
+ *   if (const Account* a = accounts.find(42))
+ *       ...
+ *   for (const Account& a : accounts.find_all<&Account::city>("Oslo"))
+ *       ...
+ *   accounts.modify(42, [](Account& a) { a.balance += 10; });
+ *   accounts.erase(42);
+ * ================================================================
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "meta_hash.h"
+
+namespace meta
+{
+
+namespace detail
+{
+
+template <typename T>
+using table_fields = std::remove_cvref_t<decltype(MetaTuple<T>::fields)>;
+
+template <typename T> inline constexpr size_t table_field_count = std::tuple_size_v<table_fields<T>>;
+
+template <typename T, size_t I>
+using table_field = std::remove_cvref_t<std::tuple_element_t<I, table_fields<T>>>;
+
+template <typename T, size_t I>
+inline constexpr bool table_has_member = table_field<T, I>::memberPtr != nullptr;
+
+template <typename T, size_t I>
+inline constexpr bool is_primary_key = table_has_member<T, I> && (table_field<T, I>::properties & Prop::PrimaryKey);
+
+template <typename T, size_t I>
+inline constexpr bool is_secondary_key = table_has_member<T, I> && (table_field<T, I>::properties & Prop::Hashable) &&
+                                         !(table_field<T, I>::properties & Prop::PrimaryKey);
+
+template <typename T> constexpr size_t primary_key_index()
+{
+    constexpr auto found = []<size_t... I>(std::index_sequence<I...>)
+    {
+        size_t count = 0, index = 0;
+        ((is_primary_key<T, I> ? (void)(++count, index = I) : (void)0), ...);
+        return std::pair{count, index};
+    }(std::make_index_sequence<table_field_count<T>>{});
+    static_assert(found.first == 1, "meta::table<T> needs exactly one Prop::PrimaryKey field in MetaTuple<T>::fields");
+    return found.second;
+}
+
+// Field indexes of the secondary keys, in field order
+template <typename T> constexpr auto secondary_key_indexes()
+{
+    constexpr size_t count = []<size_t... I>(std::index_sequence<I...>)
+    {
+        return (size_t{0} + ... + (is_secondary_key<T, I> ? 1 : 0));
+    }(std::make_index_sequence<table_field_count<T>>{});
+
+    std::array<size_t, count> indexes{};
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        size_t next = 0;
+        ((is_secondary_key<T, I> ? (void)(indexes[next++] = I) : (void)0), ...);
+    }(std::make_index_sequence<table_field_count<T>>{});
+    return indexes;
+}
+
+// Index of the field whose member pointer is MemberPtr
+template <typename T, auto MemberPtr> constexpr size_t table_index()
+{
+    constexpr size_t index = []<size_t... I>(std::index_sequence<I...>)
+    {
+        size_t found = sizeof...(I);
+        (
+            [&]
+            {
+                constexpr auto candidate = table_field<T, I>::memberPtr;
+                if constexpr (std::is_same_v<std::remove_const_t<decltype(candidate)>, decltype(MemberPtr)>)
+                {
+                    if (found == sizeof...(I) && candidate == MemberPtr)
+                        found = I;
+                }
+            }(),
+            ...);
+        return found;
+    }(std::make_index_sequence<table_field_count<T>>{});
+    static_assert(index < table_field_count<T>, "meta::table: member is not in MetaTuple<T>::fields");
+    return index;
+}
+
+// 32-bit hash of a key through meta::hash_value (a std::string and a
+// string_view of it hash the same, so lookups need not build a std::string)
+template <typename K> uint32_t table_hash(const K& key)
+{
+    uint64_t h = hash_value(key);
+    return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+// The lookup argument as Key: strings stay string_views, other types convert
+template <typename Key, typename K> decltype(auto) as_key(const K& key)
+{
+    if constexpr (std::is_same_v<K, Key>)
+        return (key);
+    else if constexpr (std::is_convertible_v<const K&, std::string_view> &&
+                       std::is_convertible_v<const Key&, std::string_view>)
+        return std::string_view(key);
+    else
+        return static_cast<Key>(key);
+}
+
+inline constexpr uint32_t no_row = UINT32_MAX;
+
+// Open-addressing map from a key to one row number. Slots are looked up by
+// hash; key_of(row) gives a row's key to compare with when the slot does
+// not hold the key itself.
+template <typename Key> class key_index
+{
+  public:
+    static constexpr bool inline_key = std::is_trivially_copyable_v<Key> && sizeof(Key) <= 8;
+
+    template <typename K, typename KeyOf> uint32_t find(const K& key, uint32_t hash, const KeyOf& key_of) const
+    {
+        if (slots_.empty())
+            return no_row;
+        for (size_t pos = hash & mask_;; pos = (pos + 1) & mask_)
+        {
+            const slot& s = slots_[pos];
+            if (s.row == no_row)
+                return no_row;
+            if (s.hash == hash && matches(s, key, key_of))
+                return s.row;
+        }
+    }
+
+    // Adds key -> row; the key must not be present
+    void insert(const Key& key, uint32_t hash, uint32_t row)
+    {
+        if ((size_ + 1) * 2 > slots_.size())
+            rehash(slots_.empty() ? 16 : slots_.size() * 2);
+        place(make_slot(key, hash, row));
+        ++size_;
+    }
+
+    // Points the slot holding old_row (for a key with this hash) at new_row
+    void replace(uint32_t hash, uint32_t old_row, uint32_t new_row)
+    {
+        slots_[locate(hash, old_row)].row = new_row;
+    }
+
+    // Removes the slot holding row, shifting later slots of the probe run back
+    void erase(uint32_t hash, uint32_t row)
+    {
+        size_t hole = locate(hash, row);
+        for (size_t pos = (hole + 1) & mask_; slots_[pos].row != no_row; pos = (pos + 1) & mask_)
+        {
+            size_t home = slots_[pos].hash & mask_;
+            // move back unless the slot's home lies in (hole, pos]
+            if (((pos - home) & mask_) >= ((pos - hole) & mask_))
+            {
+                slots_[hole] = slots_[pos];
+                hole = pos;
+            }
+        }
+        slots_[hole].row = no_row;
+        --size_;
+    }
+
+    // Room for count keys without rehashing
+    void reserve(size_t count)
+    {
+        size_t capacity = 16;
+        while (capacity < count * 2)
+            capacity *= 2;
+        if (capacity > slots_.size())
+            rehash(capacity);
+    }
+
+    void clear()
+    {
+        slots_.clear();
+        mask_ = 0;
+        size_ = 0;
+    }
+
+  private:
+    struct hashed_slot
+    {
+        uint32_t hash;
+        uint32_t row = no_row;
+    };
+    struct keyed_slot
+    {
+        Key key;
+        uint32_t hash;
+        uint32_t row = no_row;
+    };
+    using slot = std::conditional_t<inline_key, keyed_slot, hashed_slot>;
+
+    static slot make_slot(const Key& key, uint32_t hash, uint32_t row)
+    {
+        if constexpr (inline_key)
+            return slot{key, hash, row};
+        else
+            return slot{hash, row};
+    }
+
+    template <typename K, typename KeyOf> static bool matches(const slot& s, const K& key, const KeyOf& key_of)
+    {
+        if constexpr (inline_key)
+            return equal_value(s.key, key);
+        else if constexpr (std::is_same_v<K, Key>)
+            return equal_value(key_of(s.row), key);
+        else
+            return key_of(s.row) == key;
+    }
+
+    size_t locate(uint32_t hash, uint32_t row) const
+    {
+        size_t pos = hash & mask_;
+        while (slots_[pos].row != row)
+            pos = (pos + 1) & mask_;
+        return pos;
+    }
+
+    void place(const slot& s)
+    {
+        size_t pos = s.hash & mask_;
+        while (slots_[pos].row != no_row)
+            pos = (pos + 1) & mask_;
+        slots_[pos] = s;
+    }
+
+    void rehash(size_t capacity)
+    {
+        std::vector<slot> old(capacity);
+        old.swap(slots_);
+        mask_ = capacity - 1;
+        for (const slot& s : old)
+            if (s.row != no_row)
+                place(s);
+    }
+
+    std::vector<slot> slots_;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+};
+
+} // namespace detail
+
+template <typename T> class table
+{
+    static constexpr size_t key_field = detail::primary_key_index<T>();
+    static constexpr auto key_member = detail::table_field<T, key_field>::memberPtr;
+    static constexpr auto secondary_fields = detail::secondary_key_indexes<T>();
+
+    template <size_t I> using field_type = typename detail::table_field<T, I>::type;
+    template <size_t I> static constexpr auto member_ptr = detail::table_field<T, I>::memberPtr;
+
+    // Key -> first row with that key; the other rows are chained through
+    // next/prev in no particular order
+    template <size_t I> struct secondary_index
+    {
+        detail::key_index<field_type<I>> heads;
+        std::vector<uint32_t> next;
+        std::vector<uint32_t> prev;
+    };
+
+    template <size_t... J>
+    static auto make_secondaries(std::index_sequence<J...>) -> std::tuple<secondary_index<secondary_fields[J]>...>;
+    using secondaries = decltype(make_secondaries(std::make_index_sequence<secondary_fields.size()>{}));
+
+  public:
+    using value_type = T;
+    using key_type = field_type<key_field>;
+    using size_type = size_t;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    // Rows of one secondary-key value
+    template <size_t I> class match_range
+    {
+      public:
+        class iterator
+        {
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            iterator() = default;
+            iterator(const table* owner, uint32_t row) : owner_(owner), row_(row)
+            {
+            }
+
+            const T& operator*() const
+            {
+                return owner_->rows_[row_];
+            }
+            const T* operator->() const
+            {
+                return &owner_->rows_[row_];
+            }
+            iterator& operator++()
+            {
+                row_ = std::get<secondary_slot<I>()>(owner_->secondaries_).next[row_];
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                iterator before = *this;
+                ++*this;
+                return before;
+            }
+            bool operator==(const iterator& other) const
+            {
+                return row_ == other.row_;
+            }
+
+          private:
+            const table* owner_ = nullptr;
+            uint32_t row_ = detail::no_row;
+        };
+
+        match_range(const table* owner, uint32_t head) : owner_(owner), head_(head)
+        {
+        }
+
+        iterator begin() const
+        {
+            return {owner_, head_};
+        }
+        iterator end() const
+        {
+            return {owner_, detail::no_row};
+        }
+        bool empty() const
+        {
+            return head_ == detail::no_row;
+        }
+
+      private:
+        const table* owner_;
+        uint32_t head_;
+    };
+
+    table() = default;
+
+    template <typename Range>
+        requires std::ranges::range<Range> && (!std::is_same_v<std::remove_cvref_t<Range>, table>)
+    explicit table(Range&& rows)
+    {
+        load(std::forward<Range>(rows));
+    }
+
+    table(const table&) = default;
+    table(table&&) noexcept = default;
+    table& operator=(const table&) = default;
+    table& operator=(table&&) noexcept = default;
+
+    // ----------------------------------------------------------------
+    // Capacity and rows
+    // ----------------------------------------------------------------
+
+    size_t size() const
+    {
+        return rows_.size();
+    }
+    bool empty() const
+    {
+        return rows_.empty();
+    }
+
+    void reserve(size_t count)
+    {
+        rows_.reserve(count);
+        primary_.reserve(count);
+        for_each_secondary(
+            [&](auto& index)
+            {
+                index.next.reserve(count);
+                index.prev.reserve(count);
+            });
+    }
+
+    void clear()
+    {
+        rows_.clear();
+        primary_.clear();
+        for_each_secondary(
+            [](auto& index)
+            {
+                index.heads.clear();
+                index.next.clear();
+                index.prev.clear();
+            });
+    }
+
+    // The rows, contiguous, in insertion order until the first erase
+    std::span<const T> rows() const
+    {
+        return rows_;
+    }
+    const_iterator begin() const
+    {
+        return rows_.begin();
+    }
+    const_iterator end() const
+    {
+        return rows_.end();
+    }
+
+    // ----------------------------------------------------------------
+    // Lookup
+    // ----------------------------------------------------------------
+
+    // The row with this primary key, or nullptr
+    template <typename K = key_type> const T* find(const K& key) const
+    {
+        uint32_t row = find_row(key);
+        return row == detail::no_row ? nullptr : &rows_[row];
+    }
+
+    template <typename K = key_type> bool contains(const K& key) const
+    {
+        return find_row(key) != detail::no_row;
+    }
+
+    template <typename K = key_type> const T& at(const K& key) const
+    {
+        uint32_t row = find_row(key);
+        if (row == detail::no_row)
+            throw std::out_of_range("meta::table: key not found");
+        return rows_[row];
+    }
+
+    // The rows whose Prop::Hashable field Member equals value
+    template <auto Member, typename K = field_type<detail::table_index<T, Member>()>>
+    auto find_all(const K& value) const
+    {
+        constexpr size_t I = detail::table_index<T, Member>();
+        static_assert(detail::is_secondary_key<T, I>, "meta::table: find_all needs a Prop::Hashable field");
+        const auto& index = std::get<secondary_slot<I>()>(secondaries_);
+        decltype(auto) key = detail::as_key<field_type<I>>(value);
+        uint32_t head = index.heads.find(key, detail::table_hash(key),
+                                         [this](uint32_t row) -> const auto& { return rows_[row].*member_ptr<I>; });
+        return match_range<I>(this, head);
+    }
+
+    template <auto Member, typename K = field_type<detail::table_index<T, Member>()>>
+    size_t count(const K& value) const
+    {
+        auto matches = find_all<Member>(value);
+        return static_cast<size_t>(std::distance(matches.begin(), matches.end()));
+    }
+
+    // ----------------------------------------------------------------
+    // Changes
+    // ----------------------------------------------------------------
+
+    // Adds row unless its key is present; returns the row with that key and
+    // whether it was added
+    std::pair<const T*, bool> insert(T row)
+    {
+        const key_type& key = row.*key_member;
+        uint32_t hash = detail::table_hash(key);
+        uint32_t found = find_row(key, hash);
+        if (found != detail::no_row)
+            return {&rows_[found], false};
+        return {&rows_[append(std::move(row), hash)], true};
+    }
+
+    // Adds row, or replaces the row with the same key
+    std::pair<const T*, bool> insert_or_assign(T row)
+    {
+        const key_type& key = row.*key_member;
+        uint32_t hash = detail::table_hash(key);
+        uint32_t found = find_row(key, hash);
+        if (found == detail::no_row)
+            return {&rows_[append(std::move(row), hash)], true};
+
+        unlink_secondaries(found);
+        rows_[found] = std::move(row);
+        link_secondaries(found);
+        return {&rows_[found], false};
+    }
+
+    // Adds every row of a range or generator (rows may be pointers, as
+    // FetchRowsGeneratorT yields); a later row replaces an earlier one with
+    // the same key. Returns the number of rows read.
+    template <typename Range> size_t load(Range&& rows)
+    {
+        if constexpr (std::ranges::sized_range<Range>)
+            reserve(size() + std::ranges::size(rows));
+
+        size_t count = 0;
+        for (auto&& row : rows)
+        {
+            using Row = std::remove_cvref_t<decltype(row)>;
+            if constexpr (std::is_convertible_v<Row, T>)
+            {
+                if constexpr (std::is_lvalue_reference_v<Range>)
+                    insert_or_assign(row);
+                else
+                    insert_or_assign(std::move(row));
+            }
+            else if constexpr (std::is_same_v<Row, std::unique_ptr<T>>)
+                insert_or_assign(std::move(*row));
+            else
+                insert_or_assign(*row);
+            ++count;
+        }
+        return count;
+    }
+
+    // Removes the row with this key; the last row moves into its place
+    template <typename K = key_type> bool erase(const K& value)
+    {
+        decltype(auto) key = detail::as_key<key_type>(value);
+        uint32_t hash = detail::table_hash(key);
+        uint32_t row = find_row(key, hash);
+        if (row == detail::no_row)
+            return false;
+
+        unlink_secondaries(row);
+        primary_.erase(hash, row);
+
+        uint32_t last = static_cast<uint32_t>(rows_.size() - 1);
+        if (row != last)
+        {
+            rows_[row] = std::move(rows_[last]);
+            primary_.replace(detail::table_hash(rows_[row].*key_member), last, row);
+            renumber_secondaries(last, row);
+        }
+        rows_.pop_back();
+        for_each_secondary(
+            [](auto& index)
+            {
+                index.next.pop_back();
+                index.prev.pop_back();
+            });
+        return true;
+    }
+
+    // Applies fn(T&) to the row with this key and re-indexes it. When fn
+    // throws, or changes the primary key to one another row has, the old
+    // key is put back (other changes stay) and the exception propagates;
+    // a key clash throws std::invalid_argument.
+    template <typename Fn, typename K = key_type> bool modify(const K& value, Fn&& fn)
+    {
+        decltype(auto) key = detail::as_key<key_type>(value);
+        uint32_t hash = detail::table_hash(key);
+        uint32_t row = find_row(key, hash);
+        if (row == detail::no_row)
+            return false;
+
+        T& target = rows_[row];
+        key_type old_key = target.*key_member;
+        unlink_secondaries(row);
+        try
+        {
+            std::forward<Fn>(fn)(target);
+        }
+        catch (...)
+        {
+            target.*key_member = old_key;
+            link_secondaries(row);
+            throw;
+        }
+
+        if (!detail::equal_value(target.*key_member, old_key))
+        {
+            uint32_t new_hash = detail::table_hash(target.*key_member);
+            if (find_row(target.*key_member, new_hash) != detail::no_row)
+            {
+                target.*key_member = std::move(old_key);
+                link_secondaries(row);
+                throw std::invalid_argument("meta::table: modify() changed the key to one already present");
+            }
+            primary_.erase(hash, row);
+            primary_.insert(target.*key_member, new_hash, row);
+        }
+        link_secondaries(row);
+        return true;
+    }
+
+  private:
+    template <size_t I> static constexpr size_t secondary_slot()
+    {
+        for (size_t j = 0; j < secondary_fields.size(); ++j)
+            if (secondary_fields[j] == I)
+                return j;
+        return secondary_fields.size();
+    }
+
+    template <typename Fn> void for_each_secondary(Fn&& fn)
+    {
+        std::apply([&](auto&... index) { (fn(index), ...); }, secondaries_);
+    }
+
+    template <typename K> uint32_t find_row(const K& value) const
+    {
+        decltype(auto) key = detail::as_key<key_type>(value);
+        return find_row(key, detail::table_hash(key));
+    }
+
+    template <typename K> uint32_t find_row(const K& key, uint32_t hash) const
+    {
+        return primary_.find(key, hash, [this](uint32_t row) -> const key_type& { return rows_[row].*key_member; });
+    }
+
+    uint32_t append(T&& row, uint32_t hash)
+    {
+        if (rows_.size() >= detail::no_row)
+            throw std::length_error("meta::table: too many rows");
+        uint32_t index = static_cast<uint32_t>(rows_.size());
+        rows_.push_back(std::move(row));
+        primary_.insert(rows_[index].*key_member, hash, index);
+        for_each_secondary(
+            [](auto& secondary)
+            {
+                secondary.next.push_back(detail::no_row);
+                secondary.prev.push_back(detail::no_row);
+            });
+        link_secondaries(index);
+        return index;
+    }
+
+    // Puts row at the head of its chain in every secondary index
+    void link_secondaries(uint32_t row)
+    {
+        [&]<size_t... J>(std::index_sequence<J...>)
+        {
+            (link<secondary_fields[J]>(row), ...);
+        }(std::make_index_sequence<secondary_fields.size()>{});
+    }
+
+    template <size_t I> void link(uint32_t row)
+    {
+        auto& index = std::get<secondary_slot<I>()>(secondaries_);
+        const auto& value = rows_[row].*member_ptr<I>;
+        uint32_t hash = detail::table_hash(value);
+        uint32_t head = index.heads.find(value, hash, [this](uint32_t r) -> const auto& { return rows_[r].*member_ptr<I>; });
+
+        index.prev[row] = detail::no_row;
+        index.next[row] = head;
+        if (head == detail::no_row)
+            index.heads.insert(value, hash, row);
+        else
+        {
+            index.prev[head] = row;
+            index.heads.replace(hash, head, row);
+        }
+    }
+
+    void unlink_secondaries(uint32_t row)
+    {
+        [&]<size_t... J>(std::index_sequence<J...>)
+        {
+            (unlink<secondary_fields[J]>(row), ...);
+        }(std::make_index_sequence<secondary_fields.size()>{});
+    }
+
+    template <size_t I> void unlink(uint32_t row)
+    {
+        auto& index = std::get<secondary_slot<I>()>(secondaries_);
+        uint32_t next = index.next[row];
+        uint32_t prev = index.prev[row];
+        if (prev != detail::no_row)
+            index.next[prev] = next;
+        else
+        {
+            uint32_t hash = detail::table_hash(rows_[row].*member_ptr<I>);
+            if (next == detail::no_row)
+                index.heads.erase(hash, row);
+            else
+                index.heads.replace(hash, row, next);
+        }
+        if (next != detail::no_row)
+            index.prev[next] = prev;
+    }
+
+    // Row from moved to row to (rows_[to] already holds it)
+    void renumber_secondaries(uint32_t from, uint32_t to)
+    {
+        [&]<size_t... J>(std::index_sequence<J...>)
+        {
+            (renumber<secondary_fields[J]>(from, to), ...);
+        }(std::make_index_sequence<secondary_fields.size()>{});
+    }
+
+    template <size_t I> void renumber(uint32_t from, uint32_t to)
+    {
+        auto& index = std::get<secondary_slot<I>()>(secondaries_);
+        uint32_t next = index.next[from];
+        uint32_t prev = index.prev[from];
+        if (prev != detail::no_row)
+            index.next[prev] = to;
+        else
+            index.heads.replace(detail::table_hash(rows_[to].*member_ptr<I>), from, to);
+        if (next != detail::no_row)
+            index.prev[next] = to;
+        index.next[to] = next;
+        index.prev[to] = prev;
+    }
+
+    std::vector<T> rows_;
+    detail::key_index<key_type> primary_;
+    secondaries secondaries_;
+};
+
+} // namespace meta
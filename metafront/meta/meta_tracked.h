@@ -0,0 +1,215 @@
+/*
+ * ================================================================
+ * DIRTY-FIELD TRACKING
+ *
+ * meta::tracked<T> wraps a reflected record and keeps a bit per
+ * MetaTuple<T>::fields entry (the same mask type as meta::patch<T>). The
+ * record is read-only through the wrapper; writes go through set<&T::m>()
+ * or modify<&T::m>(), which set the field's bit. set() calls the field's
+ * setter (Field's SetterPtr) when it has one, else assigns the member.
+ *
+ * The bits drive the partial writers:
+ *   changes()       a meta::patch<T> of the dirty fields with their current
+ *                   values, for meta::json::serialize_patch and
+ *                   meta::binary::serialize_patch (meta_diff.h)
+ *   dirty()         the mask, for db::updateSQL(obj, mask): an UPDATE that
+ *                   sets only those columns, keyed by the Prop::PrimaryKey
+ *                   field (meta_db.h; throws when T has none)
+ * A written field counts as dirty even if the new value equals the old;
+ * use meta::diff when the old record is at hand and only real changes
+ * should go out.
+ *
+ * Usage:
+ *   meta::tracked<Account> account(loadAccount(42));
+ *   account.set<&Account::balance>(account->balance + 10);
+ *   if (account.is_dirty())
+ *   {
+ *       exec(db::updateSQL(account.value(), account.dirty()));
+ *       account.mark_clean();
+ *   }
+ * ================================================================
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "meta_diff.h"
+
+namespace meta
+{
+
+namespace detail
+{
+
+// Sets delta to what writes value over anything: every field of a struct,
+// every element of a vector
+template <typename V> void whole_delta(const V& value, delta_t<V>& delta)
+{
+    if constexpr (diff_reflected<V>)
+    {
+        using mask_type = typename patch<V>::mask_type;
+        delta.mask = 0;
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (
+                [&]
+                {
+                    if constexpr (diff_has_member<V, I>)
+                    {
+                        whole_delta(value.*diff_field<V, I>::memberPtr, std::get<I>(delta.values));
+                        delta.mask |= static_cast<mask_type>(uint64_t{1} << I);
+                    }
+                }(),
+                ...);
+        }(std::make_index_sequence<diff_field_count<V>>{});
+    }
+    else if constexpr (is_diff_vector<V>::value)
+    {
+        using E = typename V::value_type;
+        delta.size = value.size();
+        delta.changes.clear();
+        delta.changes.reserve(value.size());
+        for (size_t i = 0; i < value.size(); ++i)
+        {
+            delta.changes.emplace_back(static_cast<uint32_t>(i), delta_t<E>{});
+            whole_delta<E>(value[i], delta.changes.back().second);
+        }
+    }
+    else
+        delta = value;
+}
+
+} // namespace detail
+
+template <typename T> class tracked
+{
+  public:
+    using mask_type = typename patch<T>::mask_type;
+
+    tracked() = default;
+
+    // Starts clean
+    explicit tracked(T value) : value_(std::move(value))
+    {
+    }
+
+    const T& value() const
+    {
+        return value_;
+    }
+    const T& operator*() const
+    {
+        return value_;
+    }
+    const T* operator->() const
+    {
+        return &value_;
+    }
+
+    template <auto Member> const auto& get() const
+    {
+        return value_.*Member;
+    }
+
+    // Writes the field and marks it dirty
+    template <auto Member, typename V> void set(V&& v)
+    {
+        constexpr size_t index = detail::diff_index<T, Member>();
+        using FieldMeta = detail::diff_field<T, index>;
+        // a plain if: GCC rejects a member function pointer compared with
+        // nullptr in if constexpr, and folds this one anyway
+        if constexpr (requires { FieldMeta::setterPtr; })
+        {
+            if (FieldMeta::setterPtr != nullptr)
+                (value_.*FieldMeta::setterPtr)(std::forward<V>(v));
+            else
+                value_.*Member = std::forward<V>(v);
+        }
+        else
+            value_.*Member = std::forward<V>(v);
+        mark_dirty<Member>();
+    }
+
+    // Calls fn with the field to change in place and marks it dirty
+    template <auto Member, typename Fn> decltype(auto) modify(Fn&& fn)
+    {
+        mark_dirty<Member>();
+        return std::forward<Fn>(fn)(value_.*Member);
+    }
+
+    mask_type dirty() const
+    {
+        return dirty_;
+    }
+
+    bool is_dirty() const
+    {
+        return dirty_ != 0;
+    }
+
+    template <auto Member> bool is_dirty() const
+    {
+        return (dirty_ >> detail::diff_index<T, Member>()) & 1;
+    }
+
+    template <auto Member> void mark_dirty()
+    {
+        dirty_ |= static_cast<mask_type>(uint64_t{1} << detail::diff_index<T, Member>());
+    }
+
+    // Every field backed by a member, e.g. for a record to be written whole
+    void mark_all_dirty()
+    {
+        dirty_ = all_fields;
+    }
+
+    // After the changes were written out
+    void mark_clean()
+    {
+        dirty_ = 0;
+    }
+
+    // The dirty fields with their current values
+    patch<T> changes() const
+    {
+        patch<T> delta;
+        delta.mask = dirty_;
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (
+                [&]
+                {
+                    if constexpr (detail::diff_has_member<T, I>)
+                    {
+                        if (delta.changed(I))
+                            detail::whole_delta(value_.*detail::diff_field<T, I>::memberPtr,
+                                                std::get<I>(delta.values));
+                    }
+                }(),
+                ...);
+        }(std::make_index_sequence<detail::diff_field_count<T>>{});
+        return delta;
+    }
+
+    // Gives up the record; the wrapper is left empty and clean
+    T release()
+    {
+        dirty_ = 0;
+        return std::exchange(value_, T{});
+    }
+
+  private:
+    static constexpr mask_type all_fields = []<size_t... I>(std::index_sequence<I...>)
+    {
+        return static_cast<mask_type>((uint64_t{0} | ... | (detail::diff_has_member<T, I> ? uint64_t{1} << I : 0)));
+    }(std::make_index_sequence<detail::diff_field_count<T>>{});
+
+    T value_{};
+    mask_type dirty_ = 0;
+};
+
+} // namespace meta
@@ -12,20 +12,35 @@
  * - Mixed complex types and combinations
  *
  * Usage: meta::xml::serialize(your_vector_of_objects)
+ *        meta::xml::reader<T>(xml).next(record) to read it back
  * ================================================================
  */
 
 #pragma once
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <map>
 #include <optional>
+#include <ranges>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
+#include "meta_escape.h"
+#include "meta_field_index.h"
+#include "meta_generator.h"
+#include "meta_parallel.h"
+#include "meta_sink.h"
+
 namespace meta
 {
 namespace xml
@@ -34,59 +49,55 @@ namespace xml
 // Helper function to escape XML strings
 std::string escape_xml_string(const std::string& str)
 {
+    static constexpr meta::escape::CharSet specials("<>&\"'", true);
+
     std::string escaped;
     escaped.reserve(str.length());
 
-    for (char c : str)
-    {
-        switch (c)
-        {
-        case '<':
-            escaped += "&lt;";
-            break;
-        case '>':
-            escaped += "&gt;";
-            break;
-        case '&':
-            escaped += "&amp;";
-            break;
-        case '"':
-            escaped += "&quot;";
-            break;
-        case '\'':
-            escaped += "&apos;";
-            break;
-        case '\n':
-            escaped += "&#10;";
-            break;
-        case '\r':
-            escaped += "&#13;";
-            break;
-        case '\t':
-            escaped += "&#9;";
-            break;
-        default:
-            if (static_cast<unsigned char>(c) < 32)
-            {
-                // Control characters
-                escaped += "&#" + std::to_string(static_cast<int>(c)) + ";";
-            }
-            else
-            {
-                escaped += c;
-            }
-            break;
-        }
-    }
+    meta::escape::append_escaped(escaped,
+                                 str,
+                                 specials,
+                                 [](std::string& out, char c)
+                                 {
+                                     switch (c)
+                                     {
+                                     case '<':
+                                         out += "&lt;";
+                                         break;
+                                     case '>':
+                                         out += "&gt;";
+                                         break;
+                                     case '&':
+                                         out += "&amp;";
+                                         break;
+                                     case '"':
+                                         out += "&quot;";
+                                         break;
+                                     case '\'':
+                                         out += "&apos;";
+                                         break;
+                                     default:
+                                         // control characters (\n, \r, \t, ...)
+                                         out += "&#" + std::to_string(static_cast<int>(c)) + ";";
+                                         break;
+                                     }
+                                 });
     return escaped;
 }
 
 // Forward declaration for recursive calls
 template <typename T>
 std::string format_xml_value(const T& value,
-                             const std::string& tag_name = "item",
+                             std::string_view tag_name = "item",
                              int indent_level = 0);
 
+template <typename T> struct is_std_array : std::false_type
+{
+};
+template <typename T, std::size_t N> struct is_std_array<std::array<T, N>> : std::true_type
+{
+};
+
 // Helper to create indentation
 std::string get_indent(int level)
 {
@@ -97,7 +108,7 @@ std::string get_indent(int level)
 template <typename Tuple, std::size_t... Is>
 std::string format_tuple_xml(const Tuple& t,
                              std::index_sequence<Is...>,
-                             const std::string& tag_name = "tuple",
+                             std::string_view tag_name = "tuple",
                              int indent_level = 0)
 {
     std::stringstream ss;
@@ -112,17 +123,17 @@ std::string format_tuple_xml(const Tuple& t,
     return ss.str();
 }
 
-// Helper to format vector as XML array
-template <typename T>
-std::string format_vector_xml(const std::vector<T>& vec,
-                              const std::string& tag_name = "array",
+// Helper to format vector (or std::array) as XML array
+template <typename Sequence>
+std::string format_vector_xml(const Sequence& vec,
+                              std::string_view tag_name = "array",
                               int indent_level = 0)
 {
     std::string ind = get_indent(indent_level);
 
     if (vec.empty())
     {
-        return ind + "<" + tag_name + " />";
+        return ind + "<" + std::string(tag_name) + " />";
     }
 
     std::stringstream ss;
@@ -140,14 +151,14 @@ std::string format_vector_xml(const std::vector<T>& vec,
 // Helper to format map as XML object
 template <typename K, typename V>
 std::string format_map_xml(const std::map<K, V>& map,
-                           const std::string& tag_name = "map",
+                           std::string_view tag_name = "map",
                            int indent_level = 0)
 {
     std::string ind = get_indent(indent_level);
 
     if (map.empty())
     {
-        return ind + "<" + tag_name + " />";
+        return ind + "<" + std::string(tag_name) + " />";
     }
 
     std::stringstream ss;
@@ -187,7 +198,7 @@ std::string format_map_xml(const std::map<K, V>& map,
 // Helper to format optional
 template <typename T>
 std::string format_optional_xml(const std::optional<T>& opt,
-                                const std::string& tag_name = "optional",
+                                std::string_view tag_name = "optional",
                                 int indent_level = 0)
 {
     std::string ind = get_indent(indent_level);
@@ -198,13 +209,13 @@ std::string format_optional_xml(const std::optional<T>& opt,
     }
     else
     {
-        return ind + "<" + tag_name + " null=\"true\" />";
+        return ind + "<" + std::string(tag_name) + " null=\"true\" />";
     }
 }
 
 // Main format function - handles all types
 template <typename T>
-std::string format_xml_value(const T& value, const std::string& tag_name, int indent_level)
+std::string format_xml_value(const T& value, std::string_view tag_name, int indent_level)
 {
     std::string ind = get_indent(indent_level);
     std::stringstream ss;
@@ -441,6 +452,10 @@ std::string format_xml_value(const T& value, const std::string& tag_name, int in
                                 tag_name,
                                 indent_level);
     }
+    else if constexpr (is_std_array<T>::value)
+    {
+        return format_vector_xml(value, tag_name, indent_level);
+    }
 
     // Fallback for unknown types
     else
@@ -452,42 +467,116 @@ std::string format_xml_value(const T& value, const std::string& tag_name, int in
     return ss.str();
 }
 
+// One <object> element of serialize(), index being its position in the collection
+template <typename ObjectType>
+void append_record(std::string& out, const ObjectType& obj, size_t index)
+{
+    out += "  <object index=\"";
+    out += std::to_string(index);
+    out += "\">\n";
+
+    std::apply(
+        [&](auto&&... fieldMeta) -> void
+        {
+            ((out += format_xml_value(obj.*(fieldMeta.memberPtr), fieldMeta.memberName, 2),
+              out += '\n'),
+             ...);
+        },
+        meta::MetaTuple<ObjectType>::fields);
+
+    out += "  </object>\n";
+}
+
+// One <object> element of serialize_compact(): arithmetic and string fields
+// become attributes, everything else child elements
+template <typename ObjectType> void append_compact_record(std::string& out, const ObjectType& obj)
+{
+    out += "  <object";
+
+    std::apply(
+        [&](auto&&... fieldMeta) -> void
+        {
+            auto writeAttribute = [&](const auto& field)
+            {
+                using FieldType = typename std::remove_cvref_t<decltype(field)>::FieldType;
+                if constexpr (std::is_arithmetic_v<FieldType>)
+                {
+                    out += ' ';
+                    out += field.memberName;
+                    out += "=\"";
+                    out += escape_xml_string(std::to_string(obj.*(field.memberPtr)));
+                    out += '"';
+                }
+                else if constexpr (std::is_same_v<FieldType, std::string>)
+                {
+                    out += ' ';
+                    out += field.memberName;
+                    out += "=\"";
+                    out += escape_xml_string(obj.*(field.memberPtr));
+                    out += '"';
+                }
+            };
+            (writeAttribute(fieldMeta), ...);
+        },
+        meta::MetaTuple<ObjectType>::fields);
+
+    out += ">\n";
+
+    std::apply(
+        [&](auto&&... fieldMeta) -> void
+        {
+            auto writeChild = [&](const auto& field)
+            {
+                using FieldType = typename std::remove_cvref_t<decltype(field)>::FieldType;
+                if constexpr (!std::is_arithmetic_v<FieldType> &&
+                              !std::is_same_v<FieldType, std::string>)
+                {
+                    out += format_xml_value(obj.*(field.memberPtr), field.memberName, 2);
+                    out += '\n';
+                }
+            };
+            (writeChild(fieldMeta), ...);
+        },
+        meta::MetaTuple<ObjectType>::fields);
+
+    out += "  </object>\n";
+}
+
+// XML declaration and opening root tag
+inline void append_prologue(std::string& out, const std::string& root_name)
+{
+    out += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    out += '<';
+    out += root_name;
+    out += ">\n";
+}
+
+inline void append_epilogue(std::string& out, const std::string& root_name)
+{
+    out += "</";
+    out += root_name;
+    out += ">\n";
+}
+
 // Main serialize function - pretty formatted
 template <typename ObjectType>
 std::string serialize(const std::vector<ObjectType>& objects, const std::string& root_name = "data")
 {
-    std::stringstream os;
-    os << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-    os << "<" << root_name << ">\n";
+    std::string out;
+    append_prologue(out, root_name);
 
     if (objects.empty())
     {
-        os << "  <!-- Empty collection -->\n";
-        os << "</" << root_name << ">\n";
-        return os.str();
+        out += "  <!-- Empty collection -->\n";
     }
 
-    constexpr auto& fields = meta::MetaTuple<ObjectType>::fields;
-
     for (size_t i = 0; i < objects.size(); ++i)
     {
-        const auto& obj = objects[i];
-        os << "  <object index=\"" << i << "\">\n";
-
-        std::apply(
-            [&](auto&&... fieldMeta) -> void
-            {
-                ((os << format_xml_value(obj.*(fieldMeta.memberPtr), fieldMeta.memberName, 2)
-                     << "\n"),
-                 ...);
-            },
-            fields);
-
-        os << "  </object>\n";
+        append_record(out, objects[i], i);
     }
 
-    os << "</" << root_name << ">\n";
-    return os.str();
+    append_epilogue(out, root_name);
+    return out;
 }
 
 // Compact version - attributes where possible
@@ -495,53 +584,52 @@ template <typename ObjectType>
 std::string serialize_compact(const std::vector<ObjectType>& objects,
                               const std::string& root_name = "data")
 {
-    std::stringstream os;
-    os << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-    os << "<" << root_name << ">\n";
+    std::string out;
+    append_prologue(out, root_name);
 
-    if (objects.empty())
+    for (const auto& obj : objects)
     {
-        os << "</" << root_name << ">\n";
-        return os.str();
+        append_compact_record(out, obj);
     }
 
-    constexpr auto& fields = meta::MetaTuple<ObjectType>::fields;
-
-    for (size_t i = 0; i < objects.size(); ++i)
-    {
-        const auto& obj = objects[i];
-        os << "  <object";
-
-        // Try to put simple fields as attributes
-        std::apply(
-            [&](auto&&... fieldMeta) -> void
-            {
-                ((std::is_arithmetic_v<typename decltype(fieldMeta)::FieldType> || 
-                  std::is_same_v<typename decltype(fieldMeta)::FieldType, std::string>) ?
-                 (os << " " << fieldMeta.memberName << "=\"" 
-                     << escape_xml_string(std::to_string(obj.*(fieldMeta.memberPtr))) << "\"") :
-                 void()), ...);
-            },
-            fields);
-
-        os << ">\n";
+    append_epilogue(out, root_name);
+    return out;
+}
 
-        // Complex fields as child elements
-        std::apply(
-            [&](auto&&... fieldMeta) -> void
-            {
-                ((!std::is_arithmetic_v<typename decltype(fieldMeta)::FieldType> && 
-                  !std::is_same_v<typename decltype(fieldMeta)::FieldType, std::string>) ?
-                 (os << format_xml_value(obj.*(fieldMeta.memberPtr), fieldMeta.memberName, 2) << "\n") :
-                 void()), ...);
-            },
-            fields);
+// serialize() (Layout::Pretty) or serialize_compact() with the records
+// formatted on up to `threads` threads (0 = one per core); same bytes
+template <typename ObjectType>
+std::string serialize_parallel(const std::vector<ObjectType>& objects,
+                               const std::string& root_name = "data",
+                               meta::Layout layout = meta::Layout::Pretty,
+                               size_t threads = 0)
+{
+    std::string out;
+    append_prologue(out, root_name);
 
-        os << "  </object>\n";
+    if (layout == meta::Layout::Pretty)
+    {
+        if (objects.empty())
+        {
+            out += "  <!-- Empty collection -->\n";
+        }
+        meta::append_parallel(
+            out,
+            objects,
+            [](std::string& buf, const ObjectType& obj, size_t i) { append_record(buf, obj, i); },
+            threads);
+    }
+    else
+    {
+        meta::append_parallel(
+            out,
+            objects,
+            [](std::string& buf, const ObjectType& obj, size_t) { append_compact_record(buf, obj); },
+            threads);
     }
 
-    os << "</" << root_name << ">\n";
-    return os.str();
+    append_epilogue(out, root_name);
+    return out;
 }
 
 // Alternative serialize function with schema information
@@ -630,5 +718,965 @@ std::string serialize_single(const ObjectType& obj, const std::string& root_name
     return os.str();
 }
 
+// Streaming writer: the root element is opened on construction, each
+// write() appends one <object> to a meta::Sink (flushed in blocks) and
+// close() ends the document. The bytes match serialize() (Layout::Pretty)
+// or serialize_compact() (Layout::Compact).
+//
+// Usage:
+//   meta::xml::writer<Row> out(meta::Sink::file("rows.xml"), "rows");
+//   out.write_all(FetchRowsGeneratorT<Row>(conn));
+//   out.close();
+template <typename ObjectType> class writer
+{
+  public:
+    explicit writer(meta::Sink sink,
+                    std::string root_name = "data",
+                    meta::Layout layout = meta::Layout::Pretty)
+        : sink_(std::move(sink)), root_name_(std::move(root_name)), layout_(layout)
+    {
+        append_prologue(sink_.buffer(), root_name_);
+    }
+
+    ~writer()
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    writer(const writer&) = delete;
+    writer& operator=(const writer&) = delete;
+
+    void write(const ObjectType& obj)
+    {
+        if (closed_)
+            throw std::logic_error("xml: write after close");
+        if (layout_ == meta::Layout::Pretty)
+            append_record(sink_.buffer(), obj, count_);
+        else
+            append_compact_record(sink_.buffer(), obj);
+        ++count_;
+        sink_.commit();
+    }
+
+    // Writes every row of a range or generator (rows may be pointers); returns the count
+    template <typename Range> size_t write_all(Range&& rows)
+    {
+        return meta::write_rows(*this, std::forward<Range>(rows));
+    }
+
+    // Closes the root element, flushes and releases the sink
+    void close()
+    {
+        if (closed_)
+            return;
+        closed_ = true;
+        if (count_ == 0 && layout_ == meta::Layout::Pretty)
+            sink_.buffer() += "  <!-- Empty collection -->\n";
+        append_epilogue(sink_.buffer(), root_name_);
+        sink_.close();
+    }
+
+    size_t count() const
+    {
+        return count_;
+    }
+
+  private:
+    meta::Sink sink_;
+    std::string root_name_;
+    meta::Layout layout_;
+    size_t count_ = 0;
+    bool closed_ = false;
+};
+
+// ================================================================
+// Reader
+//
+// meta::xml::reader<T> pulls the records of a document one at a time: every
+// element named `element` ("object", as serialize() and serialize_compact()
+// write them) is read into a T, and the memory in use does not grow with
+// the document. The Tokenizer underneath is a pull parser over the input
+// text; element names, attribute values and text are views into it, and
+// entity references (&lt; &#10; ...) are decoded, into a reused buffer,
+// only in the values that contain a '&'. Comments, processing instructions,
+// the DOCTYPE and CDATA sections are handled; namespaces and DTD entities
+// are not.
+//
+// Child elements and attributes are matched to the MetaTuple<T>::fields
+// names through a perfect hash (the field after the previous one is tried
+// first, so elements in declaration order cost one compare). Values map
+// back the way format_xml_value() writes them: text for scalars, <item>
+// children for sequences, one child per key for maps (numeric keys as
+// key_N), element_N children for tuples, null="true" for an empty optional;
+// a type="unknown" element leaves the member as is. Unknown elements are
+// skipped, so are the elements around the records.
+//
+// Errors throw meta::xml::parse_error with the byte offset.
+//
+// Usage:
+//   meta::xml::reader<Row> in(xml);
+//   for (Row row; in.next(row);) { ... }
+//   auto rows = meta::xml::parse<Row>(meta::xml::serialize(rows));
+//   meta::csv::MappedFile feed("feed.xml");   // a multi-GB file, paged in as read
+//   meta::xml::parse_each<Trade>(feed.view(), [](Trade&& trade) { ... }, "trade");
+// ================================================================
+
+class parse_error : public std::runtime_error
+{
+  public:
+    parse_error(const std::string& what, size_t offset)
+        : std::runtime_error("xml: " + what + " at offset " + std::to_string(offset)), offset_(offset)
+    {
+    }
+
+    size_t offset() const
+    {
+        return offset_;
+    }
+
+  private:
+    size_t offset_;
+};
+
+namespace detail
+{
+
+template <typename T> struct is_optional : std::false_type
+{
+};
+template <typename T> struct is_optional<std::optional<T>> : std::true_type
+{
+};
+
+template <typename T>
+concept Reflected = requires { meta::MetaTuple<T>::fields; };
+
+template <typename T>
+concept MapLike = std::ranges::input_range<T> && requires {
+    typename T::key_type;
+    typename T::mapped_type;
+};
+
+template <typename T>
+concept SequenceLike = std::ranges::input_range<T> && !std::is_convertible_v<const T&, std::string_view> && !MapLike<T>;
+
+template <typename T>
+concept TupleLike = !std::ranges::range<T> && requires { std::tuple_size<T>::value; };
+
+inline bool is_space(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+// Ends an element or attribute name
+inline bool is_name_end(char c)
+{
+    return is_space(c) || c == '/' || c == '>' || c == '=';
+}
+
+inline void append_utf8(std::string& out, uint32_t code)
+{
+    if (code < 0x80)
+        out += static_cast<char>(code);
+    else if (code < 0x800)
+    {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000)
+    {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else
+    {
+        out += static_cast<char>(0xF0 | (code >> 18));
+        out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+} // namespace detail
+
+// Pull parser: next() returns the next start tag, end tag or run of text.
+// A self-closing <tag /> comes back as a Start followed by its End.
+class Tokenizer
+{
+  public:
+    enum class Token
+    {
+        Start,
+        End,
+        Text,
+        Eof
+    };
+
+    explicit Tokenizer(std::string_view xml)
+        : begin_(xml.data()), p_(xml.data()), end_(xml.data() + xml.size()), token_(xml.data())
+    {
+    }
+
+    Token next()
+    {
+        if (close_pending_)
+        {
+            close_pending_ = false;
+            return Token::End;
+        }
+        for (;;)
+        {
+            token_ = p_;
+            if (p_ == end_)
+                return Token::Eof;
+            if (*p_ != '<')
+            {
+                const char* lt = static_cast<const char*>(std::memchr(p_, '<', static_cast<size_t>(end_ - p_)));
+                if (lt == nullptr)
+                    lt = end_;
+                text_ = {p_, static_cast<size_t>(lt - p_)};
+                cdata_ = false;
+                p_ = lt;
+                return Token::Text;
+            }
+            std::string_view rest(p_, static_cast<size_t>(end_ - p_));
+            if (rest.starts_with("<!--"))
+                p_ = find(p_ + 4, "-->", "unterminated comment") + 3;
+            else if (rest.starts_with("<![CDATA["))
+            {
+                const char* close = find(p_ + 9, "]]>", "unterminated CDATA section");
+                text_ = {p_ + 9, static_cast<size_t>(close - p_ - 9)};
+                cdata_ = true;
+                p_ = close + 3;
+                return Token::Text;
+            }
+            else if (rest.starts_with("<?"))
+                p_ = find(p_ + 2, "?>", "unterminated processing instruction") + 2;
+            else if (rest.starts_with("<!"))
+                skip_declaration();
+            else if (rest.starts_with("</"))
+            {
+                read_name(p_ + 2);
+                const char* q = name_.data() + name_.size();
+                while (q < end_ && detail::is_space(*q))
+                    ++q;
+                if (q == end_ || *q != '>')
+                    fail("expected '>' after </" + std::string(name_));
+                p_ = q + 1;
+                return Token::End;
+            }
+            else
+            {
+                read_start_tag();
+                return Token::Start;
+            }
+        }
+    }
+
+    // Element name of the last Start or End
+    std::string_view name() const
+    {
+        return name_;
+    }
+
+    // The last Text as it appears in the input (see decode)
+    std::string_view text() const
+    {
+        return text_;
+    }
+
+    // The last Text is a CDATA section: no entity references to decode
+    bool cdata() const
+    {
+        return cdata_;
+    }
+
+    // The last Start was <tag />
+    bool empty_element() const
+    {
+        return close_pending_;
+    }
+
+    // Next attribute of the last Start; value as it appears in the input
+    // (see decode). False after the last one.
+    bool next_attribute(std::string_view& name, std::string_view& value)
+    {
+        const char* q = attribute_;
+        while (q < attributes_end_ && detail::is_space(*q))
+            ++q;
+        if (q == attributes_end_)
+            return false;
+        const char* n = q;
+        while (q < attributes_end_ && !detail::is_name_end(*q))
+            ++q;
+        name = {n, static_cast<size_t>(q - n)};
+        while (q < attributes_end_ && detail::is_space(*q))
+            ++q;
+        if (name.empty() || q == attributes_end_ || *q != '=')
+            fail("malformed attribute in <" + std::string(name_) + ">");
+        ++q;
+        while (q < attributes_end_ && detail::is_space(*q))
+            ++q;
+        if (q == attributes_end_ || (*q != '"' && *q != '\''))
+            fail("expected a quoted value for attribute " + std::string(name));
+        // read_start_tag checked the quotes are closed
+        const char* close = static_cast<const char*>(std::memchr(q + 1, *q, static_cast<size_t>(attributes_end_ - q - 1)));
+        value = {q + 1, static_cast<size_t>(close - q - 1)};
+        attribute_ = close + 1;
+        return true;
+    }
+
+    // Starts next_attribute() over from the first attribute
+    void rewind_attributes()
+    {
+        attribute_ = attributes_;
+    }
+
+    // raw with its entity references replaced: raw itself when it has none,
+    // else a view of a buffer reused by the next decode() or element_text()
+    std::string_view decode(std::string_view raw)
+    {
+        if (std::memchr(raw.data(), '&', raw.size()) == nullptr)
+            return raw;
+        scratch_.clear();
+        append_decoded(scratch_, raw);
+        return scratch_;
+    }
+
+    // Text of the element whose Start was just read, consuming its End. A
+    // view into the input unless it had entity references or was split by
+    // comments and CDATA sections (then as decode()).
+    std::string_view element_text()
+    {
+        const std::string_view element = name_;
+        std::string_view text;
+        bool owned = false;
+        for (;;)
+        {
+            switch (next())
+            {
+            case Token::Text:
+                if (!owned && text.empty())
+                {
+                    text = cdata_ ? text_ : decode(text_);
+                    owned = text.data() == scratch_.data();
+                }
+                else
+                {
+                    if (!owned)
+                        scratch_.assign(text.data(), text.size());
+                    owned = true;
+                    if (cdata_)
+                        scratch_.append(text_);
+                    else
+                        append_decoded(scratch_, text_);
+                    text = scratch_;
+                }
+                break;
+            case Token::Start:
+                fail("unexpected element <" + std::string(name_) + "> in the value of <" + std::string(element) + ">");
+            case Token::End:
+                expect_end(element);
+                return text;
+            case Token::Eof:
+                fail("unterminated element <" + std::string(element) + ">");
+            }
+        }
+    }
+
+    // Skips the rest of the element whose Start was just read
+    void skip_element()
+    {
+        const std::string_view element = name_;
+        for (size_t depth = 1; depth > 0;)
+        {
+            switch (next())
+            {
+            case Token::Start:
+                ++depth;
+                break;
+            case Token::End:
+                --depth;
+                break;
+            case Token::Text:
+                break;
+            case Token::Eof:
+                fail("unterminated element <" + std::string(element) + ">");
+            }
+        }
+    }
+
+    // The End just read closes element
+    void expect_end(std::string_view element) const
+    {
+        if (name_ != element)
+            fail("</" + std::string(name_) + "> closes <" + std::string(element) + ">");
+    }
+
+    // Byte offset of the current token
+    size_t offset() const
+    {
+        return static_cast<size_t>(token_ - begin_);
+    }
+
+    [[noreturn]] void fail(const std::string& what) const
+    {
+        throw parse_error(what, offset());
+    }
+
+  private:
+    const char* find(const char* from, std::string_view close, const char* what) const
+    {
+        size_t at = std::string_view(from, static_cast<size_t>(end_ - from)).find(close);
+        if (at == std::string_view::npos)
+            fail(what);
+        return from + at;
+    }
+
+    void read_name(const char* from)
+    {
+        const char* q = from;
+        while (q < end_ && !detail::is_name_end(*q))
+            ++q;
+        if (q == from)
+            fail("expected an element name");
+        name_ = {from, static_cast<size_t>(q - from)};
+    }
+
+    void read_start_tag()
+    {
+        read_name(p_ + 1);
+        const char* q = name_.data() + name_.size();
+        attributes_ = attribute_ = q;
+        char quote = 0;
+        for (; q < end_; ++q)
+        {
+            if (quote != 0)
+            {
+                if (*q == quote)
+                    quote = 0;
+            }
+            else if (*q == '"' || *q == '\'')
+                quote = *q;
+            else if (*q == '>')
+                break;
+        }
+        if (q == end_)
+            fail("unterminated tag <" + std::string(name_) + ">");
+        close_pending_ = q[-1] == '/' && q - 1 >= attributes_;
+        attributes_end_ = close_pending_ ? q - 1 : q;
+        p_ = q + 1;
+    }
+
+    // <!DOCTYPE ...> with an optional [internal subset]
+    void skip_declaration()
+    {
+        const char* q = p_ + 2;
+        int brackets = 0;
+        char quote = 0;
+        for (; q < end_; ++q)
+        {
+            if (quote != 0)
+            {
+                if (*q == quote)
+                    quote = 0;
+            }
+            else if (*q == '"' || *q == '\'')
+                quote = *q;
+            else if (*q == '[')
+                ++brackets;
+            else if (*q == ']')
+                --brackets;
+            else if (*q == '>' && brackets == 0)
+                break;
+        }
+        if (q == end_)
+            fail("unterminated declaration");
+        p_ = q + 1;
+    }
+
+    void append_decoded(std::string& out, std::string_view raw) const
+    {
+        for (;;)
+        {
+            size_t amp = raw.find('&');
+            out.append(raw.data(), amp == std::string_view::npos ? raw.size() : amp);
+            if (amp == std::string_view::npos)
+                return;
+            size_t semi = raw.find(';', amp);
+            if (semi == std::string_view::npos)
+                fail("unterminated entity reference");
+            std::string_view entity = raw.substr(amp + 1, semi - amp - 1);
+            if (entity == "lt")
+                out += '<';
+            else if (entity == "gt")
+                out += '>';
+            else if (entity == "amp")
+                out += '&';
+            else if (entity == "quot")
+                out += '"';
+            else if (entity == "apos")
+                out += '\'';
+            else if (entity.size() > 1 && entity[0] == '#')
+            {
+                bool hex = entity[1] == 'x' || entity[1] == 'X';
+                std::string_view digits = entity.substr(hex ? 2 : 1);
+                uint32_t code = 0;
+                auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), code, hex ? 16 : 10);
+                if (ec != std::errc() || end != digits.data() + digits.size() || digits.empty() || code > 0x10FFFF)
+                    fail("bad character reference &" + std::string(entity) + ";");
+                detail::append_utf8(out, code);
+            }
+            else
+                fail("unknown entity &" + std::string(entity) + ";");
+            raw.remove_prefix(semi + 1);
+        }
+    }
+
+    const char* begin_;
+    const char* p_;
+    const char* end_;
+    const char* token_;
+    std::string_view name_;
+    std::string_view text_;
+    const char* attributes_ = nullptr;
+    const char* attribute_ = nullptr;
+    const char* attributes_end_ = nullptr;
+    bool cdata_ = false;
+    bool close_pending_ = false;
+    std::string scratch_;
+};
+
+// Fills value from the element whose Start was just read, consuming its End
+template <typename T> void read_value(Tokenizer& tokenizer, T& value);
+
+namespace detail
+{
+
+// Field name as written by serialize() (memberName on FieldMeta, fieldName on meta::Field)
+template <typename FieldMeta> std::string_view field_name(const FieldMeta& fieldMeta)
+{
+    if constexpr (requires { fieldMeta.memberName; })
+        return fieldMeta.memberName;
+    else
+        return fieldMeta.fieldName;
+}
+
+// Converts element text or an attribute value to value
+template <typename T> void assign_text(Tokenizer& tokenizer, T& value, std::string_view text)
+{
+    if constexpr (std::is_same_v<T, std::string>)
+        value.assign(text.data(), text.size());
+    else
+    {
+        while (!text.empty() && is_space(text.front()))
+            text.remove_prefix(1);
+        while (!text.empty() && is_space(text.back()))
+            text.remove_suffix(1);
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            // serialize_compact() writes bools as 1 and 0
+            if (text == "true" || text == "1")
+                value = true;
+            else if (text == "false" || text == "0")
+                value = false;
+            else
+                tokenizer.fail("expected true or false, found '" + std::string(text) + "'");
+        }
+        else if constexpr (std::is_same_v<T, char>)
+        {
+            if (text.size() > 1)
+                tokenizer.fail("expected a single character");
+            value = text.empty() ? '\0' : text[0];
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            std::underlying_type_t<T> raw{};
+            assign_text(tokenizer, raw, text);
+            value = static_cast<T>(raw);
+        }
+        else if constexpr (std::is_arithmetic_v<T>)
+        {
+            if (!text.empty() && text[0] == '+')
+                text.remove_prefix(1);
+            auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (ec == std::errc::result_out_of_range)
+                tokenizer.fail("number out of range");
+            if (ec != std::errc() || end != text.data() + text.size() || text.empty())
+                tokenizer.fail("expected a number, found '" + std::string(text) + "'");
+        }
+        else
+            static_assert(sizeof(T) == 0, "meta::xml: no conversion from text for this type");
+    }
+}
+
+// A field that serialize_compact() may write as an attribute
+template <typename T>
+concept AttributeValue = std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_same_v<T, std::string>;
+
+// Element and attribute names to fields of a reflected type: the shared
+// perfect-hash FieldNameIndex, plus a reader and attribute setter per field
+template <typename ObjectType> class FieldTable
+{
+  public:
+    static constexpr size_t count = std::tuple_size_v<std::remove_cvref_t<decltype(meta::MetaTuple<ObjectType>::fields)>>;
+    using Reader = void (*)(Tokenizer&, ObjectType&);
+    using AttributeSetter = void (*)(Tokenizer&, ObjectType&, std::string_view);
+
+    static const FieldTable& get()
+    {
+        static const FieldTable table;
+        return table;
+    }
+
+    // Index of the field named name, or count; hint is tried first
+    size_t find(std::string_view name, size_t hint) const
+    {
+        return index_.find(name, hint);
+    }
+
+    void read(size_t field, Tokenizer& tokenizer, ObjectType& obj) const
+    {
+        readers_[field](tokenizer, obj);
+    }
+
+    // Attributes of fields with no text form (containers) are ignored
+    void set_attribute(size_t field, Tokenizer& tokenizer, ObjectType& obj, std::string_view raw) const
+    {
+        if (attribute_setters_[field] != nullptr)
+            attribute_setters_[field](tokenizer, obj, raw);
+    }
+
+  private:
+    template <typename FieldMeta> static Reader make_reader()
+    {
+        if constexpr (FieldMeta::memberPtr != nullptr)
+            return [](Tokenizer& tokenizer, ObjectType& obj) { read_value(tokenizer, obj.*(FieldMeta::memberPtr)); };
+        else
+            return [](Tokenizer& tokenizer, ObjectType&) { tokenizer.skip_element(); };
+    }
+
+    template <typename FieldMeta> static AttributeSetter make_attribute_setter()
+    {
+        if constexpr (FieldMeta::memberPtr != nullptr)
+        {
+            using V = std::remove_cvref_t<decltype(std::declval<ObjectType&>().*(FieldMeta::memberPtr))>;
+            if constexpr (AttributeValue<V>)
+                return [](Tokenizer& tokenizer, ObjectType& obj, std::string_view raw)
+                { assign_text(tokenizer, obj.*(FieldMeta::memberPtr), tokenizer.decode(raw)); };
+        }
+        return nullptr;
+    }
+
+    static std::array<std::string_view, count> names()
+    {
+        std::array<std::string_view, count> result{};
+        std::apply(
+            [&](const auto&... fieldMeta)
+            {
+                size_t i = 0;
+                ((result[i++] = field_name(fieldMeta)), ...);
+            },
+            meta::MetaTuple<ObjectType>::fields);
+        return result;
+    }
+
+    FieldTable() : index_(names(), "meta::xml")
+    {
+        std::apply(
+            [&](const auto&... fieldMeta)
+            {
+                size_t i = 0;
+                ((attribute_setters_[i] = make_attribute_setter<std::remove_cvref_t<decltype(fieldMeta)>>(),
+                  readers_[i++] = make_reader<std::remove_cvref_t<decltype(fieldMeta)>>()),
+                 ...);
+            },
+            meta::MetaTuple<ObjectType>::fields);
+    }
+
+    meta::detail::FieldNameIndex<count> index_;
+    std::array<Reader, count> readers_{};
+    std::array<AttributeSetter, count> attribute_setters_{};
+};
+
+// Calls fn(name) at each child element's Start (fn consumes the child up to
+// its End) until the End of the element whose Start was just read. Text
+// between the children (indentation) is ignored.
+template <typename Fn> void for_each_child(Tokenizer& tokenizer, Fn&& fn)
+{
+    const std::string_view element = tokenizer.name();
+    for (;;)
+    {
+        switch (tokenizer.next())
+        {
+        case Tokenizer::Token::Start:
+            fn(tokenizer.name());
+            break;
+        case Tokenizer::Token::End:
+            tokenizer.expect_end(element);
+            return;
+        case Tokenizer::Token::Text:
+            break;
+        case Tokenizer::Token::Eof:
+            tokenizer.fail("unterminated element <" + std::string(element) + ">");
+        }
+    }
+}
+
+template <typename T> void read_object(Tokenizer& tokenizer, T& obj)
+{
+    using Table = FieldTable<T>;
+    const Table& table = Table::get();
+    size_t hint = 0;
+    std::string_view name;
+    std::string_view raw;
+    while (tokenizer.next_attribute(name, raw))
+    {
+        size_t field = table.find(name, hint);
+        if (field < Table::count)
+        {
+            table.set_attribute(field, tokenizer, obj, raw);
+            hint = field + 1;
+        }
+    }
+    hint = 0;
+    for_each_child(tokenizer,
+                   [&](std::string_view child)
+                   {
+                       size_t field = table.find(child, hint);
+                       if (field < Table::count)
+                       {
+                           table.read(field, tokenizer, obj);
+                           hint = field + 1;
+                       }
+                       else
+                           tokenizer.skip_element();
+                   });
+}
+
+} // namespace detail
+
+template <typename T> void read_value(Tokenizer& tokenizer, T& value)
+{
+    if constexpr (detail::Reflected<T>)
+        detail::read_object(tokenizer, value);
+    else
+    {
+        bool null = false;
+        bool unknown = false;
+        std::string_view name;
+        std::string_view raw;
+        while (tokenizer.next_attribute(name, raw))
+        {
+            if (name == "null")
+                null = raw == "true";
+            else if (name == "type")
+                unknown = raw == "unknown";
+        }
+        // null="true" on anything but an optional, or no mapping in
+        // format_xml_value (type="unknown"): leave the member as is
+        if (unknown || (null && !detail::is_optional<T>::value))
+        {
+            tokenizer.skip_element();
+            return;
+        }
+
+        if constexpr (detail::is_optional<T>::value)
+        {
+            if (null)
+            {
+                value.reset();
+                tokenizer.skip_element();
+            }
+            else
+            {
+                tokenizer.rewind_attributes();
+                read_value(tokenizer, value.emplace());
+            }
+        }
+        else if constexpr (detail::MapLike<T>)
+        {
+            using K = typename T::key_type;
+            value.clear();
+            detail::for_each_child(tokenizer,
+                                   [&](std::string_view child)
+                                   {
+                                       // format_map_xml writes numeric keys as key_N
+                                       K key{};
+                                       if constexpr (std::is_same_v<K, std::string>)
+                                           key.assign(child.data(), child.size());
+                                       else
+                                       {
+                                           if (child.starts_with("key_"))
+                                               child.remove_prefix(4);
+                                           detail::assign_text(tokenizer, key, child);
+                                       }
+                                       typename T::mapped_type mapped{};
+                                       read_value(tokenizer, mapped);
+                                       value.insert_or_assign(std::move(key), std::move(mapped));
+                                   });
+        }
+        else if constexpr (detail::SequenceLike<T> && requires { std::tuple_size<T>::value; })
+        {
+            // std::array: fixed element count, assigned in place
+            size_t index = 0;
+            detail::for_each_child(tokenizer,
+                                   [&](std::string_view)
+                                   {
+                                       if (index == std::tuple_size_v<T>)
+                                           tokenizer.fail("more than " + std::to_string(std::tuple_size_v<T>) +
+                                                          " array elements");
+                                       read_value(tokenizer, value[index++]);
+                                   });
+        }
+        else if constexpr (detail::SequenceLike<T>)
+        {
+            value.clear();
+            detail::for_each_child(tokenizer,
+                                   [&](std::string_view)
+                                   {
+                                       typename T::value_type element{};
+                                       read_value(tokenizer, element);
+                                       if constexpr (requires { value.push_back(std::move(element)); })
+                                           value.push_back(std::move(element));
+                                       else
+                                           value.insert(std::move(element));
+                                   });
+        }
+        else if constexpr (detail::TupleLike<T>)
+        {
+            constexpr size_t size = std::tuple_size_v<T>;
+            size_t index = 0;
+            detail::for_each_child(tokenizer,
+                                   [&](std::string_view)
+                                   {
+                                       if (index == size)
+                                           tokenizer.fail("more than " + std::to_string(size) + " tuple elements");
+                                       [&]<size_t... I>(std::index_sequence<I...>)
+                                       {
+                                           ((index == I ? read_value(tokenizer, std::get<I>(value)) : void()), ...);
+                                       }(std::make_index_sequence<size>{});
+                                       ++index;
+                                   });
+            if (index != size)
+                tokenizer.fail("expected " + std::to_string(size) + " tuple elements, found " + std::to_string(index));
+        }
+        else
+            detail::assign_text(tokenizer, value, tokenizer.element_text());
+    }
+}
+
+// Reads the records of an XML document one at a time: each element named
+// element, wherever it is nested, becomes one T. xml must outlive the reader.
+template <typename T> class reader
+{
+  public:
+    explicit reader(std::string_view xml, std::string_view element = "object")
+        : tokenizer_(xml), element_(element)
+    {
+    }
+
+    // Fills out from the next record; false at the end of the document.
+    // Fields the record has no element or attribute for keep their value.
+    bool next(T& out)
+    {
+        for (;;)
+        {
+            switch (tokenizer_.next())
+            {
+            case Tokenizer::Token::Start:
+                if (tokenizer_.name() == element_)
+                {
+                    read_value(tokenizer_, out);
+                    return true;
+                }
+                break;
+            case Tokenizer::Token::Eof:
+                return false;
+            default:
+                break;
+            }
+        }
+    }
+
+    // Byte offset reached in the document
+    size_t offset() const
+    {
+        return tokenizer_.offset();
+    }
+
+  private:
+    Tokenizer tokenizer_;
+    std::string_view element_;
+};
+
+// Calls fn(T&&) for every record (serialize() or serialize_compact()
+// output, or any document with repeated `element`s); returns the count
+template <typename T, typename Fn>
+size_t parse_each(std::string_view xml, Fn&& fn, std::string_view element = "object")
+{
+    reader<T> in(xml, element);
+    size_t count = 0;
+    for (;;)
+    {
+        T item{};
+        if (!in.next(item))
+            break;
+        fn(std::move(item));
+        ++count;
+    }
+    return count;
+}
+
+// All records of xml
+template <typename T> std::vector<T> parse(std::string_view xml, std::string_view element = "object")
+{
+    std::vector<T> out;
+    parse_each<T>(xml, [&](T&& item) { out.push_back(std::move(item)); }, element);
+    return out;
+}
+
+// The document element of serialize_single() output (whatever its name)
+template <typename T> T parse_single(std::string_view xml)
+{
+    Tokenizer tokenizer(xml);
+    for (;;)
+    {
+        switch (tokenizer.next())
+        {
+        case Tokenizer::Token::Start:
+        {
+            T out{};
+            read_value(tokenizer, out);
+            return out;
+        }
+        case Tokenizer::Token::Eof:
+            tokenizer.fail("no document element");
+        default:
+            break;
+        }
+    }
+}
+
+// Lazily yields the records of xml (which must outlive the generator)
+template <typename T> Generator<T> records(std::string_view xml, std::string_view element = "object")
+{
+    reader<T> in(xml, element);
+    for (;;)
+    {
+        T item{};
+        if (!in.next(item))
+            break;
+        co_yield std::move(item);
+    }
+}
+
 } // namespace xml
 } // namespace meta
@@ -12,43 +12,64 @@
  * - Mixed complex types and combinations
  *
  * Usage: meta::yaml::serialize(your_vector_of_objects)
+ *        meta::yaml::parse<std::vector<T>>(text)   (Reader section below)
  * ================================================================
  */
 
 #pragma once
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <optional>
+#include <ranges>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
+#include "meta_escape.h"
+#include "meta_field_index.h"
+#include "meta_parallel.h"
+#include "meta_sink.h"
+
 namespace meta
 {
 namespace yaml
 {
 
+namespace detail
+{
+// Plain scalars the reader takes as null; the writer quotes strings that match
+inline bool is_null(std::string_view text)
+{
+    return text == "null" || text == "~" || text == "Null" || text == "NULL";
+}
+} // namespace detail
+
 // Helper function to escape YAML strings
 std::string escape_yaml_string(const std::string& str)
 {
-    // Check if string needs quoting
-    bool needs_quotes = false;
+    // Characters that force a quoted scalar anywhere in the string (',' ends
+    // a plain scalar inside the flow sequences and mappings)
+    static constexpr meta::escape::CharSet quoteTriggers(":#\n\r\t\"'[]{},");
+    // Characters escaped inside the double-quoted form
+    static constexpr meta::escape::CharSet specials("\"\\\b\f\n\r\t");
 
     // YAML special cases that need quoting
-    if (str.empty() || str == "true" || str == "false" || str == "yes" || str == "no" ||
-        str == "null" || str == "~" || std::isdigit(str[0]) || str[0] == '-' || str[0] == '+' ||
-        str.find(':') != std::string::npos || str.find('#') != std::string::npos ||
-        str.find('\n') != std::string::npos || str.find('\r') != std::string::npos ||
-        str.find('\t') != std::string::npos || str.find('"') != std::string::npos ||
-        str.find('\'') != std::string::npos || str.find('[') != std::string::npos ||
-        str.find(']') != std::string::npos || str.find('{') != std::string::npos ||
-        str.find('}') != std::string::npos || str[0] == ' ' || str.back() == ' ')
-    {
-        needs_quotes = true;
-    }
+    bool needs_quotes = str.empty() || str == "true" || str == "false" || str == "yes" ||
+                        str == "no" || detail::is_null(str) || std::isdigit(str[0]) ||
+                        str[0] == '-' || str[0] == '+' || str[0] == ' ' || str.back() == ' ' ||
+                        meta::escape::contains_any(str, quoteTriggers);
 
     if (!needs_quotes)
     {
@@ -57,36 +78,34 @@ std::string escape_yaml_string(const std::string& str)
 
     // Use double quotes and escape
     std::string escaped = "\"";
-    for (char c : str)
-    {
-        switch (c)
-        {
-        case '"':
-            escaped += "\\\"";
-            break;
-        case '\\':
-            escaped += "\\\\";
-            break;
-        case '\b':
-            escaped += "\\b";
-            break;
-        case '\f':
-            escaped += "\\f";
-            break;
-        case '\n':
-            escaped += "\\n";
-            break;
-        case '\r':
-            escaped += "\\r";
-            break;
-        case '\t':
-            escaped += "\\t";
-            break;
-        default:
-            escaped += c;
-            break;
-        }
-    }
+    meta::escape::append_escaped(escaped,
+                                 str,
+                                 specials,
+                                 [](std::string& out, char c)
+                                 {
+                                     switch (c)
+                                     {
+                                     case '\b':
+                                         out += "\\b";
+                                         break;
+                                     case '\f':
+                                         out += "\\f";
+                                         break;
+                                     case '\n':
+                                         out += "\\n";
+                                         break;
+                                     case '\r':
+                                         out += "\\r";
+                                         break;
+                                     case '\t':
+                                         out += "\\t";
+                                         break;
+                                     default: // '"' and '\\'
+                                         out += '\\';
+                                         out += c;
+                                         break;
+                                     }
+                                 });
     escaped += "\"";
     return escaped;
 }
@@ -177,7 +196,8 @@ std::string format_map_yaml(const std::map<K, V>& map, int indent_level = 0)
 
     for (const auto& [key, value] : map)
     {
-        ss << get_indent(indent_level + 1) << key << ": ";
+        // keys are quoted like the flow form's ("a: b" and "- x" would not read back)
+        ss << get_indent(indent_level + 1) << format_yaml_value(key, 0) << ": ";
         std::string value_str = format_yaml_value(value, indent_level + 1);
         if (value_str.front() == '\n')
         {
@@ -445,50 +465,146 @@ template <typename T> std::string format_yaml_value(const T& value, int indent_l
     }
 }
 
-// Main serialize function - pretty formatted
-template <typename ObjectType> std::string serialize(const std::vector<ObjectType>& objects)
+// One block-style list item of serialize(): "- a: 1\n  b: 2\n"
+template <typename ObjectType> void append_record(std::string& out, const ObjectType& obj)
 {
-    if (objects.empty())
-    {
-        return "---\n[]\n";
-    }
+    out += "- ";
 
-    std::stringstream os;
-    os << "---\n";
+    std::apply(
+        [&](auto&&... fieldMeta) -> void
+        {
+            bool first = true;
+            auto writeField = [&](const auto& field)
+            {
+                if (!first)
+                    out += "  ";
+                first = false;
+                out += field.memberName;
+                out += ": ";
 
-    constexpr auto& fields = meta::MetaTuple<ObjectType>::fields;
+                std::string value_str = format_yaml_value(obj.*(field.memberPtr), 1);
+                out += value_str;
+                if (value_str.empty() || value_str.front() != '\n')
+                    out += '\n';
+            };
+            (writeField(fieldMeta), ...);
+        },
+        meta::MetaTuple<ObjectType>::fields);
+}
 
-    for (size_t i = 0; i < objects.size(); ++i)
+// Flow-style value for serialize_compact(): sequences, mappings and tuples
+// nest on one line ("[[1, 2], [3]]", "{k: [1, 2]}") instead of switching
+// to the block form inside a flow mapping
+template <typename T> struct is_flow_vector : std::false_type
+{
+};
+template <typename T, typename A> struct is_flow_vector<std::vector<T, A>> : std::true_type
+{
+};
+template <typename T> struct is_flow_map : std::false_type
+{
+};
+template <typename K, typename V, typename C, typename A>
+struct is_flow_map<std::map<K, V, C, A>> : std::true_type
+{
+};
+template <typename T> struct is_flow_tuple : std::false_type
+{
+};
+template <typename... Ts> struct is_flow_tuple<std::tuple<Ts...>> : std::true_type
+{
+};
+template <typename T> struct is_flow_optional : std::false_type
+{
+};
+template <typename T> struct is_flow_optional<std::optional<T>> : std::true_type
+{
+};
+
+template <typename T> std::string format_flow_yaml(const T& value)
+{
+    if constexpr (is_flow_vector<T>::value)
     {
-        const auto& obj = objects[i];
+        std::string out = "[";
+        for (const auto& item : value)
+        {
+            if (out.size() > 1)
+                out += ", ";
+            out += format_flow_yaml(static_cast<const typename T::value_type&>(item));
+        }
+        return out + "]";
+    }
+    else if constexpr (is_flow_map<T>::value)
+    {
+        std::string out = "{";
+        for (const auto& [key, item] : value)
+        {
+            if (out.size() > 1)
+                out += ", ";
+            out += format_yaml_value(key, 0);
+            out += ": ";
+            out += format_flow_yaml(item);
+        }
+        return out + "}";
+    }
+    else if constexpr (is_flow_tuple<T>::value)
+    {
+        std::string out = "[";
+        std::apply(
+            [&](const auto&... items)
+            { ((out += (out.size() > 1 ? ", " : ""), out += format_flow_yaml(items)), ...); },
+            value);
+        return out + "]";
+    }
+    else if constexpr (is_flow_optional<T>::value)
+    {
+        return value ? format_flow_yaml(*value) : "null";
+    }
+    else
+    {
+        return format_yaml_value(value, 0);
+    }
+}
 
-        os << "- ";
+// One flow-style list item of serialize_compact(): "- {a: 1, b: 2}" (no newline)
+template <typename ObjectType> void append_flow_record(std::string& out, const ObjectType& obj)
+{
+    out += "- {";
 
-        // Write object fields
-        std::apply(
-            [&](auto&&... fieldMeta) -> void
+    std::apply(
+        [&](auto&&... fieldMeta) -> void
+        {
+            bool first = true;
+            auto writeField = [&](const auto& field)
             {
-                bool first = true;
-                ((first ? (os << fieldMeta.memberName << ": ", first = false)
-                        : (os << "  " << fieldMeta.memberName << ": "),
-                  [&]()
-                  {
-                      std::string value_str = format_yaml_value(obj.*(fieldMeta.memberPtr), 1);
-                      if (value_str.front() == '\n')
-                      {
-                          os << value_str;
-                      }
-                      else
-                      {
-                          os << value_str << "\n";
-                      }
-                  }()),
-                 ...);
-            },
-            fields);
+                if (!first)
+                    out += ", ";
+                first = false;
+                out += field.memberName;
+                out += ": ";
+                out += format_flow_yaml(obj.*(field.memberPtr));
+            };
+            (writeField(fieldMeta), ...);
+        },
+        meta::MetaTuple<ObjectType>::fields);
+
+    out += '}';
+}
+
+// Main serialize function - pretty formatted
+template <typename ObjectType> std::string serialize(const std::vector<ObjectType>& objects)
+{
+    if (objects.empty())
+    {
+        return "---\n[]\n";
     }
 
-    return os.str();
+    std::string out = "---\n";
+    for (const auto& obj : objects)
+    {
+        append_record(out, obj);
+    }
+    return out;
 }
 
 // Compact version - flow style where appropriate
@@ -499,36 +615,54 @@ template <typename ObjectType> std::string serialize_compact(const std::vector<O
         return "---\n[]";
     }
 
-    std::stringstream os;
-    os << "---\n";
-
-    constexpr auto& fields = meta::MetaTuple<ObjectType>::fields;
-
+    std::string out = "---\n";
     for (size_t i = 0; i < objects.size(); ++i)
     {
-        const auto& obj = objects[i];
-
-        os << "- {";
-
-        std::apply(
-            [&](auto&&... fieldMeta) -> void
-            {
-                bool first = true;
-                ((os << (first ? "" : ", ") << (first ? (first = false, "") : "")
-                     << fieldMeta.memberName << ": "
-                     << format_yaml_value(obj.*(fieldMeta.memberPtr), 0)),
-                 ...);
-            },
-            fields);
-
-        os << "}";
+        append_flow_record(out, objects[i]);
         if (i < objects.size() - 1)
         {
-            os << "\n";
+            out += '\n';
         }
     }
+    return out;
+}
 
-    return os.str();
+// serialize() (Layout::Pretty) or serialize_compact() with the records
+// formatted on up to `threads` threads (0 = one per core); same bytes
+template <typename ObjectType>
+std::string serialize_parallel(const std::vector<ObjectType>& objects,
+                               meta::Layout layout = meta::Layout::Pretty,
+                               size_t threads = 0)
+{
+    const bool pretty = layout == meta::Layout::Pretty;
+    if (objects.empty())
+    {
+        return pretty ? "---\n[]\n" : "---\n[]";
+    }
+
+    std::string out = "---\n";
+    if (pretty)
+    {
+        meta::append_parallel(
+            out,
+            objects,
+            [](std::string& buf, const ObjectType& obj, size_t) { append_record(buf, obj); },
+            threads);
+    }
+    else
+    {
+        meta::append_parallel(
+            out,
+            objects,
+            [](std::string& buf, const ObjectType& obj, size_t i)
+            {
+                if (i != 0)
+                    buf += '\n';
+                append_flow_record(buf, obj);
+            },
+            threads);
+    }
+    return out;
 }
 
 // Alternative serialize function with custom document separator and comments
@@ -624,5 +758,1237 @@ template <typename ObjectType> std::string serialize_single(const ObjectType& ob
     return os.str();
 }
 
+// Streaming writer: one "---" document written record by record into a
+// meta::Sink (flushed in blocks), byte-identical to serialize()
+// (Layout::Pretty) or serialize_compact() (Layout::Compact).
+//
+// Usage:
+//   meta::yaml::writer<Row> out(meta::Sink::file("rows.yaml"));
+//   out.write_all(rows);
+//   out.close();
+template <typename ObjectType> class writer
+{
+  public:
+    explicit writer(meta::Sink sink, meta::Layout layout = meta::Layout::Pretty)
+        : sink_(std::move(sink)), layout_(layout)
+    {
+        sink_.buffer() += "---\n";
+    }
+
+    ~writer()
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    writer(const writer&) = delete;
+    writer& operator=(const writer&) = delete;
+
+    void write(const ObjectType& obj)
+    {
+        if (closed_)
+            throw std::logic_error("yaml: write after close");
+        auto& out = sink_.buffer();
+        if (layout_ == meta::Layout::Pretty)
+        {
+            append_record(out, obj);
+        }
+        else
+        {
+            if (count_ != 0)
+                out += '\n';
+            append_flow_record(out, obj);
+        }
+        ++count_;
+        sink_.commit();
+    }
+
+    // Writes every row of a range or generator (rows may be pointers); returns the count
+    template <typename Range> size_t write_all(Range&& rows)
+    {
+        return meta::write_rows(*this, std::forward<Range>(rows));
+    }
+
+    // Writes the empty-list marker if nothing was written, flushes and releases the sink
+    void close()
+    {
+        if (closed_)
+            return;
+        closed_ = true;
+        if (count_ == 0)
+            sink_.buffer() += layout_ == meta::Layout::Pretty ? "[]\n" : "[]";
+        sink_.close();
+    }
+
+    size_t count() const
+    {
+        return count_;
+    }
+
+  private:
+    meta::Sink sink_;
+    meta::Layout layout_;
+    size_t count_ = 0;
+    bool closed_ = false;
+};
+
+// ================================================================
+// Reader
+//
+// meta::yaml::parse<T>(text) fills a T straight from the input text, for
+// the subset serialize(), serialize_compact() and serialize_single() write:
+// block sequences ("- ") and mappings ("key: value") nested by indentation,
+// flow sequences and mappings ([a, b], {k: v}), plain, "double" and
+// 'single' quoted scalars, comments, and a leading "---". No node tree is
+// built: the target type says what each value must be, mapping keys are
+// matched against the MetaTuple<T>::fields names (trying the field after
+// the previous one first, so keys in declaration order cost one compare),
+// and scalars are converted from views into the input (only quoted
+// strings with escapes are decoded, into a reused buffer). Unknown keys
+// are skipped. Anchors, tags, block scalars (| and >) and multi-line plain
+// scalars are not supported.
+//
+// Errors throw meta::yaml::parse_error with the 1-based line and column.
+//
+// parse_each<T> calls back with the records of a top-level sequence one at
+// a time instead of materializing a std::vector<T>.
+//
+// Usage:
+//   auto rows = meta::yaml::parse<std::vector<Row>>(text);
+//   auto config = meta::yaml::parse<Config>(meta::yaml::serialize_single(config));
+//   meta::yaml::parse_each<Row>(text, [](Row&& row) { ... });
+// ================================================================
+
+class parse_error : public std::runtime_error
+{
+  public:
+    parse_error(const std::string& what, size_t line, size_t column)
+        : std::runtime_error("yaml: " + what + " at line " + std::to_string(line) + ", column " +
+                             std::to_string(column)),
+          line_(line),
+          column_(column)
+    {
+    }
+
+    size_t line() const
+    {
+        return line_;
+    }
+
+    size_t column() const
+    {
+        return column_;
+    }
+
+  private:
+    size_t line_;
+    size_t column_;
+};
+
+namespace detail
+{
+
+template <typename T> struct is_optional : std::false_type
+{
+};
+template <typename T> struct is_optional<std::optional<T>> : std::true_type
+{
+};
+
+template <typename T>
+concept Reflected = requires { meta::MetaTuple<T>::fields; };
+
+template <typename T>
+concept MapLike = std::ranges::input_range<T> && requires {
+    typename T::key_type;
+    typename T::mapped_type;
+};
+
+template <typename T>
+concept SequenceLike = std::ranges::input_range<T> && !std::is_convertible_v<const T&, std::string_view> && !MapLike<T>;
+
+template <typename T>
+concept TupleLike = !std::ranges::range<T> && requires { std::tuple_size<T>::value; };
+
+// Ends of a plain scalar: in block context the line end or a " #" comment,
+// in flow context also the flow indicators
+inline constexpr meta::escape::CharSet block_plain_end("\n\r#");
+inline constexpr meta::escape::CharSet flow_plain_end("\n\r#,[]{}:");
+
+} // namespace detail
+
+class Reader
+{
+  public:
+    explicit Reader(std::string_view text)
+        : p_(text.data()), end_(text.data() + text.size()), line_start_(text.data())
+    {
+    }
+
+    // Where the reader is; restored with reset() to look ahead
+    struct Mark
+    {
+        const char* p;
+        const char* lineStart;
+        size_t line;
+    };
+
+    Mark mark() const
+    {
+        return {p_, line_start_, line_};
+    }
+
+    void reset(const Mark& m)
+    {
+        p_ = m.p;
+        line_start_ = m.lineStart;
+        line_ = m.line;
+    }
+
+    bool at_end() const
+    {
+        return p_ == end_;
+    }
+
+    // A "---" or "..." document marker at the current position
+    bool at_marker(std::string_view marker) const
+    {
+        size_t n = marker.size();
+        if (static_cast<size_t>(end_ - p_) < n || std::memcmp(p_, marker.data(), n) != 0)
+            return false;
+        return p_ + n == end_ || p_[n] == ' ' || p_[n] == '\t' || p_[n] == '\n' || p_[n] == '\r';
+    }
+
+    char peek() const
+    {
+        return p_ == end_ ? '\0' : *p_;
+    }
+
+    // 0-based column of the next character
+    int column() const
+    {
+        return static_cast<int>(p_ - line_start_);
+    }
+
+    [[noreturn]] void fail(const std::string& what) const
+    {
+        throw parse_error(what, line_, static_cast<size_t>(column()) + 1);
+    }
+
+    // Reports at the start of a scalar when it is a view into the current line
+    [[noreturn]] void fail_at(std::string_view text, const std::string& what) const
+    {
+        if (std::less_equal<const char*>()(line_start_, text.data()) &&
+            std::less_equal<const char*>()(text.data(), p_))
+            throw parse_error(what, line_, static_cast<size_t>(text.data() - line_start_) + 1);
+        fail(what);
+    }
+
+    void advance(size_t n)
+    {
+        p_ += n;
+    }
+
+    void skip_spaces()
+    {
+        while (p_ != end_ && (*p_ == ' ' || *p_ == '\t'))
+            ++p_;
+    }
+
+    // True when only spaces or a comment are left on the line
+    bool at_line_end()
+    {
+        skip_spaces();
+        return p_ == end_ || *p_ == '\n' || *p_ == '\r' || *p_ == '#';
+    }
+
+    // Moves past the current line to the first character of the next line
+    // with content (blank and comment lines skipped), or to the end
+    void next_content_line()
+    {
+        for (;;)
+        {
+            const void* nl = std::memchr(p_, '\n', static_cast<size_t>(end_ - p_));
+            if (nl == nullptr)
+            {
+                p_ = end_;
+                return;
+            }
+            p_ = static_cast<const char*>(nl) + 1;
+            line_start_ = p_;
+            ++line_;
+            skip_spaces();
+            if (p_ == end_ || (*p_ != '\n' && *p_ != '\r' && *p_ != '#'))
+                return;
+        }
+    }
+
+    // After a value on a block line: nothing but a comment may follow
+    void finish_line()
+    {
+        if (!at_line_end())
+            fail("unexpected text after value");
+        next_content_line();
+    }
+
+    // A block sequence entry: "-" followed by a space or the line end
+    bool at_item() const
+    {
+        if (p_ == end_ || *p_ != '-')
+            return false;
+        if (p_ + 1 == end_)
+            return true;
+        char c = p_[1];
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    // Whether the line holds a "key: ..." entry (looked for up to the line end)
+    bool at_key()
+    {
+        Mark start = mark();
+        bool found = false;
+        if (peek() == '"' || peek() == '\'')
+        {
+            scalar(true);
+            skip_spaces();
+            found = peek() == ':';
+        }
+        else
+        {
+            for (const char* q = p_; q != end_ && *q != '\n' && *q != '\r'; ++q)
+            {
+                if (*q == ':' && (q + 1 == end_ || q[1] == ' ' || q[1] == '\t' || q[1] == '\n' || q[1] == '\r'))
+                {
+                    found = true;
+                    break;
+                }
+                if (*q == '#' && q != p_ && (q[-1] == ' ' || q[-1] == '\t'))
+                    break;
+            }
+        }
+        reset(start);
+        return found;
+    }
+
+    // Inside flow collections, whitespace includes line breaks and comments
+    void skip_flow_space()
+    {
+        for (;;)
+        {
+            skip_spaces();
+            if (p_ == end_)
+                return;
+            if (*p_ == '#' || *p_ == '\r' || *p_ == '\n')
+            {
+                const void* nl = std::memchr(p_, '\n', static_cast<size_t>(end_ - p_));
+                if (nl == nullptr)
+                {
+                    p_ = end_;
+                    return;
+                }
+                p_ = static_cast<const char*>(nl) + 1;
+                line_start_ = p_;
+                ++line_;
+                continue;
+            }
+            return;
+        }
+    }
+
+    bool consume(char c)
+    {
+        if (peek() != c)
+            return false;
+        ++p_;
+        return true;
+    }
+
+    void expect(char c)
+    {
+        if (!consume(c))
+            fail(std::string("expected '") + c + "'");
+    }
+
+    // The next scalar: quoted (decoded; quoted is set) or plain, ending at
+    // the line end or a comment, and in flow context also at , [ ] { } and
+    // ": ". The view points into the input, or into a buffer reused by the
+    // next call when a quoted scalar had escapes.
+    std::string_view scalar(bool flow, bool* quoted = nullptr)
+    {
+        if (quoted != nullptr)
+            *quoted = p_ != end_ && (*p_ == '"' || *p_ == '\'');
+        if (p_ != end_ && *p_ == '"')
+            return double_quoted();
+        if (p_ != end_ && *p_ == '\'')
+            return single_quoted();
+
+        const char* start = p_;
+        const auto& ends = flow ? detail::flow_plain_end : detail::block_plain_end;
+        for (;;)
+        {
+            p_ += meta::escape::find_first(std::string_view(p_, static_cast<size_t>(end_ - p_)), ends);
+            if (p_ == end_ || *p_ == '\n' || *p_ == '\r')
+                break;
+            // '#' starts a comment only after whitespace, ':' ends a key only before it
+            if (*p_ == '#' && p_ != start && (p_[-1] == ' ' || p_[-1] == '\t'))
+                break;
+            if (*p_ == ':' && p_ + 1 != end_ && p_[1] != ' ' && p_[1] != '\t' && p_[1] != '\n' &&
+                p_[1] != '\r' && p_[1] != ',' && p_[1] != ']' && p_[1] != '}')
+            {
+                ++p_;
+                continue;
+            }
+            if (*p_ != '#')
+                break;
+            ++p_;
+        }
+        const char* stop = p_;
+        while (stop != start && (stop[-1] == ' ' || stop[-1] == '\t'))
+            --stop;
+        return std::string_view(start, static_cast<size_t>(stop - start));
+    }
+
+    // A mapping key up to its ':' (consumed, with the spaces after it)
+    std::string_view key(bool flow)
+    {
+        if (p_ != end_ && (*p_ == '"' || *p_ == '\''))
+        {
+            std::string_view k = scalar(flow);
+            if (k.data() == scratch_.data())
+            {
+                // keep the decoded key: the value's scalar reuses scratch_
+                key_scratch_.assign(k);
+                k = key_scratch_;
+            }
+            skip_spaces();
+            expect(':');
+            skip_spaces();
+            return k;
+        }
+        const char* start = p_;
+        for (;;)
+        {
+            if (p_ == end_ || *p_ == '\n' || *p_ == '\r' || (flow && (*p_ == ',' || *p_ == '}')))
+                fail("expected ':' after key");
+            if (*p_ == ':' && (p_ + 1 == end_ || p_[1] == ' ' || p_[1] == '\t' || p_[1] == '\n' ||
+                               p_[1] == '\r' || (flow && (p_[1] == ',' || p_[1] == '}'))))
+                break;
+            ++p_;
+        }
+        const char* stop = p_;
+        while (stop != start && (stop[-1] == ' ' || stop[-1] == '\t'))
+            --stop;
+        ++p_;
+        skip_spaces();
+        return std::string_view(start, static_cast<size_t>(stop - start));
+    }
+
+  private:
+    std::string_view double_quoted()
+    {
+        const char* start = ++p_;
+        bool escaped = false;
+        while (p_ != end_ && *p_ != '"')
+        {
+            if (*p_ == '\n')
+                fail("unterminated string");
+            if (*p_ == '\\')
+            {
+                escaped = true;
+                if (++p_ == end_)
+                    break;
+            }
+            ++p_;
+        }
+        if (p_ == end_)
+            fail("unterminated string");
+        std::string_view raw(start, static_cast<size_t>(p_++ - start));
+        if (!escaped)
+            return raw;
+
+        scratch_.clear();
+        for (size_t i = 0; i < raw.size(); ++i)
+        {
+            char c = raw[i];
+            if (c != '\\')
+            {
+                scratch_ += c;
+                continue;
+            }
+            switch (raw[++i])
+            {
+            case 'n':
+                scratch_ += '\n';
+                break;
+            case 't':
+                scratch_ += '\t';
+                break;
+            case 'r':
+                scratch_ += '\r';
+                break;
+            case 'b':
+                scratch_ += '\b';
+                break;
+            case 'f':
+                scratch_ += '\f';
+                break;
+            case '0':
+                scratch_ += '\0';
+                break;
+            case 'x':
+            case 'u':
+            case 'U':
+            {
+                size_t digits = raw[i] == 'x' ? 2 : raw[i] == 'u' ? 4 : 8;
+                uint32_t code = 0;
+                if (i + digits >= raw.size() ||
+                    std::from_chars(raw.data() + i + 1, raw.data() + i + 1 + digits, code, 16).ptr !=
+                        raw.data() + i + 1 + digits)
+                    fail("bad escape in string");
+                i += digits;
+                append_utf8(code);
+                break;
+            }
+            default: // '"', '\\', '/', ' ' and other characters escaped as themselves
+                scratch_ += raw[i];
+                break;
+            }
+        }
+        return scratch_;
+    }
+
+    std::string_view single_quoted()
+    {
+        const char* start = ++p_;
+        bool doubled = false;
+        for (;;)
+        {
+            if (p_ == end_ || *p_ == '\n')
+                fail("unterminated string");
+            if (*p_ == '\'')
+            {
+                if (p_ + 1 != end_ && p_[1] == '\'')
+                {
+                    doubled = true;
+                    p_ += 2;
+                    continue;
+                }
+                break;
+            }
+            ++p_;
+        }
+        std::string_view raw(start, static_cast<size_t>(p_++ - start));
+        if (!doubled)
+            return raw;
+        scratch_.clear();
+        for (size_t i = 0; i < raw.size(); ++i)
+        {
+            scratch_ += raw[i];
+            if (raw[i] == '\'')
+                ++i;
+        }
+        return scratch_;
+    }
+
+    void append_utf8(uint32_t code)
+    {
+        if (code < 0x80)
+            scratch_ += static_cast<char>(code);
+        else if (code < 0x800)
+        {
+            scratch_ += static_cast<char>(0xC0 | (code >> 6));
+            scratch_ += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else if (code < 0x10000)
+        {
+            scratch_ += static_cast<char>(0xE0 | (code >> 12));
+            scratch_ += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            scratch_ += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else
+        {
+            scratch_ += static_cast<char>(0xF0 | (code >> 18));
+            scratch_ += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            scratch_ += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            scratch_ += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    const char* p_;
+    const char* end_;
+    const char* line_start_;
+    size_t line_ = 1;
+    std::string scratch_;
+    std::string key_scratch_;
+};
+
+// Block values start after "key:" or "- " (parse_node) or at the start of a
+// line (parse_block) and leave the reader at the next line with content;
+// flow values (parse_flow) stay on the characters they consumed.
+template <typename T> void parse_node(Reader& reader, T& value, int parent, bool item);
+template <typename T> void parse_block(Reader& reader, T& value, int indent);
+template <typename T> void parse_flow(Reader& reader, T& value);
+
+namespace detail
+{
+
+// Field name as written by serialize() (memberName on FieldMeta, fieldName on meta::Field)
+template <typename FieldMeta> std::string_view field_name(const FieldMeta& fieldMeta)
+{
+    if constexpr (requires { fieldMeta.memberName; })
+        return fieldMeta.memberName;
+    else
+        return fieldMeta.fieldName;
+}
+
+// Mapping keys to fields of a reflected type: the shared perfect-hash
+// FieldNameIndex, plus a setter per field
+template <typename ObjectType> class FieldTable
+{
+  public:
+    static constexpr size_t count = std::tuple_size_v<std::remove_cvref_t<decltype(meta::MetaTuple<ObjectType>::fields)>>;
+    using Setter = void (*)(Reader&, ObjectType&, int);
+
+    static const FieldTable& get()
+    {
+        static const FieldTable table;
+        return table;
+    }
+
+    // Index of the field named key, or count; hint is tried first
+    size_t find(std::string_view key, size_t hint) const
+    {
+        return index_.find(key, hint);
+    }
+
+    void set(size_t field, Reader& reader, ObjectType& obj, int indent) const
+    {
+        setters_[field](reader, obj, indent);
+    }
+
+  private:
+    static std::array<std::string_view, count> names()
+    {
+        std::array<std::string_view, count> result{};
+        std::apply(
+            [&](const auto&... fieldMeta)
+            {
+                size_t i = 0;
+                ((result[i++] = field_name(fieldMeta)), ...);
+            },
+            meta::MetaTuple<ObjectType>::fields);
+        return result;
+    }
+
+    FieldTable() : index_(names(), "meta::yaml")
+    {
+        std::apply(
+            [&](const auto&... fieldMeta)
+            {
+                size_t i = 0;
+                ((setters_[i++] = make_setter<std::remove_cvref_t<decltype(fieldMeta)>>()), ...);
+            },
+            meta::MetaTuple<ObjectType>::fields);
+    }
+
+    template <typename FieldMeta> static Setter make_setter();
+
+    meta::detail::FieldNameIndex<count> index_;
+    std::array<Setter, count> setters_{};
+};
+
+// Skips a flow value of any shape (an unknown key's)
+inline void skip_flow_value(Reader& reader)
+{
+    reader.skip_flow_space();
+    char c = reader.peek();
+    if (c != '[' && c != '{')
+    {
+        reader.scalar(true);
+        return;
+    }
+    int depth = 0;
+    do
+    {
+        reader.skip_flow_space();
+        c = reader.peek();
+        if (c == '\0')
+            reader.fail("unterminated flow collection");
+        if (c == '"' || c == '\'')
+            reader.scalar(true);
+        else
+        {
+            depth += c == '[' || c == '{' ? 1 : c == ']' || c == '}' ? -1 : 0;
+            reader.advance(1);
+        }
+    } while (depth > 0);
+}
+
+// Skips the block value of an unknown key: the rest of the line (a flow
+// collection may go on over more lines), then everything nested under it
+inline void skip_node(Reader& reader, int parent)
+{
+    if (!reader.at_line_end() && (reader.peek() == '[' || reader.peek() == '{'))
+        skip_flow_value(reader);
+    reader.next_content_line();
+    while (!reader.at_end() && (reader.column() > parent || (reader.column() == parent && reader.at_item())))
+        reader.next_content_line();
+}
+
+template <typename FieldMeta, typename ObjectType>
+void set_field(Reader& reader, ObjectType& obj, int indent)
+{
+    if constexpr (FieldMeta::memberPtr != nullptr)
+        parse_node(reader, obj.*(FieldMeta::memberPtr), indent, false);
+    else
+        skip_node(reader, indent);
+}
+
+template <typename ObjectType>
+template <typename FieldMeta>
+typename FieldTable<ObjectType>::Setter FieldTable<ObjectType>::make_setter()
+{
+    return &set_field<FieldMeta, ObjectType>;
+}
+
+// Converts a scalar to value
+template <typename T> void assign_scalar(Reader& reader, T& value, std::string_view text, bool quoted)
+{
+    // no mapping in format_yaml_value (the writer emits "unknown_type:..."): leave the member as is
+    if (!quoted && text.starts_with("unknown_type:"))
+        return;
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        if (!quoted && is_null(text))
+            value.clear();
+        else
+            value.assign(text.data(), text.size());
+    }
+    else if constexpr (std::is_same_v<T, bool>)
+    {
+        if (text == "true" || text == "True" || text == "TRUE" || text == "yes" || text == "on")
+            value = true;
+        else if (text == "false" || text == "False" || text == "FALSE" || text == "no" || text == "off")
+            value = false;
+        else
+            reader.fail_at(text, "expected true or false");
+    }
+    else if constexpr (std::is_same_v<T, char>)
+    {
+        if (text.size() > 1)
+            reader.fail_at(text, "expected a single character");
+        value = text.empty() ? '\0' : text[0];
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        std::underlying_type_t<T> raw{};
+        assign_scalar(reader, raw, text, quoted);
+        value = static_cast<T>(raw);
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        if (!text.empty() && text[0] == '+')
+            text.remove_prefix(1);
+        if (text == ".inf" || text == ".Inf" || text == ".INF")
+            value = std::numeric_limits<T>::infinity();
+        else if (text == "-.inf" || text == "-.Inf" || text == "-.INF")
+            value = -std::numeric_limits<T>::infinity();
+        else if (text == ".nan" || text == ".NaN" || text == ".NAN")
+            value = std::numeric_limits<T>::quiet_NaN();
+        else
+        {
+            auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (ec != std::errc() || end != text.data() + text.size() || text.empty())
+                reader.fail_at(text, "expected a number, found '" + std::string(text) + "'");
+        }
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        if (!text.empty() && text[0] == '+')
+            text.remove_prefix(1);
+        auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec == std::errc::result_out_of_range)
+            reader.fail_at(text, "integer out of range");
+        if (ec != std::errc() || end != text.data() + text.size() || text.empty())
+            reader.fail_at(text, "expected an integer, found '" + std::string(text) + "'");
+    }
+    else if constexpr (is_optional<T>::value)
+    {
+        if (!quoted && is_null(text))
+            value.reset();
+        else
+            assign_scalar(reader, value.emplace(), text, quoted);
+    }
+    else if constexpr (Reflected<T> || MapLike<T>)
+    {
+        // an empty value ("key:" with nothing nested) or null
+        if (!quoted && (text.empty() || is_null(text)))
+        {
+            if constexpr (MapLike<T>)
+                value.clear();
+        }
+        else
+            reader.fail_at(text, "expected a mapping");
+    }
+    else if constexpr (SequenceLike<T> || TupleLike<T>)
+    {
+        if (!quoted && (text.empty() || is_null(text)))
+        {
+            if constexpr (requires { value.clear(); })
+                value.clear();
+        }
+        else
+            reader.fail_at(text, "expected a sequence");
+    }
+    else
+        static_assert(!sizeof(T), "meta::yaml: no mapping for this type");
+}
+
+template <typename T> void clear_sequence(T& value)
+{
+    if constexpr (requires { value.clear(); })
+        value.clear();
+}
+
+// Parses element i of a sequence; returns false when the target is full
+template <typename T> bool parse_element(Reader& reader, T& value, size_t i, int indent, bool flow)
+{
+    auto parse_one = [&](auto& element)
+    {
+        if (flow)
+            parse_flow(reader, element);
+        else
+            parse_node(reader, element, indent, true);
+    };
+    if constexpr (TupleLike<T>)
+    {
+        bool stored = false;
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            using std::get;
+            ((i == I ? (parse_one(get<I>(value)), stored = true) : false), ...);
+        }(std::make_index_sequence<std::tuple_size_v<T>>{});
+        return stored;
+    }
+    else if constexpr (requires { std::tuple_size<T>::value; })
+    {
+        // std::array
+        if (i >= std::tuple_size_v<T>)
+            return false;
+        parse_one(value[i]);
+        return true;
+    }
+    else
+    {
+        using Item = std::ranges::range_value_t<T>;
+        if constexpr (requires {
+                          { value.emplace_back() } -> std::same_as<Item&>;
+                      })
+            parse_one(value.emplace_back());
+        else
+        {
+            // vector<bool> (proxy elements) and sets
+            Item item{};
+            parse_one(item);
+            if constexpr (requires { value.push_back(std::move(item)); })
+                value.push_back(std::move(item));
+            else
+                value.insert(std::move(item));
+        }
+        return true;
+    }
+}
+
+template <typename T> void check_tuple_size(Reader& reader, size_t n)
+{
+    if constexpr (TupleLike<T>)
+    {
+        if (n != std::tuple_size_v<T>)
+            reader.fail("expected " + std::to_string(std::tuple_size_v<T>) + " elements");
+    }
+}
+
+template <typename T> void flow_field(Reader& reader, T& obj, size_t field);
+
+// Stores a mapping entry whose key was read; the value follows
+template <typename T> void parse_entry(Reader& reader, T& value, std::string_view key, size_t& hint, int indent, bool flow)
+{
+    if constexpr (Reflected<T>)
+    {
+        const auto& table = FieldTable<T>::get();
+        size_t field = table.find(key, hint);
+        if (field == FieldTable<T>::count)
+        {
+            if (flow)
+                skip_flow_value(reader);
+            else
+                skip_node(reader, indent);
+            return;
+        }
+        hint = field + 1;
+        if (flow)
+            flow_field(reader, value, field);
+        else
+            table.set(field, reader, value, indent);
+    }
+    else
+    {
+        typename T::key_type k{};
+        assign_scalar(reader, k, key, false);
+        typename T::mapped_type item{};
+        if (flow)
+            parse_flow(reader, item);
+        else
+            parse_node(reader, item, indent, false);
+        value.insert_or_assign(std::move(k), std::move(item));
+    }
+}
+
+} // namespace detail
+
+template <typename T> void parse_flow(Reader& reader, T& value)
+{
+    reader.skip_flow_space();
+    char c = reader.peek();
+    if constexpr (detail::is_optional<T>::value)
+    {
+        auto m = reader.mark();
+        bool quoted = false;
+        std::string_view text = c == '[' || c == '{' ? std::string_view("[") : reader.scalar(true, &quoted);
+        if (!quoted && detail::is_null(text))
+        {
+            value.reset();
+            return;
+        }
+        reader.reset(m);
+        parse_flow(reader, value.emplace());
+    }
+    else if constexpr (detail::SequenceLike<T> || detail::TupleLike<T>)
+    {
+        if (c != '[')
+        {
+            bool quoted = false;
+            detail::assign_scalar(reader, value, reader.scalar(true, &quoted), quoted);
+            return;
+        }
+        reader.advance(1);
+        detail::clear_sequence(value);
+        size_t n = 0;
+        reader.skip_flow_space();
+        if (!reader.consume(']'))
+        {
+            do
+            {
+                reader.skip_flow_space();
+                if (reader.peek() == ']')
+                    break; // trailing comma
+                if (!detail::parse_element(reader, value, n++, 0, true))
+                    reader.fail("too many elements");
+                reader.skip_flow_space();
+            } while (reader.consume(','));
+            reader.skip_flow_space();
+            reader.expect(']');
+        }
+        detail::check_tuple_size<T>(reader, n);
+    }
+    else if constexpr (detail::Reflected<T> || detail::MapLike<T>)
+    {
+        if (c != '{')
+        {
+            bool quoted = false;
+            detail::assign_scalar(reader, value, reader.scalar(true, &quoted), quoted);
+            return;
+        }
+        reader.advance(1);
+        if constexpr (detail::MapLike<T>)
+            value.clear();
+        size_t hint = 0;
+        reader.skip_flow_space();
+        if (!reader.consume('}'))
+        {
+            do
+            {
+                reader.skip_flow_space();
+                if (reader.peek() == '}')
+                    break;
+                std::string_view key = reader.key(true);
+                detail::parse_entry(reader, value, key, hint, 0, true);
+                reader.skip_flow_space();
+            } while (reader.consume(','));
+            reader.skip_flow_space();
+            reader.expect('}');
+        }
+    }
+    else
+    {
+        if (c == '[' || c == '{')
+            reader.fail("expected a scalar");
+        bool quoted = false;
+        std::string_view text = reader.scalar(true, &quoted);
+        detail::assign_scalar(reader, value, text, quoted);
+    }
+}
+
+namespace detail
+{
+
+template <typename T> void flow_field(Reader& reader, T& obj, size_t field)
+{
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (
+            [&]
+            {
+                using FieldMeta = std::remove_cvref_t<std::tuple_element_t<I, std::remove_cvref_t<decltype(meta::MetaTuple<T>::fields)>>>;
+                if (field != I)
+                    return;
+                if constexpr (FieldMeta::memberPtr != nullptr)
+                    parse_flow(reader, obj.*(FieldMeta::memberPtr));
+                else
+                    skip_flow_value(reader);
+            }(),
+            ...);
+    }(std::make_index_sequence<FieldTable<T>::count>{});
+}
+
+template <typename T> void parse_block_sequence(Reader& reader, T& value, int indent)
+{
+    clear_sequence(value);
+    size_t n = 0;
+    while (!reader.at_end() && reader.column() == indent && reader.at_item())
+    {
+        reader.advance(1);
+        if (!parse_element(reader, value, n++, indent, false))
+            reader.fail("too many elements");
+    }
+    if (!reader.at_end() && reader.column() > indent)
+        reader.fail("bad indentation");
+    check_tuple_size<T>(reader, n);
+}
+
+template <typename T> void parse_block_mapping(Reader& reader, T& value, int indent)
+{
+    if constexpr (MapLike<T>)
+        value.clear();
+    size_t hint = 0;
+    // a column-0 "..." ends the document (end_document checks it)
+    while (!reader.at_end() && reader.column() == indent && !reader.at_item() &&
+           !(reader.column() == 0 && reader.at_marker("...")))
+    {
+        std::string_view key = reader.key(false);
+        parse_entry(reader, value, key, hint, indent, false);
+    }
+    if (!reader.at_end() && reader.column() > indent)
+        reader.fail("bad indentation");
+}
+
+} // namespace detail
+
+// A value whose content starts at the current position, at the start of a
+// line or after "- " (where a nested "key: value" or "- " may begin)
+template <typename T> void parse_block(Reader& reader, T& value, int indent)
+{
+    char c = reader.peek();
+    if constexpr (detail::is_optional<T>::value)
+    {
+        auto m = reader.mark();
+        bool quoted = false;
+        std::string_view text = c == '[' || c == '{' || reader.at_item() ? std::string_view("[")
+                                                                          : reader.scalar(false, &quoted);
+        if (!quoted && detail::is_null(text) && reader.at_line_end())
+        {
+            value.reset();
+            reader.next_content_line();
+            return;
+        }
+        reader.reset(m);
+        parse_block(reader, value.emplace(), indent);
+    }
+    else
+    {
+        if (c == '[' || c == '{')
+        {
+            parse_flow(reader, value);
+            reader.finish_line();
+        }
+        else if constexpr (detail::SequenceLike<T> || detail::TupleLike<T>)
+        {
+            if (reader.at_item())
+                detail::parse_block_sequence(reader, value, indent);
+            else
+            {
+                bool quoted = false;
+                std::string_view text = reader.scalar(false, &quoted);
+                detail::assign_scalar(reader, value, text, quoted);
+                reader.finish_line();
+            }
+        }
+        else if constexpr (detail::Reflected<T> || detail::MapLike<T>)
+        {
+            if (reader.at_key())
+                detail::parse_block_mapping(reader, value, indent);
+            else
+            {
+                bool quoted = false;
+                std::string_view text = reader.scalar(false, &quoted);
+                detail::assign_scalar(reader, value, text, quoted);
+                reader.finish_line();
+            }
+        }
+        else
+        {
+            if (reader.at_item())
+                reader.fail("expected a scalar, found a sequence");
+            bool quoted = false;
+            std::string_view text = reader.scalar(false, &quoted);
+            detail::assign_scalar(reader, value, text, quoted);
+            reader.finish_line();
+        }
+    }
+}
+
+// The value after "key:" (item false) or "- " (item true); parent is the
+// column of the key or the dash
+template <typename T> void parse_node(Reader& reader, T& value, int parent, bool item)
+{
+    if (!reader.at_line_end())
+    {
+        if (item)
+        {
+            // "- key: value" and "- - x" open a collection on the dash's line
+            parse_block(reader, value, reader.column());
+            return;
+        }
+        char c = reader.peek();
+        if (c == '[' || c == '{')
+            parse_flow(reader, value);
+        else
+        {
+            bool quoted = false;
+            std::string_view text = reader.scalar(false, &quoted);
+            detail::assign_scalar(reader, value, text, quoted);
+        }
+        reader.finish_line();
+        return;
+    }
+
+    // the value is on the lines below, or empty
+    auto m = reader.mark();
+    reader.next_content_line();
+    if (!reader.at_end() &&
+        (reader.column() > parent || (!item && reader.column() == parent && reader.at_item())))
+    {
+        parse_block(reader, value, reader.column());
+        return;
+    }
+    auto next = reader.mark();
+    reader.reset(m);
+    detail::assign_scalar(reader, value, std::string_view(), false);
+    reader.reset(next);
+}
+
+namespace detail
+{
+
+// Moves past blank and comment lines before the document
+inline void begin_document(Reader& reader)
+{
+    if (reader.at_line_end())
+        reader.next_content_line();
+}
+
+inline void end_document(Reader& reader)
+{
+    if (!reader.at_end() && !(reader.column() == 0 && reader.at_marker("...")))
+        reader.fail("unexpected content after the document");
+}
+
+} // namespace detail
+
+// Fills out from a YAML document
+template <typename T> void parse(std::string_view yaml, T& out)
+{
+    Reader reader(yaml);
+    detail::begin_document(reader);
+    if (reader.column() == 0 && reader.at_marker("---"))
+    {
+        reader.advance(3);
+        parse_node(reader, out, -1, false);
+    }
+    else if (!reader.at_end())
+        parse_block(reader, out, reader.column());
+    else
+        detail::assign_scalar(reader, out, std::string_view(), false);
+    detail::end_document(reader);
+}
+
+template <typename T> T parse(std::string_view yaml)
+{
+    T out{};
+    parse(yaml, out);
+    return out;
+}
+
+// Calls fn(T&&) for every record of a top-level block or flow sequence
+// (serialize() or serialize_compact() output); returns the count
+template <typename T, typename Fn> size_t parse_each(std::string_view yaml, Fn&& fn)
+{
+    Reader reader(yaml);
+    detail::begin_document(reader);
+    if (reader.column() == 0 && reader.at_marker("---"))
+    {
+        reader.advance(3);
+        if (reader.at_line_end())
+            reader.next_content_line();
+    }
+
+    size_t count = 0;
+    if (reader.peek() == '[')
+    {
+        reader.advance(1);
+        reader.skip_flow_space();
+        if (!reader.consume(']'))
+        {
+            do
+            {
+                reader.skip_flow_space();
+                if (reader.peek() == ']')
+                    break;
+                T item{};
+                parse_flow(reader, item);
+                fn(std::move(item));
+                ++count;
+                reader.skip_flow_space();
+            } while (reader.consume(','));
+            reader.skip_flow_space();
+            reader.expect(']');
+        }
+        reader.finish_line();
+    }
+    else if (!reader.at_end())
+    {
+        const int indent = reader.column();
+        if (!reader.at_item())
+            reader.fail("expected a sequence");
+        while (!reader.at_end() && reader.column() == indent && reader.at_item())
+        {
+            reader.advance(1);
+            T item{};
+            parse_node(reader, item, indent, true);
+            fn(std::move(item));
+            ++count;
+        }
+        if (!reader.at_end() && reader.column() > indent)
+            reader.fail("bad indentation");
+    }
+    detail::end_document(reader);
+    return count;
+}
+
 } // namespace yaml
 } // namespace meta
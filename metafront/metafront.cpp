@@ -65,6 +65,7 @@ Apache License 2.0
 #include <cctype>
 #include <clang-c/Index.h>
 #include <iostream>
+#include <map>
 #include <optional>
 #include <regex>
 #include <string>
@@ -81,6 +82,9 @@ Apache License 2.0
 // Global verbose flag
 bool g_verbose = false;
 
+// Emit meta::StaticField (compile-time names and attributes) instead of meta::field
+bool g_staticFields = false;
+
 #define DEBUG(...) do { if (g_verbose) { std::cerr << __VA_ARGS__; } } while(0)
 
 // -------------------------
@@ -161,6 +165,9 @@ int main(int argc, char** argv)
     
     app.add_flag("-v,--verbose", verbose, "Show debug output (AST walking details)");
     
+    app.add_flag("--static-fields", g_staticFields,
+                 "Emit meta::StaticField (constexpr names and attributes) instead of meta::field");
+    
     CLI11_PARSE(app, argc, argv);
     
     // Set global verbose flag for use in other functions
@@ -800,6 +807,56 @@ void generateNestedMetaTuples(const std::vector<FieldInfo>& fields,
                               const std::string& parentShortName,
                               const std::string& parentTypeRef);
 
+// C++ string literal body for value
+std::string escapeLiteral(const std::string& value)
+{
+    std::string out;
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+// meta::StaticField<&Owner::name, "name", "type", props, meta::Attr{...}...>{}
+// Flags naming a meta::Prop go into the props; "Prefix:Value" annotations
+// become attributes keyed like the runtime Field ones (CsvColumn -> csv_column).
+// Getter/Setter flags only set the Prop bits: no accessor is emitted, so the
+// field's getterPtr/setterPtr stay null and reads and writes use the member.
+void emitStaticField(const std::string& owner, const FieldInfo& field)
+{
+    static const std::vector<std::string> propFlags = {
+        "PrimaryKey", "Setter", "Getter", "Serializable", "Hashable", "Private"};
+    static const std::map<std::string, std::string> attributeKeys = {
+        {"CsvColumn", "csv_column"}, {"SqlColumn", "sql_column"}, {"ProtoType", "proto_type"}};
+
+    std::string props;
+    std::string attributes;
+    for (const auto& ann : field.annotations)
+    {
+        size_t colon_pos = ann.find(':');
+        if (colon_pos == std::string::npos)
+        {
+            if (std::find(propFlags.begin(), propFlags.end(), ann) != propFlags.end())
+                props += (props.empty() ? "" : " | ") + std::string("meta::Prop::") + ann;
+            else
+                attributes += ", meta::Attr{\"flag\", \"" + escapeLiteral(ann) + "\"}";
+            continue;
+        }
+
+        std::string prefix = ann.substr(0, colon_pos);
+        auto key = attributeKeys.find(prefix);
+        attributes += ", meta::Attr{\"" + (key != attributeKeys.end() ? key->second : prefix) +
+                      "\", \"" + escapeLiteral(ann.substr(colon_pos + 1)) + "\"}";
+    }
+
+    std::cout << "    meta::StaticField<&" << owner << "::" << field.name << ", \"" << field.name
+              << "\", \"" << escapeLiteral(field.type) << "\", "
+              << (props.empty() ? "meta::Prop::None" : props) << attributes << ">{}";
+}
+
 void generateTuples(std::vector<FieldInfo> fields, std::string shortName, std::string ns, std::string qname, std::string tablename, const std::string& parentDecltype)
 {
     DEBUG("// generateTuples: " << shortName << " (" << fields.size() << " fields)\n");
@@ -831,7 +888,8 @@ void generateTuples(std::vector<FieldInfo> fields, std::string shortName, std::s
     std::cout << "namespace meta\n{\n";
     std::cout << "namespace " << shortName << "\n{\n";
     
-    std::cout << "inline const auto FieldsMeta = std::make_tuple(\n";
+    std::cout << (g_staticFields ? "inline constexpr auto" : "inline const auto")
+              << " FieldsMeta = std::make_tuple(\n";
 
     // Output each Field with typed annotations
     bool firstField = true;
@@ -855,6 +913,12 @@ void generateTuples(std::vector<FieldInfo> fields, std::string shortName, std::s
             DEBUG("//     Annotation: " << ann << "\n");
         }
         
+        if (g_staticFields)
+        {
+            emitStaticField(typePrefix, fields[i]);
+            continue;
+        }
+
         std::cout << "    meta::field<&" << typePrefix << "::" << fields[i].name << ">";
         std::cout << "(\"" << fields[i].name << "\"";
         
@@ -981,7 +1045,8 @@ void generateNestedTuples(const std::vector<FieldInfo>& fields,
             // Generate namespace for this anonymous struct field
             std::cout << "namespace " << field.name << "\n{\n";
             
-            std::cout << "inline const auto FieldsMeta = std::make_tuple(\n";
+            std::cout << (g_staticFields ? "inline constexpr auto" : "inline const auto")
+                      << " FieldsMeta = std::make_tuple(\n";
             
             // Generate fields for the nested struct
             bool firstNestedField = true;
@@ -1005,8 +1070,11 @@ void generateNestedTuples(const std::vector<FieldInfo>& fields,
                     currentDecltype = "decltype(" + parentDecltype + "::" + field.name + ")";
                 }
                 
-                std::cout << "    meta::field<&" << currentDecltype << "::" << nestedField.name << ">"
-                         << "(\"" << nestedField.name << "\")";
+                if (g_staticFields)
+                    emitStaticField(currentDecltype, nestedField);
+                else
+                    std::cout << "    meta::field<&" << currentDecltype << "::" << nestedField.name << ">"
+                             << "(\"" << nestedField.name << "\")";
             }
             std::cout << ");\n";
             
@@ -0,0 +1,429 @@
+// prag_bench.cpp - throughput and allocation benchmarks for every parser and walker
+//
+// Benchmarks registered at startup:
+//   parse/<ext>/<input>           parser only, over tests/*/inputs and synthetic schemas
+//   walk/<walker>/<input>         walker only; the AST is rebuilt outside the timed region
+//                                 (walk/<walker>/<input>/j<N> per --jobs count)
+//   pair/<ext>-><walker>/<input>  end-to-end parse + walk for every parser x walker pair
+//
+// Throughput is reported as bytes_per_second of schema source; "allocs" and
+// "alloc_bytes" are per-iteration operator new counts from alloc_hook.cpp, which
+// prag_bench always links. Pairs that crash or throw on a probe run are skipped.
+//
+// Extra flags (everything else goes to Google Benchmark):
+//   --corpus=<dir>         root containing */inputs (default: prag/tests)
+//   --synthetic=N,D,F      add a synthetic schema: N messages, reference depth D,
+//                          F scalar fields per message (repeatable)
+//   --no-pairs             skip the parser x walker matrix
+//   --jobs=N[,N...]        run the walk benchmarks with AstWalker::jobs = N (scaling
+//                          of the parallel root-node walk; 0 = all cores)
+//
+// JSON results: prag_bench --benchmark_out=results.json --benchmark_out_format=json
+// (or the bench_json target).
+#include <benchmark/benchmark.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ast.h"
+#include "parser_registry.h"
+#include "profile.h"
+#include "walker_registry.h"
+
+#ifndef PRAG_CORPUS_DIR
+#define PRAG_CORPUS_DIR "tests"
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+struct Input
+{
+    std::string name;
+    std::string ext; // parser extension
+    std::string source;
+};
+
+struct SyntheticSize
+{
+    size_t messages;
+    size_t depth;
+    size_t fields;
+};
+
+// Proto3 schema with `messages` top-level messages. Each message owns a chain of
+// `depth` referenced messages so the walkers see cross-type references without
+// nested definitions.
+std::string syntheticProto(const SyntheticSize& size)
+{
+    static const char* scalars[] = {
+        "int32", "int64", "string", "bool", "double", "float", "uint32", "bytes"};
+
+    std::ostringstream out;
+    out << "syntax = \"proto3\";\n\npackage synthetic;\n\n";
+    out << "enum Kind {\n  KIND_UNKNOWN = 0;\n  KIND_PRIMARY = 1;\n  KIND_SECONDARY = 2;\n}\n\n";
+
+    for (size_t m = 0; m < size.messages; ++m)
+    {
+        for (size_t d = 0; d <= size.depth; ++d)
+        {
+            std::string name = "Message" + std::to_string(m);
+            if (d != 0)
+                name += "Level" + std::to_string(d);
+
+            int tag = 1;
+            out << "message " << name << " {\n";
+            for (size_t f = 0; f < size.fields; ++f)
+                out << "  " << scalars[f % std::size(scalars)] << " field_" << f << " = " << tag++
+                    << ";\n";
+            out << "  Kind kind = " << tag++ << ";\n";
+            out << "  repeated string tags = " << tag++ << ";\n";
+            out << "  map<string, int64> counters = " << tag++ << ";\n";
+            if (d < size.depth)
+                out << "  Message" << m << "Level" << d + 1 << " child = " << tag++ << ";\n";
+            out << "}\n\n";
+        }
+    }
+    return out.str();
+}
+
+std::string syntheticName(const SyntheticSize& size)
+{
+    return "synthetic_n" + std::to_string(size.messages) + "_d" + std::to_string(size.depth) +
+           "_f" + std::to_string(size.fields);
+}
+
+std::vector<Input> loadCorpus(const fs::path& root)
+{
+    std::vector<Input> inputs;
+    if (!fs::is_directory(root))
+        return inputs;
+
+    const auto& parsers = bhw::ParserRegistry::getParserRegistry();
+    for (const auto& dir : fs::directory_iterator(root))
+    {
+        fs::path in = dir.path() / "inputs";
+        if (!fs::is_directory(in))
+            continue;
+        for (const auto& entry : fs::recursive_directory_iterator(in))
+        {
+            if (!entry.is_regular_file())
+                continue;
+            std::string ext = entry.path().extension().string();
+            if (ext.size() < 2 || !parsers.has(ext.substr(1)))
+                continue;
+            inputs.push_back({fs::relative(entry.path(), root).generic_string(),
+                              ext.substr(1),
+                              bhw::readFile(entry.path().string())});
+        }
+    }
+    return inputs;
+}
+
+// Parsers and walkers chat on stdout/stderr; keep that out of the reporter output.
+class QuietStreams
+{
+  public:
+    QuietStreams() : out_(std::cout.rdbuf(&sink_)), err_(std::cerr.rdbuf(&sink_))
+    {
+    }
+    ~QuietStreams()
+    {
+        std::cout.rdbuf(out_);
+        std::cerr.rdbuf(err_);
+    }
+    QuietStreams(const QuietStreams&) = delete;
+    QuietStreams& operator=(const QuietStreams&) = delete;
+
+  private:
+    struct NullBuf : std::streambuf
+    {
+        int overflow(int c) override
+        {
+            return c;
+        }
+    };
+    NullBuf sink_;
+    std::streambuf* out_;
+    std::streambuf* err_;
+};
+
+// Run fn once in a child process; false if it throws or dies. Several
+// parser/walker combinations still segfault on some inputs, and one bad pair
+// must not take the whole suite down.
+bool probe(const std::function<void()>& fn)
+{
+    std::cout.flush();
+    std::cerr.flush();
+    pid_t pid = fork();
+    if (pid < 0)
+        return false;
+    if (pid == 0)
+    {
+        std::freopen("/dev/null", "w", stdout);
+        std::freopen("/dev/null", "w", stderr);
+        try
+        {
+            fn();
+        }
+        catch (...)
+        {
+            _exit(1);
+        }
+        _exit(0);
+    }
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid)
+        return false;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+bhw::Ast parseInput(const Input& input)
+{
+    auto parser = bhw::ParserRegistry::getParserRegistry().create(input.ext);
+    if (!parser)
+        throw std::runtime_error("no parser for ." + input.ext);
+    return parser.value()->parse(input.source);
+}
+
+std::string walkAst(const std::string& walker, bhw::Ast&& ast)
+{
+    auto w = bhw::WalkerRegistry::getWalkerRegistry().create(walker);
+    if (!w)
+        throw std::runtime_error("no walker for " + walker);
+    return w->walk(std::move(ast));
+}
+
+class AllocationCounter
+{
+  public:
+    void start()
+    {
+        allocations_ = bhw::threadAllocations();
+        bytes_ = bhw::threadAllocatedBytes();
+    }
+    void stop()
+    {
+        totalAllocations_ += bhw::threadAllocations() - allocations_;
+        totalBytes_ += bhw::threadAllocatedBytes() - bytes_;
+    }
+    void report(benchmark::State& state) const
+    {
+        state.counters["allocs"] = benchmark::Counter(static_cast<double>(totalAllocations_),
+                                                      benchmark::Counter::kAvgIterations);
+        state.counters["alloc_bytes"] = benchmark::Counter(static_cast<double>(totalBytes_),
+                                                           benchmark::Counter::kAvgIterations);
+    }
+
+  private:
+    uint64_t allocations_ = 0;
+    uint64_t bytes_ = 0;
+    uint64_t totalAllocations_ = 0;
+    uint64_t totalBytes_ = 0;
+};
+
+void benchParse(benchmark::State& state, const Input& input)
+{
+    QuietStreams quiet;
+    AllocationCounter allocs;
+    for (auto _ : state)
+    {
+        // parsers keep per-run state, so each iteration gets a fresh one (as prag does)
+        allocs.start();
+        auto ast = parseInput(input);
+        allocs.stop();
+        benchmark::DoNotOptimize(ast.nodes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.source.size()));
+    allocs.report(state);
+}
+
+void benchWalk(benchmark::State& state,
+               const Input& input,
+               const std::string& walker,
+               size_t jobs)
+{
+    QuietStreams quiet;
+    auto w = bhw::WalkerRegistry::getWalkerRegistry().create(walker);
+    w->jobs = jobs;
+    AllocationCounter allocs;
+    size_t outputBytes = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto ast = parseInput(input);
+        state.ResumeTiming();
+
+        allocs.start();
+        auto out = w->walk(std::move(ast));
+        allocs.stop();
+        outputBytes = out.size();
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.source.size()));
+    state.counters["output_bytes"] = static_cast<double>(outputBytes);
+    allocs.report(state);
+}
+
+void benchPair(benchmark::State& state, const Input& input, const std::string& walker)
+{
+    QuietStreams quiet;
+    AllocationCounter allocs;
+    for (auto _ : state)
+    {
+        allocs.start();
+        auto out = walkAst(walker, parseInput(input));
+        allocs.stop();
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.source.size()));
+    allocs.report(state);
+}
+
+bool parseSynthetic(const std::string& spec, SyntheticSize& size)
+{
+    return std::sscanf(spec.c_str(), "%zu,%zu,%zu", &size.messages, &size.depth, &size.fields) ==
+           3;
+}
+
+bool parseJobs(const std::string& spec, std::vector<size_t>& jobs)
+{
+    std::istringstream in(spec);
+    std::string item;
+    while (std::getline(in, item, ','))
+    {
+        size_t n = 0;
+        if (std::sscanf(item.c_str(), "%zu", &n) != 1)
+            return false;
+        jobs.push_back(n);
+    }
+    return !jobs.empty();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    fs::path corpus = PRAG_CORPUS_DIR;
+    std::vector<SyntheticSize> sizes;
+    std::vector<size_t> jobs;
+    bool pairs = true;
+
+    // Strip our own flags before handing argv to Google Benchmark
+    std::vector<char*> rest{argv[0]};
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        SyntheticSize size{};
+        if (arg.rfind("--corpus=", 0) == 0)
+            corpus = arg.substr(9);
+        else if (arg.rfind("--synthetic=", 0) == 0 && parseSynthetic(arg.substr(12), size))
+            sizes.push_back(size);
+        else if (arg.rfind("--jobs=", 0) == 0 && parseJobs(arg.substr(7), jobs))
+            continue;
+        else if (arg == "--no-pairs")
+            pairs = false;
+        else
+            rest.push_back(argv[i]);
+    }
+    if (sizes.empty())
+        sizes = {{10, 1, 8}, {100, 2, 8}, {1000, 3, 16}};
+
+    int restArgc = static_cast<int>(rest.size());
+    benchmark::Initialize(&restArgc, rest.data());
+    if (benchmark::ReportUnrecognizedArguments(restArgc, rest.data()))
+        return 1;
+
+    // Benchmarks hold references into these for the lifetime of the run
+    static std::vector<Input> corpusInputs;
+    static std::vector<Input> syntheticInputs;
+    corpusInputs = loadCorpus(corpus);
+    for (const auto& size : sizes)
+        syntheticInputs.push_back({syntheticName(size), "proto", syntheticProto(size)});
+
+    const auto walkers = bhw::WalkerRegistry::getWalkerRegistry().getLangs();
+    size_t skipped = 0;
+
+    for (const auto* inputs : {&corpusInputs, &syntheticInputs})
+    {
+        for (const auto& input : *inputs)
+        {
+            if (!probe([&] { parseInput(input); }))
+            {
+                ++skipped;
+                continue;
+            }
+            benchmark::RegisterBenchmark(
+                ("parse/" + input.ext + "/" + input.name).c_str(), benchParse, std::cref(input));
+        }
+    }
+
+    for (const auto& walker : walkers)
+    {
+        for (const auto& input : syntheticInputs)
+        {
+            if (!probe([&] { walkAst(walker, parseInput(input)); }))
+            {
+                ++skipped;
+                continue;
+            }
+            if (jobs.empty())
+            {
+                benchmark::RegisterBenchmark(("walk/" + walker + "/" + input.name).c_str(),
+                                             benchWalk,
+                                             std::cref(input),
+                                             walker,
+                                             size_t{1});
+                continue;
+            }
+            for (size_t n : jobs)
+            {
+                benchmark::RegisterBenchmark(
+                    ("walk/" + walker + "/" + input.name + "/j" + std::to_string(n)).c_str(),
+                    benchWalk,
+                    std::cref(input),
+                    walker,
+                    n)
+                    ->UseRealTime();
+            }
+        }
+    }
+
+    if (pairs)
+    {
+        for (const auto& input : corpusInputs)
+        {
+            for (const auto& walker : walkers)
+            {
+                if (!probe([&] { walkAst(walker, parseInput(input)); }))
+                {
+                    ++skipped;
+                    continue;
+                }
+                benchmark::RegisterBenchmark(
+                    ("pair/" + input.ext + "->" + walker + "/" + input.name).c_str(),
+                    benchPair,
+                    std::cref(input),
+                    walker);
+            }
+        }
+    }
+
+    std::cerr << "prag_bench: " << corpusInputs.size() << " corpus inputs, "
+              << syntheticInputs.size() << " synthetic schemas, " << skipped
+              << " combinations skipped (crash or parse error)\n";
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
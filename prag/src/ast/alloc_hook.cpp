@@ -0,0 +1,129 @@
+// Replacement global operator new/delete feeding the per-thread allocation counters
+// in profile.h. Linked only into executables (prag_bench always, prag when built
+// with PRAG_PROFILING), never into the ast library, so code linking ast keeps its
+// own allocator.
+#include "profile.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+void* allocate(std::size_t size) noexcept
+{
+    bhw::countAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept
+{
+    bhw::countAllocation(size);
+    auto align = static_cast<std::size_t>(alignment);
+    size = (size + align - 1) / align * align; // aligned_alloc wants a multiple
+#ifdef _WIN32
+    return _aligned_malloc(size ? size : align, align);
+#else
+    return std::aligned_alloc(align, size ? size : align);
+#endif
+}
+
+void release(void* p) noexcept
+{
+    std::free(p);
+}
+
+void releaseAligned(void* p) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    if (void* p = allocate(size))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void* p = allocateAligned(size, alignment))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* p) noexcept
+{
+    release(p);
+}
+void operator delete[](void* p) noexcept
+{
+    release(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+    release(p);
+}
+void operator delete[](void* p, std::size_t) noexcept
+{
+    release(p);
+}
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    release(p);
+}
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    release(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    releaseAligned(p);
+}
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    releaseAligned(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    releaseAligned(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    releaseAligned(p);
+}
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    releaseAligned(p);
+}
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    releaseAligned(p);
+}
@@ -1,4 +1,5 @@
 #include "ast.h"
+#include "profile.h"
 
 #include <functional>
 #include <sstream>
@@ -214,6 +215,7 @@ std::string showNodes(const std::vector<bhw::AstRootNode>& nodes, size_t indent
 
 void bhw::Ast::flattenNestedTypes()
 {
+    PRAG_PROFILE_SCOPE("flatten", "flattenNestedTypes");
     std::vector<Enum> flattenedEnums;
     std::vector<Struct> flattenedStructs;
 
@@ -315,3 +317,176 @@ void bhw::Ast::flattenStructMembers(Struct& s,
     }
     s.members = std::move(newMembers);
 }
+
+auto bhw::rootNodeName(const AstRootNode& node) -> std::string
+{
+    return std::visit([](const auto& n) -> std::string { return n.name; }, node);
+}
+
+namespace
+{
+// "pkg.Type", ".pkg.Type" and "pkg::Type" -> "pkg::Type"
+std::string qualified(const std::string& name)
+{
+    std::string out;
+    out.reserve(name.size() + 4);
+    for (size_t i = 0; i < name.size(); ++i)
+    {
+        if (name[i] == '.' || name[i] == ':')
+        {
+            if (name[i] == ':' && i + 1 < name.size() && name[i + 1] == ':')
+                ++i;
+            if (!out.empty())
+                out += "::";
+        }
+        else
+        {
+            out += name[i];
+        }
+    }
+    return out;
+}
+
+void collectRefs(const bhw::Type& type, std::set<std::string>& refs);
+
+void collectRefs(const bhw::Struct& s, std::set<std::string>& refs)
+{
+    if (!s.baseType.empty())
+        refs.insert(qualified(s.baseType));
+
+    for (const auto& member : s.members)
+    {
+        std::visit(
+            [&](const auto& m)
+            {
+                using T = std::decay_t<decltype(m)>;
+                if constexpr (std::is_same_v<T, bhw::Field>)
+                {
+                    if (m.type)
+                        collectRefs(*m.type, refs);
+                }
+                else if constexpr (std::is_same_v<T, bhw::Oneof>)
+                {
+                    for (const auto& f : m.fields)
+                        if (f.type)
+                            collectRefs(*f.type, refs);
+                }
+                else if constexpr (std::is_same_v<T, bhw::Struct>)
+                {
+                    collectRefs(m, refs);
+                }
+            },
+            member);
+    }
+}
+
+void collectRefs(const bhw::Type& type, std::set<std::string>& refs)
+{
+    std::visit(
+        [&](const auto& t)
+        {
+            using T = std::decay_t<decltype(t)>;
+            if constexpr (std::is_same_v<T, bhw::StructRefType>)
+                refs.insert(qualified(t.srcTypeString));
+            else if constexpr (std::is_same_v<T, bhw::PointerType>)
+            {
+                if (t.pointee)
+                    collectRefs(*t.pointee, refs);
+            }
+            else if constexpr (std::is_same_v<T, bhw::GenericType>)
+            {
+                for (const auto& arg : t.args)
+                    collectRefs(*arg, refs);
+            }
+            else if constexpr (std::is_same_v<T, bhw::StructType>)
+            {
+                if (t.value)
+                    collectRefs(*t.value, refs);
+            }
+        },
+        type.value);
+}
+} // namespace
+
+void bhw::collectTypeRefs(const AstRootNode& node, std::set<std::string>& refs)
+{
+    std::visit(
+        [&](const auto& n)
+        {
+            using T = std::decay_t<decltype(n)>;
+            if constexpr (std::is_same_v<T, Struct>)
+                collectRefs(n, refs);
+            else if constexpr (std::is_same_v<T, Oneof>)
+            {
+                for (const auto& f : n.fields)
+                    if (f.type)
+                        collectRefs(*f.type, refs);
+            }
+            else if constexpr (std::is_same_v<T, Namespace>)
+            {
+                for (const auto& child : n.nodes)
+                    collectTypeRefs(child, refs);
+            }
+        },
+        node);
+}
+
+namespace
+{
+template <typename T> std::string scopedName(const T& n, const std::string& scope)
+{
+    // types inside a namespace node may not carry the namespace themselves
+    if (!n.namespaces.empty() || scope.empty())
+        return n.getFullyQualifiedName();
+    return scope + "::" + n.name;
+}
+
+void collectNestedNames(const bhw::Struct& s, const std::string& name, std::vector<std::string>& names)
+{
+    for (const auto& member : s.members)
+    {
+        if (const auto* nested = std::get_if<bhw::Struct>(&member); nested && !nested->name.empty())
+        {
+            // recurse with a local: push_back may reallocate names
+            std::string nestedName = name + "::" + nested->name;
+            names.push_back(nestedName);
+            collectNestedNames(*nested, nestedName, names);
+        }
+        else if (const auto* e = std::get_if<bhw::Enum>(&member))
+        {
+            names.push_back(name + "::" + e->name);
+        }
+    }
+}
+
+void collectNames(const bhw::AstRootNode& node, const std::string& scope, std::vector<std::string>& names)
+{
+    std::visit(
+        [&](const auto& n)
+        {
+            using T = std::decay_t<decltype(n)>;
+            if constexpr (std::is_same_v<T, bhw::Struct>)
+            {
+                std::string name = scopedName(n, scope);
+                names.push_back(name);
+                collectNestedNames(n, name, names);
+            }
+            else if constexpr (std::is_same_v<T, bhw::Enum>)
+                names.push_back(scopedName(n, scope));
+            else if constexpr (std::is_same_v<T, bhw::Oneof>)
+                names.push_back(scope.empty() ? n.name : scope + "::" + n.name);
+            else if constexpr (std::is_same_v<T, bhw::Namespace>)
+            {
+                std::string inner = scope.empty() ? qualified(n.name) : scope + "::" + qualified(n.name);
+                for (const auto& child : n.nodes)
+                    collectNames(child, inner, names);
+            }
+        },
+        node);
+}
+} // namespace
+
+void bhw::collectTypeNames(const AstRootNode& node, std::vector<std::string>& names)
+{
+    collectNames(node, "", names);
+}
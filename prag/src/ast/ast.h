@@ -4,12 +4,14 @@
 #include <iostream>
 #include <memory>
 #include <ostream>
+#include <set>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 #include <variant>
 #include <vector>
 
+#include "naming.h"
 #include "reified.h"
 
 namespace bhw
@@ -250,6 +252,7 @@ struct Ast
     std::string srcName;
     std::vector<std::string> namespaces;
     std::vector<AstRootNode> nodes;
+    NameTable names; // memoized identifier case conversions, shared by walkers
 
     std::string showAst(size_t indent = 0) const;
 
@@ -260,6 +263,15 @@ struct Ast
 };
 
 // ---------------- Utility ----------------
+// Name of a top-level node (struct, enum, namespace, service or oneof)
+std::string rootNodeName(const AstRootNode& node);
+// Collect every struct/enum referenced from a node, qualified as written in the
+// source with "::" separators ("pkg.Type" and ".pkg.Type" become "pkg::Type")
+void collectTypeRefs(const AstRootNode& node, std::set<std::string>& refs);
+// Collect the "::"-qualified names of the structs and enums a node defines,
+// including those nested in it or in a namespace node
+void collectTypeNames(const AstRootNode& node, std::vector<std::string>& names);
+
 std::string showType(const Type& type, size_t indent = 0);
 std::string showField(const Field& field, size_t indent = 0);
 std::string showStruct(const Struct& str, size_t indent = 0);
@@ -1,6 +1,7 @@
 #pragma once
 #include "ast.h"
 #include "languages.h"
+#include "profile.h"
 #include "string.h"
 
 namespace bhw
@@ -12,5 +13,12 @@ class AstParser
     virtual ~AstParser() = default;
     virtual auto getLang() -> bhw::Language = 0;
     virtual auto parseToAst(const std::string& src) -> bhw::Ast = 0;
+
+    // parseToAst wrapped in a profiling scope
+    auto parse(const std::string& src) -> bhw::Ast
+    {
+        PRAG_PROFILE_SCOPE("parse", LanguageEnum::toString(getLang()));
+        return parseToAst(src);
+    }
 };
 } // namespace bhw
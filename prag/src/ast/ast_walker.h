@@ -1,10 +1,21 @@
 #pragma once
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "ast.h"
 #include "language_info.h"
 #include "languages.h"
+#include "output_files.h"
+#include "parallel.h"
+#include "profile.h"
 
 namespace bhw
 {
@@ -45,57 +56,262 @@ struct WalkContext
     // std::string parentStructName;
 };
 
+// Split output: which file (unit) defines each type, keyed on the "::"-qualified name.
+// A reference resolves to the type of that exact name, else to the one type whose
+// qualified name ends with it ("Point" -> "geo::Point"); when several namespaces
+// define it, the referencing unit's own namespace wins and otherwise it is ambiguous
+// and left unresolved.
+class TypeUnits
+{
+  public:
+    void add(const std::string& qualifiedName, size_t unit)
+    {
+        if (units_.emplace(qualifiedName, unit).second)
+            byName_[lastComponent(qualifiedName)].push_back(qualifiedName);
+        scopes_.resize(std::max(scopes_.size(), unit + 1));
+        if (scopes_[unit].empty())
+            scopes_[unit] = scopeOf(qualifiedName);
+    }
+
+    std::optional<size_t> find(const std::string& ref, size_t fromUnit) const
+    {
+        if (auto it = units_.find(ref); it != units_.end())
+            return it->second;
+
+        auto candidates = byName_.find(lastComponent(ref));
+        if (candidates == byName_.end())
+            return std::nullopt;
+        const std::string suffix = "::" + ref;
+        const std::string* match = nullptr;
+        size_t matches = 0;
+        for (const auto& name : candidates->second)
+        {
+            if (name.ends_with(suffix))
+            {
+                match = &name;
+                ++matches;
+            }
+        }
+        if (matches == 1)
+            return units_.at(*match);
+        if (matches > 1 && fromUnit < scopes_.size() && !scopes_[fromUnit].empty())
+        {
+            if (auto it = units_.find(scopes_[fromUnit] + suffix); it != units_.end())
+                return it->second;
+        }
+        return std::nullopt;
+    }
+
+  private:
+    static std::string lastComponent(const std::string& name)
+    {
+        size_t pos = name.rfind("::");
+        return pos == std::string::npos ? name : name.substr(pos + 2);
+    }
+    static std::string scopeOf(const std::string& name)
+    {
+        size_t pos = name.rfind("::");
+        return pos == std::string::npos ? std::string() : name.substr(0, pos);
+    }
+
+    std::map<std::string, size_t> units_;
+    std::map<std::string, std::vector<std::string>> byName_;
+    std::vector<std::string> scopes_; // namespace of each unit's first type
+};
+
 class AstWalker
 {
   public:
     std::string srcLang;
+    size_t jobs = 1; // threads for walking top-level nodes (0 = hardware concurrency)
 
     virtual ~AstWalker() = default;
     virtual auto getLang() -> Language = 0;
 
+    // Walkers whose generate* methods read or write member state (counters, stacks,
+    // accumulated documents) must return true; their top-level nodes are then always
+    // walked in order on the calling thread.
+    virtual bool hasCrossNodeState() const
+    {
+        return false;
+    }
+
     virtual std::string walk(bhw::Ast&& ast)
     {
+        PRAG_PROFILE_SCOPE("walk", LanguageEnum::toString(getLang()));
+        names_ = &ast.names;
+        loadNamingStyles();
+        prepareAst(ast);
 
         std::ostringstream out;
 
         out << generateHeader(ast);
 
         // does anything need flattening
-
-        auto registry = getRegistry();
-        if (registry.contains(getLang()))
+        if (applyFlatteningPolicy(ast))
         {
-            const auto& policy = registry.at(getLang()).flattening;
+            WalkContext flatten{.pass = WalkContext::Pass::Flatten, .level = 0};
+            walkRootNodes(ast.nodes, flatten, out);
+        }
 
-            if (policy.anonymous == AnonymousPolicy::Rename)
-            {
-                renameAnonymousStructs(ast);
-            }
-            if (policy.needsFlattening())
-            {
+        // there is always a normal pass
+        WalkContext normal{.pass = WalkContext::Pass::Normal, .level = 0};
+        walkRootNodes(ast.nodes, normal, out);
 
-                ast.flattenNestedTypes();
+        // Generate file footer
+        out << generateFooter(ast);
 
-                WalkContext flatten{.pass = WalkContext::Pass::Flatten, .level = 0};
-                for (const auto& node : ast.nodes)
-                {
-                    out << walkRootNode(node, flatten);
-                }
-            }
+        names_ = nullptr;
+        return out.str();
+    }
+
+    // Split output: one file per top-level type or namespace, named through
+    // LanguageInfo::naming.file_name. Each file carries the walker header/footer plus
+    // imports for the other files it references; generateAggregate() may add an
+    // umbrella header/module. Files are generated in parallel unless the walker
+    // has cross-node state.
+    virtual std::vector<OutputFile> walkFiles(bhw::Ast&& ast, const std::string& moduleFile)
+    {
+        const std::string moduleName = sanitizeFileStem(moduleFile);
+        PRAG_PROFILE_SCOPE("walk", LanguageEnum::toString(getLang()));
+        names_ = &ast.names;
+        loadNamingStyles();
+        prepareAst(ast);
+        bool flatten = applyFlatteningPolicy(ast);
+
+        // Assign a unique file stem to every top-level node. The aggregate file's stem
+        // is taken first so no type file can overwrite it (or be overwritten by it).
+        std::vector<size_t> units;
+        std::vector<std::string> stems;
+        std::set<std::string> used;
+        if (auto aggregate = aggregateStem(moduleName))
+            used.insert(*aggregate);
+        TypeUnits typeUnits;
+        CaseStyle fileStyle = parseCaseStyle(getNaming().file_name);
+        for (size_t i = 0; i < ast.nodes.size(); ++i)
+        {
+            if (std::holds_alternative<Service>(ast.nodes[i]))
+                continue; // no walker emits services
+
+            std::string name = rootNodeName(ast.nodes[i]);
+            std::string base = sanitizeFileStem(convertName(name, fileStyle));
+            std::string stem = base;
+            for (size_t n = 2; used.contains(stem); ++n)
+                stem = base + "_" + std::to_string(n);
+            used.insert(stem);
+
+            std::vector<std::string> typeNames;
+            collectTypeNames(ast.nodes[i], typeNames);
+            for (const auto& typeName : typeNames)
+                typeUnits.add(typeName, units.size());
+            units.push_back(i);
+            stems.push_back(stem);
         }
 
-        // there is always a normal pass
-        WalkContext normal{.pass = WalkContext::Pass::Normal, .level = 0};
+        std::vector<OutputFile> files(units.size());
+        parallelFor(units.size(),
+                    hasCrossNodeState() ? 1 : jobs,
+                    [&](size_t u)
+                    {
+                        const auto& node = ast.nodes[units[u]];
+
+                        std::set<std::string> refs;
+                        collectTypeRefs(node, refs);
+                        std::set<size_t> depUnits;
+                        for (const auto& ref : refs)
+                        {
+                            if (auto unit = typeUnits.find(ref, u); unit && *unit != u)
+                                depUnits.insert(*unit);
+                        }
+                        std::vector<std::string> deps;
+                        for (size_t d : depUnits)
+                            deps.push_back(stems[d]);
+
+                        std::ostringstream out;
+                        out << generateHeader(ast) << generateFileImports(deps);
+                        if (flatten)
+                            out << walkRootNode(node, {.pass = WalkContext::Pass::Flatten});
+                        out << walkRootNode(node, {.pass = WalkContext::Pass::Normal});
+                        out << generateFooter(ast);
+
+                        files[u] = {stems[u] + "." + fileExtension(), out.str()};
+                    });
+
+        if (auto aggregate = generateAggregate(moduleName, stems))
+            files.push_back(std::move(*aggregate));
+
+        names_ = nullptr;
+        return files;
+    }
+
+    // Extension for split output files
+    virtual std::string fileExtension()
+    {
+        const auto& registry = getRegistry();
+        auto it = registry.find(getLang());
+        return it == registry.end() ? "txt" : it->second.file_ext;
+    }
+
+    // Split output hooks: imports of sibling files, and an optional umbrella file
+    virtual std::string generateFileImports(const std::vector<std::string>&)
+    {
+        return "";
+    }
+    // Stem of the file generateAggregate() writes (reserved before the type files are
+    // named); walkers that override one override both
+    virtual std::optional<std::string> aggregateStem(const std::string&)
+    {
+        return std::nullopt;
+    }
+    virtual std::optional<OutputFile> generateAggregate(const std::string&,
+                                                        const std::vector<std::string>&)
+    {
+        return std::nullopt;
+    }
+
+    // Hook to reshape the AST before anything is generated
+    virtual void prepareAst(bhw::Ast&)
+    {
+    }
+
+    // Apply the registry flattening policy; returns true when a flatten pass is needed
+    bool applyFlatteningPolicy(bhw::Ast& ast)
+    {
+        const auto& registry = getRegistry();
+        if (!registry.contains(getLang()))
+            return false;
 
-        for (const auto& node : ast.nodes)
+        const auto& policy = registry.at(getLang()).flattening;
+        if (policy.anonymous == AnonymousPolicy::Rename)
         {
-            out << walkRootNode(node, normal);
+            renameAnonymousStructs(ast);
         }
+        if (policy.needsFlattening())
+        {
+            ast.flattenNestedTypes();
+            return true;
+        }
+        return false;
+    }
 
-        // Generate file footer
-        out << generateFooter(ast);
+    const NamingConventions& getNaming()
+    {
+        static const NamingConventions none{};
+        const auto& registry = getRegistry();
+        auto it = registry.find(getLang());
+        return it == registry.end() ? none : it->second.naming;
+    }
 
-        return out.str();
+    // Identifiers in this language's NamingConventions, through the AST name table.
+    // Walkers call these where the target language's convention differs from the
+    // schema's (C# and Go fields, Java fields, C# enum values).
+    template <typename Out> void appendFieldName(Out& out, std::string_view name) const
+    {
+        appendName(out, name, fieldStyle_);
+    }
+    template <typename Out> void appendConstantName(Out& out, std::string_view name) const
+    {
+        appendName(out, name, constantStyle_);
     }
 
     // Override these to customize code generation
@@ -108,6 +324,45 @@ class AstWalker
         return "";
     }
 
+    // Walk the top-level nodes in order. With jobs > 1 and no cross-node state the
+    // nodes are split into chunks, walked on worker threads into separate buffers
+    // and joined in order, so the output matches the serial walk byte for byte.
+    void walkRootNodes(const std::vector<AstRootNode>& nodes,
+                       const WalkContext& ctx,
+                       std::ostringstream& out)
+    {
+        size_t workers = resolveJobs(jobs);
+        if (workers <= 1 || hasCrossNodeState() || nodes.size() < 2)
+        {
+            for (const auto& node : nodes)
+            {
+                out << walkRootNode(node, ctx);
+            }
+            return;
+        }
+
+        // a few chunks per worker keeps threads busy when node sizes vary
+        size_t chunkSize = std::max<size_t>(1, nodes.size() / (workers * 4));
+        size_t chunkCount = (nodes.size() + chunkSize - 1) / chunkSize;
+        std::vector<std::string> chunks(chunkCount);
+
+        parallelFor(chunkCount,
+                    workers,
+                    [&](size_t c)
+                    {
+                        size_t end = std::min(nodes.size(), (c + 1) * chunkSize);
+                        for (size_t i = c * chunkSize; i < end; ++i)
+                        {
+                            chunks[c] += walkRootNode(nodes[i], ctx);
+                        }
+                    });
+
+        for (const auto& chunk : chunks)
+        {
+            out << chunk;
+        }
+    }
+
     // Walk different node types
     virtual auto walkRootNode(const bhw::AstRootNode& node, const WalkContext& ctx) -> std::string
     {
@@ -306,6 +561,76 @@ class AstWalker
     }
 
     // Utility methods
+
+    // Case conversion into the caller's buffer or stream. Word styles (snake_case,
+    // PascalCase, ...) are memoized in the AST name table while walking; AsIs and the
+    // first-letter styles are cheaper to redo than to look up and are written directly.
+    void appendName(std::string& out, std::string_view name, CaseStyle style) const
+    {
+        if (names_ && splitsWords(style))
+            out += names_->convert(name, style);
+        else
+            appendCase(out, name, style);
+    }
+    void appendName(std::ostream& out, std::string_view name, CaseStyle style) const
+    {
+        if (names_ && splitsWords(style))
+        {
+            out << names_->convert(name, style);
+            return;
+        }
+        switch (style)
+        {
+        case CaseStyle::AsIs:
+            out << name;
+            return;
+        case CaseStyle::Capitalized:
+        case CaseStyle::Uncapitalized:
+            if (name.empty())
+                return;
+            out.put(style == CaseStyle::Capitalized
+                        ? static_cast<char>(std::toupper(static_cast<unsigned char>(name[0])))
+                        : static_cast<char>(std::tolower(static_cast<unsigned char>(name[0]))));
+            out.write(name.data() + 1, static_cast<std::streamsize>(name.size() - 1));
+            return;
+        default:
+        {
+            std::string converted;
+            appendCase(converted, name, style);
+            out << converted;
+            return;
+        }
+        }
+    }
+    std::string convertName(std::string_view name, CaseStyle style) const
+    {
+        std::string out;
+        appendName(out, name, style);
+        return out;
+    }
+
+    // Oneof variant / wrapper type names: Capitalized(first) + separator + Capitalized(second)
+    std::string variantName(std::string_view first,
+                            std::string_view separator,
+                            std::string_view second) const
+    {
+        std::string out;
+        out.reserve(first.size() + separator.size() + second.size());
+        appendName(out, first, CaseStyle::Capitalized);
+        out += separator;
+        appendName(out, second, CaseStyle::Capitalized);
+        return out;
+    }
+
+    std::string capitalize(const std::string& s) const
+    {
+        return convertName(s, CaseStyle::Capitalized);
+    }
+    std::string uncapitalize(const std::string& s) const
+    {
+        return convertName(s, CaseStyle::Uncapitalized);
+    }
+
     std::string indent(size_t level) const
     {
         return std::string(level * 2, ' ');
@@ -380,5 +705,19 @@ class AstWalker
                 node);
         }
     }
+
+  protected:
+    NameTable* names_ = nullptr; // name table of the AST being walked
+
+  private:
+    void loadNamingStyles()
+    {
+        const auto& naming = getNaming();
+        fieldStyle_ = parseCaseStyle(naming.field_name);
+        constantStyle_ = parseCaseStyle(naming.constant);
+    }
+
+    CaseStyle fieldStyle_ = CaseStyle::AsIs;
+    CaseStyle constantStyle_ = CaseStyle::AsIs;
 };
 } // namespace bhw
@@ -5,12 +5,16 @@
 
 #include "ast.h"
 #include "language_info.h"
+#include "profile.h"
 
 namespace bhw
 {
 const std::map<Language, LanguageInfo>& getRegistry()
 {
-    static const std::map<Language, LanguageInfo> registry = {
+    static const std::map<Language, LanguageInfo> registry = []()
+    {
+        PRAG_PROFILE_SCOPE("registry", "languages");
+        return std::map<Language, LanguageInfo>{
         {
 
             {Language::Avro,
@@ -629,6 +633,7 @@ const std::map<Language, LanguageInfo>& getRegistry()
         }
 
     };
+    }();
 
     return registry;
 };
@@ -0,0 +1,204 @@
+#include "naming.h"
+
+#include <cctype>
+
+namespace
+{
+bool isSeparator(char c)
+{
+    return c == '_' || c == '-' || c == ' ' || c == '.' || c == ':';
+}
+bool isUpper(char c)
+{
+    return std::isupper(static_cast<unsigned char>(c)) != 0;
+}
+bool isLower(char c)
+{
+    return std::islower(static_cast<unsigned char>(c)) != 0;
+}
+bool isDigit(char c)
+{
+    return std::isdigit(static_cast<unsigned char>(c)) != 0;
+}
+char upper(char c)
+{
+    return static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+}
+char lower(char c)
+{
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+void appendWord(std::string& out, std::string_view word, bool capitalizeFirst, bool allUpper)
+{
+    for (size_t i = 0; i < word.size(); ++i)
+    {
+        if (allUpper || (i == 0 && capitalizeFirst))
+            out += upper(word[i]);
+        else
+            out += lower(word[i]);
+    }
+}
+} // namespace
+
+namespace bhw
+{
+
+CaseStyle parseCaseStyle(std::string_view convention)
+{
+    if (convention == "PascalCase")
+        return CaseStyle::PascalCase;
+    if (convention == "camelCase")
+        return CaseStyle::CamelCase;
+    if (convention == "snake_case")
+        return CaseStyle::SnakeCase;
+    if (convention == "SCREAMING_SNAKE_CASE" || convention == "UPPER_SNAKE_CASE")
+        return CaseStyle::ScreamingSnakeCase;
+    if (convention == "kebab-case")
+        return CaseStyle::KebabCase;
+    if (convention == "lowercase")
+        return CaseStyle::LowerCase;
+    return CaseStyle::AsIs;
+}
+
+WordSpans splitWords(std::string_view id)
+{
+    WordSpans words;
+    size_t start = 0;
+    bool inWord = false;
+
+    for (size_t i = 0; i < id.size(); ++i)
+    {
+        char c = id[i];
+        if (isSeparator(c))
+        {
+            if (inWord)
+                words.emplace_back(static_cast<uint32_t>(start), static_cast<uint32_t>(i - start));
+            inWord = false;
+            continue;
+        }
+        if (!inWord)
+        {
+            start = i;
+            inWord = true;
+            continue;
+        }
+
+        char prev = id[i - 1];
+        bool boundary = false;
+        if (isUpper(c) && (isLower(prev) || isDigit(prev)))
+            boundary = true; // fooBar, v2Name
+        else if (isUpper(c) && isUpper(prev) && i + 1 < id.size() && isLower(id[i + 1]))
+            boundary = true; // HTTPServer -> HTTP|Server
+
+        if (boundary)
+        {
+            words.emplace_back(static_cast<uint32_t>(start), static_cast<uint32_t>(i - start));
+            start = i;
+        }
+    }
+    if (inWord)
+        words.emplace_back(static_cast<uint32_t>(start), static_cast<uint32_t>(id.size() - start));
+    return words;
+}
+
+void appendCase(std::string& out, std::string_view id, CaseStyle style)
+{
+    appendCase(out, id, splitsWords(style) ? splitWords(id) : WordSpans{}, style);
+}
+
+void appendCase(std::string& out, std::string_view id, const WordSpans& words, CaseStyle style)
+{
+    switch (style)
+    {
+    case CaseStyle::AsIs:
+    case CaseStyle::Count:
+        out += id;
+        return;
+    case CaseStyle::Capitalized:
+    case CaseStyle::Uncapitalized:
+        if (id.empty())
+            return;
+        out += style == CaseStyle::Capitalized ? upper(id[0]) : lower(id[0]);
+        out += id.substr(1);
+        return;
+    default:
+        break;
+    }
+
+    if (words.empty())
+    {
+        out += id;
+        return;
+    }
+
+    // keep leading underscores (_private stays private-looking)
+    for (size_t i = 0; i < id.size() && id[i] == '_'; ++i)
+        out += '_';
+
+    out.reserve(out.size() + id.size() + words.size());
+    for (size_t w = 0; w < words.size(); ++w)
+    {
+        std::string_view word = id.substr(words[w].first, words[w].second);
+        switch (style)
+        {
+        case CaseStyle::PascalCase:
+            appendWord(out, word, true, false);
+            break;
+        case CaseStyle::CamelCase:
+            appendWord(out, word, w != 0, false);
+            break;
+        case CaseStyle::SnakeCase:
+            if (w != 0)
+                out += '_';
+            appendWord(out, word, false, false);
+            break;
+        case CaseStyle::ScreamingSnakeCase:
+            if (w != 0)
+                out += '_';
+            appendWord(out, word, false, true);
+            break;
+        case CaseStyle::KebabCase:
+            if (w != 0)
+                out += '-';
+            appendWord(out, word, false, false);
+            break;
+        case CaseStyle::LowerCase:
+            appendWord(out, word, false, false);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+const std::string& NameTable::convert(std::string_view identifier, CaseStyle style)
+{
+    const size_t index = static_cast<size_t>(style);
+    {
+        std::shared_lock lock(mutex_);
+        auto it = entries_.find(identifier);
+        if (it != entries_.end() && it->second.converted[index])
+            return *it->second.converted[index];
+    }
+
+    // first conversion of this (identifier, style); another thread may have won the race
+    std::unique_lock lock(mutex_);
+    auto it = entries_.find(identifier);
+    if (it == entries_.end())
+    {
+        it = entries_.emplace(std::string(identifier), Entry{}).first;
+        it->second.words = splitWords(identifier);
+    }
+
+    auto& slot = it->second.converted[index];
+    if (!slot)
+    {
+        std::string converted;
+        appendCase(converted, it->first, it->second.words, style);
+        slot = std::move(converted);
+    }
+    return *slot;
+}
+
+} // namespace bhw
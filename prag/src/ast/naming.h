@@ -0,0 +1,115 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bhw
+{
+
+// Identifier case styles named by LanguageInfo::naming ("PascalCase", "snake_case", ...)
+enum class CaseStyle : uint8_t
+{
+    AsIs,
+    PascalCase,
+    CamelCase,
+    SnakeCase,
+    ScreamingSnakeCase,
+    KebabCase,
+    LowerCase,
+    Capitalized,   // first letter upper, rest untouched
+    Uncapitalized, // first letter lower, rest untouched
+    Count
+};
+
+// Map a NamingConventions string to a style; unknown strings map to AsIs
+CaseStyle parseCaseStyle(std::string_view convention);
+
+// Styles converted word by word; AsIs and the first-letter styles need no split
+constexpr bool splitsWords(CaseStyle style)
+{
+    return style != CaseStyle::AsIs && style != CaseStyle::Capitalized &&
+           style != CaseStyle::Uncapitalized && style != CaseStyle::Count;
+}
+
+// Word boundaries of an identifier: "HTTPServer_id2" -> HTTP, Server, id2
+using WordSpans = std::vector<std::pair<uint32_t, uint32_t>>;
+WordSpans splitWords(std::string_view identifier);
+
+// Append `identifier` converted to `style` onto `out`
+void appendCase(std::string& out, std::string_view identifier, CaseStyle style);
+void appendCase(std::string& out,
+                std::string_view identifier,
+                const WordSpans& words,
+                CaseStyle style);
+
+// ---------------- Name table ----------------
+// Per-AST string table memoizing (identifier, style) conversions. Each identifier
+// is tokenized once; every style is converted at most once and then served by
+// reference. References stay valid for the lifetime of the table. Walkers share one
+// table across threads: hits take a shared lock, only a first conversion takes the
+// exclusive one.
+class NameTable
+{
+  public:
+    NameTable() = default;
+    NameTable(NameTable&& other) noexcept : entries_(std::move(other.entries_))
+    {
+    }
+    NameTable& operator=(NameTable&& other) noexcept
+    {
+        entries_ = std::move(other.entries_);
+        return *this;
+    }
+
+    const std::string& convert(std::string_view identifier, CaseStyle style);
+    const std::string& convert(std::string_view identifier, std::string_view convention)
+    {
+        return convert(identifier, parseCaseStyle(convention));
+    }
+
+    // Append the converted identifier onto a caller-provided buffer
+    void appendTo(std::string& out, std::string_view identifier, CaseStyle style)
+    {
+        out += convert(identifier, style);
+    }
+
+    size_t size() const
+    {
+        std::shared_lock lock(mutex_);
+        return entries_.size();
+    }
+    void clear()
+    {
+        std::unique_lock lock(mutex_);
+        entries_.clear();
+    }
+
+  private:
+    struct Entry
+    {
+        WordSpans words;
+        std::array<std::optional<std::string>, static_cast<size_t>(CaseStyle::Count)> converted;
+    };
+
+    struct Hash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const
+        {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    std::unordered_map<std::string, Entry, Hash, std::equal_to<>> entries_;
+    mutable std::shared_mutex mutex_;
+};
+
+} // namespace bhw
@@ -0,0 +1,112 @@
+#include "output_files.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+
+#include "parallel.h"
+
+namespace
+{
+bool sameContent(const std::filesystem::path& path, const std::string& content)
+{
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec || size != content.size())
+        return false;
+
+    std::ifstream in(path, std::ios::binary);
+    std::string existing(size, '\0');
+    in.read(existing.data(), static_cast<std::streamsize>(size));
+    return in && existing == content;
+}
+} // namespace
+
+namespace bhw
+{
+
+std::string sanitizeFileStem(std::string_view name)
+{
+    std::string stem;
+    stem.reserve(name.size());
+    for (char c : name)
+    {
+        if (std::isalnum(static_cast<unsigned char>(c)) || c == '_' || (c == '-' && !stem.empty()))
+            stem += c;
+        else if (!stem.empty() && stem.back() != '_')
+            stem += '_';
+    }
+    while (!stem.empty() && (stem.back() == '_' || stem.back() == '-'))
+        stem.pop_back();
+
+    if (stem.empty())
+        return "unnamed";
+    if (std::isdigit(static_cast<unsigned char>(stem.front())))
+        stem.insert(stem.begin(), '_');
+
+    static constexpr std::array<std::string_view, 22> reserved = {
+        "con",  "prn",  "aux",  "nul",  "com1", "com2", "com3", "com4",
+        "com5", "com6", "com7", "com8", "com9", "lpt1", "lpt2", "lpt3",
+        "lpt4", "lpt5", "lpt6", "lpt7", "lpt8", "lpt9"};
+    std::string lower = stem;
+    std::transform(lower.begin(),
+                   lower.end(),
+                   lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (std::find(reserved.begin(), reserved.end(), lower) != reserved.end())
+        stem += '_';
+    return stem;
+}
+
+WriteStats writeOutputFiles(const std::string& dir, const std::vector<OutputFile>& files, size_t jobs)
+{
+    namespace fs = std::filesystem;
+
+    // two workers must never write (and rename) the same path
+    std::set<std::string> names;
+    for (const auto& file : files)
+    {
+        if (!names.insert(file.name).second)
+            throw std::runtime_error("Duplicate output file: " + file.name);
+    }
+
+    fs::create_directories(dir);
+
+    std::atomic<size_t> written{0};
+    std::atomic<size_t> unchanged{0};
+
+    parallelFor(files.size(),
+                jobs,
+                [&](size_t i)
+                {
+                    const auto& file = files[i];
+                    fs::path path = fs::path(dir) / file.name;
+                    if (sameContent(path, file.content))
+                    {
+                        ++unchanged;
+                        return;
+                    }
+
+                    // write next to the target, then rename so readers never see a partial file
+                    fs::path tmp = path;
+                    tmp += ".tmp";
+                    {
+                        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+                        out.write(file.content.data(),
+                                  static_cast<std::streamsize>(file.content.size()));
+                        if (!out)
+                            throw std::runtime_error("Cannot write file: " + tmp.string());
+                    }
+                    fs::rename(tmp, path);
+                    ++written;
+                });
+
+    return {written.load(), unchanged.load()};
+}
+
+} // namespace bhw
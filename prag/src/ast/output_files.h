@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bhw
+{
+
+// One generated file of a split (--out-dir) walk; name is relative to the output dir
+struct OutputFile
+{
+    std::string name;
+    std::string content;
+};
+
+struct WriteStats
+{
+    size_t written = 0;
+    size_t unchanged = 0;
+};
+
+// Portable file stem for a converted type or namespace name: runs of characters
+// other than letters, digits, '_' and '-' become one '_' ("<anonymous>" -> "anonymous",
+// "a::b" -> "a_b"), a leading digit gets a '_' prefix, Windows device names
+// (con, nul, com1, ...) get a '_' suffix, and an empty result is "unnamed".
+std::string sanitizeFileStem(std::string_view name);
+
+// Write files into dir on up to `jobs` threads. A file whose content on disk already
+// matches is left alone so its mtime (and downstream rebuilds) stay put. Throws
+// std::runtime_error, before writing anything, if two files have the same name.
+WriteStats writeOutputFiles(const std::string& dir, const std::vector<OutputFile>& files, size_t jobs);
+
+} // namespace bhw
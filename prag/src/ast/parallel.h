@@ -0,0 +1,164 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bhw
+{
+
+// Resolve a --jobs style request: 0 means one per hardware thread
+inline size_t resolveJobs(size_t jobs)
+{
+    if (jobs == 0)
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+    return jobs;
+}
+
+// Process-wide worker threads shared by every parallelFor call. Threads are
+// started on first use, added when a call asks for more than exist, and
+// joined at exit.
+class ThreadPool
+{
+  public:
+    static ThreadPool& instance()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : threads_)
+            t.join();
+    }
+
+    // Queue `copies` runs of task, making sure at least that many workers exist
+    void submit(size_t copies, const std::function<void()>& task)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            while (threads_.size() < copies)
+                threads_.emplace_back([this] { run(); });
+            for (size_t i = 0; i < copies; ++i)
+                tasks_.push_back(task);
+        }
+        wake_.notify_all();
+    }
+
+  private:
+    ThreadPool() = default;
+
+    void run()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty())
+                    return;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> threads_;
+    bool stopping_ = false;
+};
+
+// Run fn(i) for every i in [0, count) on up to `jobs` threads: the calling
+// thread plus workers from the shared ThreadPool. Work items are handed out
+// dynamically; the first exception thrown by any item is rethrown on the
+// calling thread once every started item has finished.
+//
+// The caller only waits for items that are running, never for queued pool
+// tasks, so a nested call made from inside fn cannot deadlock: if no worker
+// is free the caller works through all the items itself, and pool tasks that
+// start late find nothing left to claim.
+template <typename Fn> void parallelFor(size_t count, size_t jobs, Fn&& fn)
+{
+    jobs = std::min(resolveJobs(jobs), count);
+    if (jobs <= 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+            fn(i);
+        return;
+    }
+
+    // shared with pool tasks that may start after this call has returned
+    struct State
+    {
+        std::atomic<size_t> next{0};
+        size_t inFlight = 0; // claims in progress, guarded by mutex
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable idle;
+    };
+    auto state = std::make_shared<State>();
+    auto* body = &fn; // only dereferenced while a claim is in flight
+
+    auto worker = [state, body, count]()
+    {
+        for (;;)
+        {
+            {
+                std::lock_guard lock(state->mutex);
+                ++state->inFlight;
+            }
+            size_t i = state->next++;
+            if (i < count)
+            {
+                try
+                {
+                    (*body)(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard lock(state->mutex);
+                    if (!state->error)
+                        state->error = std::current_exception();
+                    state->next = count; // stop handing out work
+                }
+            }
+
+            std::lock_guard lock(state->mutex);
+            if (--state->inFlight == 0)
+                state->idle.notify_all();
+            if (i >= count)
+                return;
+        }
+    };
+
+    ThreadPool::instance().submit(jobs - 1, worker);
+    worker();
+
+    // every item is claimed now; wait for the ones still running elsewhere
+    std::unique_lock lock(state->mutex);
+    state->idle.wait(lock, [&] { return state->inFlight == 0; });
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+} // namespace bhw
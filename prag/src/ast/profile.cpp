@@ -0,0 +1,137 @@
+#include "profile.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <utility>
+
+namespace
+{
+thread_local uint64_t tlAllocations = 0;
+thread_local uint64_t tlAllocatedBytes = 0;
+
+std::atomic<uint32_t> nextThreadId{0};
+thread_local uint32_t tlThreadId = nextThreadId++;
+
+void writeJsonString(std::ostream& os, const std::string& s)
+{
+    os << '"';
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+            os << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            os << ' ';
+        else
+            os << c;
+    }
+    os << '"';
+}
+} // namespace
+
+namespace bhw
+{
+
+void countAllocation(std::size_t size)
+{
+    ++tlAllocations;
+    tlAllocatedBytes += size;
+}
+
+uint64_t threadAllocations()
+{
+    return tlAllocations;
+}
+uint64_t threadAllocatedBytes()
+{
+    return tlAllocatedBytes;
+}
+uint32_t profileThreadId()
+{
+    return tlThreadId;
+}
+
+Profiler::Profiler() : origin_(std::chrono::steady_clock::now())
+{
+}
+
+Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+uint64_t Profiler::nowUs() const
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now() - origin_)
+                                     .count());
+}
+
+void Profiler::record(ProfileEvent event)
+{
+    std::lock_guard lock(mutex_);
+    events_.push_back(std::move(event));
+}
+
+void Profiler::writeChromeTrace(std::ostream& os) const
+{
+    std::lock_guard lock(mutex_);
+    os << "{\"traceEvents\":[\n";
+    for (size_t i = 0; i < events_.size(); ++i)
+    {
+        const auto& e = events_[i];
+        os << "{\"name\":";
+        writeJsonString(os, e.name);
+        os << ",\"cat\":";
+        writeJsonString(os, e.category);
+        os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread << ",\"ts\":" << e.startUs
+           << ",\"dur\":" << e.durationUs << ",\"args\":{\"allocations\":" << e.allocations
+           << ",\"bytes\":" << e.allocatedBytes << "}}" << (i + 1 < events_.size() ? ",\n" : "\n");
+    }
+    os << "],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void Profiler::writeSummary(std::ostream& os) const
+{
+    struct Total
+    {
+        uint64_t calls = 0;
+        uint64_t us = 0;
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+    };
+
+    std::map<std::pair<std::string, std::string>, Total> totals;
+    {
+        std::lock_guard lock(mutex_);
+        for (const auto& e : events_)
+        {
+            auto& t = totals[{e.category, e.name}];
+            t.calls++;
+            t.us += e.durationUs;
+            t.allocations += e.allocations;
+            t.bytes += e.allocatedBytes;
+        }
+    }
+
+    // slowest first
+    std::vector<std::pair<std::pair<std::string, std::string>, Total>> rows(totals.begin(),
+                                                                            totals.end());
+    std::sort(rows.begin(),
+              rows.end(),
+              [](const auto& a, const auto& b) { return a.second.us > b.second.us; });
+
+    os << std::left << std::setw(10) << "phase" << std::setw(20) << "name" << std::right
+       << std::setw(8) << "calls" << std::setw(12) << "total ms" << std::setw(12) << "mean ms"
+       << std::setw(12) << "allocs" << std::setw(14) << "bytes" << "\n";
+    for (const auto& [key, t] : rows)
+    {
+        os << std::left << std::setw(10) << key.first << std::setw(20) << key.second << std::right
+           << std::setw(8) << t.calls << std::setw(12) << std::fixed << std::setprecision(3)
+           << t.us / 1000.0 << std::setw(12) << t.us / 1000.0 / static_cast<double>(t.calls)
+           << std::setw(12) << t.allocations << std::setw(14) << t.bytes << "\n";
+    }
+}
+
+} // namespace bhw
@@ -0,0 +1,119 @@
+#pragma once
+// Hot-path instrumentation for prag (--profile).
+//
+// Build with -DPRAG_PROFILING (CMake option PRAG_PROFILING) to compile the scopes in;
+// otherwise PRAG_PROFILE_SCOPE expands to nothing. When compiled in, recording still
+// only happens after Profiler::instance().enable(), so an idle scope costs one
+// relaxed atomic load.
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bhw
+{
+
+struct ProfileEvent
+{
+    std::string category; // lex, parse, flatten, walk, registry, ...
+    std::string name;     // language or phase
+    uint64_t startUs = 0;
+    uint64_t durationUs = 0;
+    uint32_t thread = 0;
+    uint64_t allocations = 0; // operator new calls on this thread inside the scope
+    uint64_t allocatedBytes = 0;
+};
+
+class Profiler
+{
+  public:
+    static Profiler& instance();
+
+    void enable()
+    {
+        enabled_.store(true, std::memory_order_relaxed);
+    }
+    bool enabled() const
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    void record(ProfileEvent event);
+
+    // Chrome trace-event JSON (load in chrome://tracing or Perfetto)
+    void writeChromeTrace(std::ostream& os) const;
+    // Per (category, name) totals: calls, time, allocations
+    void writeSummary(std::ostream& os) const;
+
+    uint64_t nowUs() const;
+
+  private:
+    Profiler();
+
+    std::atomic<bool> enabled_{false};
+    std::chrono::steady_clock::time_point origin_;
+    mutable std::mutex mutex_;
+    std::vector<ProfileEvent> events_;
+};
+
+// Allocation counters for the calling thread. They stay zero unless the executable
+// links alloc_hook.cpp (prag_bench always does, prag when PRAG_PROFILING is ON),
+// whose replacement operator new calls countAllocation.
+void countAllocation(std::size_t size);
+uint64_t threadAllocations();
+uint64_t threadAllocatedBytes();
+uint32_t profileThreadId();
+
+class ProfileScope
+{
+  public:
+    template <typename NameFn> ProfileScope(const char* category, NameFn&& name)
+    {
+        auto& profiler = Profiler::instance();
+        if (!profiler.enabled())
+            return;
+        active_ = true;
+        event_.category = category;
+        event_.name = name();
+        event_.thread = profileThreadId();
+        allocations_ = threadAllocations();
+        bytes_ = threadAllocatedBytes();
+        event_.startUs = profiler.nowUs();
+    }
+    ~ProfileScope()
+    {
+        if (!active_)
+            return;
+        auto& profiler = Profiler::instance();
+        event_.durationUs = profiler.nowUs() - event_.startUs;
+        event_.allocations = threadAllocations() - allocations_;
+        event_.allocatedBytes = threadAllocatedBytes() - bytes_;
+        profiler.record(std::move(event_));
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+  private:
+    bool active_ = false;
+    ProfileEvent event_;
+    uint64_t allocations_ = 0;
+    uint64_t bytes_ = 0;
+};
+
+} // namespace bhw
+
+#define PRAG_PROFILE_CONCAT_(a, b) a##b
+#define PRAG_PROFILE_CONCAT(a, b) PRAG_PROFILE_CONCAT_(a, b)
+
+#ifdef PRAG_PROFILING
+// name is only evaluated while profiling is enabled
+#define PRAG_PROFILE_SCOPE(category, name)                                                         \
+    ::bhw::ProfileScope PRAG_PROFILE_CONCAT(pragProfileScope_, __LINE__)(category,                 \
+                                                                         [&] { return (name); })
+#else
+#define PRAG_PROFILE_SCOPE(category, name)
+#endif
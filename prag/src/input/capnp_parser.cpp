@@ -4,6 +4,7 @@
 
 // capnp_parser.cpp
 #include "capnp_parser.h"
+#include "profile.h"
 
 #include <cctype>
 #include <map>
@@ -33,6 +34,7 @@ CapnProtoLexer::CapnProtoLexer(std::string_view source) : source_(source)
 
 std::vector<CapnProtoToken> CapnProtoLexer::tokenize()
 {
+    PRAG_PROFILE_SCOPE("lex", "Capnp");
     std::vector<CapnProtoToken> tokens;
 
     while (!isAtEnd())
@@ -1,5 +1,6 @@
 // flatbuf_parser.cpp
 #include "flatbuf_parser.h"
+#include "profile.h"
 
 #include <cctype>
 #include <map>
@@ -36,6 +37,7 @@ FlatBufLexer::FlatBufLexer(std::string_view source) : source_(source)
 
 std::vector<FlatBufToken> FlatBufLexer::tokenize()
 {
+    PRAG_PROFILE_SCOPE("lex", "FlatBuf");
     std::vector<FlatBufToken> tokens;
 
     while (!isAtEnd())
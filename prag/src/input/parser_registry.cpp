@@ -21,6 +21,7 @@
 #include "thrift_parser.h"
 #include "typescript_parser.h"
 #include "prag_parser.h"
+#include "profile.h"
 
 namespace
 {
@@ -36,6 +37,7 @@ auto bhw::ParserRegistry::getParserRegistry() -> bhw::ParserRegistry&
     static bool initialized = false;
     if (!initialized)
     {
+        PRAG_PROFILE_SCOPE("registry", "parsers");
         registerParser<AvroParser>("avsc");
         registerParser<CSharpParser>("cs");
         registerParser<CapnProtoParser>("capnp");
@@ -54,7 +56,7 @@ auto bhw::ParserRegistry::getParserRegistry() -> bhw::ParserRegistry&
 	registerParser<ThriftParser>("thrift");
 	registerParser<TypeScriptParser>("ts");
 	registerParser<PragParser>("prag");
-	
+        initialized = true;
     }
     return ParserRegistry::instance();
 };
@@ -16,6 +16,10 @@ class AvroAstWalker : public AstWalker
     {
         return Language::Avro;
     }
+    bool hasCrossNodeState() const override
+    {
+        return true;
+    }
 
   private:
     json schemas;
@@ -126,7 +130,7 @@ class AvroAstWalker : public AstWalker
             {
                 json recordType;
                 recordType["type"] = "record";
-                recordType["name"] = capitalize(oneof.name) + "_" + capitalize(oneofField.name);
+                recordType["name"] = variantName(oneof.name, "_", oneofField.name);
                 recordType["fields"] = json::array();
 
                 json valueField;
@@ -149,8 +153,7 @@ class AvroAstWalker : public AstWalker
 
             for (const auto& oneofField : oneof.fields)
             {
-                std::string typeName = capitalize(oneof.name) + "_" + capitalize(oneofField.name);
-                unionTypes.push_back(typeName);
+                unionTypes.push_back(variantName(oneof.name, "_", oneofField.name));
             }
 
             field["type"] = unionTypes;
@@ -160,15 +163,6 @@ class AvroAstWalker : public AstWalker
     }
 
   private:
-    std::string capitalize(const std::string& s)
-    {
-        if (s.empty())
-            return s;
-        std::string result = s;
-        result[0] = std::toupper(static_cast<unsigned char>(result[0]));
-        return result;
-    }
-
     json typeToJson(const Type& type)
     {
         if (std::holds_alternative<SimpleType>(type.value))
@@ -21,6 +21,10 @@ class CapnProtoAstWalker : public RegistryAstWalker
     {
         return bhw::Language::Capnp;
     }
+    bool hasCrossNodeState() const override
+    {
+        return true;
+    }
 
   protected:
     std::string generateHeader(const bhw::Ast&) override
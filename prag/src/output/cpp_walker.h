@@ -15,8 +15,12 @@ class CppWalker : public RegistryAstWalker
     {
         return bhw::Language::Cpp26;
     }
+    bool hasCrossNodeState() const override
+    {
+        return true;
+    }
 
-    std::string walk(bhw::Ast&& ast) override
+    void prepareAst(bhw::Ast& ast) override
     {
         this->srcLang = ast.srcName;
         // C++ needs enums before structs that use them
@@ -48,8 +52,31 @@ class CppWalker : public RegistryAstWalker
             ast.nodes.push_back(std::move(e));
         for (auto& s : structs)
             ast.nodes.push_back(std::move(s));
+    }
+
+    std::string generateFileImports(const std::vector<std::string>& deps) override
+    {
+        std::ostringstream out;
+        for (const auto& dep : deps)
+            out << "#include \"" << dep << "." << fileExtension() << "\"\n";
+        if (!deps.empty())
+            out << "\n";
+        return out.str();
+    }
 
-        return RegistryAstWalker::walk(std::move(ast));
+    // <input stem>.h including every generated header
+    std::optional<std::string> aggregateStem(const std::string& moduleName) override
+    {
+        return moduleName;
+    }
+    std::optional<OutputFile> generateAggregate(const std::string& moduleName,
+                                                const std::vector<std::string>& stems) override
+    {
+        std::ostringstream out;
+        out << "#pragma once\n";
+        for (const auto& stem : stems)
+            out << "#include \"" << stem << "." << fileExtension() << "\"\n";
+        return OutputFile{*aggregateStem(moduleName) + "." + fileExtension(), out.str()};
     }
 
   private:
@@ -249,7 +276,7 @@ class CppWalker : public RegistryAstWalker
         // Generate wrapper structs
         for (const auto& field : oneof.fields)
         {
-            std::string wrapperName = capitalize(oneof.name) + "_" + capitalize(field.name);
+            std::string wrapperName = variantName(oneof.name, "_", field.name);
             std::string fieldType = walkType(*field.type, ctx);
 
             out << ctx.indent(namespaces.size()) << "struct " << wrapperName << " {\n"
@@ -262,8 +289,10 @@ class CppWalker : public RegistryAstWalker
 
         for (const auto& field : oneof.fields)
         {
-            std::string wrapperName = capitalize(oneof.name) + "_" + capitalize(field.name);
-            out << ", " << wrapperName;
+            out << ", ";
+            appendName(out, oneof.name, CaseStyle::Capitalized);
+            out << '_';
+            appendName(out, field.name, CaseStyle::Capitalized);
         }
 
         out << "> " << oneof.name << ";\n\n";
@@ -271,16 +300,6 @@ class CppWalker : public RegistryAstWalker
         return out.str();
     }
 
-  private:
-    std::string capitalize(const std::string& s)
-    {
-        if (s.empty())
-            return s;
-        std::string result = s;
-        result[0] = std::toupper(static_cast<unsigned char>(result[0]));
-        return result;
-    }
-
   protected:
     void modifyAst(bhw::Ast& ast)
     {
@@ -12,15 +12,6 @@ class CSharpAstWalker : public RegistryAstWalker
   private:
     const Struct* currentStruct_ = nullptr;
 
-    std::string capitalize(const std::string& s) const
-    {
-        if (s.empty())
-            return s;
-        std::string r = s;
-        r[0] = std::toupper(r[0]);
-        return r;
-    }
-
     std::string indent(size_t n) const
     {
         return std::string(n * 2, ' ');
@@ -35,6 +26,10 @@ class CSharpAstWalker : public RegistryAstWalker
     {
         return bhw::Language::CSharp;
     }
+    bool hasCrossNodeState() const override
+    {
+        return true;
+    }
 
   protected:
     std::string generateHeader(const bhw::Ast&) override
@@ -77,8 +72,8 @@ class CSharpAstWalker : public RegistryAstWalker
     {
         std::ostringstream out;
 
-        // Base class name = capitalize(oneof.name)
-        std::string baseName = capitalize(oneof.name);
+        // Base class name = Capitalized oneof name
+        std::string baseName = convertName(oneof.name, CaseStyle::Capitalized);
 
         // 1. Generate property in the parent struct
         out << ctx.indent() << "public " << baseName << " " << baseName << " { get; set; }\n";
@@ -89,8 +84,9 @@ class CSharpAstWalker : public RegistryAstWalker
         // 3. Generate concrete variant classes
         for (const auto& field : oneof.fields)
         {
-            std::string variantName = baseName + capitalize(field.name);
-            out << ctx.indent() << "public class " << variantName << " : " << baseName << "\n";
+            out << ctx.indent() << "public class " << baseName;
+            appendName(out, field.name, CaseStyle::Capitalized);
+            out << " : " << baseName << "\n";
             out << ctx.indent() << "{\n";
             out << ctx.indent(1) << "public " << walkType(*field.type, ctx)
                 << " Value { get; set; }\n";
@@ -117,8 +113,9 @@ class CSharpAstWalker : public RegistryAstWalker
     std::string generateField(const Field& field, const WalkContext& ctx) override
     {
         std::ostringstream out;
-        out << ctx.indent() << "public " << walkType(*field.type, ctx) << " "
-            << capitalize(field.name) << " { get; set; }\n";
+        out << ctx.indent() << "public " << walkType(*field.type, ctx) << " ";
+        appendFieldName(out, field.name);
+        out << " { get; set; }\n";
         return out.str();
     }
 
@@ -132,7 +129,8 @@ class CSharpAstWalker : public RegistryAstWalker
                                   const WalkContext& ctx) override
     {
         std::ostringstream out;
-        out << ctx.indent(1) << val.name;
+        out << ctx.indent(1);
+        appendConstantName(out, val.name);
         if (!isLast)
             out << ",";
         out << "\n";
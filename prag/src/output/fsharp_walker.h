@@ -44,7 +44,9 @@ class FSharpAstWalker : public RegistryAstWalker
         }
 
         std::ostringstream out;
-        out << ctx.indent() << capitalize(field.name) << ": " << walkType(*field.type, ctx) << "\n";
+        out << ctx.indent();
+        appendName(out, field.name, CaseStyle::Capitalized);
+        out << ": " << walkType(*field.type, ctx) << "\n";
         return out.str();
     }
 
@@ -170,12 +172,15 @@ class FSharpAstWalker : public RegistryAstWalker
         {
             // Generate discriminated union during flatten pass
             std::ostringstream out;
-            out << "type " << capitalize(oneof.name) << " =\n";
+            out << "type ";
+            appendName(out, oneof.name, CaseStyle::Capitalized);
+            out << " =\n";
 
             for (const auto& field : oneof.fields)
             {
-                out << "  | " << capitalize(field.name) << " of " << walkType(*field.type, ctx)
-                    << "\n";
+                out << "  | ";
+                appendName(out, field.name, CaseStyle::Capitalized);
+                out << " of " << walkType(*field.type, ctx) << "\n";
             }
             out << "\n";
             return out.str();
@@ -184,18 +189,13 @@ class FSharpAstWalker : public RegistryAstWalker
         {
             // Generate field in record during normal pass
             std::ostringstream out;
-            out << ctx.indent() << capitalize(oneof.name) << ": " << capitalize(oneof.name) << "\n";
+            out << ctx.indent();
+            appendName(out, oneof.name, CaseStyle::Capitalized);
+            out << ": ";
+            appendName(out, oneof.name, CaseStyle::Capitalized);
+            out << "\n";
             return out.str();
         }
     }
-
-    inline std::string capitalize(const std::string& s)
-    {
-        if (s.empty())
-            return s;
-        std::string r = s;
-        r[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(r[0])));
-        return r;
-    }
 };
 } // namespace bhw
\ No newline at end of file
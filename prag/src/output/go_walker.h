@@ -55,7 +55,10 @@ class GoAstWalker : public AstWalker
         {
             return ""; // Skip fields during flatten pass
         }
-        return ctx.indent() + field.name + " " + walkType(*field.type, ctx) + "\n";
+        // exported (PascalCase) so other packages and encoding/json can see it
+        std::string out = ctx.indent();
+        appendFieldName(out, field.name);
+        return out + " " + walkType(*field.type, ctx) + "\n";
     }
   
     // ---------------- Enum ----------------
@@ -92,17 +95,17 @@ class GoAstWalker : public AstWalker
         {
             // emit types/interfaces
             std::ostringstream out;
-            std::string ifaceName = capitalize(oneof.name) + "Oneof";
+            std::string ifaceName = variantName(oneof.name, "", "Oneof");
             out << "// Oneof interface\n";
             out << "type " << ifaceName << " interface { is" << ifaceName << "() }\n\n";
 
             for (const auto& field : oneof.fields)
             {
-                std::string variantName = capitalize(oneof.name) + "_" + capitalize(field.name);
-                out << "type " << variantName << " struct {\n";
+                std::string name = variantName(oneof.name, "_", field.name);
+                out << "type " << name << " struct {\n";
                 out << "\tValue " << walkType(*field.type, ctx) << "\n";
                 out << "}\n\n";
-                out << "func (" << variantName << ") is" << ifaceName << "() {}\n\n";
+                out << "func (" << name << ") is" << ifaceName << "() {}\n\n";
             }
             return out.str();
         }
@@ -110,8 +113,11 @@ class GoAstWalker : public AstWalker
         {
             // emit parent field in struct
             std::ostringstream out;
-            std::string ifaceName = capitalize(oneof.name) + "Oneof";
-            out << ctx.indent() << capitalize(oneof.name) << " " << ifaceName << "\n";
+            out << ctx.indent();
+            appendName(out, oneof.name, CaseStyle::Capitalized);
+            out << " ";
+            appendName(out, oneof.name, CaseStyle::Capitalized);
+            out << "Oneof\n";
             return out.str();
         }
     }
@@ -172,15 +178,6 @@ class GoAstWalker : public AstWalker
 
   private:
     std::string srcLang;
-
-    std::string capitalize(const std::string& s)
-    {
-        if (s.empty())
-            return s;
-        std::string r = s;
-        r[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(r[0])));
-        return r;
-    }
 };
 
 } // namespace bhw
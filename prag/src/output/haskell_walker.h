@@ -11,22 +11,9 @@ class HaskellAstWalker : public RegistryAstWalker
   private:
     size_t currentFieldIndex_ = 0;
 
-    std::string capitalize(const std::string& s) const
-    {
-        if (s.empty())
-            return s;
-        std::string result = s;
-        result[0] = std::toupper(result[0]);
-        return result;
-    }
-
     std::string lowercase(const std::string& s) const
     {
-        if (s.empty())
-            return s;
-        std::string result = s;
-        result[0] = std::tolower(result[0]);
-        return result;
+        return uncapitalize(s);
     }
 
     std::string escapeReservedKeyword(const std::string& name) const
@@ -47,6 +34,10 @@ class HaskellAstWalker : public RegistryAstWalker
     {
         return bhw::Language::Haskell;
     }
+    bool hasCrossNodeState() const override
+    {
+        return true;
+    }
     HaskellAstWalker() : RegistryAstWalker(bhw::Language::Haskell)
     {
     }
@@ -109,7 +100,10 @@ class HaskellAstWalker : public RegistryAstWalker
         if (ctx.pass == WalkContext::Pass::Flatten)
             return "";
 
-        return (isFirst ? "      " : "    | ") + capitalize(val.name) + "\n";
+        std::string out = isFirst ? "      " : "    | ";
+        appendName(out, val.name, CaseStyle::Capitalized);
+        out += "\n";
+        return out;
     }
 
     std::string generateEnumClose(const Enum&, const WalkContext& ctx) override
@@ -180,13 +174,15 @@ class HaskellAstWalker : public RegistryAstWalker
         {
             // Generate oneof type directly during flatten pass
             std::ostringstream out;
-            std::string name = capitalize(oneof.name);
-            out << "data " << name << " =\n";
+            out << "data ";
+            appendName(out, oneof.name, CaseStyle::Capitalized);
+            out << " =\n";
             for (size_t i = 0; i < oneof.fields.size(); ++i)
             {
                 const auto& field = oneof.fields[i];
-                out << "    " << (i == 0 ? "  " : "| ") << capitalize(field.name) << " "
-                    << walkType(*field.type, ctx) << "\n";
+                out << "    " << (i == 0 ? "  " : "| ");
+                appendName(out, field.name, CaseStyle::Capitalized);
+                out << " " << walkType(*field.type, ctx) << "\n";
             }
             out << "    deriving (Show, Eq)\n\n";
             return out.str();
@@ -198,9 +194,9 @@ class HaskellAstWalker : public RegistryAstWalker
             if (currentFieldIndex_ > 0)
                 out << ", ";
 
-            std::string name = capitalize(oneof.name);
-            std::string fieldName = escapeReservedKeyword(lowercase(oneof.name));
-            out << fieldName << " :: " << name << "\n      ";
+            out << escapeReservedKeyword(lowercase(oneof.name)) << " :: ";
+            appendName(out, oneof.name, CaseStyle::Capitalized);
+            out << "\n      ";
             currentFieldIndex_++;
             return out.str();
         }
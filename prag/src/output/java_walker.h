@@ -12,15 +12,6 @@ class JavaAstWalker : public RegistryAstWalker
   private:
     int oneofCounter_ = 0;
 
-    std::string capitalize(const std::string& s) const
-    {
-        if (s.empty())
-            return "";
-        std::string r = s;
-        r[0] = std::toupper(r[0]);
-        return r;
-    }
-
     std::string indent(size_t n) const
     {
         return std::string(n * 2, ' ');
@@ -35,6 +26,10 @@ class JavaAstWalker : public RegistryAstWalker
     {
         return Language::Java;
     }
+    bool hasCrossNodeState() const override
+    {
+        return true;
+    }
 
 
   protected:
@@ -59,7 +54,9 @@ class JavaAstWalker : public RegistryAstWalker
     std::string generateField(const Field& field, const WalkContext& ctx) override
     {
         std::ostringstream out;
-        out << ctx.indent() << walkType(*field.type, ctx) << " " << capitalize(field.name) << ";\n";
+        out << ctx.indent() << walkType(*field.type, ctx) << " ";
+        appendFieldName(out, field.name);
+        out << ";\n";
         return out.str();
     }
 
@@ -68,11 +65,13 @@ class JavaAstWalker : public RegistryAstWalker
     {
         // Interface name = ParentStructName + OneofName
         
-        std::string interfaceName = capitalize(oneof.parentStructName) + capitalize(oneof.name);
+        std::string interfaceName = variantName(oneof.parentStructName, "", oneof.name);
 
         // Generate property in the parent struct
         std::ostringstream out;
-        out << ctx.indent() << interfaceName << " " << capitalize(oneof.name) << ";\n";
+        out << ctx.indent() << interfaceName << " ";
+        appendName(out, oneof.name, CaseStyle::Capitalized);
+        out << ";\n";
 
 
 
@@ -81,7 +80,8 @@ class JavaAstWalker : public RegistryAstWalker
         auto sep = "";
         for (const auto& field : oneof.fields)
         {
-            out << sep << interfaceName << capitalize(field.name);
+            out << sep << interfaceName;
+            appendName(out, field.name, CaseStyle::Capitalized);
             sep = ", ";
         }
         out << " {}\n";
@@ -89,8 +89,10 @@ class JavaAstWalker : public RegistryAstWalker
         // Record variants
         for (const auto& field : oneof.fields)
         {
-            out << ctx.indent() << "public record " << interfaceName << capitalize(field.name) << "("
-                << walkType(*field.type, ctx) << " value) implements " << interfaceName << " {}\n";
+            out << ctx.indent() << "public record " << interfaceName;
+            appendName(out, field.name, CaseStyle::Capitalized);
+            out << "(" << walkType(*field.type, ctx) << " value) implements " << interfaceName
+                << " {}\n";
         }
 
         out << "\n";
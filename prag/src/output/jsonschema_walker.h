@@ -17,6 +17,14 @@ class JSONSchemaAstWalker : public AstWalker
     {
         return Language::JSONSchema;
     }
+    bool hasCrossNodeState() const override
+    {
+        return true;
+    }
+    std::string fileExtension() override
+    {
+        return "json";
+    }
 
   private:
     json defs;
@@ -154,7 +162,7 @@ class JSONSchemaAstWalker : public AstWalker
         for (const auto& field : oneof.fields)
         {
             // Create wrapper object for this alternative
-            std::string wrapperName = capitalize(oneof.name) + "_" + capitalize(field.name);
+            std::string wrapperName = variantName(oneof.name, "_", field.name);
 
             json altSchema;
             altSchema["type"] = "object";
@@ -176,15 +184,6 @@ class JSONSchemaAstWalker : public AstWalker
         return "";
     }
 
-    std::string capitalize(const std::string& s)
-    {
-        if (s.empty())
-            return s;
-        std::string result = s;
-        result[0] = std::toupper(static_cast<unsigned char>(result[0]));
-        return result;
-    }
-
 
     json typeToJson(const Type& type)
     {
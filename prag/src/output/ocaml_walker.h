@@ -9,22 +9,9 @@ namespace bhw
 class OCamlAstWalker : public RegistryAstWalker
 {
   private:
-    std::string capitalize(const std::string& s) const
-    {
-        if (s.empty())
-            return s;
-        std::string result = s;
-        result[0] = std::toupper(result[0]);
-        return result;
-    }
-
     std::string lowercase(const std::string& s) const
     {
-        if (s.empty())
-            return s;
-        std::string result = s;
-        result[0] = std::tolower(result[0]);
-        return escapeKeyword(result);
+        return escapeKeyword(uncapitalize(s));
     }
 
     std::string escapeKeyword(const std::string& s) const
@@ -98,7 +85,9 @@ class OCamlAstWalker : public RegistryAstWalker
             return "";
 
         std::ostringstream out;
-        out << ctx.indent() << "| " << capitalize(val.name) << "\n";
+        out << ctx.indent() << "| ";
+        appendName(out, val.name, CaseStyle::Capitalized);
+        out << "\n";
         return out.str();
     }
 
@@ -113,7 +102,10 @@ class OCamlAstWalker : public RegistryAstWalker
     {
         if (ctx.pass == WalkContext::Pass::Flatten)
             return "";
-        return ctx.indent() + "module " + capitalize(ns.name) + " = struct\n";
+        std::string out = ctx.indent() + "module ";
+        appendName(out, ns.name, CaseStyle::Capitalized);
+        out += " = struct\n";
+        return out;
     }
 
     std::string generateNamespaceClose(const bhw::Namespace&, const WalkContext& ctx) override
@@ -133,8 +125,9 @@ class OCamlAstWalker : public RegistryAstWalker
             out << "type " << name << " =\n";
             for (const auto& field : oneof.fields)
             {
-                out << "  | " << capitalize(field.name) << " of " << walkType(*field.type, ctx)
-                    << "\n";
+                out << "  | ";
+                appendName(out, field.name, CaseStyle::Capitalized);
+                out << " of " << walkType(*field.type, ctx) << "\n";
             }
             out << "\n";
             return out.str();
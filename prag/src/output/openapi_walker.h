@@ -17,6 +17,14 @@ class OpenApiAstWalker : public AstWalker
     {
         return Language::OpenApi;
     }
+    bool hasCrossNodeState() const override
+    {
+        return true;
+    }
+    std::string fileExtension() override
+    {
+        return "json";
+    }
 
   private:
     json schemas;
@@ -18,6 +18,10 @@ public:
     PragAstWalker() : RegistryAstWalker(Language::Prag)
     {
     }
+    bool hasCrossNodeState() const override
+    {
+        return true;
+    }
 
 private:
     json items_array = json::array();
@@ -17,6 +17,10 @@ class ProtoBufAstWalker : public RegistryAstWalker
     {
         return bhw::Language::ProtoBuf;
     }
+    bool hasCrossNodeState() const override
+    {
+        return true;
+    }
 
   private:
     int field_number_ = 1;
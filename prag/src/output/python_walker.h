@@ -22,6 +22,30 @@ class PythonAstWalker : public RegistryAstWalker
         return "from dataclasses import dataclass\nfrom typing import Union\n\n";
     }
 
+    std::string generateFileImports(const std::vector<std::string>& deps) override
+    {
+        std::ostringstream out;
+        for (const auto& dep : deps)
+            out << "from ." << dep << " import *\n";
+        if (!deps.empty())
+            out << "\n";
+        return out.str();
+    }
+
+    // package __init__.py re-exporting every generated module
+    std::optional<std::string> aggregateStem(const std::string&) override
+    {
+        return "__init__";
+    }
+    std::optional<OutputFile> generateAggregate(const std::string& moduleName,
+                                                const std::vector<std::string>& stems) override
+    {
+        std::ostringstream out;
+        for (const auto& stem : stems)
+            out << "from ." << stem << " import *\n";
+        return OutputFile{*aggregateStem(moduleName) + ".py", out.str()};
+    }
+
     // ---------------- STRUCT ----------------
     std::string generateStructOpen(const Struct& s, const WalkContext& ctx) override
     {
@@ -85,9 +109,11 @@ class PythonAstWalker : public RegistryAstWalker
             std::ostringstream out;
             for (const auto& field : oneof.fields)
             {
-                std::string clsName = capitalize(oneof.name) + capitalize(field.name);
                 out << "@dataclass\n";
-                out << "class " << clsName << ":\n";
+                out << "class ";
+                appendName(out, oneof.name, CaseStyle::Capitalized);
+                appendName(out, field.name, CaseStyle::Capitalized);
+                out << ":\n";
                 out << "  value: " << walkType(*field.type, ctx) << "\n\n";
             }
             return out.str();
@@ -101,7 +127,8 @@ class PythonAstWalker : public RegistryAstWalker
             {
                 if (i > 0)
                     out << ", ";
-                out << capitalize(oneof.name) + capitalize(oneof.fields[i].name);
+                appendName(out, oneof.name, CaseStyle::Capitalized);
+                appendName(out, oneof.fields[i].name, CaseStyle::Capitalized);
             }
             out << "]\n";
             return out.str();
@@ -169,15 +196,5 @@ class PythonAstWalker : public RegistryAstWalker
     {
         return walkType(*type.pointee, ctx);
     }
-
-    // ---------------- UTILS ----------------
-    std::string capitalize(const std::string& s) const
-    {
-        if (s.empty())
-            return s;
-        std::string r = s;
-        r[0] = static_cast<char>(std::toupper(r[0]));
-        return r;
-    }
 };
 } // namespace bhw
\ No newline at end of file
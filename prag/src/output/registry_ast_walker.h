@@ -52,14 +52,6 @@ class RegistryAstWalker : public AstWalker
         return it->second.default_value;
     }
 
-    // Apply naming convention
-    std::string applyNaming(const std::string& name, const std::string&) const
-    {
-        // TODO: Implement case conversion based on convention
-        // For now, just return as-is
-        return name;
-    }
-
     // Substitute type arguments in template strings like "std::vector<{0}>"
     std::string substituteTypeArgs(const std::string& template_str,
                                    const std::vector<std::string>& args) const
@@ -22,6 +22,33 @@ class RustAstWalker : public RegistryAstWalker
         return out.str();
     }
 
+    std::string generateFileImports(const std::vector<std::string>& deps) override
+    {
+        std::ostringstream out;
+        for (const auto& dep : deps)
+            out << "use super::" << dep << "::*;\n";
+        if (!deps.empty())
+            out << "\n";
+        return out.str();
+    }
+
+    // mod.rs declaring and re-exporting every generated module
+    std::optional<std::string> aggregateStem(const std::string&) override
+    {
+        return "mod";
+    }
+    std::optional<OutputFile> generateAggregate(const std::string& moduleName,
+                                                const std::vector<std::string>& stems) override
+    {
+        std::ostringstream out;
+        for (const auto& stem : stems)
+            out << "pub mod " << stem << ";\n";
+        out << "\n";
+        for (const auto& stem : stems)
+            out << "pub use " << stem << "::*;\n";
+        return OutputFile{*aggregateStem(moduleName) + ".rs", out.str()};
+    }
+
     std::string generateStructOpen(const Struct& s, const WalkContext& ctx) override
     {
         if (ctx.pass == WalkContext::Pass::Flatten)
@@ -18,6 +18,7 @@
 #include "ocaml_walker.h"
 
 #include "prag_walker.h"
+#include "profile.h"
 
 namespace
 {
@@ -37,6 +38,7 @@ auto bhw::WalkerRegistry::getWalkerRegistry() -> WalkerRegistry&
 
     if (!initialized)
     {
+        PRAG_PROFILE_SCOPE("registry", "walkers");
 	registerWalker<CSharpAstWalker>("cs");
 	registerWalker<FSharpAstWalker>("fs");
 	registerWalker<HaskellAstWalker>("hs");
@@ -1,3 +1,5 @@
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <set>
@@ -12,6 +14,7 @@
 #include "ast.h"
 #include "ast_parser.h"
 #include "parser_registry.h"
+#include "profile.h"
 #include "walker_registry.h"
 
 int main(int argc, char* argv[])
@@ -19,6 +22,13 @@ int main(int argc, char* argv[])
     std::ios::sync_with_stdio(false);
     std::cerr.tie(&std::cout);
 
+    // registries are built before CLI parsing, so switch profiling on early
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--profile")
+            bhw::Profiler::instance().enable();
+    }
+
     const auto& parsers = bhw::ParserRegistry::getParserRegistry();
     const auto& walkers = bhw::WalkerRegistry::getWalkerRegistry();
 
@@ -29,6 +39,10 @@ int main(int argc, char* argv[])
     bool out_ast = false;
     bool out_src = false;
     bool out_all = false;
+    size_t jobs = 1;
+    std::string outDir;
+    bool profile = false;
+    std::string profileOut = "prag_profile.json";
     std::set<std::string> outWalkers;
 
     // -------- Positional input file (optional, "-" for stdin) --------
@@ -45,6 +59,12 @@ int main(int argc, char* argv[])
     app.add_flag("--out-ast", out_ast, "Dump AST");
     app.add_flag("--out-src", out_src, "Dump source");
     app.add_flag("--out-all", out_all, "Generate all outputs (AST, source, all walkers)");
+    app.add_option("-j,--jobs", jobs, "Walk top-level nodes on N threads (0 = all cores)");
+    app.add_option("--out-dir",
+                   outDir,
+                   "Write one file per top-level type/namespace into <dir>/<lang>");
+    app.add_flag("--profile", profile, "Record per-phase timings and allocations");
+    app.add_option("--profile-out", profileOut, "Chrome trace-event JSON written by --profile");
 
     // -------- Dynamic walker flags --------
     for (const auto& lang : walkers.getLangs())
@@ -124,7 +144,7 @@ int main(int argc, char* argv[])
 
     try
     {
-        const auto ast = parser.value()->parseToAst(source);
+        const auto ast = parser.value()->parse(source);
 
         if (out_src)
         {
@@ -144,7 +164,22 @@ int main(int argc, char* argv[])
             auto parser = parsers.create(ext);
             std::cerr << "********* " << lang << " *********\n";
             const auto w = walkers.create(lang);
-            auto a = parser.value()->parseToAst(source);
+            w->jobs = jobs;
+            auto a = parser.value()->parse(source);
+            if (!outDir.empty())
+            {
+                std::string module = inputFile.empty() || inputFile == "-"
+                                         ? "types"
+                                         : std::filesystem::path(inputFile).stem().string();
+                auto files = w->walkFiles(std::move(a), module);
+                // one subdirectory per language: walkers that share an extension
+                // (jsonschema, openapi) would otherwise overwrite each other
+                auto langDir = (std::filesystem::path(outDir) / lang).string();
+                auto stats = bhw::writeOutputFiles(langDir, files, jobs);
+                std::cerr << "Wrote " << stats.written << " files, " << stats.unchanged
+                          << " unchanged in " << langDir << "\n";
+                continue;
+            }
             std::cout << w->walk(std::move(a)) << "\n";
         }
     }
@@ -154,6 +189,18 @@ int main(int argc, char* argv[])
         return 1;
     }
 
+    if (profile)
+    {
+#ifdef PRAG_PROFILING
+        std::ofstream trace(profileOut);
+        bhw::Profiler::instance().writeChromeTrace(trace);
+        bhw::Profiler::instance().writeSummary(std::cerr);
+        std::cerr << "Trace written to " << profileOut << "\n";
+#else
+        std::cerr << "Profiling not compiled in (configure with -DPRAG_PROFILING=ON)\n";
+#endif
+    }
+
     return 0;
 }
 
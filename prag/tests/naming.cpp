@@ -0,0 +1,102 @@
+// naming.cpp - identifier case conversion engine
+#include <gtest/gtest.h>
+
+#include "naming.h"
+#include "parser_registry.h"
+#include "walker_registry.h"
+
+#include <string>
+
+namespace
+{
+std::string convert(const std::string& id, bhw::CaseStyle style)
+{
+    std::string out;
+    bhw::appendCase(out, id, style);
+    return out;
+}
+} // namespace
+
+TEST(Naming, SplitWords)
+{
+    auto words = bhw::splitWords("HTTPServer_id2Value");
+    ASSERT_EQ(words.size(), 4u);
+    EXPECT_EQ(words[0], std::make_pair(0u, 4u)); // HTTP
+    EXPECT_EQ(words[1], std::make_pair(4u, 6u)); // Server
+    EXPECT_EQ(words[2], std::make_pair(11u, 3u)); // id2
+    EXPECT_EQ(words[3], std::make_pair(14u, 5u)); // Value
+}
+
+TEST(Naming, Styles)
+{
+    using bhw::CaseStyle;
+    EXPECT_EQ(convert("user_id", CaseStyle::PascalCase), "UserId");
+    EXPECT_EQ(convert("user_id", CaseStyle::CamelCase), "userId");
+    EXPECT_EQ(convert("UserId", CaseStyle::SnakeCase), "user_id");
+    EXPECT_EQ(convert("userId", CaseStyle::ScreamingSnakeCase), "USER_ID");
+    EXPECT_EQ(convert("UserId", CaseStyle::KebabCase), "user-id");
+    EXPECT_EQ(convert("User_Id", CaseStyle::LowerCase), "userid");
+    EXPECT_EQ(convert("userId", CaseStyle::Capitalized), "UserId");
+    EXPECT_EQ(convert("User_Id", CaseStyle::Uncapitalized), "user_Id");
+    EXPECT_EQ(convert("_private", CaseStyle::SnakeCase), "_private");
+    EXPECT_EQ(convert("", CaseStyle::PascalCase), "");
+}
+
+TEST(Naming, ParseConvention)
+{
+    EXPECT_EQ(bhw::parseCaseStyle("PascalCase"), bhw::CaseStyle::PascalCase);
+    EXPECT_EQ(bhw::parseCaseStyle("UPPER_SNAKE_CASE"), bhw::CaseStyle::ScreamingSnakeCase);
+    EXPECT_EQ(bhw::parseCaseStyle("SCREAMING_SNAKE_CASE"), bhw::CaseStyle::ScreamingSnakeCase);
+    EXPECT_EQ(bhw::parseCaseStyle("kebab-case"), bhw::CaseStyle::KebabCase);
+    EXPECT_EQ(bhw::parseCaseStyle("whatever"), bhw::CaseStyle::AsIs);
+}
+
+TEST(Naming, NameTableMemoizes)
+{
+    bhw::NameTable names;
+    const auto& a = names.convert("field_name", bhw::CaseStyle::CamelCase);
+    const auto& b = names.convert("field_name", "camelCase");
+    EXPECT_EQ(a, "fieldName");
+    EXPECT_EQ(&a, &b);
+    EXPECT_EQ(names.size(), 1u);
+
+    std::string buf = "get";
+    names.appendTo(buf, "field_name", bhw::CaseStyle::PascalCase);
+    EXPECT_EQ(buf, "getFieldName");
+    EXPECT_EQ(names.size(), 1u);
+}
+
+TEST(Naming, FirstLetterStylesSkipTheTable)
+{
+    EXPECT_FALSE(bhw::splitsWords(bhw::CaseStyle::AsIs));
+    EXPECT_FALSE(bhw::splitsWords(bhw::CaseStyle::Capitalized));
+    EXPECT_FALSE(bhw::splitsWords(bhw::CaseStyle::Uncapitalized));
+    EXPECT_TRUE(bhw::splitsWords(bhw::CaseStyle::SnakeCase));
+    EXPECT_TRUE(bhw::splitsWords(bhw::CaseStyle::PascalCase));
+}
+
+TEST(Naming, WalkersApplyLanguageConventions)
+{
+    auto walkWith = [](const std::string& parserName, const std::string& source, const std::string& lang)
+    {
+        auto parser = bhw::ParserRegistry::getParserRegistry().create(parserName);
+        auto ast = parser.value()->parseToAst(source);
+        auto walker = bhw::WalkerRegistry::getWalkerRegistry().create(lang);
+        std::string out = walker->walk(std::move(ast));
+        EXPECT_GT(ast.names.size(), 0u) << lang; // conversions went through the table
+        return out;
+    };
+    const std::string proto = "syntax = \"proto3\";\n"
+                              "enum Status { STATUS_ACTIVE = 0; }\n"
+                              "message Account { int32 user_id = 1; }\n";
+
+    std::string cs = walkWith("proto", proto, "cs");
+    EXPECT_NE(cs.find("public int UserId { get; set; }"), std::string::npos) << cs;
+    EXPECT_NE(cs.find("StatusActive"), std::string::npos) << cs;
+
+    std::string java = walkWith("proto", proto, "java");
+    EXPECT_NE(java.find("int userId;"), std::string::npos) << java;
+
+    std::string go = walkWith("h", "struct Account { int user_id; };\n", "go");
+    EXPECT_NE(go.find("UserId int"), std::string::npos) << go;
+}
@@ -0,0 +1,151 @@
+// output_files.cpp - split (--out-dir) walks and the file writer
+#include <gtest/gtest.h>
+
+#include "output_files.h"
+#include "parser_registry.h"
+#include "walker_registry.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+const bhw::OutputFile* findFile(const std::vector<bhw::OutputFile>& files, const std::string& name)
+{
+    auto it = std::find_if(files.begin(), files.end(), [&](const auto& f) { return f.name == name; });
+    return it == files.end() ? nullptr : &*it;
+}
+} // namespace
+
+TEST(OutputFiles, TypeUnitsPreferQualifiedNames)
+{
+    bhw::TypeUnits units;
+    units.add("a::Point", 0);
+    units.add("a::Line", 0);
+    units.add("b::Point", 1);
+    units.add("b::Shape", 1);
+
+    EXPECT_EQ(units.find("a::Point", 1), 0u);
+    EXPECT_EQ(units.find("b::Point", 0), 1u);
+    EXPECT_EQ(units.find("Line", 1), 0u);
+    EXPECT_EQ(units.find("Point", 0), 0u); // ambiguous: own namespace wins
+    EXPECT_EQ(units.find("Point", 1), 1u);
+    EXPECT_EQ(units.find("Missing", 0), std::nullopt);
+}
+
+TEST(OutputFiles, AggregateNameIsReserved)
+{
+    auto parser = bhw::ParserRegistry::getParserRegistry().create("proto");
+    ASSERT_TRUE(parser.has_value());
+    auto ast = parser.value()->parseToAst("syntax = \"proto3\";\n"
+                                          "message User { string name = 1; }\n"
+                                          "message Session { User user = 1; }\n");
+    auto walker = bhw::WalkerRegistry::getWalkerRegistry().create("h");
+    ASSERT_NE(walker, nullptr);
+    auto files = walker->walkFiles(std::move(ast), "user");
+
+    const auto* aggregate = findFile(files, "user.h");
+    const auto* user = findFile(files, "user_2.h");
+    const auto* session = findFile(files, "session.h");
+    ASSERT_NE(aggregate, nullptr);
+    ASSERT_NE(user, nullptr);
+    ASSERT_NE(session, nullptr);
+    EXPECT_EQ(aggregate->content.find("#include \"user.h\""), std::string::npos);
+    EXPECT_NE(aggregate->content.find("#include \"user_2.h\""), std::string::npos);
+    EXPECT_NE(session->content.find("#include \"user_2.h\""), std::string::npos);
+}
+
+TEST(OutputFiles, DuplicateNamesAreRejected)
+{
+    auto dir = std::filesystem::temp_directory_path() / "prag_output_files_test";
+    std::filesystem::remove_all(dir);
+    std::vector<bhw::OutputFile> files = {{"a.h", "one"}, {"a.h", "two"}};
+    EXPECT_THROW(bhw::writeOutputFiles(dir.string(), files, 2), std::runtime_error);
+    EXPECT_FALSE(std::filesystem::exists(dir / "a.h"));
+    std::filesystem::remove_all(dir);
+}
+
+TEST(OutputFiles, SanitizeFileStem)
+{
+    EXPECT_EQ(bhw::sanitizeFileStem("<anonymous>"), "anonymous");
+    EXPECT_EQ(bhw::sanitizeFileStem("a::b"), "a_b");
+    EXPECT_EQ(bhw::sanitizeFileStem("my-type"), "my-type");
+    EXPECT_EQ(bhw::sanitizeFileStem("2d_point"), "_2d_point");
+    EXPECT_EQ(bhw::sanitizeFileStem("Con"), "Con_");
+    EXPECT_EQ(bhw::sanitizeFileStem("com1"), "com1_");
+    EXPECT_EQ(bhw::sanitizeFileStem("<>"), "unnamed");
+    EXPECT_EQ(bhw::sanitizeFileStem(""), "unnamed");
+}
+
+TEST(OutputFiles, AnonymousTypesGetPortableNames)
+{
+    // tests/go/inputs/nested3.go: two levels of anonymous structs
+    const std::string source = "type Person struct {\n"
+                               "    Name string\n"
+                               "    Age  int\n"
+                               "    Address struct {\n"
+                               "        Street string\n"
+                               "        Stufff struct {\n"
+                               "           Thing string\n"
+                               "        }\n"
+                               "    }\n"
+                               "}\n";
+    for (const std::string lang : {"rs", "py"})
+    {
+        auto parser = bhw::ParserRegistry::getParserRegistry().create("go");
+        ASSERT_TRUE(parser.has_value());
+        auto walker = bhw::WalkerRegistry::getWalkerRegistry().create(lang);
+        ASSERT_NE(walker, nullptr);
+        auto files = walker->walkFiles(parser.value()->parseToAst(source), "nested3");
+
+        ASSERT_GT(files.size(), 2u);
+        for (const auto& file : files)
+        {
+            EXPECT_EQ(file.name.find_first_of("<>:\"/\\|?*"), std::string::npos) << file.name;
+            EXPECT_EQ(file.content.find("<anonymous>;"), std::string::npos) << file.name;
+            EXPECT_EQ(file.content.find(".<anonymous>"), std::string::npos) << file.name;
+        }
+    }
+}
+
+TEST(OutputFiles, ManyNestedTypes)
+{
+    // enough nested names that collecting them reallocates the name list
+    const std::string source = "syntax = \"proto3\";\n"
+                               "package shop;\n"
+                               "message Order {\n"
+                               "    enum Kind { NORMAL = 0; RUSH = 1; }\n"
+                               "    message Line { string sku = 1; message Price { int64 cents = 1; } }\n"
+                               "    message Address { string street = 1; }\n"
+                               "    message Contact { string email = 1; }\n"
+                               "    Kind kind = 1;\n"
+                               "    repeated Line lines = 2;\n"
+                               "    Address address = 3;\n"
+                               "    Contact contact = 4;\n"
+                               "}\n";
+
+    auto parser = bhw::ParserRegistry::getParserRegistry().create("proto");
+    ASSERT_TRUE(parser.has_value());
+    auto ast = parser.value()->parseToAst(source);
+    std::vector<std::string> names;
+    for (const auto& node : ast.nodes)
+        bhw::collectTypeNames(node, names);
+    for (const std::string name : {"shop::Order",
+                                   "shop::Order::Kind",
+                                   "shop::Order::Line",
+                                   "shop::Order::Line::Price",
+                                   "shop::Order::Address",
+                                   "shop::Order::Contact"})
+        EXPECT_NE(std::find(names.begin(), names.end(), name), names.end()) << name;
+
+    for (const std::string lang : {"cs", "h", "java", "jsonschema", "openapi"})
+    {
+        auto langParser = bhw::ParserRegistry::getParserRegistry().create("proto");
+        auto walker = bhw::WalkerRegistry::getWalkerRegistry().create(lang);
+        ASSERT_NE(walker, nullptr);
+        auto files = walker->walkFiles(langParser.value()->parseToAst(source), "shop");
+        EXPECT_FALSE(files.empty()) << lang;
+    }
+}
@@ -0,0 +1,146 @@
+// parallel_walk.cpp - walking with jobs > 1 matches the serial walk
+#include <gtest/gtest.h>
+
+#include "ast.h"
+#include "parallel.h"
+#include "parser_registry.h"
+#include "walker_registry.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::string walkWithJobs(const std::string& parserName,
+                         const std::string& source,
+                         const std::string& lang,
+                         size_t jobs)
+{
+    auto parser = bhw::ParserRegistry::getParserRegistry().create(parserName);
+    auto walker = bhw::WalkerRegistry::getWalkerRegistry().create(lang);
+    walker->jobs = jobs;
+    return walker->walk(parser.value()->parseToAst(source));
+}
+
+enum class Outcome
+{
+    Same,
+    Different,
+    ParallelFailed,
+    Unsupported // the serial walk itself throws or crashes on this input
+};
+
+// Some parser/walker pairs crash on some inputs regardless of jobs, so each
+// comparison runs in a child process. The child reports 'S' once the serial
+// walk has finished, which tells a serial failure from a parallel one.
+Outcome compareWalks(const std::string& parserName, const std::string& source, const std::string& lang)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+        throw std::runtime_error("pipe failed");
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        close(fds[0]);
+        int code = 3;
+        try
+        {
+            std::string serial = walkWithJobs(parserName, source, lang, 1);
+            (void)!write(fds[1], "S", 1);
+            code = walkWithJobs(parserName, source, lang, 4) == serial ? 0 : 1;
+        }
+        catch (...)
+        {
+        }
+        _exit(code);
+    }
+    close(fds[1]);
+    char mark = 0;
+    bool serialDone = read(fds[0], &mark, 1) == 1;
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    if (!serialDone)
+        return Outcome::Unsupported;
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+        return Outcome::Same;
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 1)
+        return Outcome::Different;
+    return Outcome::ParallelFailed;
+}
+} // namespace
+
+TEST(ParallelWalk, MatchesSerialWalk)
+{
+    auto& parsers = bhw::ParserRegistry::getParserRegistry();
+    auto& walkers = bhw::WalkerRegistry::getWalkerRegistry();
+
+    size_t compared = 0;
+    for (const auto& dir : std::filesystem::directory_iterator(PRAG_TEST_DIR))
+    {
+        auto inputs = dir.path() / "inputs";
+        if (!std::filesystem::is_directory(inputs))
+            continue;
+        for (const auto& entry : std::filesystem::directory_iterator(inputs))
+        {
+            std::string path = entry.path().string();
+            std::string ext = bhw::getFileExtension(path);
+            if (ext.empty() || !parsers.has(ext.substr(1)))
+                continue;
+            std::string source = bhw::readFile(path);
+
+            for (const auto& lang : walkers.getLangs())
+            {
+                if (walkers.create(lang)->hasCrossNodeState())
+                    continue;
+
+                Outcome outcome = compareWalks(ext.substr(1), source, lang);
+                if (outcome == Outcome::Unsupported)
+                    continue;
+                EXPECT_NE(outcome, Outcome::Different) << path << " -> " << lang;
+                EXPECT_NE(outcome, Outcome::ParallelFailed) << path << " -> " << lang;
+                ++compared;
+            }
+        }
+    }
+    EXPECT_GT(compared, 0u);
+}
+
+TEST(ParallelWalk, ParallelForVisitsEveryIndexOnce)
+{
+    std::vector<std::atomic<int>> hits(1000);
+    bhw::parallelFor(hits.size(), 4, [&](size_t i) { ++hits[i]; });
+    for (const auto& hit : hits)
+        EXPECT_EQ(hit.load(), 1);
+}
+
+TEST(ParallelWalk, NestedParallelForCompletes)
+{
+    std::atomic<size_t> total{0};
+    bhw::parallelFor(8,
+                     4,
+                     [&](size_t)
+                     {
+                         bhw::parallelFor(100, 4, [&](size_t) { ++total; });
+                     });
+    EXPECT_EQ(total.load(), 800u);
+}
+
+TEST(ParallelWalk, ParallelForRethrows)
+{
+    EXPECT_THROW(bhw::parallelFor(100,
+                                  4,
+                                  [](size_t i)
+                                  {
+                                      if (i == 37)
+                                          throw std::runtime_error("item 37");
+                                  }),
+                 std::runtime_error);
+}
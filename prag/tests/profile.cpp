@@ -0,0 +1,70 @@
+// profile.cpp - --profile instrumentation (built only with PRAG_PROFILING)
+#include <gtest/gtest.h>
+
+#include "parser_registry.h"
+#include "profile.h"
+#include "walker_registry.h"
+
+#include <nlohmann/json.hpp>
+
+#include <set>
+#include <sstream>
+#include <string>
+
+TEST(Profile, DisabledScopeRecordsNothing)
+{
+    auto& profiler = bhw::Profiler::instance();
+    ASSERT_FALSE(profiler.enabled());
+    bool evaluated = false;
+    {
+        PRAG_PROFILE_SCOPE("test", (evaluated = true, "idle"));
+    }
+    EXPECT_FALSE(evaluated);
+
+    std::ostringstream trace;
+    profiler.writeChromeTrace(trace);
+    EXPECT_TRUE(nlohmann::json::parse(trace.str())["traceEvents"].empty());
+}
+
+TEST(Profile, ParseAndWalkProduceTrace)
+{
+    auto& profiler = bhw::Profiler::instance();
+    profiler.enable();
+
+    // the anonymous struct makes the py walker flatten before walking
+    auto parser = bhw::ParserRegistry::getParserRegistry().create("go");
+    ASSERT_TRUE(parser.has_value());
+    auto ast = parser.value()->parse("type Person struct {\n"
+                                     "    Name string\n"
+                                     "    Address struct {\n"
+                                     "        Street string\n"
+                                     "    }\n"
+                                     "}\n");
+    auto walker = bhw::WalkerRegistry::getWalkerRegistry().create("py");
+    ASSERT_NE(walker, nullptr);
+    EXPECT_FALSE(walker->walk(std::move(ast)).empty());
+
+    std::ostringstream trace;
+    profiler.writeChromeTrace(trace);
+    auto json = nlohmann::json::parse(trace.str());
+    ASSERT_TRUE(json["traceEvents"].is_array());
+
+    std::set<std::string> categories;
+    for (const auto& event : json["traceEvents"])
+    {
+        EXPECT_EQ(event["ph"], "X");
+        EXPECT_TRUE(event["ts"].is_number());
+        EXPECT_TRUE(event["dur"].is_number());
+        EXPECT_TRUE(event["args"]["allocations"].is_number());
+        categories.insert(event["cat"].get<std::string>());
+    }
+    EXPECT_TRUE(categories.contains("parse"));
+    EXPECT_TRUE(categories.contains("flatten"));
+    EXPECT_TRUE(categories.contains("walk"));
+
+    std::ostringstream summary;
+    profiler.writeSummary(summary);
+    EXPECT_NE(summary.str().find("phase"), std::string::npos);
+    EXPECT_NE(summary.str().find("walk"), std::string::npos);
+    EXPECT_NE(summary.str().find("flatten"), std::string::npos);
+}